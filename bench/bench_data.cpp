@@ -0,0 +1,40 @@
+// bench/bench_data.cpp
+#include "bench_data.h"
+#include "services/generator/client_generator.h"
+#include <cstdlib>
+#include <sstream>
+
+namespace bench_data {
+std::vector<std::size_t> bench_row_counts() {
+  std::vector<std::size_t> counts;
+  if (const char *env = std::getenv("SAFECOIN_BENCH_ROWS")) {
+    std::istringstream input(env);
+    std::string item;
+    while (std::getline(input, item, ','))
+      if (!item.empty())
+        counts.push_back(static_cast<std::size_t>(std::stoull(item)));
+  }
+  if (counts.empty())
+    counts = {10'000, 1'000'000, 10'000'000};
+  return counts;
+}
+
+std::string bench_account_number(std::size_t i) {
+  return client_generator::generated_account_number(i);
+}
+
+std::filesystem::path get_bench_file(std::size_t rows) {
+  // Fixed seed so every run and every machine measures the same bytes.
+  client_generator::stGeneratorOptions options;
+  options.rows = rows;
+  options.seed = 0x5afec011;
+
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() /
+      ("safecoin_bench_s" + std::to_string(options.seed) + "_" +
+       std::to_string(rows) + ".csv");
+  if (!std::filesystem::exists(path))
+    client_generator::generate_clients_file(path, options);
+  return path;
+}
+} // namespace bench_data
@@ -0,0 +1,20 @@
+// bench/bench_data.h
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace bench_data
+{
+    // Row counts to benchmark. Read from SAFECOIN_BENCH_ROWS (comma separated) so a quick
+    // local run can use e.g. "10000"; defaults to 10K, 1M and 10M rows.
+    std::vector<std::size_t> bench_row_counts();
+
+    // Path of a synthetic data file with `rows` records in the real #//# format.
+    // Made by client_generator with a fixed seed once into the temp directory, then reused.
+    std::filesystem::path get_bench_file(std::size_t rows);
+
+    // Account number of row i in every bench file.
+    std::string bench_account_number(std::size_t i);
+}
@@ -0,0 +1,44 @@
+// bench/bench_detect_delim.cpp
+#include "catch_amalgamated.hpp"
+#include "infrastructure.h"
+#include "platform_ops/cpu/cpu.h"
+#include "services/convert/h_convert/h_convert.h"
+#include <string>
+#include <vector>
+
+TEST_CASE("detect_delim kernels", "[bench][detect_delim]") {
+  const std::string record =
+      "AC100004242#//#4821#//#01123456789#//#Client mohamedelsayed#//#-1234.56";
+  std::vector<short> indexes;
+  indexes.reserve(8);
+
+  BENCHMARK("detect_delim scalar, one record") {
+    indexes.clear();
+    h_convert::detect_delim_scalar(record, infrastructure_names::SEPARATOR, indexes);
+    return indexes.size();
+  };
+  if (platform_ops_cpu::has_sse2()) {
+    BENCHMARK("detect_delim sse2, one record") {
+      indexes.clear();
+      h_convert::detect_delim_sse2(record, infrastructure_names::SEPARATOR, indexes);
+      return indexes.size();
+    };
+  }
+  if (platform_ops_cpu::has_avx2()) {
+    BENCHMARK("detect_delim avx2, one record") {
+      indexes.clear();
+      h_convert::detect_delim_avx2(record, infrastructure_names::SEPARATOR, indexes);
+      return indexes.size();
+    };
+  }
+  BENCHMARK("detect_delim dispatched, one record") {
+    indexes.clear();
+    h_convert::detect_delim(record, infrastructure_names::SEPARATOR, indexes);
+    return indexes.size();
+  };
+
+  client_data_structure::stClientData parsed{};
+  BENCHMARK("convert_line_to_record, one record") {
+    return h_convert::convert_line_to_record(record, parsed);
+  };
+}
@@ -0,0 +1,60 @@
+// bench/bench_load.cpp
+#include "bench_data.h"
+#include "catch_amalgamated.hpp"
+#include "file_ops/client_stream/client_stream.h"
+#include "file_ops/file_ops.h"
+#include "services/columnar_snapshot/columnar_snapshot.h"
+#include "services/client_table/client_table.h"
+#include <string>
+
+TEST_CASE("Loading the data file", "[bench][load]") {
+  for (std::size_t rows : bench_data::bench_row_counts()) {
+    const std::filesystem::path path = bench_data::get_bench_file(rows);
+    const std::string suffix = ", " + std::to_string(rows) + " rows";
+
+    BENCHMARK("get_all_clients" + suffix) {
+      return file_ops::get_all_clients(path).size();
+    };
+    BENCHMARK("get_all_clients_mapped" + suffix) {
+      return file_ops::get_all_clients_mapped(path).lines.size();
+    };
+    BENCHMARK("get_all_clients_indexed" + suffix) {
+      return structural_index::row_count(
+          file_ops::get_all_clients_indexed(path).index);
+    };
+
+    // Record parsing: the same file all the way to parsed records
+    BENCHMARK("load_clients_parallel 1 thread" + suffix) {
+      return file_ops::load_clients_parallel(path, 1).size();
+    };
+    BENCHMARK("load_clients_parallel all cores" + suffix) {
+      return file_ops::load_clients_parallel(path).size();
+    };
+    BENCHMARK("clsClientStream full pass" + suffix) {
+      std::size_t count = 0;
+      for (const auto &client : file_ops::clsClientStream(path))
+        count += client.account_number.size();
+      return count;
+    };
+    BENCHMARK("load_client_table" + suffix) {
+      return client_table::load_client_table(path).size();
+    };
+
+    // Start-up from the columnar snapshot instead of the CSV
+    std::filesystem::path snapshot_path = path;
+    snapshot_path += ".snap";
+    columnar_snapshot::write_snapshot_file(
+        snapshot_path, file_ops::load_clients_parallel(path), path);
+    BENCHMARK("columnar snapshot open" + suffix) {
+      columnar_snapshot::clsSnapshotFile snapshot;
+      return snapshot.open(snapshot_path, path) ? snapshot.size() : 0;
+    };
+    BENCHMARK("columnar snapshot open + verify + to_records" + suffix) {
+      return columnar_snapshot::load_clients(path, snapshot_path).size();
+    };
+    BENCHMARK("columnar snapshot open + to_table" + suffix) {
+      columnar_snapshot::clsSnapshotFile snapshot;
+      return snapshot.open(snapshot_path, path) ? snapshot.to_table().size() : 0;
+    };
+  }
+}
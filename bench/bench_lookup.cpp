@@ -0,0 +1,82 @@
+// bench/bench_lookup.cpp
+#include "bench_data.h"
+#include "catch_amalgamated.hpp"
+#include "services/client_snapshot/client_snapshot.h"
+#include "services/client_table/client_table.h"
+#include "services/index/account_index/account_index.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Looking up clients by account number", "[bench][lookup]") {
+  for (std::size_t rows : bench_data::bench_row_counts()) {
+    const std::filesystem::path path = bench_data::get_bench_file(rows);
+    const std::string suffix = ", " + std::to_string(rows) + " rows";
+
+    // 1000 keys spread over the file, plus one miss in ten
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < 1000; ++i)
+      keys.push_back(i % 10 == 9 ? "missing" + std::to_string(i)
+                                 : bench_data::bench_account_number(
+                                       (i * 7919) % rows));
+
+    std::filesystem::path index_path = path;
+    index_path += ".idx";
+    account_index::clsAccountIndex index;
+    REQUIRE(index.open(path, index_path));
+
+    BENCHMARK("clsAccountIndex::find x1000" + suffix) {
+      std::size_t hits = 0;
+      for (const auto &key : keys)
+        hits += index.find(key).has_value() ? 1 : 0;
+      return hits;
+    };
+
+    const client_table::clsClientTable table = client_table::load_client_table(path);
+    BENCHMARK("clsClientTable::find_row linear scan x1" + suffix) {
+      return table.find_row(keys[0]);
+    };
+  }
+}
+
+TEST_CASE("Snapshot table reads under a stream of updates", "[bench][snapshot]") {
+  for (std::size_t rows : bench_data::bench_row_counts()) {
+    if (rows > 1'000'000)
+      continue; // Each published version copies the table
+    const std::string suffix = ", " + std::to_string(rows) + " rows";
+    client_snapshot::clsSnapshotTable clients(
+        client_table::load_client_table(bench_data::get_bench_file(rows)));
+
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < 1000; ++i)
+      keys.push_back(bench_data::bench_account_number((i * 7919) % rows));
+    auto find_all = [&] {
+      std::size_t hits = 0;
+      for (const auto &key : keys) {
+        auto view = clients.read();
+        hits += view.find(key).has_value() ? 1 : 0;
+      }
+      return hits;
+    };
+
+    BENCHMARK("clsSnapshotTable find x1000, no writer" + suffix) {
+      return find_all();
+    };
+
+    std::atomic<bool> done{false};
+    std::jthread writer([&] {
+      std::vector<op_log::stLogEntry> batch(1);
+      for (std::size_t i = 0; !done.load(); ++i) {
+        batch[0] = {op_log::enOperation::update,
+                    {bench_data::bench_account_number(i % rows), "1234",
+                     "0100000000", "Updated", static_cast<double>(i)}};
+        clients.apply(batch);
+      }
+    });
+    BENCHMARK("clsSnapshotTable find x1000, writer publishing" + suffix) {
+      return find_all();
+    };
+    done = true;
+  }
+}
@@ -0,0 +1,45 @@
+// bench/bench_rewrite.cpp
+#include "bench_data.h"
+#include "catch_amalgamated.hpp"
+#include "file_ops/file_ops.h"
+#include "services/balance/balance.h"
+#include "services/client_table/client_table.h"
+#include <string>
+
+TEST_CASE("Full rewrite of the data file", "[bench][rewrite]") {
+  for (std::size_t rows : bench_data::bench_row_counts()) {
+    const std::filesystem::path path = bench_data::get_bench_file(rows);
+    const std::string suffix = ", " + std::to_string(rows) + " rows";
+
+    const auto records = file_ops::load_clients_parallel(path);
+    const std::filesystem::path out_dir =
+        std::filesystem::temp_directory_path() / "safecoin_bench_rewrite";
+    std::filesystem::create_directories(out_dir);
+    const std::filesystem::path out_path = out_dir / "clients.csv";
+
+    BENCHMARK("save_all_clients" + suffix) {
+      file_ops::save_all_clients(out_path, records);
+      return out_path.native().size();
+    };
+    std::filesystem::remove_all(out_dir);
+  }
+}
+
+TEST_CASE("Balance column aggregation", "[bench][balance]") {
+  for (std::size_t rows : bench_data::bench_row_counts()) {
+    const auto table =
+        client_table::load_client_table(bench_data::get_bench_file(rows));
+    const auto column = table.balances_minor();
+    const std::string suffix = ", " + std::to_string(rows) + " rows";
+
+    BENCHMARK("sum_minor scalar" + suffix) {
+      return balance::sum_minor_scalar(column);
+    };
+    BENCHMARK("sum_minor dispatched" + suffix) {
+      return balance::sum_minor(column);
+    };
+    BENCHMARK("compute_portfolio_totals" + suffix) {
+      return balance::compute_portfolio_totals(column).total_minor;
+    };
+  }
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "services/balance/balance.h"
+
+namespace report_screens
+{
+	// Prints the portfolio totals report (client count, exact total, lowest/highest
+	// balance, overdrawn and zero-balance counts) in the same frame as the main menu.
+	void show_portfolio_totals_screen(const balance::stPortfolioTotals& totals);
+}
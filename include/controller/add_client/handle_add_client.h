@@ -0,0 +1,58 @@
+// controller/add_client/handle_add_client.h
+
+#pragma once
+
+#include "file_ops/op_log/op_log.h"
+#include "services/index/account_filter/account_filter.h"
+#include <string_view>
+
+namespace add_client_controller
+{
+	enum class enAddStatus
+	{
+		added,     // Appended to the operation log
+		duplicate, // A client with that account_number already exists; nothing written
+	};
+
+	struct stAddResult
+	{
+		enAddStatus status = enAddStatus::added;
+		bool scanned = false; // True if the full client list had to be loaded
+	};
+
+#pragma region add_new_client Documentation
+	/**
+	 * @brief Adds one client after making sure its account_number is not in use.
+	 *
+	 * The account filter answers first. "Definitely new" goes straight to a single log
+	 * append: the data file is never read. Only a possible hit (or a filter that is stale
+	 * and has to be rebuilt) loads the current state and checks it exactly.
+	 *
+	 * @param operation_log  Log of the data file; @p filter must be attached to it
+	 *                       (account_filter::attach) so the append also updates the filter.
+	 * @param filter         Account filter of the same data directory; rebuilt if stale.
+	 * @param record         The new client.
+	 * @return stAddResult  Whether it was added, and whether the slow path ran.
+	 *
+	 * @throws data_lock::clsVersionConflict
+	 *   If another process committed between the check and the append. Nothing is written;
+	 *   retry (the retry sees the other process's clients).
+	 * @throws std::runtime_error
+	 *   If the append or a filter rebuild fails.
+	 */
+#pragma endregion
+	stAddResult add_new_client(op_log::clsOpLog& operation_log, account_filter::clsAccountFilter& filter,
+		const client_data_structure::stClientData& record);
+
+#pragma region run_add_program Documentation
+	/**
+	 * @brief `--add` entry point: prepares the data files like start_program, then add_new_client.
+	 *
+	 * @param record_line  The client as one record line (account#//#pin#//#phone#//#name#//#balance).
+	 * @param sync         Sync policy of the log; the OK is printed after the sync.
+	 * @return int  Process exit code: 0 if added; 1 if the line is malformed, the account
+	 *              exists or another process kept winning the version check.
+	 */
+#pragma endregion
+	int run_add_program(std::string_view record_line, const op_log::stSyncOptions& sync = {});
+}
@@ -0,0 +1,59 @@
+// controller/batch/handle_batch.h
+
+#pragma once
+
+#include "file_ops/op_log/op_log.h"
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+namespace batch_controller
+{
+	struct stBatchResult
+	{
+		std::size_t commands = 0;  // Non-blank, non-comment lines read
+		std::size_t mutations = 0; // add/update/delete commands that succeeded
+		std::size_t errors = 0;    // Lines rejected (unknown command, bad record, missing account...)
+		bool rewrote = false;      // True if the batch rewrote the data file instead of appending
+	};
+
+#pragma region run_batch Documentation
+	/**
+	 * @brief Runs a script of client commands without menus or prompts.
+	 *
+	 * One command per line, in the command_session::clsCommandSession language (add,
+	 * update, delete, find, list). Blank lines and lines starting with '#' are skipped.
+	 *
+	 * The current state is loaded once into a session, so a find sees the adds made
+	 * earlier in the same script. The mutations are committed once, at the end: a single
+	 * log append, or one rewrite of the data file when the batch is large.
+	 *
+	 * @param script         Command source (a file or piped stdin).
+	 * @param out            Receives find/list results, one record line each.
+	 * @param err            Receives "line N: <reason>" for every rejected command.
+	 * @param operation_log  Log of the data file the script applies to.
+	 * @return stBatchResult with the counts above.
+	 *
+	 * @throws std::runtime_error
+	 *   If the batch cannot be persisted (see clsOpLog::commit_batch).
+	 *
+	 * @note
+	 *   - A rejected line does not stop the batch; the remaining commands still run.
+	 *   - Nothing is persisted if the process dies before the end of the script.
+	 */
+#pragma endregion
+	stBatchResult run_batch(std::istream& script, std::ostream& out, std::ostream& err,
+		op_log::clsOpLog& operation_log);
+
+#pragma region run_batch_program Documentation
+	/**
+	 * @brief Batch-mode entry point: prepares the data files like start_program, then run_batch.
+	 *
+	 * @param script  Command source; results go to std::cout and errors to std::cerr.
+	 * @param sync    Sync policy of the log (the whole script is one group).
+	 * @return int  Process exit code: 0 if every command succeeded, 1 otherwise. A batch that
+	 *              loses a version conflict to another process saves nothing and returns 1.
+	 */
+#pragma endregion
+	int run_batch_program(std::istream& script, const op_log::stSyncOptions& sync = {});
+}
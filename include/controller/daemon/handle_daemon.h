@@ -0,0 +1,110 @@
+// controller/daemon/handle_daemon.h
+
+#pragma once
+
+#include "file_ops/op_log/op_log.h"
+#include "services/client_snapshot/client_snapshot.h"
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+
+namespace daemon_controller
+{
+#pragma region clsDaemon Documentation
+	/**
+	 * @brief Long-running server that keeps the client state warm and serves it over a
+	 *        Unix domain socket.
+	 *
+	 * One command_session::clsCommandSession holds the clients for the lifetime of the
+	 * process. Clients connect to the socket and send command lines in the session language
+	 * (add, update, delete, find, list). Each command gets its result lines, if any, then
+	 * one status line:
+	 *   OK
+	 *   ERR <reason>
+	 * Blank and '#' lines get no reply.
+	 *
+	 * A single thread runs an epoll loop over the listening socket and every connection
+	 * (all non-blocking). Each wake-up handles every ready connection and adds its commands
+	 * to the open group. A group commits all its mutations in one clsOpLog::commit_batch
+	 * (one fdatasync under enSyncPolicy::group), and only then sends the replies. An OK for
+	 * a mutation is therefore never sent before the mutation is in the log. If another
+	 * process committed in between (data_lock::clsVersionConflict), or the commit failed (a
+	 * full disk, a failed sync), every command of that group is answered ERR instead, the
+	 * state is reloaded from disk and the daemon keeps serving.
+	 *
+	 * With a group_window of 0 every wake-up is its own group. Otherwise a group stays open
+	 * for group_window after its first mutation (a timerfd), so clients that write at about
+	 * the same time share one commit and one sync. Each of them waits at most that long.
+	 * A stop, or a client hanging up, commits the group at once.
+	 *
+	 * After each commit the session publishes the committed state as a new version of
+	 * published() (client_snapshot::clsSnapshotTable). find and list are answered from a
+	 * read() of it unless the open group has already staged a mutation, which they must
+	 * see. Other threads may read() it too, without waiting for the loop.
+	 *
+	 * A delete is a tombstone in the log. Once tombstones cross the compaction ratio, a
+	 * compactor::clsCompactor rewrites the data file in a task on the shared scheduler.
+	 * The loop keeps serving meanwhile, and publishes the result when the task signals.
+	 *
+	 * @note
+	 *   - Linux only (epoll). Elsewhere the constructor throws std::runtime_error.
+	 *   - The constructor replaces a stale socket file left by a crashed daemon, and the
+	 *     destructor removes the socket file.
+	 *   - stop() may be called from another thread or a signal handler.
+	 */
+#pragma endregion
+	class clsDaemon
+	{
+	public:
+		// Lines longer than this close the connection instead of growing its buffer forever.
+		static constexpr std::size_t MAX_LINE_BYTES = 1u << 20;
+
+		/**
+		 * @throws std::system_error    If the socket cannot be created, bound or listened on.
+		 * @throws std::runtime_error   If the path is too long for a socket address.
+		 */
+		clsDaemon(const std::filesystem::path& socket_path, op_log::clsOpLog& operation_log,
+			std::chrono::microseconds group_window = std::chrono::microseconds{ 0 });
+		~clsDaemon();
+
+		clsDaemon(const clsDaemon&) = delete;
+		clsDaemon& operator=(const clsDaemon&) = delete;
+
+		// Serves until stop(). The last group is committed before it returns.
+		void run();
+
+		// Wakes run() and makes it return. Async-signal-safe.
+		void stop() noexcept;
+
+		const std::filesystem::path& socket_path() const noexcept { return _socket_path; }
+
+		// The committed client state; read() is safe from any thread while run() serves.
+		const client_snapshot::clsSnapshotTable& published() const noexcept { return _published; }
+
+	private:
+		void close_all() noexcept;
+
+		std::filesystem::path _socket_path;
+		op_log::clsOpLog& _operation_log;
+		std::chrono::microseconds _group_window;
+		client_snapshot::clsSnapshotTable _published;
+		int _listen_fd = -1;
+		int _epoll_fd = -1;
+		int _wake_fd = -1; // eventfd written by stop()
+		int _timer_fd = -1; // timerfd that closes a group window
+		int _compact_fd = -1; // eventfd written when a background compaction is ready
+		bool _bound = false; // The socket file is ours to remove
+	};
+
+#pragma region run_daemon_program Documentation
+	/**
+	 * @brief Daemon-mode entry point: prepares the data files like start_program, then
+	 *        serves on @p socket_path until SIGINT or SIGTERM.
+	 *
+	 * @param socket_path  Socket to listen on; empty means SOCKET_FILE_NAME in the data directory.
+	 * @param sync         Sync policy of the log and the group window (see op_log::stSyncOptions).
+	 * @return int  Process exit code: 0 after a clean stop, 1 if the daemon failed.
+	 */
+#pragma endregion
+	int run_daemon_program(const std::filesystem::path& socket_path, const op_log::stSyncOptions& sync = {});
+}
@@ -0,0 +1,100 @@
+// controller/find_client/handle_find_client.h
+
+#pragma once
+
+#include "services/index/account_index/account_index.h"
+#include "services/index/balance_index/balance_index.h"
+#include "services/index/name_index/name_index.h"
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace find_client_controller
+{
+#pragma region find_client_by_account Documentation
+	/**
+	 * @brief Finds the client with @p account_number: its last entry in the operation log
+	 *        (op_log::find_last_entry, which parses no other line) if there is one,
+	 *        otherwise one account index probe.
+	 *
+	 * @param index     Open account index of the data file.
+	 * @param log_path  The operation log of the same data file (may not exist).
+	 * @return std::vector<stClientData>  The client, or nothing if there is none (a delete
+	 *         still in the log included).
+	 */
+#pragma endregion
+	std::vector<client_data_structure::stClientData> find_client_by_account(
+		const account_index::clsAccountIndex& index, const std::filesystem::path& log_path,
+		std::string_view account_number);
+
+#pragma region run_find_account_program Documentation
+	/**
+	 * @brief `--find` entry point: prepares the data files like start_program, then prints
+	 *        the record line of find_client_by_account.
+	 *
+	 * @return int  Process exit code: 0 if the client exists, 1 otherwise.
+	 */
+#pragma endregion
+	int run_find_account_program(std::string_view account_number);
+
+#pragma region find_clients_by_name Documentation
+	/**
+	 * @brief Finds every client whose name starts with @p prefix, ignoring ASCII case.
+	 *
+	 * The name index gives the matching records of the data file, then the operation log
+	 * is replayed over just those records (op_log::replay), and the result is filtered by
+	 * name again. So an add or rename still in the log shows up, and a deleted or renamed
+	 * client drops out. Neither costs a scan of the data file.
+	 *
+	 * @param index     Open name index of the data file.
+	 * @param log_path  The operation log of the same data file (may not exist).
+	 * @param prefix    Name prefix; empty matches every client.
+	 * @return std::vector<stClientData>  The matches, ordered by folded name.
+	 *
+	 * @note For a consistent view while other processes write, call it under the shared
+	 *       data lock (run_find_name_program does).
+	 */
+#pragma endregion
+	std::vector<client_data_structure::stClientData> find_clients_by_name(
+		const name_index::clsNameIndex& index, const std::filesystem::path& log_path,
+		std::string_view prefix);
+
+#pragma region run_find_name_program Documentation
+	/**
+	 * @brief `--find-name` entry point: prepares the data files like start_program, then
+	 *        prints one record line per match of find_clients_by_name.
+	 *
+	 * @return int  Process exit code: 0 if at least one client matched, 1 otherwise.
+	 */
+#pragma endregion
+	int run_find_name_program(std::string_view prefix);
+
+#pragma region find_clients_by_balance Documentation
+	/**
+	 * @brief Finds every client with low_minor <= balance <= high_minor (minor units).
+	 *
+	 * Same scheme as find_clients_by_name: the balance index gives the matching records of
+	 * the data file in O(log n + k). The operation log is replayed over just those, then the
+	 * range is applied again, so pending adds, balance updates and deletes are reflected.
+	 *
+	 * @param index     Open balance index of the data file.
+	 * @param log_path  The operation log of the same data file (may not exist).
+	 * @return std::vector<stClientData>  The matches, lowest balance first.
+	 */
+#pragma endregion
+	std::vector<client_data_structure::stClientData> find_clients_by_balance(
+		const balance_index::clsBalanceIndex& index, const std::filesystem::path& log_path,
+		std::int64_t low_minor, std::int64_t high_minor);
+
+#pragma region run_balance_range_program Documentation
+	/**
+	 * @brief `--balance-range` / `--overdrawn` entry point: prepares the data files like
+	 *        start_program, then prints one record line per match of find_clients_by_balance.
+	 *
+	 * @param low_minor, high_minor  Inclusive bounds in minor units.
+	 * @return int  Process exit code: 0 if at least one client matched, 1 otherwise.
+	 */
+#pragma endregion
+	int run_balance_range_program(std::int64_t low_minor, std::int64_t high_minor);
+}
@@ -0,0 +1,78 @@
+// controller/fixed_records/handle_fixed_records.h
+
+#pragma once
+
+#include "file_ops/fixed_records/fixed_records.h"
+#include "file_ops/op_log/op_log.h"
+#include <cstdint>
+#include <string>
+
+namespace fixed_records_controller
+{
+#pragma region run_convert_fixed_program Documentation
+	/**
+	 * @brief `--to-fixed` entry point: prepares the data files like start_program, loads the
+	 *        current state (data file + operation log) and writes it to FIXED_FILE_NAME.
+	 *
+	 * The '#//#' data file and the operation log stay the primary store; the fixed-width
+	 * file is a copy taken at this moment, for positional reads and in-place updates
+	 * (update_fixed_balance / delete_fixed_row).
+	 *
+	 * @return int  Process exit code: 0 once written (prints "OK <rows>"), 1 on failure.
+	 */
+#pragma endregion
+	int run_convert_fixed_program();
+
+#pragma region run_page_program Documentation
+	/**
+	 * @brief `--page` entry point: prints the live clients among rows [first, first + count)
+	 *        of FIXED_FILE_NAME, one record line each.
+	 *
+	 * One pread for the whole page, wherever it starts: no scan of the rows before it.
+	 * The file must still match the clients: its stamp (fixed_records::stFixedSource) is
+	 * compared with the data lock version and the operation log size first.
+	 *
+	 * @return int  Process exit code: 0 if the file was read (even past its end), 1 if it is
+	 *              missing, not a fixed-width file, or stale (any commit since --to-fixed).
+	 */
+#pragma endregion
+	int run_page_program(std::uint64_t first, std::uint64_t count);
+
+#pragma region update_fixed_balance / delete_fixed_row Documentation
+	/**
+	 * @brief In-place changes of row @p row of a current fixed-width file, kept in step with
+	 *        the primary store.
+	 *
+	 * The change is committed to @p operation_log first (an update with the new balance, or
+	 * a remove), so every other mode sees it. Only then is the row written in place (one
+	 * pwrite: the 8-byte balance or the 1-byte tombstone, after the file was unstamped) and
+	 * the file restamped with the version and log size of that commit. A crash in between
+	 * leaves the file stale, never wrong.
+	 *
+	 * @param operation_log  Current log (version() and log_size() equal the file's stamp).
+	 * @param file           The fixed-width file, opened writable.
+	 * @param error          Set to the reason when false is returned.
+	 * @return bool  false, changing nothing, if the file is stale or the row is out of range
+	 *               or deleted; false after the commit if the file could not be written
+	 *               (it is then left unstamped).
+	 * @throw data_lock::clsVersionConflict / std::runtime_error  From the commit.
+	 */
+#pragma endregion
+	bool update_fixed_balance(op_log::clsOpLog& operation_log, fixed_records::clsFixedRecordFile& file,
+		std::uint64_t row, std::int64_t balance_minor, std::string& error);
+	bool delete_fixed_row(op_log::clsOpLog& operation_log, fixed_records::clsFixedRecordFile& file,
+		std::uint64_t row, std::string& error);
+
+#pragma region run_fixed_balance_program / run_fixed_delete_program Documentation
+	/**
+	 * @brief `--fixed-balance <row> <amount>` and `--fixed-delete <row>` entry points: open
+	 *        the data store (no fold, which would leave the copy stale) and FIXED_FILE_NAME,
+	 *        then update_fixed_balance / delete_fixed_row.
+	 *
+	 * @return int  Process exit code: 0 (prints "OK"), or 1 with "ERR <reason>".
+	 */
+#pragma endregion
+	int run_fixed_balance_program(std::uint64_t row, std::int64_t balance_minor,
+		const op_log::stSyncOptions& sync);
+	int run_fixed_delete_program(std::uint64_t row, const op_log::stSyncOptions& sync);
+}
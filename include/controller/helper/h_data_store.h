@@ -0,0 +1,77 @@
+// controller/helper/h_data_store.h
+
+#pragma once
+#include "file_ops/op_log/op_log.h"
+#include "services/index/account_filter/account_filter.h"
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+
+namespace h_controller
+{
+#pragma region clsDataStore Documentation
+	/**
+	 * @brief The start-up every command-line mode shares with start_program.
+	 *
+	 * The constructor resolves the executable directory, makes sure the data directory and
+	 * the original data file exist (handle_file_exist) and opens the operation log of that
+	 * data file. prepare_writes() adds what the writing modes (--add, --batch, --serve)
+	 * need on top: the account filter sidecar attached as the commit observer (kept current
+	 * when it exists; --add rebuilds it), the sync policy, and a fold of a log that is due.
+	 *
+	 * @throws std::runtime_error / std::filesystem::filesystem_error  If the data files
+	 *         cannot be created or the operation log and its lock cannot be opened.
+	 *
+	 * @note Not movable: the commit observer refers to the filter member.
+	 */
+#pragma endregion
+	class clsDataStore
+	{
+	public:
+		clsDataStore();
+		clsDataStore(const clsDataStore&) = delete;
+		clsDataStore& operator=(const clsDataStore&) = delete;
+
+		// @p fold false keeps the data file as it is (a fold would leave a fixed-width
+		// copy stale).
+		void prepare_writes(const op_log::stSyncOptions& sync, bool fold = true);
+
+		const std::filesystem::path& exe_dir() const noexcept { return _exe_dir; }
+		// <exe_dir>/data/<file_name>
+		std::filesystem::path data_file_path(std::string_view file_name) const;
+
+		op_log::clsOpLog& operation_log() noexcept { return _operation_log; }
+		account_filter::clsAccountFilter& account_filter() noexcept { return _filter; }
+
+	private:
+		std::filesystem::path _exe_dir;
+		op_log::clsOpLog _operation_log;
+		account_filter::clsAccountFilter _filter;
+	};
+
+#pragma region run_data_program Documentation
+	/**
+	 * @brief Runs @p program (int(clsDataStore&)) on a freshly opened clsDataStore.
+	 *
+	 * A failure of the start-up itself, or anything @p program lets escape, is printed as
+	 * "ERR <reason>" and the mode exits with 1, never through std::terminate.
+	 *
+	 * @return int  @p program's exit code, or 1 after an error.
+	 */
+#pragma endregion
+	template <class Program>
+	int run_data_program(Program program)
+	{
+		try
+		{
+			clsDataStore store;
+			return program(store);
+		}
+		catch (const std::exception& error)
+		{
+			std::cerr << "ERR " << error.what() << '\n';
+			return 1;
+		}
+	}
+}
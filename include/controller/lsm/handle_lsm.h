@@ -0,0 +1,61 @@
+// controller/lsm/handle_lsm.h
+
+#pragma once
+
+#include "file_ops/lsm/lsm.h"
+#include "file_ops/op_log/op_log.h"
+#include <istream>
+
+namespace lsm_controller
+{
+	// Entries per clsLsmStore::apply call: one write-ahead append each.
+	constexpr std::size_t INGEST_BATCH = 1024;
+
+#pragma region ingest_clients Documentation
+	/**
+	 * @brief Upserts every record line of @p input into @p store, INGEST_BATCH at a time.
+	 *
+	 * Blank lines are skipped; a malformed line is reported on stderr (with its line
+	 * number) and skipped too.
+	 *
+	 * @return std::size_t  Number of lines written.
+	 * @throws whatever clsLsmStore::apply throws.
+	 */
+#pragma endregion
+	std::size_t ingest_clients(lsm::clsLsmStore& store, std::istream& input, std::size_t& malformed);
+
+#pragma region publish_staged Documentation
+	/**
+	 * @brief Commits every client staged in @p staging to @p operation_log as one batch,
+	 *        then empties @p staging.
+	 *
+	 * The staged clients (one per account, last line wins) become adds for new accounts
+	 * and updates for existing ones, applied to operation_log.load() and committed with one
+	 * clsOpLog::commit_batch: one append, or one rewrite of the data file for a batch past
+	 * the fold threshold. So every mode (--find, the indexes, --totals, batch, the daemon)
+	 * sees the whole ingest at once, or none of it. A version conflict reloads and retries.
+	 *
+	 * @return std::size_t  Number of clients committed.
+	 * @throws data_lock::clsVersionConflict  After the last retry (@p staging is kept).
+	 * @throws std::runtime_error             If the commit fails (@p staging is kept).
+	 */
+#pragma endregion
+	std::size_t publish_staged(lsm::clsLsmStore& staging, op_log::clsOpLog& operation_log);
+
+#pragma region run_ingest_program Documentation
+	/**
+	 * @brief `--ingest` entry point: stages the record lines of @p input in the LSM store of
+	 *        the data directory (ingest_clients), then publish_staged into the clients.
+	 *
+	 * Staging costs each line one write-ahead append, whatever the table size; the table
+	 * is read and written once per ingest, not once per line. A second ingest into the
+	 * same data directory waits until this one is done (clsLsmStore, Locking). Whatever an
+	 * interrupted ingest left staged was never acknowledged and is cleared first.
+	 *
+	 * @param sync  Sync policy of the commit to the operation log.
+	 * @return int  Process exit code: 0 if every line was ingested (prints "OK <clients>"),
+	 *              1 if a line was malformed (the others are committed) or a write failed.
+	 */
+#pragma endregion
+	int run_ingest_program(std::istream& input, const op_log::stSyncOptions& sync = {});
+}
@@ -0,0 +1,42 @@
+// controller/report/handle_report.h
+
+#pragma once
+
+#include "services/balance/balance.h"
+#include "infrastructure.h"
+#include <filesystem>
+#include <span>
+
+namespace report_controller
+{
+#pragma region portfolio_totals Documentation
+	/**
+	 * @brief The portfolio totals of @p records, from one column of exact minor units.
+	 *
+	 * @return balance::stPortfolioTotals  See balance::compute_portfolio_totals.
+	 */
+#pragma endregion
+	balance::stPortfolioTotals portfolio_totals(std::span<const client_data_structure::stClientData> records);
+
+#pragma region load_portfolio_totals Documentation
+	/**
+	 * @brief The portfolio totals of the current state: the data file, read under the
+	 *        shared data lock with every balance parsed exactly from its text
+	 *        (client_table::load_client_table), and the operation log applied on top.
+	 *
+	 * @throw std::runtime_error  If the data file cannot be read or the lock taken.
+	 */
+#pragma endregion
+	balance::stPortfolioTotals load_portfolio_totals(const std::filesystem::path& data_file_path,
+		const std::filesystem::path& log_file_path);
+
+#pragma region run_totals_program Documentation
+	/**
+	 * @brief `--totals` entry point: prepares the data files like start_program and prints
+	 *        load_portfolio_totals (report_screens::show_portfolio_totals_screen).
+	 *
+	 * @return int  Process exit code: 0 once printed, 1 if the clients cannot be loaded.
+	 */
+#pragma endregion
+	int run_totals_program();
+}
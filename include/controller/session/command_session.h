@@ -0,0 +1,88 @@
+// controller/session/command_session.h
+
+#pragma once
+
+#include "file_ops/op_log/op_log.h"
+#include "services/client_snapshot/client_snapshot.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace command_session
+{
+	enum class enCommandStatus
+	{
+		ok,       // Command ran; any result lines were appended to the output
+		rejected, // Bad command or argument; the reason was appended to the error
+		skipped,  // Blank line or '#' comment
+	};
+
+#pragma region clsCommandSession Documentation
+	/**
+	 * @brief In-memory client state plus the text commands that act on it.
+	 *
+	 * Loads the current state once (data file + operation log) and keeps it, with an
+	 * account_number -> position map, for as long as the session lives. Shared by batch
+	 * mode and the daemon, so both speak the same command language (one per line):
+	 *   add <account_number>#//#<pass_code>#//#<phone_no>#//#<name>#//#<balance>
+	 *   update <same record line; replaces the client with that account_number>
+	 *   delete <account_number>
+	 *   find <account_number>
+	 *   list
+	 *
+	 * Mutations change the in-memory state at once and are staged; commit() persists
+	 * everything staged so far through clsOpLog::commit_batch. A find or list issued
+	 * before the commit already sees them.
+	 *
+	 * With a clsSnapshotTable to publish to (the daemon), the session publishes the loaded
+	 * state and then each commit's entries as one new version. While nothing is staged the
+	 * two agree, so find and list are then answered from a read() of that table; other
+	 * threads can read() it at any time without waiting for the session.
+	 *
+	 * @note
+	 *   - Deleted clients are only marked until commit(), which compacts the state once
+	 *     marked rows make up half of it.
+	 *   - commit() also writes a checkpoint of the state (clsOpLog::checkpoint_if_due)
+	 *     every checkpoint_interval() bytes of log, which bounds the replay on the next
+	 *     start. The position map is rebuilt from it on load (one hash insert per client).
+	 *   - Not thread-safe; the owner serializes calls.
+	 */
+#pragma endregion
+	class clsCommandSession
+	{
+	public:
+		// @p published, if given, must outlive the session; its state is replaced at once.
+		explicit clsCommandSession(op_log::clsOpLog& operation_log,
+			client_snapshot::clsSnapshotTable* published = nullptr);
+
+		/**
+		 * @brief Runs one command line (a trailing '\r' is ignored).
+		 *
+		 * @param line    The command, without '\n'.
+		 * @param output  find/list append one record line (with '\n') per client.
+		 * @param error   On rejected, receives the reason (no '\n').
+		 */
+		enCommandStatus execute(std::string_view line, std::string& output, std::string& error);
+
+		// Persists the staged mutations; returns true if the data file was rewritten.
+		// Throws whatever clsOpLog::commit_batch throws; the staged entries are kept then.
+		bool commit();
+
+		std::size_t pending_mutations() const noexcept { return _staged.size(); }
+		std::size_t client_count() const noexcept { return _positions.size(); }
+
+	private:
+		void compact();
+		bool read_published(std::string_view verb, std::string_view argument,
+			std::string& output, std::string& error, enCommandStatus& status) const;
+
+		op_log::clsOpLog& _operation_log;
+		client_snapshot::clsSnapshotTable* _published;
+		std::vector<client_data_structure::stClientData> _records;
+		std::unordered_map<std::string, std::size_t> _positions;
+		std::vector<op_log::stLogEntry> _staged;
+		std::size_t _deleted = 0; // Marked rows still in _records
+	};
+}
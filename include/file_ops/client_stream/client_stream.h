@@ -0,0 +1,97 @@
+// include/file_ops/client_stream/client_stream.h
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "infrastructure.h"
+
+namespace file_ops
+{
+#pragma region clsClientStream Documentation
+    /*
+        Class: clsClientStream
+
+        Description:
+            A single-pass input range over the parsed records of a .csv data file.
+            It plays the role of a std::generator<stClientData>: each step reads one line with
+            std::getline into a reused buffer, parses it with h_convert::convert_line_to_record
+            and exposes the result. It is written by hand because std::generator is not
+            available in every toolchain this project builds with (GCC 12, older MSVC).
+
+        Usage:
+            for (const auto& client : file_ops::clsClientStream(path)) { ... }
+            Also models std::ranges::input_range, so std::ranges algorithms and views work on it.
+
+        Behaviour:
+            - Blank and malformed lines are skipped, same as file_ops::load_clients_parallel.
+            - If the file can't be opened, the range is empty (silent, like get_all_clients).
+            - begin() may be called once; the range cannot be rewound.
+            - A dereferenced record stays valid only until the next increment.
+
+        Big O:
+            - Time: O(b) for a full pass, b = file size in bytes.
+            - Space: O(1) in the file size: one line buffer, one record and a fixed 64 KiB
+              stream buffer. That lets show-list, find and export work on files larger than RAM.
+    */
+#pragma endregion
+    class clsClientStream
+    {
+    public:
+        class iterator
+        {
+        public:
+            using value_type = client_data_structure::stClientData;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::input_iterator_tag;
+
+            iterator() = default;
+
+            const value_type& operator*() const noexcept { return _owner->_current; }
+            const value_type* operator->() const noexcept { return &_owner->_current; }
+
+            iterator& operator++()
+            {
+                if (!_owner->advance())
+                    _owner = nullptr; // Exhausted: compare equal to the sentinel
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept
+            {
+                return it._owner == nullptr;
+            }
+
+        private:
+            friend class clsClientStream;
+            explicit iterator(clsClientStream* owner) noexcept : _owner(owner) {}
+
+            clsClientStream* _owner = nullptr;
+        };
+
+        explicit clsClientStream(const std::filesystem::path& file_path);
+
+        clsClientStream(const clsClientStream&) = delete;
+        clsClientStream& operator=(const clsClientStream&) = delete;
+        clsClientStream(clsClientStream&&) = default;
+        clsClientStream& operator=(clsClientStream&&) = default;
+
+        bool is_open() const { return _file.is_open(); }
+
+        // Reads up to the first record; call once.
+        iterator begin();
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+    private:
+        // Reads lines until one parses; false at end of file or on a read error.
+        bool advance();
+
+        std::vector<char> _buffer; // Stream buffer; must outlive _file
+        std::ifstream _file;
+        std::string _line;
+        client_data_structure::stClientData _current{};
+    };
+}
@@ -0,0 +1,67 @@
+// include/file_ops/compactor/compactor.h
+#pragma once
+#include <atomic>
+#include <functional>
+#include <optional>
+#include "file_ops/op_log/op_log.h"
+#include "platform_ops/scheduler/scheduler.h"
+
+namespace compactor
+{
+#pragma region clsCompactor Documentation
+    /*
+        Class: clsCompactor
+
+        Description:
+            Runs the compactions of one clsOpLog in the background, for a long-running
+            writer (the daemon). At most one job is in flight:
+            - start_if_due() (owner's thread) starts a job once the log's tombstones cross
+              COMPACTION_TOMBSTONE_RATIO: clsOpLog::begin_compaction, then
+              clsOpLog::prepare_compaction (the O(n) rewrite) as a task on the shared
+              scheduler (platform_ops_scheduler::default_scheduler).
+            - When the task is done it calls `on_ready`, from the scheduler's thread, so the
+              owner can wake up (e.g. write an eventfd).
+            - finish_if_ready() (owner's thread) publishes the job with
+              clsOpLog::finish_compaction, a short step under the exclusive lock.
+            The owner keeps committing in the meantime; the entries it appends while the job
+            runs move to the fresh log when the job is published.
+
+        Throws:
+            - finish_if_ready(): whatever clsOpLog::finish_compaction throws. A failed
+              preparation is not an error; its temp files are removed and the next
+              start_if_due() tries again.
+
+        Notes:
+            - The clsOpLog is only touched from the owner's thread; the task works on the
+              job alone.
+            - The destructor waits for a running job and discards it.
+    */
+#pragma endregion
+    class clsCompactor
+    {
+    public:
+        explicit clsCompactor(op_log::clsOpLog& operation_log, std::function<void()> on_ready = {});
+        ~clsCompactor();
+
+        clsCompactor(const clsCompactor&) = delete;
+        clsCompactor& operator=(const clsCompactor&) = delete;
+
+        // Starts a job if compaction is due and none is running; returns whether it did.
+        bool start_if_due();
+
+        // Publishes a finished job; returns true if the data file was compacted. False
+        // while the job is still running, or if it failed or was overtaken (see
+        // clsOpLog::finish_compaction).
+        bool finish_if_ready();
+
+        bool is_running() const noexcept { return _job.has_value(); }
+
+    private:
+        op_log::clsOpLog& _operation_log;
+        std::function<void()> _on_ready;
+        std::optional<op_log::stCompactionJob> _job;
+        bool _failed = false; // Written by the task before _ready
+        std::atomic<bool> _ready{ false };
+        platform_ops_scheduler::clsTaskGroup _task;
+    };
+}
@@ -0,0 +1,83 @@
+// include/file_ops/data_lock/data_lock.h
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+#include "platform_ops/lock/lock.h"
+
+namespace data_lock
+{
+    // Thrown by clsDataLock::commit when another process committed first.
+    class clsVersionConflict : public std::runtime_error
+    {
+    public:
+        clsVersionConflict(std::uint64_t expected_version, std::uint64_t actual_version);
+
+        std::uint64_t expected_version() const noexcept { return _expected_version; }
+        std::uint64_t actual_version() const noexcept { return _actual_version; }
+
+    private:
+        std::uint64_t _expected_version;
+        std::uint64_t _actual_version;
+    };
+
+#pragma region clsDataLock Documentation
+    /*
+        Class: clsDataLock
+
+        Description:
+            Coordinates every process working on one data directory through LOCK_FILE_NAME.
+            The lock file holds the data version: a counter that every committed change to
+            the data file or the operation log increments.
+            - Readers run their whole load under a shared lock (read_locked), so no rename
+              or log truncation can happen in the middle of it, and learn the version they
+              read.
+            - Writers prepare their change without any lock (the slow part, e.g. writing a
+              multi-GB temp file), then commit(): take the exclusive lock, compare the
+              version with the one their data was based on, publish (rename / append) and
+              bump the version. If another process committed in between, commit() throws
+              clsVersionConflict at once instead of overwriting that change.
+
+        Throws:
+            - std::runtime_error if the lock file cannot be opened, locked or updated.
+            - clsVersionConflict from commit(), as described above.
+
+        Notes:
+            - The exclusive lock is held only for the publish step, so readers and other
+              writers are blocked for a rename or a small append, never for a rewrite.
+            - Two clsDataLock objects exclude each other even inside one process.
+    */
+#pragma endregion
+    class clsDataLock
+    {
+    public:
+        explicit clsDataLock(const std::filesystem::path& lock_file_path);
+
+        // Runs `read` under the shared lock; returns the version it saw.
+        std::uint64_t read_locked(const std::function<void()>& read);
+
+        // Runs `read` under the shared lock only if the version is still
+        // expected_version; returns whether it ran. For writes that do not change the
+        // data and are identical for every holder of that version (checkpoints).
+        bool read_locked_if_current(std::uint64_t expected_version, const std::function<void()>& read);
+
+        // Current version (briefly takes the shared lock).
+        std::uint64_t current_version();
+
+        // Exclusive lock; throws clsVersionConflict unless the version is still
+        // expected_version, else runs `publish` and returns the new version.
+        // If `publish` throws, the version is left unchanged.
+        std::uint64_t commit(std::uint64_t expected_version, const std::function<void()>& publish);
+
+        // Runs `work` under the exclusive lock without touching the version
+        // (housekeeping that does not change the data, e.g. trimming a torn log tail).
+        void exclusive(const std::function<void()>& work);
+
+    private:
+        std::uint64_t read_version() const;
+
+        std::filesystem::path _lock_file_path;
+        platform_ops_lock::clsFileLock _lock;
+    };
+}
@@ -3,6 +3,10 @@
 #include <vector>
 #include <string>
 #include <filesystem>
+#include <string_view>
+#include "infrastructure.h"
+#include "platform_ops/map/map.h"
+#include "services/index/structural_index/structural_index.h"
 
 
 namespace file_ops
@@ -51,4 +55,168 @@ namespace file_ops
     */
 #pragma endregion
     std::vector<std::string> get_all_clients(const std::filesystem::path& file_path);
+
+#pragma region get_all_clients_mapped Documentation
+    /*
+        Function: get_all_clients_mapped
+
+        Description:
+            Zero-copy variant of get_all_clients. Maps the whole .csv file into memory once and
+            splits it into lines without copying: every line is a std::string_view into the mapping.
+            The returned stMappedClients owns the mapping, so the views stay valid for as long as
+            that object (or whatever it is moved into) is alive.
+
+        Parameters:
+            - file_path (const std::filesystem::path&): The path to the .csv file containing client data.
+
+        Returns:
+            stMappedClients
+                - mapping: the clsMappedFile that owns the bytes.
+                - lines:   one view per line, exactly the lines get_all_clients would return
+                           (no trailing '\n', a last line without '\n' is kept, blank lines are kept).
+                - If the file can't be opened/mapped or is empty: lines is empty.
+
+        Notes:
+            - No error message is printed if opening fails (silent error), same as get_all_clients.
+            - Do not let a view outlive its stMappedClients.
+            - Function does not throw exceptions except std::bad_alloc while growing the vector.
+
+        Side Effects:
+            - None. The file is mapped read-only (MAP_PRIVATE).
+
+        Big O:
+            - Time: O(b) where b = file size in bytes; newlines are found with memchr.
+            - Space: O(n) views (16 bytes each) on the heap; the text itself is never copied.
+            - Latency is bounded by page-fault/read-ahead throughput, not by the allocator
+              (one vector growth sequence instead of one allocation per client).
+    */
+#pragma endregion
+    struct stMappedClients
+    {
+        platform_ops_map::clsMappedFile mapping;
+        std::vector<std::string_view> lines;
+    };
+
+    stMappedClients get_all_clients_mapped(const std::filesystem::path& file_path);
+
+#pragma region get_all_clients_indexed Documentation
+    /*
+        Function: get_all_clients_indexed
+
+        Description:
+            Maps the .csv file once and builds its structural index (every '\n' and every
+            infrastructure_names::SEPARATOR) in a single pass. Line and field access afterwards is
+            offset arithmetic through structural_index::get_row / get_field, so neither the
+            list view nor the search paths rescan the bytes.
+
+        Parameters:
+            - file_path (const std::filesystem::path&): The path to the .csv file containing client data.
+
+        Returns:
+            stIndexedClients
+                - mapping: the clsMappedFile that owns the bytes.
+                - index:   the structural index of mapping.view().
+                - If the file can't be opened/mapped or is empty: the index has no rows.
+
+        Notes:
+            - Rows follow the same rules as get_all_clients / get_all_clients_mapped.
+            - Function does not throw exceptions except std::bad_alloc.
+
+        Big O:
+            - Time: O(b), b = file size in bytes, one pass (32 bytes per step with AVX2).
+            - Space: O(s) 8-byte offsets, s = number of newlines plus separators.
+    */
+#pragma endregion
+    struct stIndexedClients
+    {
+        platform_ops_map::clsMappedFile mapping;
+        structural_index::stStructuralIndex index;
+    };
+
+    stIndexedClients get_all_clients_indexed(const std::filesystem::path& file_path);
+
+#pragma region load_clients_parallel Documentation
+    /*
+        Function: load_clients_parallel
+
+        Description:
+            Loads and parses the whole .csv file into records using every core.
+            The file is mapped once and cut into thread_count byte ranges of roughly equal size.
+            Each inner boundary is moved forward to just past the next '\n', so no line is
+            split. Every range is parsed with h_convert::convert_line_to_record on its own
+            worker, and the per-range results are joined in file order.
+
+        Parameters:
+            - file_path (const std::filesystem::path&): The path to the .csv file containing client data.
+            - thread_count (unsigned): Number of ranges (parallel tasks). 0 (default) means
+              std::thread::hardware_concurrency(). Small files get fewer ranges.
+
+        Returns:
+            std::vector<client_data_structure::stClientData>
+                - One record per valid line, in file order.
+                - Blank and malformed lines (wrong column count, non-numeric balance) are skipped.
+                - If the file can't be opened/mapped or is empty: an empty vector {}.
+
+        Notes:
+            - The ranges are tasks on platform_ops_scheduler::default_scheduler(); the calling
+              thread runs queued ranges itself while it waits for the rest.
+            - An exception thrown by a range (std::bad_alloc) is rethrown on the calling thread.
+
+        Big O:
+            - Time: O(b / t + r), b = file size, t = thread count, r = records (the final
+              in-order join only moves strings, it never copies their text).
+            - Space: O(r * m), m = average record size, plus a transient per-range vector.
+    */
+#pragma endregion
+    std::vector<client_data_structure::stClientData> load_clients_parallel(const std::filesystem::path& file_path,
+        unsigned thread_count = 0);
+
+#pragma region save_all_clients Documentation
+    /*
+        Function: save_all_clients
+
+        Description:
+            Rewrites the whole .csv file from `records`, atomically. The lines are written by
+            write_clients_temp to a temp file in the same directory, which is then renamed
+            over `file_path`. A reader (or a crash) therefore sees either the old file or the
+            new one, never a half-written one.
+
+        Parameters:
+            - file_path (const std::filesystem::path&): The .csv file to replace.
+            - records (const std::vector<stClientData>&): Records to write, in order. Records with
+              delete_mark set are skipped.
+
+        Throws:
+            - std::runtime_error if the temp file cannot be created or written.
+            - std::filesystem::filesystem_error if the final rename fails.
+
+        Big O:
+            - Time: O(r * m), r = records, m = average line length. This is the full rewrite that
+              the operation log (op_log) is there to avoid on every single edit.
+            - Space: O(1) beyond the records; one reused line buffer and a 1 MiB stream buffer.
+    */
+#pragma endregion
+    void save_all_clients(const std::filesystem::path& file_path,
+        const std::vector<client_data_structure::stClientData>& records);
+
+#pragma region write_clients_temp Documentation
+    /*
+        Function: write_clients_temp
+
+        Description:
+            First half of save_all_clients: writes `records` (minus delete_mark rows) to
+            "<TEMP_FILE_NAME>.<process id>" next to `file_path` and returns that path, without
+            renaming it. Callers that must publish under a lock (op_log with data_lock) write
+            the temp file unlocked and only hold the lock for the rename. The process id in
+            the name keeps concurrent processes from writing the same temp file.
+            A non-empty `tag` is appended as one more ".<tag>", for a second rewrite that may
+            run in the same process at the same time (the background compaction).
+
+        Throws:
+            - std::runtime_error if the temp file cannot be created or written (the partial
+              temp file is removed).
+    */
+#pragma endregion
+    std::filesystem::path write_clients_temp(const std::filesystem::path& file_path,
+        const std::vector<client_data_structure::stClientData>& records, std::string_view tag = {});
 }
\ No newline at end of file
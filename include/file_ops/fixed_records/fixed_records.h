@@ -0,0 +1,203 @@
+// include/file_ops/fixed_records/fixed_records.h
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+#include "infrastructure.h"
+#include "platform_ops/file_io/file_io.h"
+
+namespace fixed_records
+{
+#pragma region Fixed-width layout Documentation
+    /*
+        File: FIXED_FILE_NAME
+
+        Description:
+            An alternative to the '#//#' text format where every client takes the same
+            number of bytes, so row N lives at a computed offset:
+                [stFixedHeader][record 0][record 1]...   native endianness
+                record = [account_number][pass_code][phone_no][name]   NUL-padded to the
+                         widths in the header
+                         [padding to 8][std::int64_t balance][std::uint8_t flags][padding to 8]
+                offset(row) = sizeof(stFixedHeader) + row * record_size
+            - The balance is binary, in minor units (balance::to_minor_units), so a balance
+              update is one aligned 8-byte write and never changes the record length.
+            - flags bit 0 (FLAG_DELETED) is a tombstone: delete is one byte written in place,
+              and readers skip the row. A rewrite (convert_to_fixed) drops tombstoned rows.
+            - The widths are chosen once, when the file is written (at least the
+              DEFAULT_WIDTHS, more if a value is longer, up to UINT16_MAX). A later write of
+              a longer value is refused rather than truncated.
+            - source_version / source_log_size record the state the file mirrors: the data
+              lock version and the operation log size it was converted at, or restamped at
+              (set_source) after a change committed to the log was written in place. Once
+              either has moved on, the file is a stale copy (see stFixedSource). Every
+              in-place write first sets source_version to UNSTAMPED_VERSION, so a file
+              changed without a matching commit and restamp is never taken as current.
+            - row_count in the header is written after an appended record, so a crash in
+              between leaves the row invisible, never half-read.
+    */
+#pragma endregion
+    struct stFixedHeader
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t record_size;
+        std::uint64_t row_count;
+        std::array<std::uint16_t, 4> widths; // account_number, pass_code, phone_no, name
+        std::uint64_t source_version;
+        std::uint64_t source_log_size;
+        std::uint64_t reserved[2];
+    };
+    static_assert(sizeof(stFixedHeader) == 64, "header must stay one cache line");
+
+    constexpr std::uint64_t FIXED_MAGIC = 0x3144455849464353ull; // "SCFIXED1"
+    constexpr std::uint32_t FIXED_VERSION = 2;
+    constexpr std::uint8_t FLAG_DELETED = 1;
+    // source_version of a file written in place and not restamped yet.
+    constexpr std::uint64_t UNSTAMPED_VERSION = UINT64_MAX;
+
+    // 16 + 16 + 16 + 48 text bytes + balance + flags: 112-byte records.
+    constexpr std::array<std::uint16_t, 4> DEFAULT_WIDTHS = { 16, 16, 16, 48 };
+
+#pragma region stFixedLayout Documentation
+    /*
+        Struct: stFixedLayout
+
+        Description:
+            Byte offsets inside one record, derived from the widths. make_layout() is the
+            only place that computes them, for the writer and the reader alike.
+    */
+#pragma endregion
+    struct stFixedLayout
+    {
+        std::array<std::uint16_t, 4> widths{};
+        std::array<std::uint32_t, 4> field_offsets{};
+        std::uint32_t balance_offset = 0;
+        std::uint32_t flags_offset = 0;
+        std::uint32_t record_size = 0;
+    };
+
+    stFixedLayout make_layout(const std::array<std::uint16_t, 4>& widths) noexcept;
+
+    // Smallest widths (at least DEFAULT_WIDTHS) that fit every live record.
+    // Throws std::runtime_error if a value is longer than UINT16_MAX bytes.
+    std::array<std::uint16_t, 4> fit_widths(const std::vector<client_data_structure::stClientData>& records);
+
+    // The state a fixed-width file was converted from (clsOpLog::version / log_size).
+    struct stFixedSource
+    {
+        std::uint64_t data_version = 0;
+        std::uint64_t log_size = 0;
+        bool operator==(const stFixedSource&) const = default;
+    };
+
+#pragma region clsFixedRecordFile Documentation
+    /*
+        Class: clsFixedRecordFile
+
+        Description:
+            Positional access to a FIXED_FILE_NAME file through
+            platform_ops_file_io::clsRandomAccessFile. Every call is one pread or pwrite at
+            a computed offset: no scan, no parsing, no rewrite.
+
+        Returns:
+            - open: false if the file is missing, not a fixed-width file, or its size does
+              not match row_count * record_size (a torn append is tolerated: extra bytes
+              past the last counted row are ignored and overwritten by the next append).
+            - read_row / write_row / update_balance / mark_deleted: false if the row is out
+              of range, a value does not fit its width, or the I/O fails.
+
+        Big O:
+            - read_row, write_row, update_balance, mark_deleted, append_row: O(1), one
+              system call each (append_row: two), plus one to unstamp a stamped file.
+            - read_rows: O(count), one pread for the whole page.
+
+        Notes:
+            - No locking: one writer at a time (readers may run alongside; a row being
+              rewritten can be read half old, half new).
+            - The writers change this copy only. fixed_records_controller commits each
+              change to the operation log first and restamps the file afterwards.
+            - sync() makes the writes durable; without it they are as durable as any
+              buffered write.
+    */
+#pragma endregion
+    class clsFixedRecordFile
+    {
+    public:
+        bool open(const std::filesystem::path& file_path, bool writable = false) noexcept;
+        void close() noexcept { _file.close(); }
+        bool is_open() const noexcept { return _file.is_open(); }
+
+        // Rows, tombstoned ones included.
+        std::uint64_t size() const noexcept { return _header.row_count; }
+        const stFixedLayout& layout() const noexcept { return _layout; }
+        stFixedSource source() const noexcept { return { _header.source_version, _header.source_log_size }; }
+
+        // Row @p row; record.delete_mark reports its tombstone.
+        bool read_row(std::uint64_t row, client_data_structure::stClientData& record) const;
+
+        /*
+            Page read: up to @p count rows from @p first, tombstoned ones skipped, appended
+            to @p records. Returns the number of rows scanned (first + scanned is where the
+            next page starts); 0 at the end.
+        */
+        std::uint64_t read_rows(std::uint64_t first, std::uint64_t count,
+            std::vector<client_data_structure::stClientData>& records) const;
+
+        // Replaces row @p row in place (its tombstone is cleared or set from delete_mark).
+        bool write_row(std::uint64_t row, const client_data_structure::stClientData& record);
+
+        // One 8-byte write.
+        bool update_balance(std::uint64_t row, std::int64_t balance_minor);
+
+        // One 1-byte write.
+        bool mark_deleted(std::uint64_t row);
+
+        // Adds a row at the end; returns its row number, or -1 on failure.
+        std::int64_t append_row(const client_data_structure::stClientData& record);
+
+        // Stamps the file as a copy of @p source (two adjacent header fields, one pwrite).
+        bool set_source(const stFixedSource& source);
+
+        bool sync() noexcept { return _file.sync_data(); }
+
+    private:
+        std::uint64_t row_offset(std::uint64_t row) const noexcept
+        {
+            return sizeof(stFixedHeader) + row * _layout.record_size;
+        }
+        void decode(const char* bytes, client_data_structure::stClientData& record) const;
+        // Sets source_version to UNSTAMPED_VERSION before the first in-place write.
+        bool unstamp();
+
+        platform_ops_file_io::clsRandomAccessFile _file;
+        stFixedHeader _header{};
+        stFixedLayout _layout{};
+    };
+
+#pragma region convert_to_fixed Documentation
+    /*
+        Function: convert_to_fixed
+
+        Description:
+            The one-time converter: writes @p records (delete_mark rows left out) as a
+            fixed-width file at @p fixed_file_path with fit_widths() widths, through a temp
+            file renamed into place. Callers convert the current state, i.e. the data file
+            with the operation log replayed (clsOpLog::load), and pass the version and log
+            size of that load as @p source.
+
+        Returns:
+            The number of rows written.
+
+        Throws:
+            - std::runtime_error if a value is longer than UINT16_MAX bytes (nothing is
+              written), or the temp file cannot be written.
+            - std::filesystem::filesystem_error if the rename fails.
+    */
+#pragma endregion
+    std::uint64_t convert_to_fixed(const std::vector<client_data_structure::stClientData>& records,
+        const std::filesystem::path& fixed_file_path, const stFixedSource& source = {});
+}
@@ -0,0 +1,288 @@
+// include/file_ops/lsm/lsm.h
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "file_ops/op_log/op_log.h"
+#include "infrastructure.h"
+#include "platform_ops/lock/lock.h"
+#include "platform_ops/map/map.h"
+#include "platform_ops/scheduler/scheduler.h"
+#include "platform_ops/sync/sync.h"
+
+namespace lsm
+{
+#pragma region Run file layout Documentation
+    /*
+        File: <LSM_RUN_PREFIX><sequence><LSM_RUN_EXTENSION> in the data directory
+
+        Description:
+            One immutable sorted run, memory-mapped as is (native endianness):
+                [stRunHeader][entry lines][std::uint64_t offset x index_count][bloom bytes]
+            - Entry lines are operation log lines (op_log::convert_entry_to_line), one per
+              account_number, sorted by account_number: U#//#<record line> for a client,
+              D#//#<account_number> for a tombstone that hides older runs.
+            - The sparse index holds the offset (from the start of the file) of every
+              SPARSE_INDEX_INTERVAL-th line. A lookup binary-searches it, reading each key
+              from the line it points to, then scans at most that many lines.
+            - The Bloom filter has bloom_bits bits and hash_count probes per key (the double
+              hashing of account_filter), about 1% false positives: a lookup for an
+              account_number the run does not hold rarely touches the entries at all.
+            - last_offset is the offset of the last line, for the run's key range.
+    */
+#pragma endregion
+    struct stRunHeader
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t hash_count;
+        std::uint64_t entry_count;
+        std::uint64_t entries_end; // One past the last entry byte
+        std::uint64_t last_offset;
+        std::uint64_t index_count;
+        std::uint64_t bloom_bits;
+        std::uint64_t reserved;
+    };
+    static_assert(sizeof(stRunHeader) == 64, "header must stay one cache line");
+
+    constexpr std::uint64_t RUN_MAGIC = 0x314e5552534c4353ull; // "SCLSRUN1"
+    constexpr std::uint32_t RUN_VERSION = 1;
+    constexpr std::uint64_t SPARSE_INDEX_INTERVAL = 16;
+
+#pragma region stLsmOptions Documentation
+    /*
+        Struct: stLsmOptions
+
+        Description:
+            Sizing of one clsLsmStore. The defaults suit a table of millions of clients;
+            tests shrink them to exercise flushes and compactions with a few rows.
+            - memtable_bytes: entry bytes held in memory before they are flushed as a
+              level-0 run.
+            - l0_compaction_trigger: level-0 runs (which may overlap) that start a merge
+              into level 1; l0_stop_trigger: level-0 runs at which writers wait for it.
+            - level_base_bytes / level_ratio: level i >= 1 may hold
+              level_base_bytes * level_ratio^(i - 1) bytes before one of its runs is merged
+              into level i + 1.
+            - target_run_bytes: compaction output is split into runs of about this size.
+            - sync: when a write reaches the disk (op_log::enSyncPolicy); none by default,
+              like clsOpLog.
+            - background: compact as tasks on the shared scheduler
+              (platform_ops_scheduler::default_scheduler). Without it, compactions run only
+              in compact_pending(), on the caller's thread.
+            - read_only: open for find() / load() only (see clsLsmStore, Locking); the
+              store then never writes, and background is ignored.
+    */
+#pragma endregion
+    struct stLsmOptions
+    {
+        std::size_t memtable_bytes = 4u * 1024u * 1024u;
+        std::size_t l0_compaction_trigger = 4;
+        std::size_t l0_stop_trigger = 12;
+        std::uint64_t level_base_bytes = 32u * 1024u * 1024u;
+        std::uint64_t level_ratio = 10;
+        std::uint64_t target_run_bytes = 8u * 1024u * 1024u;
+        op_log::enSyncPolicy sync = op_log::enSyncPolicy::none;
+        bool background = true;
+        bool read_only = false;
+    };
+
+#pragma region clsRunFile Documentation
+    /*
+        Class: clsRunFile
+
+        Description:
+            Read side of one run file, mapped read-only. open() checks the header and the
+            section bounds in O(1); find() costs one Bloom probe, a binary search of the
+            sparse index and a scan of at most SPARSE_INDEX_INTERVAL lines.
+
+        Notes:
+            - Read-only after open(); concurrent lookups are fine.
+            - entries() stays valid while the object lives.
+    */
+#pragma endregion
+    class clsRunFile
+    {
+    public:
+        // false if missing or not a valid run file.
+        bool open(const std::filesystem::path& run_path, std::uint64_t sequence) noexcept;
+
+        const std::filesystem::path& path() const noexcept { return _path; }
+        std::uint64_t sequence() const noexcept { return _sequence; }
+        std::uint64_t entry_count() const noexcept { return _header.entry_count; }
+        std::uint64_t file_size() const noexcept { return _mapping.size(); }
+        std::string_view min_key() const noexcept { return _min_key; }
+        std::string_view max_key() const noexcept { return _max_key; }
+
+        // The entry lines, in account_number order.
+        std::string_view entries() const noexcept;
+
+        // false: the run has no entry for @p account_number. true: maybe.
+        bool may_contain(std::string_view account_number) const noexcept;
+
+        // The entry for @p account_number (a client or a tombstone), if the run has one.
+        bool find(std::string_view account_number, op_log::stLogEntry& entry) const;
+
+    private:
+        std::string_view line_at(std::uint64_t offset) const noexcept;
+
+        std::filesystem::path _path;
+        std::uint64_t _sequence = 0;
+        platform_ops_map::clsMappedFile _mapping;
+        stRunHeader _header{};
+        const std::uint64_t* _index = nullptr;
+        const unsigned char* _bloom = nullptr;
+        std::string_view _min_key;
+        std::string_view _max_key;
+    };
+
+#pragma region clsLsmStore Documentation
+    /*
+        Class: clsLsmStore
+
+        Description:
+            Log-structured merge store of the clients, keyed by account_number, for
+            write-heavy loads (bulk ingestion). A write never touches the existing data:
+            - apply() appends the entries to a write-ahead log (LSM_LOG_FILE_NAME) and puts
+              them in the memtable, an ordered map in memory.
+            - Once the memtable holds memtable_bytes of entries it is flushed as a new
+              level-0 run, the manifest (LSM_MANIFEST_FILE_NAME, the list of live runs per
+              level) is replaced, and the write-ahead log is emptied.
+            - Leveled compaction merges runs in the background, one scheduler task per
+              merge, queued whenever a flush or a merge leaves one due: all of level 0 with the
+              level-1 runs they overlap, or one run of a full level i with the runs of
+              level i + 1 it overlaps. Levels >= 1 hold disjoint key ranges, so a lookup
+              reads at most one run per level. Tombstones are dropped once they reach the
+              deepest level.
+            So the cost of a write is one append plus its share of bounded flushes and
+            merges: it does not grow with the table.
+
+        Reads:
+            find() looks in the memtable, then level 0 newest first, then one run per
+            level; the first entry found wins. load() merges everything into the live
+            clients in account_number order.
+
+        Recovery:
+            Construction reads the manifest, opens its runs, deletes run files it does not
+            list (a flush or merge that died before the manifest was replaced), and replays
+            the write-ahead log into the memtable (a torn last line is cut off). Replaying
+            entries that were already flushed is harmless: every entry is an upsert or a
+            delete. A read_only store replays the same way but deletes and cuts nothing.
+
+        Locking:
+            Construction waits for a lock on LSM_LOCK_FILE_NAME and holds it until
+            destruction: exclusive for a writable store, shared for a read_only one. So two
+            ingests into one data directory run one after the other, and a lookup never
+            sees the files of a flush or merge half done. The manifest itself is replaced
+            by rename, so it cannot carry the lock.
+
+        Throws:
+            - std::runtime_error if the lock cannot be taken, the manifest is corrupt, a
+              listed run cannot be opened, or the write-ahead log cannot be written
+              (construction, apply()); apply(), flush() and compact_pending() on a
+              read_only store.
+            - apply() / flush(): whatever writing a run throws. A background compaction
+              failure is not thrown; it is kept in last_error() and retried after the next
+              flush.
+
+        Notes:
+            - Thread-safe. Lookups and load() hold the mutex only to take a snapshot of the
+              run lists; a merge runs without it and installs its output under it.
+            - The lock is per object, so a second writable store on the same directory
+              waits even within one process: never open one while another is alive.
+            - The destructor lets a running merge finish and drops the queued ones; the
+              memtable stays in the write-ahead log for the next start.
+    */
+#pragma endregion
+    class clsLsmStore
+    {
+    public:
+        explicit clsLsmStore(const std::filesystem::path& directory, const stLsmOptions& options = {});
+        ~clsLsmStore();
+
+        clsLsmStore(const clsLsmStore&) = delete;
+        clsLsmStore& operator=(const clsLsmStore&) = delete;
+
+        // add / update upsert record; remove writes a tombstone for record.account_number.
+        // One write-ahead append (and one sync, per options.sync) for the whole span.
+        void apply(std::span<const op_log::stLogEntry> entries);
+
+        bool find(std::string_view account_number, client_data_structure::stClientData& record) const;
+
+        // Every live client, in account_number order.
+        std::vector<client_data_structure::stClientData> load() const;
+
+        // Writes the memtable as a level-0 run now (no-op if empty).
+        void flush();
+
+        // Drops every client: waits for a running merge, then lists no run, empties the
+        // write-ahead log and the memtable, and deletes the run files.
+        void clear();
+
+        // Runs the due compactions on the caller's thread; returns how many.
+        std::size_t compact_pending();
+
+        // Blocks until no merge is due or running (returns at once without background).
+        void wait_idle();
+
+        // Runs per level (index 0 = level 0), and memtable entries.
+        std::vector<std::size_t> run_counts() const;
+        std::size_t memtable_size() const;
+
+        std::string last_error() const;
+
+    private:
+        using run_ptr = std::shared_ptr<const clsRunFile>;
+
+        struct stCompactionPlan
+        {
+            std::size_t output_level = 0;
+            std::vector<run_ptr> inputs; // Newest first
+            bool drop_tombstones = false;
+            bool empty() const noexcept { return inputs.empty(); }
+        };
+
+        void recover();
+        void require_writable() const;
+        void open_log(bool truncate);
+        void flush_locked(); // Under the mutex
+        void write_manifest(const std::vector<std::vector<run_ptr>>& levels) const;
+        std::filesystem::path run_path(std::uint64_t sequence) const;
+        std::uint64_t level_bytes(std::size_t level) const noexcept;
+        std::uint64_t level_limit(std::size_t level) const noexcept;
+        stCompactionPlan plan_compaction() const;
+        std::vector<run_ptr> merge(const stCompactionPlan& plan); // Without the mutex
+        void install(const stCompactionPlan& plan, const std::vector<run_ptr>& outputs);
+        bool compact_once(std::unique_lock<std::mutex>& lock);
+        void schedule_compaction(); // Under the mutex
+        void run_compaction_task();
+
+        std::filesystem::path _directory;
+        stLsmOptions _options;
+        platform_ops_lock::clsFileLock _file_lock; // Released last
+
+        mutable std::mutex _mutex;
+        std::condition_variable_any _changed;
+        std::map<std::string, op_log::stLogEntry, std::less<>> _memtable;
+        std::size_t _memtable_bytes = 0;
+        std::vector<std::vector<run_ptr>> _levels; // Level 0 oldest first; others by key
+        std::uint64_t _next_sequence = 1;
+        bool _compacting = false;
+        bool _retry_blocked = false; // A merge failed; wait for the next flush
+        bool _compaction_queued = false;
+        bool _stopping = false;
+        std::string _last_error;
+
+        std::ofstream _log;
+        platform_ops_sync::clsFileSync _log_sync;
+        platform_ops_scheduler::clsTaskGroup _compactions; // Destroyed first: waits for the task
+    };
+}
@@ -0,0 +1,381 @@
+// include/file_ops/op_log/op_log.h
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "file_ops/data_lock/data_lock.h"
+#include "infrastructure.h"
+#include "platform_ops/sync/sync.h"
+#include "services/columnar_snapshot/columnar_snapshot.h"
+#include "services/index/account_index/account_index.h"
+
+namespace op_log
+{
+    // One mutation. The character value is what is written at the start of the log line.
+    enum class enOperation : char
+    {
+        add = 'A',    // record holds the full new client
+        update = 'U', // record holds the full updated client, keyed by account_number
+        remove = 'D', // only record.account_number is used
+    };
+
+    struct stLogEntry
+    {
+        enOperation operation;
+        client_data_structure::stClientData record;
+    };
+
+    // When a commit reaches stable storage (platform_ops_sync) before it returns.
+    enum class enSyncPolicy
+    {
+        none,      // Flush to the kernel only; a power loss can drop acknowledged commits
+        group,     // One fdatasync per commit (append, or a whole commit_batch)
+        operation, // One write + fdatasync per entry, even inside a batch
+    };
+
+#pragma region stSyncOptions Documentation
+    /*
+        Struct: stSyncOptions
+
+        Description:
+            Durability settings of one deployment, given on the command line as
+            --sync <spec> (see parse_sync_options):
+                none | operation | group | group:<microseconds>
+            group_window only matters to writers that gather commands from many clients
+            (the daemon): it holds a group open that long after its first mutation, so
+            concurrent clients share one fdatasync. 0 commits each wake-up at once.
+            The default, group with no window, never acknowledges an unsynced commit.
+    */
+#pragma endregion
+    struct stSyncOptions
+    {
+        enSyncPolicy policy = enSyncPolicy::group;
+        std::chrono::microseconds group_window{ 0 };
+    };
+
+    // Parses `spec` into `options`; false (options untouched) if it is not a valid spec.
+    bool parse_sync_options(std::string_view spec, stSyncOptions& options);
+
+#pragma region Log line format Documentation
+    /*
+        Functions: convert_entry_to_line / convert_line_to_entry
+
+        Description:
+            One entry is one text line in the same style as the data file:
+                A#//#<record line>\n
+                U#//#<record line>\n
+                D#//#<account_number>\n
+            where <record line> is exactly what h_convert::append_record_line produces.
+
+        Returns:
+            - convert_entry_to_line: the line including its trailing '\n'.
+            - convert_line_to_entry: true if `line` (without '\n') is a well-formed entry.
+    */
+#pragma endregion
+    std::string convert_entry_to_line(const stLogEntry& entry);
+    bool convert_line_to_entry(std::string_view line, stLogEntry& entry);
+
+#pragma region replay Documentation
+    /*
+        Function: replay
+
+        Description:
+            Applies every complete entry of the log at `log_path` from byte `start_offset`
+            on (an entry boundary, e.g. a checkpoint's log_offset) to `records`, in log order.
+            - add / update: upsert by account_number (replace the existing record or append).
+            - remove:       drop the record with that account_number, if any.
+            Because every entry is an upsert or a delete, replaying a log a second time on
+            top of its own result changes nothing. So a crash between folding the log into
+            the data file and truncating the log loses nothing and duplicates nothing.
+
+        Returns:
+            std::size_t - number of entries applied. A final line without '\n' (torn
+            append) and malformed lines are skipped. A missing log file, or one no longer
+            than `start_offset`, applies 0 entries.
+
+        Big O:
+            - Time: O(r + e), r = records (one hash map build), e = log entries after
+              `start_offset`.
+            - Space: O(r) for the account_number -> position map, only when the log is non-empty.
+    */
+#pragma endregion
+    std::size_t replay(const std::filesystem::path& log_path,
+        std::vector<client_data_structure::stClientData>& records, std::uintmax_t start_offset = 0);
+
+    // The entries replay() would apply from `start_offset` on, in log order, for callers
+    // that fold them into something other than a record vector (a client_table).
+    std::vector<stLogEntry> read_entries(const std::filesystem::path& log_path, std::uintmax_t start_offset = 0);
+
+#pragma region find_last_entry Documentation
+    /*
+        Function: find_last_entry
+        Description:
+            The entry replay() would apply last for `account_number`, i.e. what the log
+            says that client is now. Lines are scanned from the end of the log and only
+            compared on their account_number field; just the match is parsed.
+        Returns:
+            bool - true (and `entry` set) if the log holds a well-formed entry for the
+            account; false if it holds none (the data file has the final word).
+        Big O:
+            - Time: O(bytes after the last entry of the account), no allocation per line.
+    */
+#pragma endregion
+    bool find_last_entry(const std::filesystem::path& log_path, std::string_view account_number,
+        stLogEntry& entry);
+
+#pragma region stCompactionJob Documentation
+    /*
+        Struct: stCompactionJob
+
+        Description:
+            One compaction in flight (clsOpLog::begin_compaction / prepare_compaction /
+            finish_compaction). It rewrites the data file as the state at log_offset, while
+            this process keeps appending behind it. The first block is filled by
+            begin_compaction, the rest by prepare_compaction.
+    */
+#pragma endregion
+    struct stCompactionJob
+    {
+        std::filesystem::path data_file_path;
+        std::filesystem::path log_file_path;
+        std::filesystem::path snapshot_path;
+        std::filesystem::path account_index_path; // Empty: no account index to keep current
+        std::uintmax_t log_offset = 0; // The rewrite covers log[0, log_offset)
+        std::uint64_t generation = 0;  // clsOpLog::generation() when it began
+        bool durable = false;          // Sync the new data file before it is published
+
+        std::filesystem::path temp_path; // The new data file, not yet renamed
+        columnar_snapshot::stPreparedSnapshot snapshot;
+        std::filesystem::path account_index; // Index of temp_path, not yet renamed
+    };
+
+#pragma region clsOpLog Documentation
+    /*
+        Class: clsOpLog
+
+        Description:
+            Append-only operation log kept next to the data file (LOG_FILE_NAME in the data
+            directory). Each add/update/delete costs one small append instead of a rewrite of
+            the whole data file. Readers get the current state with load() (data file + replay).
+            Once the log grows past the fold threshold, fold() writes the replayed state to a
+            temp file (file_ops::write_clients_temp), renames it over the data file and
+            empties the log.
+            Every such rewrite also publishes a columnar snapshot of the new data file
+            (SNAPSHOT_FILE_NAME), and load() reads the data file through it
+            (columnar_snapshot::load_clients), so start-up does not re-parse the CSV.
+            If an account index (ACCOUNT_INDEX_FILE_NAME) exists, the rewrite builds the
+            index of the new data file beforehand and publishes it with the rename, so
+            `--find` never has to rebuild it after a fold.
+
+        Checkpoints:
+            Between rewrites, checkpoint() replaces that snapshot with the current state
+            (data file + log so far) and the log size it covers. load() then replays only
+            the entries after it, so start-up costs one snapshot copy plus at most
+            checkpoint_interval() bytes of log, however long the log has grown.
+            checkpoint_if_due() is called after every batch commit by the writers that hold
+            the whole state anyway (controller::command_session). A checkpoint never changes
+            the data: it is published under the shared lock and only if the version is still
+            the one the records belong to.
+
+        Tombstones and compaction:
+            A delete is one remove entry in the log (a tombstone): O(1), and every read
+            (replay, the session) skips the client from then on. The data file row stays until
+            a rewrite. Once tombstones make up COMPACTION_TOMBSTONE_RATIO of the rows
+            (is_compaction_due), the data file is compacted:
+            - fold_if_due() does it in place (start-up, short-lived programs);
+            - compactor::clsCompactor does it in the background: begin_compaction()
+              notes the log size, prepare_compaction() rebuilds that state and writes the
+              new data file (TEMP_FILE_NAME) on its own thread, and finish_compaction()
+              renames it into place under the exclusive lock. The entries appended in the
+              meantime move to a fresh log, so writers never wait for the rewrite and a
+              busy writer cannot starve it.
+
+        Concurrency between processes:
+            Every write goes through data_lock::clsDataLock::commit with the version of the
+            state this object last loaded (or wrote). If another process committed since,
+            the write fails with data_lock::clsVersionConflict instead of being applied on
+            top of a state the caller never saw; load() again and retry. Loads hold the
+            shared lock; the exclusive lock covers only an append, or a rename + truncate.
+
+        Construction:
+            Opens (creating if needed) the log for appending. If the previous process died in
+            the middle of an append, the torn last line is cut off first, so the next
+            entry starts on a clean line.
+
+        Throws:
+            - std::runtime_error if the log or the lock file cannot be opened or an append fails.
+            - data_lock::clsVersionConflict from append(), commit_batch() and fold() (but not
+              fold_if_due(), which just skips the fold) when another process committed first.
+            - whatever file_ops::write_clients_temp throws, from a rewrite.
+
+        Notes:
+            - append() flushes the stream, then syncs as set_sync_policy() says (default
+              none: the library leaves durability to the program, which passes the
+              deployment's stSyncOptions). The sync runs under the exclusive lock, so a
+              commit that returned is on disk; fsyncs of one process never overlap.
+            - With a policy other than none, a rewrite also syncs the new data file before
+              the rename and the directory after it, before the log is emptied. A failed
+              sync throws: the commit is then unacknowledged (for a rewrite, the old
+              log still holds every entry). A failed append is cut back off the log
+              before the lock is released; if the log cannot be cut, the version is
+              bumped anyway so every process reloads what is there.
+            - A commit observer (set_commit_observer) sees every entry this object commits,
+              inside the exclusive lock, so sidecars derived from the data (the account
+              filter) are updated in the same order by every process.
+            - Not thread-safe; one clsOpLog per process (several processes are fine).
+    */
+#pragma endregion
+    class clsOpLog
+    {
+    public:
+        // Called under the exclusive lock, after the entries were published and before the
+        // version stamp moves to new_version. A fold passes no entries (same clients).
+        using commit_observer = std::function<void(std::span<const stLogEntry> entries,
+            std::uint64_t new_version)>;
+
+        // Fold once the log holds ~16 MiB of entries: replaying that much on start-up
+        // stays far below the cost of re-parsing a multi-GB data file.
+        static constexpr std::uintmax_t DEFAULT_FOLD_THRESHOLD = 16u * 1024u * 1024u;
+
+        clsOpLog(const std::filesystem::path& data_file_path,
+            const std::filesystem::path& log_file_path,
+            std::uintmax_t fold_threshold = DEFAULT_FOLD_THRESHOLD);
+
+        void append(const stLogEntry& entry);
+
+        // Data file records with the whole log replayed on top, read under the shared
+        // lock. Also records the data version later writes are checked against.
+        std::vector<client_data_structure::stClientData> load();
+
+        std::uintmax_t log_size() const noexcept { return _log_size; }
+        bool is_fold_due() const noexcept { return _log_size >= _fold_threshold || is_compaction_due(); }
+
+        // Compact once a quarter of the data file rows are deleted clients.
+        static constexpr double COMPACTION_TOMBSTONE_RATIO = 0.25;
+
+        // Remove entries in the log, and the clients of the state, as last loaded or written.
+        std::size_t tombstone_count() const noexcept { return _tombstones; }
+        std::size_t client_count() const noexcept { return _client_count; }
+        bool is_compaction_due() const noexcept
+        {
+            return _tombstones != 0 &&
+                static_cast<double>(_tombstones) >= COMPACTION_TOMBSTONE_RATIO * static_cast<double>(_client_count + _tombstones);
+        }
+
+        // Bumped by every load() and every rewrite of the data file by this object: a
+        // compaction job only applies to the log of the generation it began in.
+        std::uint64_t generation() const noexcept { return _generation; }
+
+        // O(1): a job for the state at the current log size.
+        stCompactionJob begin_compaction() const;
+
+        /*
+            The slow part, safe on any thread (it touches no clsOpLog): rebuilds the state at
+            job.log_offset from the snapshot or the data file plus the log prefix (read with
+            plain reads, never mapped, so a concurrent truncation cannot fault), then writes
+            the new data file and its snapshot to temp files. Throws std::runtime_error on
+            failure (the temp files are removed) or if the log was rewritten meanwhile.
+        */
+        static void prepare_compaction(stCompactionJob& job);
+
+        /*
+            Publishes a prepared job: under the exclusive lock, copies log[job.log_offset,
+            end) to a fresh log, renames the new data file and then that log into place, and
+            publishes the snapshot. Returns false (and discards the job) if this object
+            loaded or rewrote since begin_compaction(), or another process committed since
+            its last load (load() and start again). Throws like a fold otherwise.
+        */
+        bool finish_compaction(stCompactionJob& job);
+
+        // Removes a job's temp files.
+        static void discard_compaction(stCompactionJob& job) noexcept;
+
+        // Log bytes covered by the snapshot load() started from (or the last checkpoint).
+        std::uintmax_t checkpoint_offset() const noexcept { return _checkpoint_offset; }
+        // A quarter of the fold threshold: recovery replays at most this much log.
+        std::uintmax_t checkpoint_interval() const noexcept { return _fold_threshold / 4; }
+        bool is_checkpoint_due() const noexcept
+        {
+            return _log_size >= _checkpoint_offset + checkpoint_interval() && !is_fold_due();
+        }
+
+        /*
+            Publishes `current_records` as the checkpoint for the current log size.
+            `current_records` must be the state load() would return now (rows with
+            delete_mark are left out). Returns false, writing nothing, if another process
+            committed since this object's last load or write.
+            Throws std::runtime_error if the checkpoint cannot be written.
+        */
+        bool checkpoint(const std::vector<client_data_structure::stClientData>& current_records);
+
+        // checkpoint() only if is_checkpoint_due(); failures are swallowed (the log
+        // stays the source of truth). Returns whether it wrote one.
+        bool checkpoint_if_due(const std::vector<client_data_structure::stClientData>& current_records) noexcept;
+
+        // Rewrites the data file with the log applied and truncates the log.
+        void fold();
+
+        // fold() only if is_fold_due(); returns whether it folded.
+        bool fold_if_due();
+
+        /*
+            Persists a whole batch of entries in one step. `current_records` must be the
+            state load() would return once `entries` are applied (the batch caller already
+            holds it). If the batch would push the log past the fold threshold, the data
+            file is rewritten from `current_records` and the log emptied; otherwise all
+            entries go out as a single append + flush. Returns true if it rewrote.
+        */
+        bool commit_batch(std::span<const stLogEntry> entries,
+            const std::vector<client_data_structure::stClientData>& current_records);
+
+        const std::filesystem::path& data_file_path() const noexcept { return _data_file_path; }
+        const std::filesystem::path& log_file_path() const noexcept { return _log_file_path; }
+
+        // Data version this object's last load() or write was based on.
+        std::uint64_t version() const noexcept { return _version; }
+
+        void set_sync_policy(enSyncPolicy policy) noexcept { _sync_policy = policy; }
+        enSyncPolicy sync_policy() const noexcept { return _sync_policy; }
+
+        // Replaces the observer (an empty one disables it).
+        void set_commit_observer(commit_observer observer) { _observer = std::move(observer); }
+
+    private:
+        void open_log(bool truncate);
+        void write_line_buffer();
+        // Cuts the log back to `size` and reopens it; false if either step failed.
+        bool truncate_log(std::uintmax_t size) noexcept;
+        // Runs `write` (an append of `entries`) and the observer as one commit,
+        // undoing the append if either throws.
+        void commit_append(std::span<const stLogEntry> entries, const std::function<void()>& write);
+        void refresh_log_size();
+        void publish_rewrite(const std::vector<client_data_structure::stClientData>& records,
+            std::span<const stLogEntry> entries);
+        void notify(std::span<const stLogEntry> entries);
+        void track(std::span<const stLogEntry> entries) noexcept; // Tombstone and client counts
+        std::filesystem::path snapshot_path() const; // SNAPSHOT_FILE_NAME next to the data file
+        std::filesystem::path account_index_path() const; // ACCOUNT_INDEX_FILE_NAME, likewise
+
+        std::filesystem::path _data_file_path;
+        std::filesystem::path _log_file_path;
+        std::uintmax_t _fold_threshold;
+        std::uintmax_t _log_size = 0;
+        std::uintmax_t _checkpoint_offset = 0;
+        std::size_t _tombstones = 0;
+        std::size_t _client_count = 0;
+        std::uint64_t _generation = 0;
+        std::ofstream _log;
+        platform_ops_sync::clsFileSync _log_sync; // Same file as _log
+        enSyncPolicy _sync_policy = enSyncPolicy::none;
+        std::string _line; // Reused serialization buffer
+        data_lock::clsDataLock _lock; // LOCK_FILE_NAME next to the data file
+        std::uint64_t _version = 0;
+        commit_observer _observer;
+    };
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <string>
 #include <string_view>
 
@@ -12,9 +13,54 @@ namespace infrastructure_names {
     // Stored in read-only data segment; no heap or stack use at runtime
     constexpr std::string_view ORIGINAL_FILE_NAME = "clients.csv";
 
-    // TEMP_FILE_NAME: filename for any temporary CSV operations
+    // TEMP_FILE_NAME: filename for any temporary CSV operations (a rewrite adds
+    // ".<process id>" so concurrent processes never share a temp file)
     constexpr std::string_view TEMP_FILE_NAME = "temp.csv";
 
+    // LOG_FILE_NAME: append-only log of add/update/delete operations not yet
+    // folded into ORIGINAL_FILE_NAME
+    constexpr std::string_view LOG_FILE_NAME = "clients.log";
+
+    // ACCOUNT_INDEX_FILE_NAME: memory-mapped hash index account_number -> byte
+    // offset of the record line in ORIGINAL_FILE_NAME
+    constexpr std::string_view ACCOUNT_INDEX_FILE_NAME = "clients.idx";
+
+    // ACCOUNT_FILTER_FILE_NAME: memory-mapped counting Bloom filter over the
+    // account numbers in use (data file + log), stamped with the data version
+    constexpr std::string_view ACCOUNT_FILTER_FILE_NAME = "clients.bloom";
+
+    // NAME_INDEX_FILE_NAME: memory-mapped radix trie folded name -> byte
+    // offsets of the record lines in ORIGINAL_FILE_NAME
+    constexpr std::string_view NAME_INDEX_FILE_NAME = "clients.names";
+
+    // BALANCE_INDEX_FILE_NAME: memory-mapped sorted (balance, byte offset)
+    // index over ORIGINAL_FILE_NAME for balance range queries
+    constexpr std::string_view BALANCE_INDEX_FILE_NAME = "clients.bal";
+
+    // SNAPSHOT_FILE_NAME: binary columnar copy of ORIGINAL_FILE_NAME, written on
+    // every rewrite and mapped at start-up instead of parsing the CSV
+    constexpr std::string_view SNAPSHOT_FILE_NAME = "clients.snap";
+
+    // FIXED_FILE_NAME: opt-in fixed-width copy of the clients (--to-fixed),
+    // read by row number (--page)
+    constexpr std::string_view FIXED_FILE_NAME = "clients.fixed";
+
+    // LSM staging store of --ingest: manifest of the live sorted runs, the
+    // write-ahead log of the memtable, the lock file held by each open store,
+    // and the run files <prefix><sequence><extension>
+    constexpr std::string_view LSM_MANIFEST_FILE_NAME = "clients.lsm";
+    constexpr std::string_view LSM_LOG_FILE_NAME = "clients.lsm.log";
+    constexpr std::string_view LSM_LOCK_FILE_NAME = "clients.lsm.lock";
+    constexpr std::string_view LSM_RUN_PREFIX = "clients-";
+    constexpr std::string_view LSM_RUN_EXTENSION = ".run";
+
+    // SOCKET_FILE_NAME: Unix domain socket the daemon (--serve) listens on
+    constexpr std::string_view SOCKET_FILE_NAME = "safecoin.sock";
+
+    // LOCK_FILE_NAME: advisory lock shared by every process using the data
+    // directory; also stores the data version stamp
+    constexpr std::string_view LOCK_FILE_NAME = "clients.lock";
+
     constexpr std::string_view SEPARATOR = "#//#";
 } // namespace infrastructure_names
 
@@ -31,6 +77,19 @@ namespace menu_options {
 } // namespace menu_options
 
 namespace client_data_structure{
+    // Column order of one record line in the data file:
+    // account_number#//#pass_code#//#phone_no#//#name#//#account_balance
+    enum class enClientField {
+    account_number = 0,
+    pass_code = 1,
+    phone_no = 2,
+    name = 3,
+    account_balance = 4,
+    };
+
+    // FIELD_COUNT: number of SEPARATOR-delimited columns in a record line
+    constexpr std::size_t FIELD_COUNT = 5;
+
     struct stClientData {
       std::string account_number;
       std::string pass_code;
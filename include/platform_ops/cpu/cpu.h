@@ -0,0 +1,60 @@
+// platform_ops/cpu/cpu.h
+
+#pragma once
+
+// PLATFORM_OPS_X86: defined when x86/x64 SIMD intrinsics (<immintrin.h>) are usable.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PLATFORM_OPS_X86 1
+#endif
+
+// PLATFORM_OPS_TARGET_AVX2: marks one function as compiled for AVX2 without turning on
+// -mavx2 for the whole build, so the binary still runs on CPUs without AVX2.
+// MSVC allows AVX2 intrinsics anywhere and needs no attribute.
+#if defined(__GNUC__) || defined(__clang__)
+#define PLATFORM_OPS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PLATFORM_OPS_TARGET_AVX2
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace platform_ops_cpu
+{
+#pragma region has_sse2 Documentation
+	/**
+	 * @brief Reports whether the running CPU supports SSE2.
+	 *
+	 * @return bool
+	 *   True on every x86-64 CPU (SSE2 is part of the baseline ABI).
+	 *   False on non-x86 builds.
+	 */
+#pragma endregion
+	bool has_sse2() noexcept;
+
+#pragma region has_avx2 Documentation
+	/**
+	 * @brief Reports whether the running CPU and OS support AVX2.
+	 *
+	 * Queries CPUID once (and XGETBV on MSVC so the OS is known to save YMM registers)
+	 * and caches the answer in a function-local static.
+	 *
+	 * @return bool
+	 *   True if AVX2 code paths may be executed. False otherwise or on non-x86 builds.
+	 */
+#pragma endregion
+	bool has_avx2() noexcept;
+
+	// Index of the lowest set bit of a non-zero SIMD movemask result.
+	inline unsigned lowest_bit(unsigned mask) noexcept
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long bit{};
+		_BitScanForward(&bit, mask);
+		return static_cast<unsigned>(bit);
+#else
+		return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+	}
+}// platform_ops_cpu
@@ -0,0 +1,102 @@
+// platform_ops/epoch/epoch.h
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace platform_ops_epoch
+{
+#pragma region clsEpochDomain Documentation
+	/**
+	 * @brief Epoch-based reclamation: frees retired objects once no reader can still see them.
+	 *
+	 * A reader pins the domain for as long as it dereferences shared pointers. Pinning
+	 * claims one of MAX_READERS slots and records the global epoch in it; no lock is taken
+	 * and no writer is ever waited for. A writer that has unlinked an object (for example
+	 * by swapping an atomic pointer) calls retire(): the object is stamped with the current
+	 * epoch and the epoch advances. reclaim() frees every retired object whose stamp is
+	 * older than the oldest pinned slot. A reader pinned before the unlink may still use
+	 * the object; a reader pinned after it can only have loaded the new pointer.
+	 *
+	 * @note
+	 *   - Pins are cheap but not free (a CAS on a slot). Hold one per operation, not per
+	 *     pointer load.
+	 *   - If all slots are taken, pin() yields until one frees up.
+	 *   - retire()/reclaim() serialize on a mutex; they are for writers only.
+	 *   - The destructor frees whatever is still retired; no reader may be pinned then.
+	 */
+#pragma endregion
+	class clsEpochDomain
+	{
+	public:
+		static constexpr std::size_t MAX_READERS = 128;
+
+		class clsGuard
+		{
+		public:
+			clsGuard() = default;
+			clsGuard(clsGuard&& other) noexcept : _slot(other._slot) { other._slot = nullptr; }
+			clsGuard& operator=(clsGuard&& other) noexcept;
+			~clsGuard() { unpin(); }
+
+			clsGuard(const clsGuard&) = delete;
+			clsGuard& operator=(const clsGuard&) = delete;
+
+			void unpin() noexcept;
+			bool is_pinned() const noexcept { return _slot != nullptr; }
+
+		private:
+			friend class clsEpochDomain;
+			explicit clsGuard(std::atomic<std::uint64_t>* slot) noexcept : _slot(slot) {}
+			std::atomic<std::uint64_t>* _slot = nullptr;
+		};
+
+		clsEpochDomain() = default;
+		~clsEpochDomain();
+
+		clsEpochDomain(const clsEpochDomain&) = delete;
+		clsEpochDomain& operator=(const clsEpochDomain&) = delete;
+
+		clsGuard pin() noexcept;
+
+		// Hands ownership of an unlinked object to the domain; freed by a later reclaim().
+		void retire(std::function<void()> deleter);
+
+		template <class T>
+		void retire(const T* object)
+		{
+			retire([object] { delete object; });
+		}
+
+		// Frees what no pinned reader can reach; returns how many objects were freed.
+		std::size_t reclaim();
+
+		// Objects retired but not yet freed.
+		std::size_t retired_count() const;
+
+	private:
+		static constexpr std::uint64_t IDLE = UINT64_MAX;
+
+		// One slot per cache line, so readers pinning at once do not share lines.
+		struct alignas(64) stSlot
+		{
+			std::atomic<std::uint64_t> epoch{ IDLE };
+		};
+
+		struct stRetired
+		{
+			std::uint64_t epoch;
+			std::function<void()> deleter;
+		};
+
+		std::atomic<std::uint64_t> _global_epoch{ 0 };
+		stSlot _slots[MAX_READERS];
+		mutable std::mutex _retired_mutex;
+		std::vector<stRetired> _retired;
+	};
+}// platform_ops_epoch
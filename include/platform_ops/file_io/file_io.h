@@ -0,0 +1,67 @@
+// platform_ops/file_io/file_io.h
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace platform_ops_file_io
+{
+	enum class enOpenMode
+	{
+		read_only,  // Existing file
+		read_write, // Existing file
+		create,     // Read-write; created if missing, truncated if present
+	};
+
+#pragma region clsRandomAccessFile Documentation
+	/**
+	 * @brief A file read and written at explicit offsets (pread/pwrite; ReadFile/WriteFile
+	 *        with an OVERLAPPED offset on Windows), with no shared file position.
+	 *
+	 * A positional call never moves a cursor, so each one is a single system call and
+	 * calls on different offsets need no coordination. Fixed-size records are read and
+	 * updated in place with it, without touching the rest of the file.
+	 *
+	 * @note
+	 *   - read_at / write_at loop until every byte moved; a read past the end fails.
+	 *   - Move-only. The destructor closes.
+	 *   - Every call is noexcept and reports failure by its return value.
+	 */
+#pragma endregion
+	class clsRandomAccessFile
+	{
+	public:
+		clsRandomAccessFile() = default;
+		~clsRandomAccessFile();
+
+		clsRandomAccessFile(const clsRandomAccessFile&) = delete;
+		clsRandomAccessFile& operator=(const clsRandomAccessFile&) = delete;
+		clsRandomAccessFile(clsRandomAccessFile&& other) noexcept;
+		clsRandomAccessFile& operator=(clsRandomAccessFile&& other) noexcept;
+
+		bool open(const std::filesystem::path& file_path, enOpenMode mode) noexcept;
+		void close() noexcept;
+		bool is_open() const noexcept;
+
+		// Current size in bytes (0 if not open).
+		std::uint64_t size() const noexcept;
+
+		// Reads exactly @p bytes at @p offset.
+		bool read_at(std::uint64_t offset, void* buffer, std::size_t bytes) const noexcept;
+
+		// Writes exactly @p bytes at @p offset, growing the file if needed.
+		bool write_at(std::uint64_t offset, const void* buffer, std::size_t bytes) noexcept;
+
+		// Waits until the file's data is on stable storage (see platform_ops_sync).
+		bool sync_data() noexcept;
+
+	private:
+#ifdef _WIN32
+		void* _handle = nullptr;
+#else
+		int _fd = -1;
+#endif
+	};
+}// platform_ops_file_io
@@ -0,0 +1,77 @@
+// platform_ops/lock/lock.h
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace platform_ops_lock
+{
+	enum class enLockMode
+	{
+		shared,    // Any number of holders at once (readers)
+		exclusive, // One holder, no shared holders (writers)
+	};
+
+#pragma region clsFileLock Documentation
+	/**
+	 * @brief Advisory whole-file lock between processes, plus an 8-byte stamp stored in the file.
+	 *
+	 * Linux uses open file description locks (F_OFD_SETLK/F_OFD_SETLKW): they belong to
+	 * this object's descriptor, not to the process, so two clsFileLock objects conflict
+	 * even inside one process, and closing an unrelated descriptor of the same file does
+	 * not drop the lock (unlike classic fcntl locks). Other POSIX systems fall back to
+	 * flock(), which has the same per-descriptor behaviour. Windows uses LockFileEx on one
+	 * byte far past the end of the file, so the lock never blocks reading or writing the
+	 * stamp itself.
+	 *
+	 * @note
+	 *   - Lock a dedicated lock file, never a file that gets replaced by rename: the new
+	 *     file would not carry the lock.
+	 *   - Move-only. The destructor unlocks and closes.
+	 *   - Every call is noexcept and reports failure by its return value.
+	 */
+#pragma endregion
+	class clsFileLock
+	{
+	public:
+		clsFileLock() = default;
+		~clsFileLock();
+
+		clsFileLock(const clsFileLock&) = delete;
+		clsFileLock& operator=(const clsFileLock&) = delete;
+		clsFileLock(clsFileLock&& other) noexcept;
+		clsFileLock& operator=(clsFileLock&& other) noexcept;
+
+		// Opens (creating if needed) the lock file; does not lock it yet.
+		bool open(const std::filesystem::path& lock_file_path) noexcept;
+		void close() noexcept;
+		bool is_open() const noexcept;
+
+		// Waits until the lock is granted. Re-locking converts the mode.
+		bool lock(enLockMode mode) noexcept;
+
+		// Returns false at once if another holder conflicts.
+		bool try_lock(enLockMode mode) noexcept;
+
+		void unlock() noexcept;
+
+		// The 8-byte stamp at offset 0; a new (short) file reads as 0.
+		bool read_stamp(std::uint64_t& stamp) const noexcept;
+
+		// Writes the stamp; call it only while holding the exclusive lock.
+		bool write_stamp(std::uint64_t stamp) noexcept;
+
+	private:
+		bool set_lock(enLockMode mode, bool wait) noexcept;
+
+#ifdef _WIN32
+		void* _handle = nullptr;
+#else
+		int _fd = -1;
+#endif
+	};
+
+	// Id of the running process (getpid / GetCurrentProcessId); used for unique temp names.
+	std::uint64_t current_process_id() noexcept;
+}// platform_ops_lock
@@ -0,0 +1,86 @@
+// platform_ops/map/map.h
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace platform_ops_map
+{
+	enum class enMapMode
+	{
+		read_only,  // PROT_READ / PAGE_READONLY; the default for data files
+		read_write, // Shared writable mapping; stores reach the file (index sidecars)
+	};
+
+#pragma region clsMappedFile Documentation
+	/**
+	 * @brief Owns a memory mapping of a whole file (read-only unless asked otherwise).
+	 *
+	 * Maps the file once (mmap on Linux, CreateFileMappingW/MapViewOfFile on Windows) and
+	 * exposes its bytes as a std::string_view. Any string_view handed out from view() stays
+	 * valid for as long as this object (or the object it was moved into) is alive, because
+	 * moving transfers the mapping without changing its address.
+	 *
+	 * @note
+	 *   - Move-only; copying would double-unmap.
+	 *   - An empty file is "open" with size() == 0 and no mapping (mmap rejects length 0).
+	 *   - Read-only mappings tell the kernel the access pattern is sequential, so read-ahead
+	 *     kicks in while the caller walks the buffer front to back. Read-write mappings are
+	 *     probed at random and say so instead.
+	 */
+#pragma endregion
+	class clsMappedFile
+	{
+	public:
+		clsMappedFile() = default;
+		~clsMappedFile();
+
+		clsMappedFile(const clsMappedFile&) = delete;
+		clsMappedFile& operator=(const clsMappedFile&) = delete;
+		clsMappedFile(clsMappedFile&& other) noexcept;
+		clsMappedFile& operator=(clsMappedFile&& other) noexcept;
+
+#pragma region open Documentation
+		/**
+		 * @brief Maps the file at @p file_path, releasing any previous mapping first.
+		 *
+		 * @param file_path  Path of the file to map.
+		 * @param mode       read_only (private, default) or read_write (shared with the file).
+		 * @return bool
+		 *   True if the file was opened and mapped (or is empty).
+		 *   False if it could not be opened, stat'ed or mapped; the object is left closed.
+		 *
+		 * @note Does not throw; mirrors the silent-failure style of file_ops::get_all_clients.
+		 */
+#pragma endregion
+		bool open(const std::filesystem::path& file_path, enMapMode mode = enMapMode::read_only) noexcept;
+
+		// Unmaps the file and closes the handle; safe to call on a closed object.
+		void close() noexcept;
+
+		bool is_open() const noexcept { return _is_open; }
+		const char* data() const noexcept { return _data; }
+		std::size_t size() const noexcept { return _size; }
+		std::string_view view() const noexcept { return { _data, _size }; }
+
+		// Writable pointer to the mapped bytes; nullptr unless opened read_write.
+		char* writable_data() const noexcept { return _writable ? const_cast<char*>(_data) : nullptr; }
+
+		// Writes dirty pages of a read_write mapping back to the file (msync / FlushViewOfFile).
+		bool flush() noexcept;
+
+	private:
+		const char* _data = nullptr;
+		std::size_t _size = 0;
+		bool _is_open = false;
+		bool _writable = false;
+#ifdef _WIN32
+		void* _file_handle = nullptr;
+		void* _map_handle = nullptr;
+#else
+		int _fd = -1;
+#endif
+	};
+}// platform_ops_map
@@ -4,6 +4,7 @@
 // to avoid multiple definitions
 
 #include <filesystem>
+#include <string_view>
 
 
 
@@ -45,6 +46,24 @@ namespace platform_ops_paths
 #pragma endregion
 	std::filesystem::path get_original_file_path(const std::filesystem::path& exe_dir_path);
 
+#pragma region get_data_file_path Documentation
+	/**
+	 * @brief Constructs the path of any file kept in the data directory.
+	 *
+	 * Same rule as get_original_file_path, for the other files under DATA_DIR_NAME
+	 * (operation log, index sidecars, temp file).
+	 *
+	 * @param exe_dir_path  The directory path of the running executable.
+	 * @param file_name     One of the infrastructure_names file name constants.
+	 * @return std::filesystem::path
+	 *   The full path: exe_dir_path / DATA_DIR_NAME / file_name.
+	 *
+	 * @throws std::bad_alloc
+	 *   If memory allocation for building the path strings fails.
+	 */
+#pragma endregion
+	std::filesystem::path get_data_file_path(const std::filesystem::path& exe_dir_path, std::string_view file_name);
+
 #pragma region is_file_exist Documentation
 	/**
 	 * @brief Checks whether the given path corresponds to an existing regular file.
@@ -0,0 +1,135 @@
+// platform_ops/scheduler/scheduler.h
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace platform_ops_scheduler
+{
+#pragma region clsTaskScheduler Documentation
+	/**
+	 * @brief Fixed pool of worker threads that share work by stealing.
+	 *
+	 * Every worker owns a deque. A task submitted from a worker goes to the back of that
+	 * worker's deque and is popped from the back again (LIFO, so nested work stays hot in
+	 * cache). A task submitted from any other thread goes to a shared injection queue. An
+	 * idle worker first drains its own deque, then the injection queue, then steals from
+	 * the front (oldest, usually biggest) of a randomly chosen victim. Workers with
+	 * nothing to do sleep on a condition variable; they do not spin.
+	 *
+	 * @note
+	 *   - Each deque is guarded by its own mutex. The lock is held for one push or pop and
+	 *     never while a task runs, so contention stays at a few owners per steal.
+	 *   - submit() takes tasks that must not throw; use clsTaskGroup to collect exceptions.
+	 *   - The destructor runs every queued task, then joins the workers.
+	 */
+#pragma endregion
+	class clsTaskScheduler
+	{
+	public:
+		using task_type = std::function<void()>;
+
+		// worker_count 0 = std::thread::hardware_concurrency() (at least 1).
+		explicit clsTaskScheduler(unsigned worker_count = 0);
+		~clsTaskScheduler();
+
+		clsTaskScheduler(const clsTaskScheduler&) = delete;
+		clsTaskScheduler& operator=(const clsTaskScheduler&) = delete;
+
+		void submit(task_type task);
+
+		// Runs one queued task on the calling thread (own deque, injection queue, then a
+		// steal). Returns false if every queue was empty. Lets a waiting thread help.
+		bool run_one();
+
+		unsigned worker_count() const noexcept { return static_cast<unsigned>(_workers.size()); }
+
+	private:
+		struct stTaskQueue
+		{
+			std::mutex mutex;
+			std::deque<task_type> tasks;
+		};
+
+		bool try_take(task_type& task);
+		void worker_loop(unsigned index);
+
+		// _queues[0.._workers.size()) belong to the workers; the last one is the injection queue.
+		std::vector<std::unique_ptr<stTaskQueue>> _queues;
+		std::vector<std::jthread> _workers;
+		std::atomic<std::size_t> _queued{ 0 };
+		std::mutex _sleep_mutex;
+		std::condition_variable _wake;
+		bool _stopping = false; // Guarded by _sleep_mutex
+	};
+
+#pragma region default_scheduler Documentation
+	/**
+	 * @brief The process-wide scheduler, sized to the machine, created on first use.
+	 *
+	 * Loader, generator and other parallel code all submit here, so the box is never
+	 * oversubscribed by several pools competing for the same cores.
+	 */
+#pragma endregion
+	clsTaskScheduler& default_scheduler();
+
+#pragma region clsTaskGroup Documentation
+	/**
+	 * @brief A set of tasks that can be waited for together.
+	 *
+	 * wait() does not just block: while tasks of any group are queued, the waiting thread
+	 * runs them itself. A worker can therefore wait on a nested group without
+	 * deadlocking the pool. The first exception thrown by a task is rethrown from wait();
+	 * the other tasks still run to completion.
+	 *
+	 * @note The destructor waits too, and swallows an exception nobody waited for.
+	 */
+#pragma endregion
+	class clsTaskGroup
+	{
+	public:
+		explicit clsTaskGroup(clsTaskScheduler& scheduler = default_scheduler()) : _scheduler(scheduler) {}
+		~clsTaskGroup();
+
+		clsTaskGroup(const clsTaskGroup&) = delete;
+		clsTaskGroup& operator=(const clsTaskGroup&) = delete;
+
+		void run(std::function<void()> task);
+		void wait();
+
+	private:
+		void wait_for_tasks() noexcept;
+
+		clsTaskScheduler& _scheduler;
+		std::mutex _state_mutex; // Guards the three members below
+		std::condition_variable _done;
+		std::size_t _pending = 0;
+		std::exception_ptr _error;
+	};
+
+#pragma region parallel_for Documentation
+	/**
+	 * @brief Calls body(i) for every i in [0, count) on the scheduler and waits.
+	 *
+	 * The calling thread helps, so parallel_for from inside a task is fine. Rethrows the
+	 * first exception a call threw.
+	 */
+#pragma endregion
+	template <class Body>
+	void parallel_for(std::size_t count, Body&& body, clsTaskScheduler& scheduler = default_scheduler())
+	{
+		clsTaskGroup group(scheduler);
+		for (std::size_t i = 0; i < count; ++i)
+			group.run([&body, i] { body(i); });
+		group.wait();
+	}
+}// platform_ops_scheduler
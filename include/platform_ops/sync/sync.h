@@ -0,0 +1,57 @@
+// platform_ops/sync/sync.h
+
+#pragma once
+
+#include <filesystem>
+
+namespace platform_ops_sync
+{
+#pragma region clsFileSync Documentation
+	/**
+	 * @brief A descriptor kept open on a file only to force its data to stable storage.
+	 *
+	 * Writes go through whatever stream owns the file (a std::ofstream cannot be
+	 * synced); sync_data() then flushes the file itself, which covers every descriptor of
+	 * it. Linux uses fdatasync (skips metadata such as mtime, but not a new file size),
+	 * other POSIX systems fsync, Windows FlushFileBuffers.
+	 *
+	 * @note
+	 *   - Flush the writing stream first: sync_data() only sees what reached the kernel.
+	 *   - Move-only. The destructor closes.
+	 *   - Every call is noexcept and reports failure by its return value.
+	 */
+#pragma endregion
+	class clsFileSync
+	{
+	public:
+		clsFileSync() = default;
+		~clsFileSync();
+
+		clsFileSync(const clsFileSync&) = delete;
+		clsFileSync& operator=(const clsFileSync&) = delete;
+		clsFileSync(clsFileSync&& other) noexcept;
+		clsFileSync& operator=(clsFileSync&& other) noexcept;
+
+		// Opens an existing file for syncing; does not create it.
+		bool open(const std::filesystem::path& file_path) noexcept;
+		void close() noexcept;
+		bool is_open() const noexcept;
+
+		// Waits until the file's data is on stable storage.
+		bool sync_data() noexcept;
+
+	private:
+#ifdef _WIN32
+		void* _handle = nullptr;
+#else
+		int _fd = -1;
+#endif
+	};
+
+	// Opens, syncs and closes @p file_path (e.g. a temp file before it is renamed into place).
+	bool sync_file(const std::filesystem::path& file_path) noexcept;
+
+	// Makes renames and creations inside @p directory_path durable. POSIX fsyncs the
+	// directory; Windows has no such call (NTFS journals them) and returns true.
+	bool sync_directory(const std::filesystem::path& directory_path) noexcept;
+}// platform_ops_sync
@@ -0,0 +1,95 @@
+// client_data_app/include/services/balance/balance.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+
+namespace balance {
+    // Balances are held as whole minor units (cents): 2500.75 -> 250075.
+    constexpr std::int64_t MINOR_UNITS_PER_MAJOR = 100;
+
+#pragma region Conversion
+    /**
+     * @brief Exact text <-> minor-unit conversion for the account_balance column.
+     * 
+     * @details
+     * - parse_minor_units: fast path for plain decimals ("-12", "2500.75", "0.5"). Digits
+     *   are accumulated straight into an int64 with no floating point. A third fraction
+     *   digit and beyond round half away from zero, so "0.30000000000000004" (a double
+     *   written by to_chars) comes back as 30. Anything else that std::from_chars accepts
+     *   as a double (e.g. "1e+20") goes through the slow path and is rounded to cents.
+     *   Returns false for non-numbers and values outside the int64 range.
+     * - append_minor_units: always writes two decimals ("-0.05", "12.30"). Parsing that
+     *   back as a double gives the nearest double, so the line stays readable by
+     *   h_convert::convert_line_to_record.
+     * - A leading '+' is rejected, as std::from_chars (and so the record parser) rejects it.
+     * - to_minor_units: the legacy double field in minor units, equal to parse_minor_units
+     *   of the text the app writes for it (the shortest to_chars form). So a balance read
+     *   from "1.005" is 101 here, as in every index built from the text.
+     * - to_major_units: the nearest double to a minor-unit amount.
+     */
+#pragma endregion Conversion
+    bool parse_minor_units(std::string_view text, std::int64_t& minor_units) noexcept;
+    void append_minor_units(std::int64_t minor_units, std::string& out);
+    std::int64_t to_minor_units(double major_units) noexcept;
+    constexpr double to_major_units(std::int64_t minor_units) noexcept
+    {
+        return static_cast<double>(minor_units) / static_cast<double>(MINOR_UNITS_PER_MAJOR);
+    }
+
+#pragma region Aggregation
+    /**
+     * @brief Aggregates over a dense int64 balance column.
+     * 
+     * @details
+     * Each function runs its AVX2 kernel when platform_ops_cpu::has_avx2() is true and the
+     * scalar loop otherwise. The kernels take 4 balances per 256-bit step (two independent
+     * accumulators for sum_minor). AVX2 has no 64-bit min/max instruction, so min and max
+     * use cmpgt + blendv. count_between subtracts each compare mask (all ones = -1) into a
+     * lane counter, which needs no branches.
+     * - sum_minor:     total. Wraps on int64 overflow (more than 9.2e16 minor units).
+     * - min_minor / max_minor: extreme value; INT64_MAX / INT64_MIN for an empty column.
+     * - count_between: rows with low <= balance <= high (inclusive).
+     * The _scalar and _avx2 variants are exposed for tests and benchmarks. Only call the
+     * _avx2 ones when has_avx2() is true.
+     */
+#pragma endregion Aggregation
+    std::int64_t sum_minor(std::span<const std::int64_t> balances) noexcept;
+    std::int64_t min_minor(std::span<const std::int64_t> balances) noexcept;
+    std::int64_t max_minor(std::span<const std::int64_t> balances) noexcept;
+    std::size_t count_between(std::span<const std::int64_t> balances, std::int64_t low, std::int64_t high) noexcept;
+
+    std::int64_t sum_minor_scalar(std::span<const std::int64_t> balances) noexcept;
+    std::int64_t min_minor_scalar(std::span<const std::int64_t> balances) noexcept;
+    std::int64_t max_minor_scalar(std::span<const std::int64_t> balances) noexcept;
+    std::size_t count_between_scalar(std::span<const std::int64_t> balances, std::int64_t low, std::int64_t high) noexcept;
+
+    std::int64_t sum_minor_avx2(std::span<const std::int64_t> balances) noexcept;
+    std::int64_t min_minor_avx2(std::span<const std::int64_t> balances) noexcept;
+    std::int64_t max_minor_avx2(std::span<const std::int64_t> balances) noexcept;
+    std::size_t count_between_avx2(std::span<const std::int64_t> balances, std::int64_t low, std::int64_t high) noexcept;
+
+#pragma region Portfolio totals
+    /**
+     * @brief Figures shown by the "portfolio totals" report.
+     * 
+     * @details
+     * compute_portfolio_totals fills it with one sum, one min, one max and two
+     * count_between passes over the column. Every figure is exact, in minor units.
+     */
+#pragma endregion Portfolio totals
+    struct stPortfolioTotals
+    {
+        std::size_t client_count = 0;
+        std::int64_t total_minor = 0;
+        std::int64_t lowest_minor = 0;
+        std::int64_t highest_minor = 0;
+        std::size_t overdrawn_count = 0; // balance < 0
+        std::size_t zero_count = 0;      // balance == 0
+    };
+
+    stPortfolioTotals compute_portfolio_totals(std::span<const std::int64_t> balances) noexcept;
+}
@@ -0,0 +1,99 @@
+// client_data_app/include/services/client_snapshot/client_snapshot.h
+#pragma once
+#include "file_ops/op_log/op_log.h"
+#include "platform_ops/epoch/epoch.h"
+#include "services/client_table/client_table.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+
+namespace client_snapshot {
+    // One published, immutable state of the clients. Never modified after publication.
+    struct stTableVersion
+    {
+        std::uint64_t number = 0;              // 1 for the first version, +1 per publication
+        client_table::clsClientTable table;    // apply() leaves out deleted rows
+        std::unordered_map<std::string_view, std::size_t> positions; // Live account_number -> row; views into table
+    };
+
+#pragma region clsReadView
+    /**
+     * @brief A reader's pinned version: stays valid and unchanged until the view is destroyed.
+     * 
+     * @details
+     * Holds an epoch guard, so the version it points at cannot be reclaimed while the view
+     * lives, whatever the writers publish meanwhile. Rows returned by find() and the rows
+     * of table() are string_views into that version and share its lifetime. Keep views
+     * short-lived: a long-held view delays the reclamation of every later version.
+     */
+#pragma endregion clsReadView
+    class clsReadView
+    {
+    public:
+        std::optional<client_table::stClientRow> find(std::string_view account_number) const;
+        const client_table::clsClientTable& table() const noexcept { return _version->table; }
+        std::size_t size() const noexcept { return _version->table.size(); }
+        std::uint64_t version() const noexcept { return _version->number; }
+
+    private:
+        friend class clsSnapshotTable;
+        clsReadView(platform_ops_epoch::clsEpochDomain::clsGuard guard, const stTableVersion* version) noexcept
+            : _guard(std::move(guard)), _version(version) {}
+
+        platform_ops_epoch::clsEpochDomain::clsGuard _guard;
+        const stTableVersion* _version;
+    };
+
+#pragma region clsSnapshotTable
+    /**
+     * @brief RCU-style client table: readers never wait, writers publish whole new versions.
+     * 
+     * @details
+     * - read(): pins the table's epoch domain and loads the current version pointer. No
+     *   lock is taken, so a find or a list costs the same whether or not a writer is busy.
+     * - apply()/publish(): build a new version next to the current one (copy-on-write),
+     *   swap the atomic pointer, retire the old version and reclaim whatever no pinned
+     *   reader can still reach. Writers serialize on a mutex that readers never touch.
+     * - apply() folds a whole batch of log entries into one new version. Each version is
+     *   an O(rows) copy, so group mutations rather than applying them one by one.
+     * 
+     * @note The destructor frees every version; no read view may outlive the table.
+     */
+#pragma endregion clsSnapshotTable
+    class clsSnapshotTable
+    {
+    public:
+        explicit clsSnapshotTable(client_table::clsClientTable initial = {});
+        ~clsSnapshotTable();
+
+        clsSnapshotTable(const clsSnapshotTable&) = delete;
+        clsSnapshotTable& operator=(const clsSnapshotTable&) = delete;
+
+        clsReadView read() const noexcept;
+
+        // Upserts (add/update) and deletes by account_number, in entry order, as one version.
+        void apply(std::span<const op_log::stLogEntry> entries);
+
+        // Replaces the whole state (for example after reloading the data file).
+        // Rows with delete_mark stay in table() but find() skips them.
+        void publish(client_table::clsClientTable table);
+
+        std::uint64_t version() const noexcept { return _current.load(std::memory_order_acquire)->number; }
+
+        // Retired versions still waiting for readers to move on.
+        std::size_t retired_versions() const { return _epochs.retired_count(); }
+
+    private:
+        void swap_in(client_table::clsClientTable table); // Caller holds _writer_mutex
+
+        mutable platform_ops_epoch::clsEpochDomain _epochs;
+        std::atomic<const stTableVersion*> _current{ nullptr };
+        std::mutex _writer_mutex;
+    };
+}
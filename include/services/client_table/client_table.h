@@ -0,0 +1,147 @@
+// client_data_app/include/services/client_table/client_table.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "infrastructure.h"
+
+
+namespace client_table {
+#pragma region stClientRow
+    /**
+     * @brief Read-only view of one row of a clsClientTable, shaped like stClientData.
+     * 
+     * @details
+     * It has the same member names as client_data_structure::stClientData, so code that reads
+     * `client.name` or `client.account_balance` compiles unchanged against a table row.
+     * String members are views into the table's shared blob. They stay valid until the
+     * table is modified (push_back, update, compact) or destroyed. `account_balance` is
+     * derived from the exact `balance_minor` column value (see services/balance).
+     */
+#pragma endregion stClientRow
+    struct stClientRow
+    {
+        std::string_view account_number;
+        std::string_view pass_code;
+        std::string_view phone_no;
+        std::string_view name;
+        double account_balance;
+        bool delete_mark;
+        std::int64_t balance_minor; // Exact balance in minor units (cents)
+
+        // Owning copy, for code that needs a real stClientData.
+        client_data_structure::stClientData to_record() const;
+    };
+
+#pragma region clsClientTable
+    /**
+     * @brief Columnar (structure-of-arrays) in-memory client table.
+     * 
+     * @details
+     * - The four string fields of every row live in one shared character blob. Per row and
+     *   field, the table keeps a 64-bit start offset and a 32-bit length.
+     * - account_balance is one dense std::vector<std::int64_t> of exact minor units
+     *   (balance::MINOR_UNITS_PER_MAJOR per unit). A balance scan walks a single
+     *   contiguous array (see balances_minor()) that the AVX2 kernels in services/balance
+     *   aggregate 4 rows per instruction. delete_mark is a dense byte array.
+     * - Per row that is 48 bytes of offsets/lengths + 8 + 1 bytes and no heap allocation,
+     *   compared with ~144 bytes of std::string headers plus up to four allocations in
+     *   stClientData.
+     * - update() cannot grow a field in place, so it appends the new text at the end of
+     *   the blob and points the row at it. compact() reclaims the abandoned bytes once
+     *   they outweigh the live ones.
+     */
+#pragma endregion clsClientTable
+    class clsClientTable
+    {
+    public:
+        // Number of string columns stored in the blob (every field but the balance).
+        static constexpr std::size_t STRING_FIELDS = 4;
+
+        std::size_t size() const noexcept { return _balances.size(); }
+        bool empty() const noexcept { return _balances.empty(); }
+
+        void reserve(std::size_t rows, std::size_t text_bytes);
+        void push_back(const client_data_structure::stClientData& record);
+        void push_back_row(const stClientRow& row); // e.g. copying rows between tables
+
+        stClientRow row(std::size_t i) const noexcept;
+        stClientRow operator[](std::size_t i) const noexcept { return row(i); }
+
+        // Replaces every field of row i (strings are re-appended to the blob).
+        void update(std::size_t i, const client_data_structure::stClientData& record);
+        void set_balance(std::size_t i, double balance) noexcept;
+        void set_balance_minor(std::size_t i, std::int64_t balance_minor) noexcept { _balances[i] = balance_minor; }
+        void set_delete_mark(std::size_t i, bool mark) noexcept { _delete_marks[i] = mark ? 1 : 0; }
+
+        // Dense columns for scans.
+        std::span<const std::int64_t> balances_minor() const noexcept { return _balances; }
+        std::span<const std::uint8_t> delete_marks() const noexcept { return _delete_marks; }
+
+        // Linear search of the account_number column; size() if absent.
+        std::size_t find_row(std::string_view account_number) const noexcept;
+
+        // Rewrites the blob without abandoned bytes. O(live text).
+        void compact();
+        std::size_t garbage_bytes() const noexcept { return _garbage_bytes; }
+
+        // Bytes held by all columns (capacity, not just size).
+        std::size_t memory_usage() const noexcept;
+
+        // Owning copies of every row, in order (for code that still needs stClientData).
+        std::vector<client_data_structure::stClientData> to_records() const;
+
+        // Forward iteration over row views: for (stClientRow client : table) ...
+        class iterator
+        {
+        public:
+            using value_type = stClientRow;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            iterator(const clsClientTable* table, std::size_t i) noexcept : _table(table), _i(i) {}
+            stClientRow operator*() const noexcept { return _table->row(_i); }
+            iterator& operator++() noexcept { ++_i; return *this; }
+            iterator operator++(int) noexcept { iterator old = *this; ++_i; return old; }
+            bool operator==(const iterator& other) const noexcept { return _i == other._i; }
+
+        private:
+            const clsClientTable* _table = nullptr;
+            std::size_t _i = 0;
+        };
+        iterator begin() const noexcept { return { this, 0 }; }
+        iterator end() const noexcept { return { this, size() }; }
+
+    private:
+        void append_field(std::string_view text);
+        std::string_view field(std::size_t i, std::size_t k) const noexcept;
+
+        std::string _text;                   // Shared blob of all string fields
+        std::vector<std::uint64_t> _offsets; // STRING_FIELDS per row
+        std::vector<std::uint32_t> _lengths; // STRING_FIELDS per row
+        std::vector<std::int64_t> _balances; // Minor units
+        std::vector<std::uint8_t> _delete_marks;
+        std::size_t _garbage_bytes = 0;
+    };
+
+#pragma region load_client_table
+    /**
+     * @brief Loads a data file straight into a clsClientTable.
+     * 
+     * @details
+     * Maps the file and builds its structural index (file_ops::get_all_clients_indexed).
+     * Each valid row's fields are then copied from the mapping into the blob, so no
+     * intermediate stClientData or std::string is created. Balances are parsed exactly with
+     * balance::parse_minor_units. Blank and malformed rows are skipped, as in
+     * file_ops::load_clients_parallel.
+     * 
+     * @param file_path The data file.
+     * @return The table; empty if the file cannot be opened.
+     */
+#pragma endregion load_client_table
+    clsClientTable load_client_table(const std::filesystem::path& file_path);
+}
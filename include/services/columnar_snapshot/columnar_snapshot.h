@@ -0,0 +1,195 @@
+// client_data_app/include/services/columnar_snapshot/columnar_snapshot.h
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "infrastructure.h"
+#include "platform_ops/map/map.h"
+#include "services/client_table/client_table.h"
+
+
+namespace columnar_snapshot {
+#pragma region On-disk layout
+    /**
+     * @brief Layout of the binary columnar snapshot (SNAPSHOT_FILE_NAME).
+     *
+     * @details
+     * [stSnapshotHeader][stColumnBlock x COLUMN_BLOCKS][block]..., native endianness,
+     * every block 8-byte aligned, memory-mapped as is.
+     * - One block per column, in stColumnBlock order. The string columns (account_number,
+     *   pass_code, phone_no, name) are either plain or dictionary-encoded:
+     *   - plain:      [std::uint64_t offset x (rows + 1)][bytes]; row i is
+     *                 bytes[offset[i], offset[i + 1]).
+     *   - dictionary: [std::uint64_t entries][std::uint32_t code x rows][padding to 8]
+     *                 [std::uint64_t offset x (entries + 1)][bytes]; row i is entry code[i].
+     *   The writer picks a dictionary when at most half the values are distinct (e.g.
+     *   repeated names or pass codes), and plain otherwise (account numbers).
+     * - account_balance is stored twice: the exact double the CSV parser produces (so
+     *   loading the snapshot gives the same records as parsing the CSV), and the minor-unit
+     *   int64 column that the services/balance kernels scan without any conversion.
+     * - Every block has a checksum_64 in its directory entry. The header and directory have
+     *   one of their own (directory_checksum, computed with that field set to 0).
+     * - data_file_size / data_file_mtime snapshot the data file it was taken from. If either
+     *   differs, the snapshot is stale and readers fall back to the CSV.
+     */
+#pragma endregion On-disk layout
+    enum class enColumnEncoding : std::uint32_t
+    {
+        plain_strings = 1,
+        dictionary_strings = 2,
+        float64 = 3,
+        int64_minor = 4,
+    };
+
+    struct stSnapshotHeader
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t block_count;
+        std::uint64_t row_count;
+        std::uint64_t data_file_size;
+        std::int64_t data_file_mtime;
+        std::uint64_t file_size;
+        std::uint64_t directory_checksum;
+        std::uint64_t log_offset;
+    };
+    static_assert(sizeof(stSnapshotHeader) == 64, "header must stay one cache line");
+
+    struct stColumnBlock
+    {
+        std::uint32_t field;    // client_data_structure::enClientField
+        std::uint32_t encoding; // enColumnEncoding
+        std::uint64_t offset;   // From the start of the file
+        std::uint64_t bytes;
+        std::uint64_t checksum; // h_hash::checksum_64 of the block
+    };
+    static_assert(sizeof(stColumnBlock) == 32, "directory entries are packed");
+
+    constexpr std::uint64_t SNAPSHOT_MAGIC = 0x313050414e534353ull; // "SCSNAP01"
+    // 2: the int64 block holds parse_minor_units of the balance text (1.005 -> 101).
+    constexpr std::uint32_t SNAPSHOT_VERSION = 2;
+    // 4 string columns + account_balance as float64 + account_balance as int64 minor units.
+    constexpr std::size_t COLUMN_BLOCKS = 6;
+
+#pragma region clsSnapshotFile
+    /**
+     * @brief Read side: the snapshot mapped read-only, with zero-copy row access.
+     *
+     * @details
+     * open() costs O(1) regardless of the row count: it maps the file and checks the
+     * header, the directory checksum, the block bounds and the data file stamp. It does not
+     * touch the blocks. row() and balances_minor() read straight from the mapping, so a
+     * caller that only needs a few rows or one column never pays for the rest. verify()
+     * checks every block checksum (O(file size)); callers that materialize every record
+     * anyway (load_clients) run it first.
+     *
+     * @note Read-only after open(); concurrent reads are fine. Row views stay valid while
+     *       the object stays open.
+     */
+#pragma endregion clsSnapshotFile
+    class clsSnapshotFile
+    {
+    public:
+        // Maps @p snapshot_path; false if missing, malformed or stale for @p data_file_path.
+        bool open(const std::filesystem::path& snapshot_path, const std::filesystem::path& data_file_path) noexcept;
+
+        bool is_open() const noexcept { return _mapping.is_open(); }
+        std::size_t size() const noexcept { return _rows; }
+        // Operation log bytes already applied to the rows (0 = the data file alone).
+        std::uint64_t log_offset() const noexcept { return _log_offset; }
+
+        // True if every block matches its checksum.
+        bool verify() const noexcept;
+
+        // Row i as views into the mapping (@p i < size()).
+        client_table::stClientRow row(std::size_t i) const noexcept;
+
+        // The exact balance column, mapped.
+        std::span<const std::int64_t> balances_minor() const noexcept { return { _balances_minor, _rows }; }
+
+        std::vector<client_data_structure::stClientData> to_records() const;
+        client_table::clsClientTable to_table() const;
+
+    private:
+        struct stStringColumn
+        {
+            const std::uint32_t* codes = nullptr; // nullptr for plain columns
+            const std::uint64_t* offsets = nullptr;
+            const char* bytes = nullptr;
+            std::uint64_t entries = 0;   // Offsets hold entries + 1 values
+            std::uint64_t byte_count = 0;
+
+            std::string_view get(std::size_t row) const noexcept;
+        };
+
+        bool bind_string_column(const stColumnBlock& block, stStringColumn& column) const noexcept;
+
+        platform_ops_map::clsMappedFile _mapping;
+        std::size_t _rows = 0;
+        std::uint64_t _log_offset = 0;
+        std::array<stStringColumn, client_table::clsClientTable::STRING_FIELDS> _strings{};
+        const double* _balances = nullptr;
+        const std::int64_t* _balances_minor = nullptr;
+    };
+
+#pragma region Writing
+    /**
+     * @brief Write side, split so the O(n) part runs outside the data lock.
+     *
+     * @details
+     * - prepare_snapshot_file writes the snapshot of @p records (rows with delete_mark are
+     *   left out, as in file_ops::write_clients_temp) to a per-process temp file next to
+     *   @p snapshot_path, covering the first @p log_offset bytes of the operation log.
+     *   The data file stamp is still zero.
+     * - publish_snapshot_file stamps it with the current size/mtime of @p data_file_path
+     *   and renames it over @p snapshot_path. Call it right after the data file itself was
+     *   replaced, under the same exclusive lock. It never throws: on failure the temp file
+     *   is removed and the old snapshot, now stale, stays behind for readers to skip.
+     * - write_snapshot_file does both, for a data file that is already in place. A
+     *   checkpoint publishes the same way under the shared lock: the data file does not
+     *   change, and two writers at the same version write the same rows.
+     *
+     * @throws std::runtime_error (prepare, write) if the temp file cannot be written.
+     */
+#pragma endregion Writing
+    struct stPreparedSnapshot
+    {
+        std::filesystem::path temp_path;
+        stSnapshotHeader header{};
+        std::array<stColumnBlock, COLUMN_BLOCKS> directory{};
+    };
+
+    stPreparedSnapshot prepare_snapshot_file(const std::filesystem::path& snapshot_path,
+        const std::vector<client_data_structure::stClientData>& records, std::uint64_t log_offset = 0);
+    bool publish_snapshot_file(stPreparedSnapshot& prepared, const std::filesystem::path& snapshot_path,
+        const std::filesystem::path& data_file_path) noexcept;
+    void write_snapshot_file(const std::filesystem::path& snapshot_path,
+        const std::vector<client_data_structure::stClientData>& records,
+        const std::filesystem::path& data_file_path);
+
+#pragma region load_clients
+    /**
+     * @brief Start-up load of the data file, from the snapshot when it can be trusted.
+     *
+     * @details
+     * If @p snapshot_path is current for @p data_file_path and verify() passes, the records
+     * are copied out of the mapped columns: no text parsing at all. Otherwise the CSV is
+     * parsed (file_ops::load_clients_parallel) and a fresh snapshot is written for the next
+     * start. If that write fails (e.g. read-only directory), the CSV result is still
+     * returned.
+     *
+     * With @p log_offset, a checkpoint is accepted too: the rows then already include the
+     * first *log_offset bytes of the operation log, and the caller replays only the rest.
+     * Without it, a checkpoint is skipped (and left in place) and the CSV is parsed.
+     *
+     * @return The records of the data file plus the first *log_offset log bytes (0 when
+     *         parsed from the CSV), in file order.
+     */
+#pragma endregion load_clients
+    std::vector<client_data_structure::stClientData> load_clients(const std::filesystem::path& data_file_path,
+        const std::filesystem::path& snapshot_path, std::uint64_t* log_offset = nullptr);
+}
@@ -1,7 +1,10 @@
 // client_data_app/include/services/convert/h_convert/h_convert.h
 #pragma once
+#include <cstddef>
+#include <string>
 #include <string_view>
 #include <vector>
+#include "infrastructure.h"
 
 
 namespace h_convert {
@@ -10,12 +13,11 @@ namespace h_convert {
      * @brief Detects all occurrences of a delimiter within a string view.
      * 
      * @details
-     * This function performs a linear scan of the `str` looking for the `delim` sequence.
-     * It uses a manual sliding comparison logic:
-     * 1. Iterates through valid start positions in `str`.
-     * 2. Checks if the substring matches `delim` character-by-character.
-     * 3. If a match is found, records the index and jumps the iterator by `delim.length()` to avoid checks inside the found delimiter.
-     * 4. If no match, advances by one character.
+     * Finds every non-overlapping match of `delim` in `str`, scanning left to right: once a
+     * match is recorded the scan resumes right after it, so "#//#//#" yields only index 0.
+     * The work is done by the fastest kernel the running CPU supports (AVX2, then SSE2, then
+     * the scalar loop). The kernel is picked once, on the first call, via
+     * platform_ops_cpu::has_avx2()/has_sse2(); every kernel produces identical results.
      * 
      * @param str The string to search through.
      * @param delim The delimiter string to look for.
@@ -23,4 +25,65 @@ namespace h_convert {
      */
 #pragma endregion Detection
     void detect_delim(std::string_view str, std::string_view delim, std::vector<short>& indexes);
-} 
\ No newline at end of file
+
+#pragma region Detection kernels
+    /**
+     * @brief The individual kernels behind detect_delim, exposed for testing and benchmarking.
+     *
+     * @details
+     * - detect_delim_scalar: manual sliding comparison. Checks the first character before
+     *   the inner loop, and on a match jumps by `delim.length()`.
+     * - detect_delim_sse2 / detect_delim_avx2: compare 16 / 32 candidate start positions at
+     *   once. One vector compare tests the delimiter's first byte and a second, shifted
+     *   compare tests its last byte. For `#//#` that alone is a strong filter. The few
+     *   surviving bits then get their middle bytes checked with memcmp, and the
+     *   non-overlap rule is applied in bit order. Whatever is left at the end (shorter
+     *   than one vector) goes through the scalar loop.
+     *
+     * @warning detect_delim_avx2 must only be called when platform_ops_cpu::has_avx2() is
+     *          true, and detect_delim_sse2 only when has_sse2() is true. On non-x86 builds
+     *          both forward to the scalar kernel.
+     */
+#pragma endregion Detection kernels
+    void detect_delim_scalar(std::string_view str, std::string_view delim, std::vector<short>& indexes);
+    void detect_delim_sse2(std::string_view str, std::string_view delim, std::vector<short>& indexes);
+    void detect_delim_avx2(std::string_view str, std::string_view delim, std::vector<short>& indexes);
+
+#pragma region Conversion
+    /**
+     * @brief Parses one record line into a stClientData.
+     * 
+     * @details
+     * Splits `line` on infrastructure_names::SEPARATOR with detect_delim (so it rides the SIMD
+     * kernels) and assigns the columns in client_data_structure::enClientField order. The
+     * balance is parsed with std::from_chars, so it does not depend on the locale and needs
+     * no temporary string. `delete_mark` is reset to false.
+     * The separator positions go into a thread_local scratch vector. Parsing millions of
+     * lines therefore allocates only for the four string members, and several threads may
+     * call this at the same time.
+     * 
+     * @param line   One line of the data file, without its '\n'.
+     * @param record [Output] Receives the parsed fields. Left unspecified when false is returned.
+     * @return true if the line has exactly FIELD_COUNT columns and a numeric balance; false otherwise.
+     */
+#pragma endregion Conversion
+    bool convert_line_to_record(std::string_view line, client_data_structure::stClientData& record);
+
+    /**
+     * @brief Serializes a record into one data-file line (the inverse of convert_line_to_record).
+     * 
+     * @details
+     * Appends the columns in enClientField order, joined by infrastructure_names::SEPARATOR,
+     * to `out`. No '\n' is appended. The balance is written with std::to_chars in its shortest
+     * round-trip form, so parsing the line back gives the exact same double. Appending into a
+     * caller-owned string lets bulk writers reuse a single buffer. `delete_mark` is not
+     * serialized.
+     * 
+     * @param record The record to serialize.
+     * @param out    [Output] String the line is appended to.
+     */
+    void append_record_line(const client_data_structure::stClientData& record, std::string& out);
+
+    // Convenience wrapper around append_record_line that returns a fresh string.
+    std::string convert_record_to_line(const client_data_structure::stClientData& record);
+} 
@@ -0,0 +1,66 @@
+// client_data_app/include/services/generator/client_generator.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+
+namespace client_generator {
+    enum class enBalanceDistribution
+    {
+        uniform, // Every value in [balance_min_minor, balance_max_minor] equally likely
+        skewed,  // Most balances near the minimum, a long tail of large ones (u^4 scaling)
+    };
+
+    struct stGeneratorOptions
+    {
+        std::uint64_t rows = 10'000;
+        std::uint64_t seed = 1;
+        std::size_t name_length_min = 4;   // Name length in letters, inclusive range
+        std::size_t name_length_max = 24;
+        enBalanceDistribution balance_distribution = enBalanceDistribution::uniform;
+        std::int64_t balance_min_minor = -100'000;   // -1000.00
+        std::int64_t balance_max_minor = 10'000'000; // 100000.00
+        double duplicate_ratio = 0.0;      // Share of rows that reuse an earlier account number
+        unsigned thread_count = 0;         // Blocks per round; 0 = std::thread::hardware_concurrency()
+    };
+
+#pragma region Row generation
+    /**
+     * @brief Builds synthetic rows in the real `#//#` record format.
+     * 
+     * @details
+     * Every row draws from its own generator, seeded from (seed, row). A row's bytes
+     * therefore depend only on the options and its row number, never on the thread count
+     * or the order rows are made in, so the same options give the same file everywhere.
+     * The random numbers come from splitmix64 with hand-written scaling, because the
+     * std:: distributions are allowed to differ between standard libraries.
+     * - generated_account_number: "AC" + 10 digits. Row i gets 1000000000 + i, so account
+     *   numbers are unique unless a row is picked as a duplicate.
+     * - append_generated_line: appends row `row` (without '\n') to out. With probability
+     *   duplicate_ratio a row after the first reuses the account number of an earlier row.
+     *   Names are one capitalised word of name_length_min..name_length_max letters.
+     */
+#pragma endregion Row generation
+    std::string generated_account_number(std::uint64_t row);
+    void append_generated_line(const stGeneratorOptions& options, std::uint64_t row, std::string& out);
+
+#pragma region generate_clients_file
+    /**
+     * @brief Writes options.rows generated rows to file_path, in parallel.
+     * 
+     * @details
+     * Rows are cut into blocks of 64K. Each round, thread_count blocks are formatted as
+     * tasks on platform_ops_scheduler::default_scheduler(), then the round is written in
+     * row order. Memory stays at about thread_count blocks no matter how large the file is.
+     * The file is written next to file_path as "<name>.tmp" and renamed into place, so a
+     * reader never sees a partial file.
+     * 
+     * @return Number of bytes written.
+     * @throws std::invalid_argument for inverted ranges or a ratio outside [0, 1].
+     * @throws std::runtime_error if the temp file cannot be created or written.
+     */
+#pragma endregion generate_clients_file
+    std::uint64_t generate_clients_file(const std::filesystem::path& file_path, const stGeneratorOptions& options);
+}
@@ -0,0 +1,76 @@
+// client_data_app/include/services/hash/h_hash.h
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+
+namespace h_hash {
+#pragma region fnv1a_64
+    /**
+     * @brief 64-bit FNV-1a hash of a byte string.
+     * 
+     * @details
+     * Used for on-disk structures (index sidecars, Bloom filters), so the value must be
+     * identical on every build and platform. std::hash gives no such guarantee.
+     * FNV-1a is byte-at-a-time, which is fine for short keys like account numbers.
+     * 
+     * @param key The bytes to hash.
+     * @return The 64-bit hash.
+     */
+#pragma endregion fnv1a_64
+    constexpr std::uint64_t fnv1a_64(std::string_view key) noexcept
+    {
+        std::uint64_t hash = 14695981039346656037ull; // FNV offset basis
+        for (char c : key)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull; // FNV prime
+        }
+        return hash;
+    }
+
+    // Final avalanche step (from MurmurHash3) for when the low bits of a hash are used as
+    // a table index: FNV-1a alone mixes the last bytes of a key poorly into the low bits.
+    constexpr std::uint64_t mix_64(std::uint64_t hash) noexcept
+    {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+#pragma region checksum_64
+    /**
+     * @brief 64-bit checksum of a large block, 8 bytes per step.
+     * 
+     * @details
+     * For on-disk blocks that are megabytes long (the columnar snapshot), where
+     * byte-at-a-time FNV-1a would dominate the cost of reading them. Each little-endian
+     * 64-bit word is folded in with a multiply and a rotate, then mix_64 avalanches the
+     * result. The tail and the length are folded in too, so a truncated or extended block
+     * never keeps its checksum. It detects corruption and is not a cryptographic hash.
+     * 
+     * @param bytes The block.
+     * @return The checksum; identical on every build of a little-endian platform.
+     */
+#pragma endregion checksum_64
+    inline std::uint64_t checksum_64(std::string_view bytes) noexcept
+    {
+        constexpr std::uint64_t prime = 0x9e3779b97f4a7c15ull;
+        std::uint64_t hash = 14695981039346656037ull ^ (bytes.size() * prime);
+        std::size_t i = 0;
+        for (; i + 8 <= bytes.size(); i += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes.data() + i, sizeof(word));
+            hash = std::rotl((hash ^ word) * prime, 29);
+        }
+        for (; i < bytes.size(); ++i)
+            hash = (hash ^ static_cast<unsigned char>(bytes[i])) * 1099511628211ull;
+        return mix_64(hash);
+    }
+}
@@ -0,0 +1,133 @@
+// client_data_app/include/services/index/account_filter/account_filter.h
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "file_ops/op_log/op_log.h"
+#include "infrastructure.h"
+#include "platform_ops/map/map.h"
+
+
+namespace account_filter {
+#pragma region On-disk layout
+    /**
+     * @brief Layout of the account filter sidecar (ACCOUNT_FILTER_FILE_NAME).
+     *
+     * @details
+     * [stFilterHeader][std::uint8_t counter x counter_count], native endianness,
+     * memory-mapped as is.
+     * - A counting Bloom filter: a key sets hash_count counters, picked by double hashing
+     *   of the mixed FNV-1a hash of the account number. An 8-bit counter instead of a bit
+     *   lets a delete take the key back out.
+     * - Sized for `capacity` keys at FALSE_POSITIVE_RATE (about 9.6 counters and 7 probes
+     *   per key at 1%). count tracks the keys actually in it; past capacity the filter is
+     *   rebuilt bigger.
+     * - A counter that reaches 255 stays there. Never decrementing it can only cause a
+     *   false positive, never a false negative.
+     * - data_version is the data_lock version whose clients the counters describe. If it
+     *   is not the version the caller is working with, the filter says nothing.
+     */
+#pragma endregion On-disk layout
+    struct stFilterHeader
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t hash_count;
+        std::uint64_t counter_count;
+        std::uint64_t capacity;
+        std::uint64_t count;
+        std::uint64_t data_version;
+        std::uint64_t padding[2];
+    };
+    static_assert(sizeof(stFilterHeader) == 64, "header must stay one cache line");
+
+    constexpr std::uint64_t FILTER_MAGIC = 0x314d4f4c42414353ull; // "SCABLOM1"
+    constexpr std::uint32_t FILTER_VERSION = 1;
+    constexpr double FALSE_POSITIVE_RATE = 0.01;
+
+#pragma region clsAccountFilter
+    /**
+     * @brief Persistent "is this account number definitely unused?" check.
+     *
+     * @details
+     * possibly_contains() answers false only for an account number that no client has.
+     * Then an add can skip the exact duplicate check, which otherwise needs the whole data
+     * file and log. A true answer is a possible hit (about 1% of new numbers are false
+     * positives), and only that case falls back to the exact check.
+     *
+     * The filter is kept current by the writers themselves: attach() registers it as the
+     * clsOpLog commit observer, so every add inserts and every delete erases the account
+     * number, under the same exclusive lock as the commit. Each process maps the same
+     * file, so they all see each other's updates. An update that arrives for a version
+     * other than data_version() + 1 is dropped. The filter then just stays stale until
+     * open_current() rebuilds it.
+     *
+     * @note A delete must name an existing client (every writer checks that first).
+     *       Erasing a key that was never inserted could produce false negatives.
+     * @note Not thread-safe for writers; concurrent possibly_contains() calls are fine.
+     */
+#pragma endregion clsAccountFilter
+    class clsAccountFilter
+    {
+    public:
+        /**
+         * @brief Maps an existing sidecar read-write.
+         * @return false if it is missing or not a valid filter file (nothing is built).
+         */
+        bool open(const std::filesystem::path& filter_file_path) noexcept;
+        void close() noexcept { _filter.close(); }
+
+        bool is_open() const noexcept { return _filter.is_open(); }
+        const std::filesystem::path& file_path() const noexcept { return _filter_file_path; }
+
+        std::uint64_t size() const noexcept;
+        std::uint64_t capacity() const noexcept;
+        std::uint64_t data_version() const noexcept;
+
+        // True if the filter is open and describes exactly @p version.
+        bool is_current(std::uint64_t version) const noexcept;
+
+        // True once more keys were inserted than the filter was sized for.
+        bool is_overfull() const noexcept;
+
+        // false: no client has @p account_number. true: maybe (also when not open).
+        bool possibly_contains(std::string_view account_number) const noexcept;
+
+        void insert(std::string_view account_number) noexcept;
+        void erase(std::string_view account_number) noexcept;
+
+        // Applies committed log entries (add -> insert, remove -> erase) if the filter
+        // is at new_version - 1, then stamps new_version; otherwise leaves it stale.
+        void apply(std::span<const op_log::stLogEntry> entries, std::uint64_t new_version) noexcept;
+
+        // Flush dirty filter pages to disk.
+        bool flush() noexcept { return _filter.flush(); }
+
+    private:
+        stFilterHeader* header() const noexcept;
+        std::uint8_t* counters() const noexcept;
+
+        std::filesystem::path _filter_file_path;
+        platform_ops_map::clsMappedFile _filter;
+    };
+
+    // Writes a fresh sidecar holding the account numbers of @p records, stamped with
+    // @p data_version and sized for at least @p min_capacity keys.
+    void build_filter_file(const std::filesystem::path& filter_file_path,
+        const std::vector<client_data_structure::stClientData>& records,
+        std::uint64_t data_version, std::uint64_t min_capacity = 0);
+
+    /**
+     * @brief Opens @p filter, rebuilding it first from operation_log.load() if it is
+     *        missing, corrupt, overfull or stamped with another version.
+     * @return true if it had to load (and so rebuild).
+     * @throws whatever clsOpLog::load or build_filter_file throw.
+     */
+    bool open_current(clsAccountFilter& filter, const std::filesystem::path& filter_file_path,
+        op_log::clsOpLog& operation_log);
+
+    // Registers @p filter as the commit observer of @p operation_log (see apply()).
+    void attach(clsAccountFilter& filter, op_log::clsOpLog& operation_log);
+}
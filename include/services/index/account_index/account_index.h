@@ -0,0 +1,140 @@
+// client_data_app/include/services/index/account_index/account_index.h
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include "infrastructure.h"
+#include "platform_ops/map/map.h"
+
+
+namespace account_index {
+#pragma region On-disk layout
+    /**
+     * @brief Layout of the account index sidecar (ACCOUNT_INDEX_FILE_NAME).
+     *
+     * @details
+     * [stIndexHeader][stIndexSlot x capacity], native endianness, memory-mapped as is.
+     * - Open addressing with linear probing over a power-of-two table kept at most half full,
+     *   so a lookup usually reads a single slot. One slot is 16 bytes, so 256 share a page.
+     * - stIndexSlot::hash is the mixed FNV-1a hash of the account number, with EMPTY_SLOT
+     *   and DELETED_SLOT reserved (real hashes are nudged past them).
+     * - stIndexSlot::offset is the byte offset of the record's line in the data file. Keys are
+     *   not stored: a hit is confirmed against the data file itself. That makes the second
+     *   page touch.
+     * - count is the live slots, tombstones the DELETED_SLOT ones. Both end a probe chain
+     *   only at an EMPTY_SLOT, so insert() rehashes once count + tombstones passes half the
+     *   capacity: at twice the size if the live slots alone need it, else at the same size
+     *   just to clear the tombstones.
+     * - data_file_size / data_file_mtime snapshot the data file the index describes. If
+     *   either differs when the index is opened, it is stale and is rebuilt.
+     */
+#pragma endregion On-disk layout
+    struct stIndexHeader
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t reserved;
+        std::uint64_t capacity;
+        std::uint64_t count;
+        std::uint64_t tombstones;
+        std::uint64_t data_file_size;
+        std::int64_t data_file_mtime;
+        std::uint64_t padding;
+    };
+    static_assert(sizeof(stIndexHeader) == 64, "header must stay one cache line");
+
+    struct stIndexSlot
+    {
+        std::uint64_t hash;
+        std::uint64_t offset;
+    };
+
+    constexpr std::uint64_t INDEX_MAGIC = 0x3158444943414353ull; // "SCACIDX1"
+    constexpr std::uint32_t INDEX_VERSION = 2;
+    constexpr std::uint64_t EMPTY_SLOT = 0;
+    constexpr std::uint64_t DELETED_SLOT = 1;
+
+#pragma region clsAccountIndex
+    /**
+     * @brief Persistent O(1) lookup from account_number to the record's position in the data file.
+     * 
+     * @details
+     * open() maps the sidecar read-write. It first builds (or rebuilds) the sidecar from the
+     * data file when it is missing, corrupt or stale. The build is one pass over
+     * file_ops::get_all_clients_indexed, so it reuses the structural index and never parses
+     * balances. Writers keep it current:
+     * - after appending a record line to the data file: insert(account, offset)
+     * - after removing one in place: erase(account)
+     * - after a full rewrite (save_all_clients, op_log fold): rebuild(). op_log builds the
+     *   index of the new data file before publishing it instead (prepare_index_file). The
+     *   size/mtime check in open() also catches rewrites made by another process.
+     * Lookups only see what is in the data file. Entries still pending in the operation log
+     * must be checked by the caller first (the log is the newer layer).
+     *
+     * @note Not thread-safe for writers; concurrent find() calls are fine.
+     */
+#pragma endregion clsAccountIndex
+    class clsAccountIndex
+    {
+    public:
+        /**
+         * @brief Maps (building first if needed) the index for @p data_file_path.
+         * @return true on success; false if the data file or the sidecar cannot be opened.
+         * @throws std::bad_alloc / std::filesystem::filesystem_error while rebuilding.
+         */
+        bool open(const std::filesystem::path& data_file_path, const std::filesystem::path& index_file_path);
+
+        bool is_open() const noexcept { return _index.is_open(); }
+        std::uint64_t size() const noexcept;
+        std::uint64_t capacity() const noexcept;
+
+        // Byte offset of the record line for @p account_number, if indexed.
+        std::optional<std::uint64_t> find(std::string_view account_number) const;
+
+        // find() plus parsing the line it points at; false if absent or unparsable.
+        bool find_record(std::string_view account_number, client_data_structure::stClientData& record) const;
+
+        // Record that a line for @p account_number now starts at @p offset (insert or move).
+        void insert(std::string_view account_number, std::uint64_t offset);
+
+        // Forget @p account_number; returns whether it was indexed.
+        bool erase(std::string_view account_number);
+
+        // Recreate the sidecar from the current data file.
+        void rebuild();
+
+        // Flush dirty index pages to disk.
+        bool flush() noexcept { return _index.flush(); }
+
+    private:
+        stIndexHeader* header() const noexcept;
+        stIndexSlot* slots() const noexcept;
+        bool remap_data() noexcept;
+        bool matches(std::uint64_t offset, std::string_view account_number) const noexcept;
+        void stamp_data_file();
+        bool rehash(std::uint64_t new_capacity);
+
+        std::filesystem::path _data_file_path;
+        std::filesystem::path _index_file_path;
+        platform_ops_map::clsMappedFile _data;
+        platform_ops_map::clsMappedFile _index;
+    };
+
+    // Writes a fresh sidecar for @p data_file_path with at least @p min_capacity slots.
+    void build_index_file(const std::filesystem::path& data_file_path, const std::filesystem::path& index_file_path,
+        std::uint64_t min_capacity = 0);
+
+    /**
+     * @brief Builds the index of @p new_data_file_path, a data file about to be renamed over
+     *        the one @p index_file_path describes, beside @p index_file_path.
+     * @details Renaming keeps the size and mtime of the data file, so the stamp still holds
+     *          once publish_index_file() renames this index into place too.
+     * @return The prepared file, for publish_index_file().
+     */
+    std::filesystem::path prepare_index_file(const std::filesystem::path& new_data_file_path,
+        const std::filesystem::path& index_file_path);
+
+    // Renames @p prepared over @p index_file_path; false (the old index is then stale) if it fails.
+    bool publish_index_file(const std::filesystem::path& prepared, const std::filesystem::path& index_file_path) noexcept;
+}
@@ -0,0 +1,121 @@
+// client_data_app/include/services/index/balance_index/balance_index.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <vector>
+#include "infrastructure.h"
+#include "platform_ops/map/map.h"
+
+
+namespace balance_index {
+#pragma region On-disk layout
+    /**
+     * @brief Layout of the balance index sidecar (BALANCE_INDEX_FILE_NAME).
+     *
+     * @details
+     * [stBalanceHeader][std::int64_t key x (count + 1)][std::uint64_t rank x (count + 1)]
+     * [std::uint64_t posting x count], native endianness, memory-mapped as is.
+     * - Postings are the byte offsets of the record lines in the data file, sorted by
+     *   balance (exact minor units, balance::parse_minor_units), ties in file order.
+     * - key[1..count] is the same sorted balance column in Eytzinger (BFS) order: the
+     *   children of slot k are 2k and 2k + 1, slot 0 is unused. A search descends with
+     *   no branch to mispredict, and the next levels share cache lines, so it can be
+     *   prefetched several steps ahead. rank[k] maps slot k back to its sorted position.
+     * - data_file_size / data_file_mtime snapshot the data file the index describes. If
+     *   either differs when the index is opened, it is stale and is rebuilt.
+     */
+#pragma endregion On-disk layout
+    struct stBalanceHeader
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t reserved;
+        std::uint64_t count;
+        std::uint64_t data_file_size;
+        std::int64_t data_file_mtime;
+        std::uint64_t padding[3];
+    };
+    static_assert(sizeof(stBalanceHeader) == 64, "header must stay one cache line");
+
+    constexpr std::uint64_t BALANCE_INDEX_MAGIC = 0x3158444942414353ull; // "SCABIDX1"
+    constexpr std::uint32_t BALANCE_INDEX_VERSION = 1;
+
+    // Overdrawn means strictly below zero.
+    constexpr std::int64_t OVERDRAWN_MAX_MINOR = -1;
+
+#pragma region clsBalanceIndex
+    /**
+     * @brief Persistent sorted (balance, record offset) index for balance range queries.
+     *
+     * @details
+     * open() maps the sidecar read-only. It first builds (or rebuilds) the sidecar from the
+     * data file when it is missing, corrupt or stale. find_range() makes two Eytzinger
+     * searches (O(log n)) and returns the matching postings as one contiguous span, so a
+     * query costs O(log n + k) for k matches.
+     *
+     * The data file only changes when it is rewritten (save_all_clients, op_log fold),
+     * and that moves every offset anyway, so the size/mtime check in open() rebuilds the
+     * index then. Changes still in the operation log are applied on top of the results by
+     * the caller (find_client_controller::find_clients_by_balance does).
+     *
+     * @note Read-only after open(); concurrent lookups are fine.
+     */
+#pragma endregion clsBalanceIndex
+    class clsBalanceIndex
+    {
+    public:
+        /**
+         * @brief Maps (building first if needed) the balance index for @p data_file_path.
+         * @return true on success; false if the data file or the sidecar cannot be opened.
+         * @throws std::bad_alloc / std::runtime_error / std::filesystem::filesystem_error
+         *         while rebuilding.
+         */
+        bool open(const std::filesystem::path& data_file_path, const std::filesystem::path& index_file_path);
+
+        bool is_open() const noexcept { return _index.is_open(); }
+        std::uint64_t size() const noexcept;
+
+        // Number of indexed balances < @p minor (the sorted position of the first >= minor).
+        std::uint64_t lower_rank(std::int64_t minor) const noexcept;
+        // Number of indexed balances <= @p minor.
+        std::uint64_t upper_rank(std::int64_t minor) const noexcept;
+
+        // Offsets of every record with low <= balance <= high (minor units), by balance.
+        std::span<const std::uint64_t> find_range(std::int64_t low_minor, std::int64_t high_minor) const noexcept;
+
+        std::span<const std::uint64_t> find_overdrawn() const noexcept
+        {
+            return find_range(std::numeric_limits<std::int64_t>::min(), OVERDRAWN_MAX_MINOR);
+        }
+
+        // find_range() plus parsing the lines, at most @p limit of them (0 = all).
+        // Returns the number of records appended to @p records. If @p balances_minor is
+        // given, it gets each record's balance exactly as indexed (parse_minor_units of
+        // the text), which the record's double field cannot always give back.
+        std::size_t find_range_records(std::int64_t low_minor, std::int64_t high_minor,
+            std::vector<client_data_structure::stClientData>& records, std::size_t limit = 0,
+            std::vector<std::int64_t>* balances_minor = nullptr) const;
+
+        // Recreate the sidecar from the current data file.
+        void rebuild();
+
+    private:
+        const stBalanceHeader* header() const noexcept;
+        const std::int64_t* keys() const noexcept;
+        const std::uint64_t* ranks() const noexcept;
+        const std::uint64_t* postings() const noexcept;
+        template <bool Inclusive>
+        std::uint64_t search(std::int64_t minor) const noexcept;
+
+        std::filesystem::path _data_file_path;
+        std::filesystem::path _index_file_path;
+        platform_ops_map::clsMappedFile _data;
+        platform_ops_map::clsMappedFile _index;
+    };
+
+    // Writes a fresh sidecar for @p data_file_path.
+    void build_index_file(const std::filesystem::path& data_file_path, const std::filesystem::path& index_file_path);
+}
@@ -0,0 +1,130 @@
+// client_data_app/include/services/index/name_index/name_index.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "infrastructure.h"
+#include "platform_ops/map/map.h"
+
+
+namespace name_index {
+#pragma region On-disk layout
+    /**
+     * @brief Layout of the name index sidecar (NAME_INDEX_FILE_NAME).
+     *
+     * @details
+     * [stNameHeader][std::uint64_t posting x posting_count][stNameNode x node_count]
+     * [stNameEdge x edge_count][label bytes], native endianness, memory-mapped as is.
+     * - A radix trie (path-compressed: each edge carries a whole run of bytes) over the
+     *   folded names (fold_name). Node 0 is the root.
+     * - Postings are the byte offsets of the record lines in the data file, ordered by
+     *   folded name. Everything below a node is therefore one contiguous range
+     *   [posting_begin, posting_end), so a prefix lookup returns a span without a walk.
+     * - A node's edges are sorted by their first label byte and binary searched.
+     * - data_file_size / data_file_mtime snapshot the data file the index describes. If
+     *   either differs when the index is opened, it is stale and is rebuilt.
+     */
+#pragma endregion On-disk layout
+    struct stNameHeader
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t reserved;
+        std::uint64_t posting_count;
+        std::uint64_t node_count;
+        std::uint64_t edge_count;
+        std::uint64_t label_bytes;
+        std::uint64_t data_file_size;
+        std::int64_t data_file_mtime;
+    };
+    static_assert(sizeof(stNameHeader) == 64, "header must stay one cache line");
+
+    struct stNameNode
+    {
+        std::uint32_t first_edge;
+        std::uint32_t edge_count;
+        std::uint32_t posting_begin;
+        std::uint32_t posting_end;
+    };
+
+    struct stNameEdge
+    {
+        std::uint32_t label_offset;
+        std::uint32_t label_length;
+        std::uint32_t child;
+    };
+
+    constexpr std::uint64_t NAME_INDEX_MAGIC = 0x315844494d4e4353ull; // "SCNMIDX1"
+    constexpr std::uint32_t NAME_INDEX_VERSION = 1;
+
+    // Lookup key of a name: ASCII letters lowered, every other byte (UTF-8 included) as is.
+    std::string fold_name(std::string_view name);
+
+#pragma region clsNameIndex
+    /**
+     * @brief Persistent prefix and case-insensitive lookup from client name to record offsets.
+     *
+     * @details
+     * open() maps the sidecar read-only. It first builds (or rebuilds) the sidecar from the
+     * data file when it is missing, corrupt or stale. A lookup walks at most one edge per
+     * matched run of bytes, so its cost depends on the prefix length, not the row count.
+     *
+     * The trie is immutable. After the data file is rewritten (save_all_clients, op_log
+     * fold), the size/mtime check in open() rebuilds it. Entries still pending in the
+     * operation log are not in it: the caller applies the log on top of the results
+     * (find_client_controller::find_clients_by_name does).
+     *
+     * @note Read-only after open(); concurrent lookups are fine.
+     */
+#pragma endregion clsNameIndex
+    class clsNameIndex
+    {
+    public:
+        /**
+         * @brief Maps (building first if needed) the name index for @p data_file_path.
+         * @return true on success; false if the data file or the sidecar cannot be opened.
+         * @throws std::bad_alloc / std::runtime_error / std::filesystem::filesystem_error
+         *         while rebuilding.
+         */
+        bool open(const std::filesystem::path& data_file_path, const std::filesystem::path& index_file_path);
+
+        bool is_open() const noexcept { return _index.is_open(); }
+        std::uint64_t size() const noexcept;
+
+        // Offsets of every record whose name starts with @p prefix (case-insensitive),
+        // ordered by name. An empty prefix matches every record.
+        std::span<const std::uint64_t> find_prefix(std::string_view prefix) const;
+
+        // Offsets of every record whose whole name equals @p name (case-insensitive).
+        std::span<const std::uint64_t> find_exact(std::string_view name) const;
+
+        // find_prefix() plus parsing the lines, at most @p limit of them (0 = all).
+        // Returns the number of records appended to @p records.
+        std::size_t find_prefix_records(std::string_view prefix,
+            std::vector<client_data_structure::stClientData>& records, std::size_t limit = 0) const;
+
+        // Recreate the sidecar from the current data file.
+        void rebuild();
+
+    private:
+        const stNameHeader* header() const noexcept;
+        const std::uint64_t* postings() const noexcept;
+        const stNameNode* nodes() const noexcept;
+        const stNameEdge* edges() const noexcept;
+        const char* labels() const noexcept;
+        // Node under which every key starting with @p folded lives; false if none.
+        bool descend(std::string_view folded, stNameNode& node, bool& at_node) const noexcept;
+
+        std::filesystem::path _data_file_path;
+        std::filesystem::path _index_file_path;
+        platform_ops_map::clsMappedFile _data;
+        platform_ops_map::clsMappedFile _index;
+    };
+
+    // Writes a fresh sidecar for @p data_file_path.
+    void build_index_file(const std::filesystem::path& data_file_path, const std::filesystem::path& index_file_path);
+}
@@ -0,0 +1,119 @@
+// client_data_app/include/services/index/sidecar/sidecar.h
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include "platform_ops/map/map.h"
+
+
+namespace sidecar {
+#pragma region Sidecar files
+    /**
+     * @brief What every file derived from the data file (indexes, snapshot, filter) shares.
+     *
+     * @details
+     * - Stamp: the header records data_file_size / data_file_mtime of the data file it was
+     *   built from. is_current() compares them with the data file now; any rewrite of the
+     *   data file changes at least one, so the sidecar is then stale and gets rebuilt.
+     * - Publishing: write_file() writes the new sidecar to temp_path() and renames it into
+     *   place, so a crash never leaves half a sidecar and readers see the old or the new
+     *   file, never a mix. The temp name carries the process id: rebuilds run under the
+     *   shared data lock, so two processes may rebuild the same sidecar at once.
+     * - Opening: ensure_current() checks an existing sidecar (magic, version, geometry and
+     *   stamp, through the caller's check) and rebuilds it when missing or unusable.
+     */
+#pragma endregion Sidecar files
+    struct stDataStamp
+    {
+        std::uint64_t size = 0;
+        std::int64_t mtime = 0;
+    };
+
+    // Size and modification time of @p data_file_path; zeros if it cannot be read.
+    stDataStamp stamp_of(const std::filesystem::path& data_file_path) noexcept;
+
+    // @p file_path plus ".tmp.<process id>".
+    std::filesystem::path temp_path(const std::filesystem::path& file_path);
+
+    template <class Header>
+    void stamp(Header& header, const std::filesystem::path& data_file_path) noexcept
+    {
+        const stDataStamp current = stamp_of(data_file_path);
+        header.data_file_size = current.size;
+        header.data_file_mtime = current.mtime;
+    }
+
+    template <class Header>
+    bool is_current(const Header& header, const std::filesystem::path& data_file_path) noexcept
+    {
+        const stDataStamp current = stamp_of(data_file_path);
+        return header.data_file_size == current.size && header.data_file_mtime == current.mtime;
+    }
+
+    // Copies the header out of a mapped sidecar; false if the file is shorter than one.
+    template <class Header>
+    bool read_header(const platform_ops_map::clsMappedFile& file, Header& header) noexcept
+    {
+        if (!file.is_open() || file.size() < sizeof(Header))
+            return false;
+        std::memcpy(&header, file.data(), sizeof(header));
+        return true;
+    }
+
+    template <class T>
+    void write_array(std::ostream& out, const std::vector<T>& items)
+    {
+        out.write(reinterpret_cast<const char*>(items.data()),
+            static_cast<std::streamsize>(items.size() * sizeof(T)));
+    }
+
+    /**
+     * @brief Writes @p file_path through temp_path() and a rename; @p write fills the stream.
+     * @param what  Name for error messages, e.g. "the balance index".
+     * @throws std::runtime_error if the temp file cannot be written (it is removed);
+     *         std::filesystem::filesystem_error if the rename fails.
+     */
+    template <class Write>
+    void write_file(const std::filesystem::path& file_path, std::string_view what, Write write)
+    {
+        const std::filesystem::path temp = temp_path(file_path);
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+                throw std::runtime_error("Failed to create " + std::string(what) + ": " + temp.string());
+            write(out);
+            out.close();
+            if (out.fail())
+            {
+                std::error_code ignored;
+                std::filesystem::remove(temp, ignored);
+                throw std::runtime_error("Failed to write " + std::string(what) + ": " + temp.string());
+            }
+        }
+        std::filesystem::rename(temp, file_path);
+    }
+
+    /**
+     * @brief Calls @p build unless @p sidecar_path exists and @p is_usable accepts it.
+     * @param is_usable  bool(const platform_ops_map::clsMappedFile&) on the mapped sidecar.
+     * @throws whatever @p build throws.
+     */
+    template <class IsUsable, class Build>
+    void ensure_current(const std::filesystem::path& sidecar_path, IsUsable is_usable, Build build)
+    {
+        bool usable = false;
+        {
+            // Unmapped again before a rebuild can replace the file.
+            platform_ops_map::clsMappedFile existing;
+            usable = existing.open(sidecar_path) && is_usable(existing);
+        }
+        if (!usable)
+            build();
+    }
+}
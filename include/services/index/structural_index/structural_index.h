@@ -0,0 +1,70 @@
+// client_data_app/include/services/index/structural_index/structural_index.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+
+namespace structural_index {
+#pragma region stStructuralIndex Documentation
+    /**
+     * @brief Positions of every structural character in a whole data buffer, found in one pass.
+     *
+     * @details
+     * - offsets:   one flat, ascending array of 64-bit byte offsets. It holds every '\n' and
+     *              the first byte of every infrastructure_names::SEPARATOR. The kind of each
+     *              entry is not stored; read the byte at that offset ('\n' vs '#').
+     *              If the buffer does not end with '\n' but has a last line, one extra
+     *              entry equal to the buffer size closes that line.
+     * - row_ends:  for each row (line), the position inside `offsets` of the entry that ends it.
+     *              This makes row r's separators the entries between row_ends[r - 1] and
+     *              row_ends[r], so a field is found with offset arithmetic alone.
+     *
+     * Rows follow std::getline: no trailing '\n' in a row, blank lines are rows, and a
+     * trailing '\n' does not start an extra empty row.
+     */
+#pragma endregion
+    struct stStructuralIndex
+    {
+        std::vector<std::uint64_t> offsets;
+        std::vector<std::uint64_t> row_ends;
+    };
+
+#pragma region build_structural_index Documentation
+    /**
+     * @brief Walks @p buffer exactly once and records every newline and separator.
+     *
+     * @details
+     * Runs an AVX2 kernel when platform_ops_cpu::has_avx2() is true, otherwise a scalar loop.
+     * Per 32 bytes the kernel builds a newline bitmask and a separator bitmask (first and last
+     * byte compare, then a memcmp of the middle bytes for surviving bits). It emits both
+     * kinds in one ascending sweep over the combined mask. Separators follow the same
+     * non-overlapping rule as h_convert::detect_delim.
+     *
+     * @param buffer  The whole file contents (typically clsMappedFile::view()).
+     * @return stStructuralIndex describing @p buffer. Holds no pointer into it.
+     *
+     * @throws std::bad_alloc If the offset arrays cannot grow.
+     */
+#pragma endregion
+    stStructuralIndex build_structural_index(std::string_view buffer);
+
+    // Number of rows (lines) described by the index.
+    inline std::size_t row_count(const stStructuralIndex& index) noexcept { return index.row_ends.size(); }
+
+#pragma region Row access Documentation
+    /**
+     * @brief O(1) accessors over an index built from the same @p buffer.
+     *
+     * - get_row:         the full line, without its '\n'.
+     * - get_field_count: number of SEPARATOR-delimited fields in the row (separators + 1).
+     * - get_field:       the @p field_no-th field (0-based). Empty view if out of range.
+     *
+     * @warning @p row must be < row_count(index); @p buffer must be the one the index was built from.
+     */
+#pragma endregion
+    std::string_view get_row(const stStructuralIndex& index, std::string_view buffer, std::size_t row) noexcept;
+    std::size_t get_field_count(const stStructuralIndex& index, std::size_t row) noexcept;
+    std::string_view get_field(const stStructuralIndex& index, std::string_view buffer, std::size_t row, std::size_t field_no) noexcept;
+}
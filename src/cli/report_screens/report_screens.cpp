@@ -0,0 +1,36 @@
+#include "cli/report_screens/report_screens.h"
+#include <print> // Provides std::print (C++23) for formatted console output
+#include <string>
+
+namespace report_screens {
+namespace {
+// Exact "1234.50" text for a minor-unit amount; no double rounding on display.
+std::string format_amount(std::int64_t minor_units) {
+  std::string text;
+  balance::append_minor_units(minor_units, text);
+  return text;
+}
+} // namespace
+
+void show_portfolio_totals_screen(const balance::stPortfolioTotals &totals) {
+  std::print(
+      "=================================================================\n");
+  std::print(
+      "                     Portfolio Totals Report                     \n");
+  std::print(
+      "=================================================================\n");
+  std::print("          Clients            : {}\n", totals.client_count);
+  std::print("          Total balance      : {}\n",
+             format_amount(totals.total_minor));
+  if (totals.client_count > 0) {
+    std::print("          Lowest balance     : {}\n",
+               format_amount(totals.lowest_minor));
+    std::print("          Highest balance    : {}\n",
+               format_amount(totals.highest_minor));
+  }
+  std::print("          Overdrawn clients  : {}\n", totals.overdrawn_count);
+  std::print("          Zero-balance       : {}\n", totals.zero_count);
+  std::print(
+      "=================================================================\n\n");
+}
+} // namespace report_screens
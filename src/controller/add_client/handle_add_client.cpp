@@ -0,0 +1,76 @@
+// controller/add_client/handle_add_client.cpp
+
+#include "controller/add_client/handle_add_client.h"
+#include "controller/helper/h_data_store.h"
+#include "services/convert/h_convert/h_convert.h"
+#include <algorithm>
+#include <iostream>
+
+namespace add_client_controller {
+namespace {
+// Conflicts come from other processes committing at the same moment; a few
+// retries, each on fresh data, are enough for any realistic contention.
+constexpr int MAX_ATTEMPTS = 3;
+} // namespace
+
+stAddResult
+add_new_client(op_log::clsOpLog &operation_log,
+               account_filter::clsAccountFilter &filter,
+               const client_data_structure::stClientData &record) {
+  stAddResult result;
+  result.scanned = account_filter::open_current(filter, filter.file_path(),
+                                                operation_log);
+
+  if (filter.possibly_contains(record.account_number)) {
+    // Possible hit: confirm against the real data (data file + log).
+    // CPU: one full load; only ~1% of genuinely new numbers get here.
+    result.scanned = true;
+    const auto records = operation_log.load();
+    if (std::any_of(records.begin(), records.end(), [&](const auto &client) {
+          return client.account_number == record.account_number;
+        })) {
+      result.status = enAddStatus::duplicate;
+      return result;
+    }
+  }
+
+  // CPU: one small append; the attached filter inserts the account number
+  // under the same lock.
+  operation_log.append({op_log::enOperation::add, record});
+  result.status = enAddStatus::added;
+  return result;
+}
+
+int run_add_program(std::string_view record_line,
+                    const op_log::stSyncOptions &sync) {
+  client_data_structure::stClientData record{};
+  if (!h_convert::convert_line_to_record(record_line, record)) {
+    std::cerr << "ERR malformed client record\n";
+    return 1;
+  }
+
+  return h_controller::run_data_program([&](h_controller::clsDataStore &store) {
+    store.prepare_writes(sync);
+    op_log::clsOpLog &operation_log = store.operation_log();
+    for (int attempt = 1;; ++attempt) {
+      try {
+        const stAddResult result =
+            add_new_client(operation_log, store.account_filter(), record);
+        if (result.status == enAddStatus::duplicate) {
+          std::cerr << "ERR account " << record.account_number
+                    << " already exists\n";
+          return 1;
+        }
+        std::cout << "OK\n";
+        return 0;
+      } catch (const data_lock::clsVersionConflict &conflict) {
+        if (attempt == MAX_ATTEMPTS) {
+          std::cerr << "ERR " << conflict.what() << '\n';
+          return 1;
+        }
+        operation_log.load(); // Pick up the other process's commit
+      }
+    }
+  });
+}
+} // namespace add_client_controller
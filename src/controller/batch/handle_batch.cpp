@@ -0,0 +1,59 @@
+// controller/batch/handle_batch.cpp
+
+#include "controller/batch/handle_batch.h"
+#include "controller/helper/h_data_store.h"
+#include "controller/session/command_session.h"
+#include <iostream>
+#include <string>
+
+namespace batch_controller {
+stBatchResult run_batch(std::istream &script, std::ostream &out,
+                        std::ostream &err, op_log::clsOpLog &operation_log) {
+  stBatchResult result;
+  command_session::clsCommandSession session(operation_log);
+
+  std::string line;
+  std::string output; // Reused for find/list results
+  std::string error;
+  std::size_t line_number = 0;
+  while (std::getline(script, line)) {
+    ++line_number;
+    output.clear();
+    switch (session.execute(line, output, error)) {
+    case command_session::enCommandStatus::skipped:
+      continue;
+    case command_session::enCommandStatus::rejected:
+      err << "line " << line_number << ": " << error << '\n';
+      ++result.errors;
+      break;
+    case command_session::enCommandStatus::ok:
+      out << output;
+      break;
+    }
+    ++result.commands;
+  }
+
+  // Every mutation of the script goes out in one append (or one rewrite).
+  result.mutations = session.pending_mutations();
+  result.rewrote = session.commit();
+  return result;
+}
+
+int run_batch_program(std::istream &script,
+                      const op_log::stSyncOptions &sync) {
+  return h_controller::run_data_program([&](h_controller::clsDataStore &store) {
+    store.prepare_writes(sync);
+    try {
+      const stBatchResult result =
+          run_batch(script, std::cout, std::cerr, store.operation_log());
+      std::cout.flush();
+      return result.errors == 0 ? 0 : 1;
+    } catch (const data_lock::clsVersionConflict &conflict) {
+      // Fail fast: nothing of the batch was written; rerun it on fresh data.
+      std::cout.flush();
+      std::cerr << "batch not saved: " << conflict.what() << '\n';
+      return 1;
+    }
+  });
+}
+} // namespace batch_controller
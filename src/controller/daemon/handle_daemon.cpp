@@ -0,0 +1,424 @@
+// controller/daemon/handle_daemon.cpp
+
+#include "controller/daemon/handle_daemon.h"
+#include "controller/helper/h_data_store.h"
+#include "controller/session/command_session.h"
+#include "file_ops/compactor/compactor.h"
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+#ifdef __linux__
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace daemon_controller {
+#ifdef __linux__
+namespace {
+[[noreturn]] void throw_errno(const char *what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+struct stConnection {
+  std::string input;  // Bytes read but not yet ending in '\n'
+  std::string output;  // Replies not yet accepted by the kernel
+  std::string pending; // Replies held back until the open group commits
+  bool closing = false;
+  bool in_group = false;
+  std::size_t group_commands = 0; // Commands answered in the open group
+};
+
+// Arms (or, with 0, disarms) the one-shot group window timer.
+void set_timer(int timer_fd, std::chrono::microseconds delay) {
+  itimerspec spec{};
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(delay);
+  spec.it_value.tv_sec = static_cast<time_t>(seconds.count());
+  spec.it_value.tv_nsec = static_cast<long>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(delay - seconds)
+          .count());
+  ::timerfd_settime(timer_fd, 0, &spec, nullptr);
+}
+
+// Sends as much of output as the socket takes; false if the peer is gone.
+bool flush_output(int fd, stConnection &connection) {
+  while (!connection.output.empty()) {
+    const ssize_t sent = ::send(fd, connection.output.data(),
+                                connection.output.size(), MSG_NOSIGNAL);
+    if (sent > 0) {
+      connection.output.erase(0, static_cast<std::size_t>(sent));
+      continue;
+    }
+    if (sent == -1 && errno == EINTR)
+      continue;
+    return sent == -1 && (errno == EAGAIN || errno == EWOULDBLOCK);
+  }
+  return true;
+}
+
+clsDaemon *running_daemon = nullptr; // Target of the SIGINT/SIGTERM handler
+extern "C" void handle_stop_signal(int) {
+  if (running_daemon != nullptr)
+    running_daemon->stop();
+}
+} // namespace
+
+clsDaemon::clsDaemon(const std::filesystem::path &socket_path,
+                     op_log::clsOpLog &operation_log,
+                     std::chrono::microseconds group_window)
+    : _socket_path(socket_path), _operation_log(operation_log),
+      _group_window(group_window) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  const std::string native = _socket_path.string();
+  if (native.size() >= sizeof(address.sun_path))
+    throw std::runtime_error("Socket path is too long: " + native);
+  std::memcpy(address.sun_path, native.c_str(), native.size() + 1);
+
+  // A socket file left by a crashed daemon would make bind() fail; only
+  // ever remove a socket, never a regular file at that path.
+  struct stat existing{};
+  if (::lstat(native.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode))
+    ::unlink(native.c_str());
+
+  _listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (_listen_fd == -1)
+    throw_errno("socket");
+  _epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+  _wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  _timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  _compact_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (_epoll_fd == -1 || _wake_fd == -1 || _timer_fd == -1 ||
+      _compact_fd == -1) {
+    const int error = errno;
+    close_all();
+    throw std::system_error(error, std::generic_category(),
+                            "epoll/eventfd/timerfd");
+  }
+  if (::bind(_listen_fd, reinterpret_cast<const sockaddr *>(&address),
+             sizeof(address)) == -1) {
+    const int error = errno;
+    close_all();
+    throw std::system_error(error, std::generic_category(), "bind " + native);
+  }
+  _bound = true;
+  if (::listen(_listen_fd, SOMAXCONN) == -1) {
+    const int error = errno;
+    close_all();
+    throw std::system_error(error, std::generic_category(), "listen " + native);
+  }
+
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = _listen_fd;
+  ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _listen_fd, &event);
+  event.data.fd = _wake_fd;
+  ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wake_fd, &event);
+  event.data.fd = _timer_fd;
+  ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _timer_fd, &event);
+  event.data.fd = _compact_fd;
+  ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _compact_fd, &event);
+}
+
+clsDaemon::~clsDaemon() { close_all(); }
+
+void clsDaemon::close_all() noexcept {
+  if (_bound)
+    ::unlink(_socket_path.c_str()); // Only the socket this object created
+  _bound = false;
+  if (_listen_fd != -1)
+    ::close(_listen_fd);
+  if (_epoll_fd != -1)
+    ::close(_epoll_fd);
+  if (_wake_fd != -1)
+    ::close(_wake_fd);
+  if (_timer_fd != -1)
+    ::close(_timer_fd);
+  if (_compact_fd != -1)
+    ::close(_compact_fd);
+  _listen_fd = _epoll_fd = _wake_fd = _timer_fd = _compact_fd = -1;
+}
+
+void clsDaemon::stop() noexcept {
+  const std::uint64_t one = 1;
+  [[maybe_unused]] ssize_t written = ::write(_wake_fd, &one, sizeof(one));
+}
+
+void clsDaemon::run() {
+  // Memory: the whole client state stays resident between requests.
+  // Optional only so that a version conflict can replace it with a reload.
+  std::optional<command_session::clsCommandSession> session;
+  session.emplace(_operation_log, &_published);
+  std::unordered_map<int, stConnection> connections;
+  // Deletes are tombstones in the log; the data file is compacted by a task
+  // on the shared scheduler, which wakes this loop through _compact_fd.
+  compactor::clsCompactor compaction(_operation_log, [this] {
+    const std::uint64_t one = 1;
+    [[maybe_unused]] ssize_t written = ::write(_compact_fd, &one, sizeof(one));
+  });
+
+  auto close_connection = [&](int fd) {
+    ::epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections.erase(fd);
+  };
+
+  std::string output;
+  std::string error;
+  std::vector<epoll_event> events(64);
+  std::vector<int> grouped; // Connections with replies held by the open group
+  bool window_open = false;  // The timer runs for the group's first mutation
+  bool running = true;
+  while (running) {
+    const int ready = ::epoll_wait(_epoll_fd, events.data(),
+                                   static_cast<int>(events.size()), -1);
+    if (ready == -1) {
+      if (errno == EINTR)
+        continue;
+      throw_errno("epoll_wait");
+    }
+
+    bool window_elapsed = false;
+    bool closing_in_group = false;
+    for (int i = 0; i < ready; ++i) {
+      const int fd = events[i].data.fd;
+      if (fd == _wake_fd) {
+        running = false;
+        continue;
+      }
+      if (fd == _timer_fd) {
+        std::uint64_t expirations = 0;
+        [[maybe_unused]] ssize_t drained =
+            ::read(_timer_fd, &expirations, sizeof(expirations));
+        window_elapsed = true;
+        continue;
+      }
+      if (fd == _compact_fd) {
+        std::uint64_t signals = 0;
+        [[maybe_unused]] ssize_t drained =
+            ::read(_compact_fd, &signals, sizeof(signals));
+        continue; // finish_if_ready() below
+      }
+      if (fd == _listen_fd) {
+        // Level-triggered: accept what is queued now, the rest on the next wake.
+        int client;
+        while ((client = ::accept4(_listen_fd, nullptr, nullptr,
+                                   SOCK_NONBLOCK | SOCK_CLOEXEC)) != -1) {
+          epoll_event event{};
+          event.events = EPOLLIN | EPOLLRDHUP;
+          event.data.fd = client;
+          ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, client, &event);
+          connections.emplace(client, stConnection{});
+        }
+        continue;
+      }
+
+      auto found = connections.find(fd);
+      if (found == connections.end())
+        continue;
+      stConnection &connection = found->second;
+
+      if (events[i].events & EPOLLOUT) {
+        if (!flush_output(fd, connection)) {
+          close_connection(fd);
+          continue;
+        }
+        if (connection.output.empty()) {
+          if (connection.closing && !connection.in_group) {
+            close_connection(fd);
+            continue;
+          }
+          epoll_event event{};
+          event.events = EPOLLIN | EPOLLRDHUP;
+          event.data.fd = fd;
+          ::epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, fd, &event);
+        }
+      }
+      if (!(events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)))
+        continue;
+
+      // CPU: drain the socket in 64 KiB reads until it would block.
+      char buffer[1 << 16];
+      for (;;) {
+        const ssize_t received = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+          connection.input.append(buffer, static_cast<std::size_t>(received));
+          continue;
+        }
+        if (received == -1 && errno == EINTR)
+          continue;
+        if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+          connection.closing = true; // Peer closed (or failed): reply, then close
+        break;
+      }
+
+      std::size_t start = 0;
+      for (std::size_t newline;
+           (newline = connection.input.find('\n', start)) != std::string::npos;
+           start = newline + 1) {
+        output.clear();
+        const auto status = session->execute(
+            std::string_view(connection.input).substr(start, newline - start),
+            output, error);
+        if (status == command_session::enCommandStatus::skipped)
+          continue;
+        ++connection.group_commands;
+        connection.pending += output;
+        if (status == command_session::enCommandStatus::ok)
+          connection.pending += "OK\n";
+        else
+          connection.pending += "ERR " + error + '\n';
+      }
+      connection.input.erase(0, start);
+      if (connection.input.size() > MAX_LINE_BYTES) {
+        close_connection(fd);
+        continue;
+      }
+      if (!connection.in_group) {
+        connection.in_group = true;
+        grouped.push_back(fd);
+      }
+      closing_in_group = closing_in_group || connection.closing;
+    }
+
+    // Group commit: one append (or rewrite), and one fdatasync under the
+    // group sync policy, for everything the group received, before any of
+    // its replies leave the process. With a window, the group stays open
+    // that long after its first mutation so more clients can join it; a
+    // stop or a departing client ends it early.
+    if (session->pending_mutations() != 0) {
+      if (_group_window.count() > 0 && running && !window_elapsed &&
+          !closing_in_group) {
+        if (!window_open) {
+          set_timer(_timer_fd, _group_window);
+          window_open = true;
+        }
+        continue;
+      }
+      // Answers every command of the group ERR (the clients retry) and
+      // reloads the state from disk, dropping what the group staged.
+      auto fail_group = [&](const char *what) {
+        const std::string reply = std::string("ERR ") + what + '\n';
+        for (int fd : grouped) {
+          auto found = connections.find(fd);
+          if (found == connections.end())
+            continue;
+          stConnection &connection = found->second;
+          connection.pending.clear();
+          for (std::size_t k = 0; k < connection.group_commands; ++k)
+            connection.pending += reply;
+        }
+        session.emplace(_operation_log, &_published);
+      };
+      try {
+        session->commit();
+      } catch (const data_lock::clsVersionConflict &conflict) {
+        // Another process changed the data: nothing of this group was
+        // written.
+        fail_group(conflict.what());
+      } catch (const std::exception &failure) {
+        // A failed append, rewrite or sync (a full disk): the commit is
+        // unacknowledged, so the group is refused the same way and the
+        // daemon keeps serving.
+        fail_group(failure.what());
+      }
+    }
+    if (window_open) {
+      set_timer(_timer_fd, std::chrono::microseconds{0});
+      window_open = false;
+    }
+
+    for (int fd : grouped) {
+      auto found = connections.find(fd);
+      if (found == connections.end())
+        continue;
+      stConnection &connection = found->second;
+      connection.output += connection.pending;
+      connection.pending.clear();
+      connection.group_commands = 0;
+      connection.in_group = false;
+      if (!flush_output(fd, connection)) {
+        close_connection(fd);
+      } else if (!connection.output.empty()) {
+        epoll_event event{};
+        event.events = EPOLLOUT | EPOLLRDHUP;
+        event.data.fd = fd;
+        ::epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, fd, &event);
+      } else if (connection.closing) {
+        close_connection(fd);
+      }
+    }
+    grouped.clear();
+
+    // Both steps are short on this thread: a rename under the lock, or
+    // handing the next rewrite to the scheduler.
+    try {
+      compaction.finish_if_ready();
+      compaction.start_if_due();
+    } catch (const std::exception &failure) {
+      // The log still holds every entry; the next due check retries.
+      std::cerr << "compaction failed: " << failure.what() << '\n';
+    }
+  }
+
+  // Every group committed its mutations, so nothing is left staged here.
+  for (auto &[fd, connection] : connections)
+    ::close(fd);
+}
+
+int run_daemon_program(const std::filesystem::path &socket_path,
+                       const op_log::stSyncOptions &sync) {
+  return h_controller::run_data_program([&](h_controller::clsDataStore &store) {
+    try {
+      store.prepare_writes(sync);
+      clsDaemon server(socket_path.empty()
+                           ? store.data_file_path(
+                                 infrastructure_names::SOCKET_FILE_NAME)
+                           : socket_path,
+                       store.operation_log(), sync.group_window);
+      running_daemon = &server;
+      std::signal(SIGINT, handle_stop_signal);
+      std::signal(SIGTERM, handle_stop_signal);
+      std::cout << "listening on " << server.socket_path().string() << std::endl;
+      server.run();
+      running_daemon = nullptr;
+      return 0;
+    } catch (const std::exception &failure) {
+      running_daemon = nullptr;
+      std::cerr << "daemon stopped: " << failure.what() << '\n';
+      return 1;
+    }
+  });
+}
+#else
+clsDaemon::clsDaemon(const std::filesystem::path &socket_path,
+                     op_log::clsOpLog &operation_log,
+                     std::chrono::microseconds group_window)
+    : _socket_path(socket_path), _operation_log(operation_log),
+      _group_window(group_window) {
+  throw std::runtime_error("Daemon mode needs Linux (epoll)");
+}
+
+clsDaemon::~clsDaemon() = default;
+void clsDaemon::close_all() noexcept {}
+void clsDaemon::run() {}
+void clsDaemon::stop() noexcept {}
+
+int run_daemon_program(const std::filesystem::path &,
+                       const op_log::stSyncOptions &) {
+  std::cerr << "daemon mode needs Linux (epoll)\n";
+  return 1;
+}
+#endif
+} // namespace daemon_controller
@@ -0,0 +1,172 @@
+// controller/find_client/handle_find_client.cpp
+
+#include "controller/find_client/handle_find_client.h"
+#include "controller/helper/h_handle_file_exist.h"
+#include "file_ops/data_lock/data_lock.h"
+#include "file_ops/op_log/op_log.h"
+#include "platform_ops/paths/paths.h"
+#include "services/balance/balance.h"
+#include "services/convert/h_convert/h_convert.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace find_client_controller {
+std::vector<client_data_structure::stClientData>
+find_client_by_account(const account_index::clsAccountIndex &index,
+                       const std::filesystem::path &log_path,
+                       std::string_view account_number) {
+  std::vector<client_data_structure::stClientData> records;
+  // CPU: the log is only compared line by line on the account field, newest
+  // first; its last entry for the account is the client (or its delete).
+  op_log::stLogEntry entry{};
+  if (op_log::find_last_entry(log_path, account_number, entry)) {
+    if (entry.operation != op_log::enOperation::remove)
+      records.push_back(std::move(entry.record));
+    return records;
+  }
+
+  records.resize(1);
+  if (!index.find_record(account_number, records.front()))
+    records.clear();
+  return records;
+}
+
+std::vector<client_data_structure::stClientData>
+find_clients_by_name(const name_index::clsNameIndex &index,
+                     const std::filesystem::path &log_path,
+                     std::string_view prefix) {
+  std::vector<client_data_structure::stClientData> records;
+  index.find_prefix_records(prefix, records);
+
+  // CPU: O(matches + log entries); the log is bounded by the fold threshold.
+  if (op_log::replay(log_path, records) != 0) {
+    const std::string folded_prefix = name_index::fold_name(prefix);
+    std::erase_if(records, [&](const auto &record) {
+      return !name_index::fold_name(record.name).starts_with(folded_prefix);
+    });
+    std::stable_sort(records.begin(), records.end(),
+                     [](const auto &a, const auto &b) {
+                       return name_index::fold_name(a.name) <
+                              name_index::fold_name(b.name);
+                     });
+  }
+  return records;
+}
+
+std::vector<client_data_structure::stClientData>
+find_clients_by_balance(const balance_index::clsBalanceIndex &index,
+                        const std::filesystem::path &log_path,
+                        std::int64_t low_minor, std::int64_t high_minor) {
+  std::vector<client_data_structure::stClientData> records;
+  std::vector<std::int64_t> indexed_minor;
+  index.find_range_records(low_minor, high_minor, records, 0, &indexed_minor);
+
+  // Memory: account_number -> (balance, exact minor units) of every hit, so a
+  // client the log leaves alone keeps the units the index parsed from its text.
+  std::unordered_map<std::string, std::pair<double, std::int64_t>> indexed;
+  indexed.reserve(records.size());
+  for (std::size_t i = 0; i < records.size(); ++i)
+    indexed.emplace(records[i].account_number,
+                    std::pair{records[i].account_balance, indexed_minor[i]});
+
+  // CPU: O(matches + log entries); the log is bounded by the fold threshold.
+  if (op_log::replay(log_path, records) == 0)
+    return records;
+
+  // A client the log wrote holds the log line's balance; to_minor_units is
+  // parse_minor_units of that text (the shortest form of the double).
+  std::vector<std::pair<std::int64_t, std::size_t>> order; // (minor, position)
+  order.reserve(records.size());
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    auto hit = indexed.find(records[i].account_number);
+    const std::int64_t minor =
+        hit != indexed.end() && hit->second.first == records[i].account_balance
+            ? hit->second.second
+            : balance::to_minor_units(records[i].account_balance);
+    if (minor >= low_minor && minor <= high_minor)
+      order.emplace_back(minor, i);
+  }
+  std::stable_sort(order.begin(), order.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+
+  std::vector<client_data_structure::stClientData> matches;
+  matches.reserve(order.size());
+  for (const auto &[minor, i] : order)
+    matches.push_back(std::move(records[i]));
+  return matches;
+}
+
+namespace {
+// Shared by the query programs: start-up like start_program, then `query`
+// under the shared lock (no fold can swap the data file or empty the log
+// between the index lookup and the replay), then one record line per match.
+template <class Query>
+int run_query_program(Query query) {
+  std::filesystem::path exe_dir = platform_ops_paths::get_exe_dir_path();
+  h_controller::handle_file_exist(exe_dir);
+  const std::filesystem::path data_file_path =
+      platform_ops_paths::get_original_file_path(exe_dir);
+  const std::filesystem::path log_path = platform_ops_paths::get_data_file_path(
+      exe_dir, infrastructure_names::LOG_FILE_NAME);
+
+  std::vector<client_data_structure::stClientData> records;
+  data_lock::clsDataLock lock(platform_ops_paths::get_data_file_path(
+      exe_dir, infrastructure_names::LOCK_FILE_NAME));
+  lock.read_locked(
+      [&] { records = query(exe_dir, data_file_path, log_path); });
+
+  std::string line;
+  for (const auto &record : records) {
+    line.clear();
+    h_convert::append_record_line(record, line);
+    line.push_back('\n');
+    std::cout << line;
+  }
+  return records.empty() ? 1 : 0;
+}
+} // namespace
+
+int run_find_account_program(std::string_view account_number) {
+  return run_query_program([account_number](
+                               const std::filesystem::path &exe_dir,
+                               const std::filesystem::path &data_file_path,
+                               const std::filesystem::path &log_path) {
+    account_index::clsAccountIndex index;
+    if (!index.open(data_file_path,
+                    platform_ops_paths::get_data_file_path(
+                        exe_dir, infrastructure_names::ACCOUNT_INDEX_FILE_NAME)))
+      return std::vector<client_data_structure::stClientData>{};
+    return find_client_by_account(index, log_path, account_number);
+  });
+}
+
+int run_find_name_program(std::string_view prefix) {
+  return run_query_program([prefix](const std::filesystem::path &exe_dir,
+                                    const std::filesystem::path &data_file_path,
+                                    const std::filesystem::path &log_path) {
+    name_index::clsNameIndex index;
+    if (!index.open(data_file_path,
+                    platform_ops_paths::get_data_file_path(
+                        exe_dir, infrastructure_names::NAME_INDEX_FILE_NAME)))
+      return std::vector<client_data_structure::stClientData>{};
+    return find_clients_by_name(index, log_path, prefix);
+  });
+}
+
+int run_balance_range_program(std::int64_t low_minor, std::int64_t high_minor) {
+  return run_query_program([=](const std::filesystem::path &exe_dir,
+                               const std::filesystem::path &data_file_path,
+                               const std::filesystem::path &log_path) {
+    balance_index::clsBalanceIndex index;
+    if (!index.open(data_file_path,
+                    platform_ops_paths::get_data_file_path(
+                        exe_dir, infrastructure_names::BALANCE_INDEX_FILE_NAME)))
+      return std::vector<client_data_structure::stClientData>{};
+    return find_clients_by_balance(index, log_path, low_minor, high_minor);
+  });
+}
+} // namespace find_client_controller
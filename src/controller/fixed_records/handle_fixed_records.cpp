@@ -0,0 +1,165 @@
+// controller/fixed_records/handle_fixed_records.cpp
+
+#include "controller/fixed_records/handle_fixed_records.h"
+#include "controller/helper/h_data_store.h"
+#include "file_ops/data_lock/data_lock.h"
+#include "file_ops/op_log/op_log.h"
+#include "platform_ops/paths/paths.h"
+#include "services/balance/balance.h"
+#include "services/convert/h_convert/h_convert.h"
+#include <exception>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace fixed_records_controller {
+int run_convert_fixed_program() {
+  return h_controller::run_data_program([](h_controller::clsDataStore &store) {
+    op_log::clsOpLog &operation_log = store.operation_log();
+    const auto records = operation_log.load();
+    const std::uint64_t rows = fixed_records::convert_to_fixed(
+        records, store.data_file_path(infrastructure_names::FIXED_FILE_NAME),
+        {operation_log.version(), operation_log.log_size()});
+    std::cout << "OK " << rows << '\n';
+    return 0;
+  });
+}
+
+int run_page_program(std::uint64_t first, std::uint64_t count) {
+  std::filesystem::path exe_dir = platform_ops_paths::get_exe_dir_path();
+  fixed_records::clsFixedRecordFile file;
+  if (!file.open(platform_ops_paths::get_data_file_path(
+          exe_dir, infrastructure_names::FIXED_FILE_NAME))) {
+    std::cerr << "ERR no fixed-width file; run --to-fixed first\n";
+    return 1;
+  }
+
+  // Any commit since the conversion moved the version or the log on: the
+  // copy no longer matches the clients, so refuse it rather than serve it.
+  fixed_records::stFixedSource current;
+  try {
+    data_lock::clsDataLock lock(platform_ops_paths::get_data_file_path(
+        exe_dir, infrastructure_names::LOCK_FILE_NAME));
+    current.data_version = lock.read_locked([&] {
+      std::error_code ec;
+      const std::uintmax_t size = std::filesystem::file_size(
+          platform_ops_paths::get_data_file_path(
+              exe_dir, infrastructure_names::LOG_FILE_NAME),
+          ec);
+      current.log_size = ec ? 0 : size;
+    });
+  } catch (const std::exception &error) {
+    std::cerr << "ERR " << error.what() << '\n';
+    return 1;
+  }
+  if (file.source() != current) {
+    std::cerr << "ERR the fixed-width file is stale; run --to-fixed again\n";
+    return 1;
+  }
+
+  std::vector<client_data_structure::stClientData> records;
+  file.read_rows(first, count, records);
+  std::string out;
+  for (const auto &record : records) {
+    h_convert::append_record_line(record, out);
+    out.push_back('\n');
+  }
+  std::cout << out;
+  return 0;
+}
+
+namespace {
+// The commit-then-mirror sequence shared by the in-place changes: `entry` is
+// built from the live row and committed, then `write` changes the row.
+template <class MakeEntry, class Write>
+bool commit_fixed_change(op_log::clsOpLog &operation_log,
+                         fixed_records::clsFixedRecordFile &file,
+                         std::uint64_t row, MakeEntry make_entry, Write write,
+                         std::string &error) {
+  if (file.source() != fixed_records::stFixedSource{operation_log.version(),
+                                                    operation_log.log_size()}) {
+    error = "the fixed-width file is stale; run --to-fixed again";
+    return false;
+  }
+  client_data_structure::stClientData record{};
+  if (!file.read_row(row, record) || record.delete_mark) {
+    error = "no client at row " + std::to_string(row);
+    return false;
+  }
+
+  operation_log.append(make_entry(std::move(record)));
+  // I/O: the row, then (if commits are synced) one fdatasync so the new
+  // stamp never reaches the disk ahead of the row it vouches for.
+  if (!write() ||
+      (operation_log.sync_policy() != op_log::enSyncPolicy::none && !file.sync()) ||
+      !file.set_source({operation_log.version(), operation_log.log_size()})) {
+    error = "saved, but the fixed-width file could not be updated; run --to-fixed again";
+    return false;
+  }
+  return true;
+}
+
+template <class Change>
+int run_fixed_change_program(const op_log::stSyncOptions &sync, Change change) {
+  return h_controller::run_data_program([&](h_controller::clsDataStore &store) {
+    store.prepare_writes(sync, false);
+    fixed_records::clsFixedRecordFile file;
+    if (!file.open(store.data_file_path(infrastructure_names::FIXED_FILE_NAME),
+                   true)) {
+      std::cerr << "ERR no fixed-width file; run --to-fixed first\n";
+      return 1;
+    }
+    std::string error;
+    if (!change(store.operation_log(), file, error)) {
+      std::cerr << "ERR " << error << '\n';
+      return 1;
+    }
+    std::cout << "OK\n";
+    return 0;
+  });
+}
+} // namespace
+
+bool update_fixed_balance(op_log::clsOpLog &operation_log,
+                          fixed_records::clsFixedRecordFile &file,
+                          std::uint64_t row, std::int64_t balance_minor,
+                          std::string &error) {
+  return commit_fixed_change(
+      operation_log, file, row,
+      [&](client_data_structure::stClientData record) {
+        record.account_balance = balance::to_major_units(balance_minor);
+        return op_log::stLogEntry{op_log::enOperation::update, std::move(record)};
+      },
+      [&] { return file.update_balance(row, balance_minor); }, error);
+}
+
+bool delete_fixed_row(op_log::clsOpLog &operation_log,
+                      fixed_records::clsFixedRecordFile &file, std::uint64_t row,
+                      std::string &error) {
+  return commit_fixed_change(
+      operation_log, file, row,
+      [](client_data_structure::stClientData record) {
+        return op_log::stLogEntry{op_log::enOperation::remove, std::move(record)};
+      },
+      [&] { return file.mark_deleted(row); }, error);
+}
+
+int run_fixed_balance_program(std::uint64_t row, std::int64_t balance_minor,
+                              const op_log::stSyncOptions &sync) {
+  return run_fixed_change_program(
+      sync, [&](op_log::clsOpLog &operation_log,
+                fixed_records::clsFixedRecordFile &file, std::string &error) {
+        return update_fixed_balance(operation_log, file, row, balance_minor, error);
+      });
+}
+
+int run_fixed_delete_program(std::uint64_t row,
+                             const op_log::stSyncOptions &sync) {
+  return run_fixed_change_program(
+      sync, [&](op_log::clsOpLog &operation_log,
+                fixed_records::clsFixedRecordFile &file, std::string &error) {
+        return delete_fixed_row(operation_log, file, row, error);
+      });
+}
+} // namespace fixed_records_controller
@@ -0,0 +1,37 @@
+// controller/helper/h_data_store.cpp
+
+#include "controller/helper/h_data_store.h"
+#include "controller/helper/h_handle_file_exist.h"
+#include "platform_ops/paths/paths.h"
+
+namespace h_controller {
+namespace {
+// Ensures the data files before the operation log opens them.
+std::filesystem::path prepare_exe_dir() {
+  std::filesystem::path exe_dir = platform_ops_paths::get_exe_dir_path();
+  handle_file_exist(exe_dir);
+  return exe_dir;
+}
+} // namespace
+
+clsDataStore::clsDataStore()
+    : _exe_dir(prepare_exe_dir()),
+      _operation_log(platform_ops_paths::get_original_file_path(_exe_dir),
+                     platform_ops_paths::get_data_file_path(
+                         _exe_dir, infrastructure_names::LOG_FILE_NAME)) {}
+
+std::filesystem::path
+clsDataStore::data_file_path(std::string_view file_name) const {
+  return platform_ops_paths::get_data_file_path(_exe_dir, file_name);
+}
+
+void clsDataStore::prepare_writes(const op_log::stSyncOptions &sync,
+                                  bool fold) {
+  // A missing filter stays closed and ignores commits; --add builds it.
+  _filter.open(data_file_path(infrastructure_names::ACCOUNT_FILTER_FILE_NAME));
+  account_filter::attach(_filter, _operation_log);
+  _operation_log.set_sync_policy(sync.policy);
+  if (fold)
+    _operation_log.fold_if_due();
+}
+} // namespace h_controller
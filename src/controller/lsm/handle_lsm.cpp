@@ -0,0 +1,104 @@
+// controller/lsm/handle_lsm.cpp
+
+#include "controller/lsm/handle_lsm.h"
+#include "controller/helper/h_data_store.h"
+#include "services/convert/h_convert/h_convert.h"
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lsm_controller {
+namespace {
+// Conflicts come from other processes committing meanwhile; each retry
+// starts again from their state, as --add does.
+constexpr int MAX_ATTEMPTS = 3;
+} // namespace
+
+std::size_t ingest_clients(lsm::clsLsmStore &store, std::istream &input,
+                           std::size_t &malformed) {
+  std::vector<op_log::stLogEntry> batch;
+  batch.reserve(INGEST_BATCH);
+  std::size_t written = 0;
+  std::size_t line_number = 0;
+  std::string line;
+  while (std::getline(input, line)) {
+    ++line_number;
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (line.empty())
+      continue;
+    op_log::stLogEntry entry{op_log::enOperation::update, {}};
+    if (!h_convert::convert_line_to_record(line, entry.record)) {
+      std::cerr << "ERR line " << line_number << ": malformed client record\n";
+      ++malformed;
+      continue;
+    }
+    batch.push_back(std::move(entry));
+    if (batch.size() == INGEST_BATCH) {
+      store.apply(batch);
+      written += batch.size();
+      batch.clear();
+    }
+  }
+  store.apply(batch);
+  return written + batch.size();
+}
+
+std::size_t publish_staged(lsm::clsLsmStore &staging,
+                           op_log::clsOpLog &operation_log) {
+  // Memory: one record per distinct account; repeated lines of one account
+  // were already merged by the staging store.
+  const std::vector<client_data_structure::stClientData> staged = staging.load();
+  if (staged.empty())
+    return 0;
+
+  std::vector<op_log::stLogEntry> entries;
+  entries.reserve(staged.size());
+  for (int attempt = 1;; ++attempt) {
+    // CPU: O(clients + staged) once per ingest, however many lines it had.
+    auto current = operation_log.load();
+    std::unordered_map<std::string, std::size_t> positions;
+    positions.reserve(current.size() + staged.size());
+    for (std::size_t i = 0; i < current.size(); ++i)
+      positions.emplace(current[i].account_number, i);
+
+    // New accounts are adds, so the account filter learns them.
+    entries.clear();
+    for (const auto &record : staged) {
+      auto [found, inserted] =
+          positions.try_emplace(record.account_number, current.size());
+      if (inserted) {
+        entries.push_back({op_log::enOperation::add, record});
+        current.push_back(record);
+      } else {
+        entries.push_back({op_log::enOperation::update, record});
+        current[found->second] = record;
+      }
+    }
+    try {
+      operation_log.commit_batch(entries, current);
+      break;
+    } catch (const data_lock::clsVersionConflict &) {
+      if (attempt == MAX_ATTEMPTS)
+        throw;
+    }
+  }
+  staging.clear();
+  return entries.size();
+}
+
+int run_ingest_program(std::istream &input, const op_log::stSyncOptions &sync) {
+  return h_controller::run_data_program([&](h_controller::clsDataStore &store) {
+    store.prepare_writes(sync);
+    // Nothing staged is acknowledged: the commit to the operation log is the
+    // durable step, so the staging store never syncs.
+    lsm::clsLsmStore staging(store.exe_dir() / infrastructure_names::DATA_DIR_NAME);
+    staging.clear(); // Left by an ingest that never printed OK
+    std::size_t malformed = 0;
+    ingest_clients(staging, input, malformed);
+    std::cout << "OK " << publish_staged(staging, store.operation_log()) << '\n';
+    return malformed == 0 ? 0 : 1;
+  });
+}
+} // namespace lsm_controller
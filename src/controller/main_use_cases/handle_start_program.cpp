@@ -3,6 +3,7 @@
 #include "controller/main_use_cases/handle_start_program.h" // Declaration of start_program() function
 #include "cli/main_screens/main_screens.h" // Declaration of show_menu_screen()
 #include "controller/helper/h_handle_file_exist.h" // Declaration of handle_file_exist() helper
+#include "file_ops/op_log/op_log.h" // clsOpLog: pending add/update/delete log
 #include "platform_ops/paths/paths.h"
 #include "services/inputs/inputs.h"
 #include <iostream>
@@ -22,6 +23,15 @@ menu_options::enMenuOptions start_program() {
   // CPU: System calls (stat, mkdir, open) to check/create filesystem objects.
   h_controller::handle_file_exist(exe_dir);
 
+  // Fold the operation log into the data file if it has grown past its
+  // threshold. Memory: loads the records only when a fold is actually due.
+  // CPU: Otherwise just a stat() of the log and an open() in append mode.
+  op_log::clsOpLog operation_log(
+      platform_ops_paths::get_original_file_path(exe_dir),
+      platform_ops_paths::get_data_file_path(
+          exe_dir, infrastructure_names::LOG_FILE_NAME));
+  operation_log.fold_if_due();
+
   // Display the main menu options to the user.
   // Memory: Stack-allocated strings for menu text (const data section).
   // CPU: Outputs directly to stdout via std::print.
@@ -0,0 +1,49 @@
+// controller/report/handle_report.cpp
+
+#include "controller/report/handle_report.h"
+#include "cli/report_screens/report_screens.h"
+#include "controller/helper/h_data_store.h"
+#include "file_ops/data_lock/data_lock.h"
+#include "file_ops/op_log/op_log.h"
+#include "services/client_snapshot/client_snapshot.h"
+#include "services/client_table/client_table.h"
+#include <vector>
+
+namespace report_controller {
+balance::stPortfolioTotals portfolio_totals(
+    std::span<const client_data_structure::stClientData> records) {
+  // Memory: one dense int64 column, so the kernels run 4 balances per step.
+  std::vector<std::int64_t> balances;
+  balances.reserve(records.size());
+  for (const auto &record : records)
+    balances.push_back(balance::to_minor_units(record.account_balance));
+  return balance::compute_portfolio_totals(balances);
+}
+
+balance::stPortfolioTotals
+load_portfolio_totals(const std::filesystem::path &data_file_path,
+                      const std::filesystem::path &log_file_path) {
+  // The data file's balances are parsed straight from their text
+  // (load_client_table), so the column holds the same minor units as the
+  // balance index; the log entries are folded in on top.
+  client_snapshot::clsSnapshotTable table;
+  std::vector<op_log::stLogEntry> entries;
+  data_lock::clsDataLock lock(data_file_path.parent_path() /
+                              infrastructure_names::LOCK_FILE_NAME);
+  lock.read_locked([&] {
+    table.publish(client_table::load_client_table(data_file_path));
+    entries = op_log::read_entries(log_file_path);
+  });
+  table.apply(entries);
+  return balance::compute_portfolio_totals(table.read().table().balances_minor());
+}
+
+int run_totals_program() {
+  return h_controller::run_data_program([](h_controller::clsDataStore &store) {
+    report_screens::show_portfolio_totals_screen(
+        load_portfolio_totals(store.operation_log().data_file_path(),
+                              store.operation_log().log_file_path()));
+    return 0;
+  });
+}
+} // namespace report_controller
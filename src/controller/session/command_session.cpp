@@ -0,0 +1,163 @@
+// controller/session/command_session.cpp
+
+#include "controller/session/command_session.h"
+#include "services/convert/h_convert/h_convert.h"
+#include <utility>
+
+namespace command_session {
+namespace {
+// Splits "verb rest" at the first space; rest keeps any inner spaces (names).
+std::pair<std::string_view, std::string_view> split_command(std::string_view line) {
+  const std::size_t space = line.find(' ');
+  if (space == std::string_view::npos)
+    return {line, {}};
+  std::string_view rest = line.substr(space + 1);
+  while (!rest.empty() && rest.front() == ' ')
+    rest.remove_prefix(1);
+  return {line.substr(0, space), rest};
+}
+
+void append_record(const client_data_structure::stClientData &record,
+                   std::string &output) {
+  h_convert::append_record_line(record, output);
+  output.push_back('\n');
+}
+} // namespace
+
+clsCommandSession::clsCommandSession(op_log::clsOpLog &operation_log,
+                                     client_snapshot::clsSnapshotTable *published)
+    : _operation_log(operation_log), _published(published) {
+  // Memory: the whole client list, loaded once for the session.
+  // CPU: one parallel parse of the data file plus a replay of the log.
+  _records = _operation_log.load();
+  _positions.reserve(_records.size());
+  for (std::size_t i = 0; i < _records.size(); ++i)
+    _positions.emplace(_records[i].account_number, i);
+  if (_published != nullptr) {
+    client_table::clsClientTable table;
+    table.reserve(_records.size(), 0);
+    for (const auto &record : _records)
+      table.push_back(record);
+    _published->publish(std::move(table));
+  }
+}
+
+bool clsCommandSession::read_published(std::string_view verb,
+                                       std::string_view argument,
+                                       std::string &output, std::string &error,
+                                       enCommandStatus &status) const {
+  // Only while nothing is staged: the table holds committed state alone.
+  if (_published == nullptr || !_staged.empty() ||
+      (verb != "find" && verb != "list"))
+    return false;
+  // CPU: no lock; the pinned version stays valid whatever commits meanwhile.
+  const client_snapshot::clsReadView view = _published->read();
+  if (verb == "find") {
+    const auto row = view.find(argument);
+    if (!row) {
+      error = "account " + std::string(argument) + " not found";
+      status = enCommandStatus::rejected;
+      return true;
+    }
+    append_record(row->to_record(), output);
+  } else {
+    for (client_table::stClientRow row : view.table())
+      if (!row.delete_mark)
+        append_record(row.to_record(), output);
+  }
+  status = enCommandStatus::ok;
+  return true;
+}
+
+enCommandStatus clsCommandSession::execute(std::string_view line,
+                                           std::string &output,
+                                           std::string &error) {
+  if (!line.empty() && line.back() == '\r')
+    line.remove_suffix(1); // Scripts written on Windows
+  if (line.empty() || line.front() == '#')
+    return enCommandStatus::skipped;
+
+  auto reject = [&error](std::string reason) {
+    error = std::move(reason);
+    return enCommandStatus::rejected;
+  };
+
+  auto [verb, argument] = split_command(line);
+  if (enCommandStatus status; read_published(verb, argument, output, error, status))
+    return status;
+  if (verb == "add" || verb == "update") {
+    client_data_structure::stClientData record{};
+    if (!h_convert::convert_line_to_record(argument, record))
+      return reject("malformed client record");
+    auto found = _positions.find(record.account_number);
+    if (verb == "add") {
+      if (found != _positions.end())
+        return reject("account " + record.account_number + " already exists");
+      _positions.emplace(record.account_number, _records.size());
+      _records.push_back(record);
+      _staged.push_back({op_log::enOperation::add, std::move(record)});
+    } else {
+      if (found == _positions.end())
+        return reject("account " + record.account_number + " not found");
+      _records[found->second] = record;
+      _staged.push_back({op_log::enOperation::update, std::move(record)});
+    }
+    return enCommandStatus::ok;
+  }
+
+  if (verb == "delete") {
+    auto found = _positions.find(std::string(argument));
+    if (found == _positions.end())
+      return reject("account " + std::string(argument) + " not found");
+    // Marked, not erased, so the other positions stay valid;
+    // save_all_clients skips marked rows if the commit ends in a rewrite.
+    _records[found->second].delete_mark = true;
+    _positions.erase(found);
+    ++_deleted;
+    op_log::stLogEntry entry{op_log::enOperation::remove, {}};
+    entry.record.account_number = std::string(argument);
+    _staged.push_back(std::move(entry));
+    return enCommandStatus::ok;
+  }
+
+  if (verb == "find") {
+    auto found = _positions.find(std::string(argument));
+    if (found == _positions.end())
+      return reject("account " + std::string(argument) + " not found");
+    append_record(_records[found->second], output);
+    return enCommandStatus::ok;
+  }
+
+  if (verb == "list") {
+    for (const auto &record : _records)
+      if (!record.delete_mark)
+        append_record(record, output);
+    return enCommandStatus::ok;
+  }
+
+  return reject("unknown command '" + std::string(verb) + "'");
+}
+
+bool clsCommandSession::commit() {
+  const bool rewrote = _operation_log.commit_batch(_staged, _records);
+  if (_published != nullptr)
+    _published->apply(_staged); // One version per commit
+  _staged.clear();
+  if (_deleted * 2 > _records.size())
+    compact();
+  // The whole state is at hand here, so the next start-up can skip the log
+  // written so far. Best effort; the log alone is enough to recover.
+  if (!rewrote)
+    _operation_log.checkpoint_if_due(_records);
+  return rewrote;
+}
+
+void clsCommandSession::compact() {
+  // CPU: one pass to drop marked rows and one to rebuild the positions.
+  std::erase_if(_records, [](const auto &record) { return record.delete_mark; });
+  _positions.clear();
+  for (std::size_t i = 0; i < _records.size(); ++i)
+    _positions.emplace(_records[i].account_number, i);
+  _deleted = 0;
+}
+} // namespace command_session
@@ -0,0 +1,31 @@
+// src/file_ops/client_stream/client_stream.cpp
+#include "file_ops/client_stream/client_stream.h"
+#include "services/convert/h_convert/h_convert.h"
+
+namespace file_ops {
+clsClientStream::clsClientStream(const std::filesystem::path &file_path)
+    : _buffer(64 * 1024) {
+  // Memory: a 64 KiB stream buffer instead of the default ~8 KiB, so each
+  // read() system call moves more data. It must be installed before open().
+  _file.rdbuf()->pubsetbuf(_buffer.data(),
+                           static_cast<std::streamsize>(_buffer.size()));
+  _file.open(file_path, std::ios::binary);
+  // A failed open leaves the stream closed; begin() then equals end().
+}
+
+clsClientStream::iterator clsClientStream::begin() {
+  return advance() ? iterator(this) : iterator();
+}
+
+bool clsClientStream::advance() {
+  if (!_file.is_open())
+    return false;
+  // CPU: getline reuses _line's capacity, so after the first few lines no
+  // allocation happens except for the record's own string members.
+  while (std::getline(_file, _line)) {
+    if (h_convert::convert_line_to_record(_line, _current))
+      return true;
+  }
+  return false;
+}
+} // namespace file_ops
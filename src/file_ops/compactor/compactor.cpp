@@ -0,0 +1,47 @@
+// src/file_ops/compactor/compactor.cpp
+#include "file_ops/compactor/compactor.h"
+#include <utility>
+
+namespace compactor {
+clsCompactor::clsCompactor(op_log::clsOpLog &operation_log,
+                           std::function<void()> on_ready)
+    : _operation_log(operation_log), _on_ready(std::move(on_ready)) {}
+
+clsCompactor::~clsCompactor() {
+  _task.wait();
+  if (_job)
+    op_log::clsOpLog::discard_compaction(*_job);
+}
+
+bool clsCompactor::start_if_due() {
+  if (_job || !_operation_log.is_compaction_due())
+    return false;
+  _job = _operation_log.begin_compaction();
+  _failed = false;
+  _ready.store(false, std::memory_order_relaxed);
+  // CPU: the whole rewrite runs here, off the owner's thread, on the pool
+  // the loaders use too.
+  _task.run([this] {
+    try {
+      op_log::clsOpLog::prepare_compaction(*_job);
+    } catch (...) {
+      _failed = true; // Temp files already removed; retried later
+    }
+    _ready.store(true, std::memory_order_release);
+    if (_on_ready)
+      _on_ready();
+  });
+  return true;
+}
+
+bool clsCompactor::finish_if_ready() {
+  if (!_job || !_ready.load(std::memory_order_acquire))
+    return false;
+  // The task touches neither _job nor _failed after _ready.
+  op_log::stCompactionJob job = std::move(*_job);
+  _job.reset();
+  if (_failed)
+    return false;
+  return _operation_log.finish_compaction(job);
+}
+} // namespace compactor
@@ -0,0 +1,89 @@
+// src/file_ops/data_lock/data_lock.cpp
+#include "file_ops/data_lock/data_lock.h"
+#include <string>
+
+namespace data_lock {
+namespace {
+// Releases the lock on every exit path, including exceptions from callbacks.
+class clsLockScope {
+public:
+  clsLockScope(platform_ops_lock::clsFileLock &lock,
+               platform_ops_lock::enLockMode mode,
+               const std::filesystem::path &path)
+      : _lock(lock) {
+    if (!_lock.lock(mode))
+      throw std::runtime_error("Failed to lock " + path.string());
+  }
+  ~clsLockScope() { _lock.unlock(); }
+  clsLockScope(const clsLockScope &) = delete;
+  clsLockScope &operator=(const clsLockScope &) = delete;
+
+private:
+  platform_ops_lock::clsFileLock &_lock;
+};
+} // namespace
+
+clsVersionConflict::clsVersionConflict(std::uint64_t expected_version,
+                                       std::uint64_t actual_version)
+    : std::runtime_error("The data was changed by another process (version " +
+                         std::to_string(actual_version) + ", expected " +
+                         std::to_string(expected_version) + ")"),
+      _expected_version(expected_version), _actual_version(actual_version) {}
+
+clsDataLock::clsDataLock(const std::filesystem::path &lock_file_path)
+    : _lock_file_path(lock_file_path) {
+  if (!_lock.open(_lock_file_path))
+    throw std::runtime_error("Failed to open the lock file: " +
+                             _lock_file_path.string());
+}
+
+std::uint64_t clsDataLock::read_version() const {
+  std::uint64_t version = 0;
+  if (!_lock.read_stamp(version))
+    throw std::runtime_error("Failed to read the lock file: " +
+                             _lock_file_path.string());
+  return version;
+}
+
+std::uint64_t clsDataLock::read_locked(const std::function<void()> &read) {
+  clsLockScope scope(_lock, platform_ops_lock::enLockMode::shared,
+                     _lock_file_path);
+  const std::uint64_t version = read_version();
+  read();
+  return version;
+}
+
+bool clsDataLock::read_locked_if_current(std::uint64_t expected_version,
+                                         const std::function<void()> &read) {
+  clsLockScope scope(_lock, platform_ops_lock::enLockMode::shared,
+                     _lock_file_path);
+  if (read_version() != expected_version)
+    return false;
+  read();
+  return true;
+}
+
+std::uint64_t clsDataLock::current_version() {
+  return read_locked([] {});
+}
+
+std::uint64_t clsDataLock::commit(std::uint64_t expected_version,
+                                  const std::function<void()> &publish) {
+  clsLockScope scope(_lock, platform_ops_lock::enLockMode::exclusive,
+                     _lock_file_path);
+  const std::uint64_t version = read_version();
+  if (version != expected_version)
+    throw clsVersionConflict(expected_version, version);
+  publish();
+  if (!_lock.write_stamp(version + 1))
+    throw std::runtime_error("Failed to update the lock file: " +
+                             _lock_file_path.string());
+  return version + 1;
+}
+
+void clsDataLock::exclusive(const std::function<void()> &work) {
+  clsLockScope scope(_lock, platform_ops_lock::enLockMode::exclusive,
+                     _lock_file_path);
+  work();
+}
+} // namespace data_lock
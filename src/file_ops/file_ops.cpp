@@ -1,7 +1,35 @@
 // src/file_ops/file_ops.cpp
 #include "file_ops/file_ops.h"
+#include "platform_ops/lock/lock.h"
+#include "platform_ops/scheduler/scheduler.h"
+#include "services/convert/h_convert/h_convert.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
 namespace file_ops {
+namespace {
+// Parses every line in [begin, end) and appends valid records to out.
+// begin must be at a line start; end is either a line start or the file end.
+void parse_range(const char *begin, const char *end,
+                 std::vector<client_data_structure::stClientData> &out) {
+  // Memory: a record line is ~60 bytes; reserving avoids most regrowth.
+  out.reserve(static_cast<std::size_t>(end - begin) / 64);
+  client_data_structure::stClientData record{};
+  while (begin < end) {
+    const char *newline = static_cast<const char *>(
+        std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+    const char *line_end = newline != nullptr ? newline : end;
+    std::string_view line(begin, static_cast<std::size_t>(line_end - begin));
+    if (h_convert::convert_line_to_record(line, record))
+      out.push_back(std::move(record));
+    begin = newline != nullptr ? newline + 1 : end;
+  }
+}
+} // namespace
+
 std::vector<std::string>
 get_all_clients(const std::filesystem::path &file_path) {
   std::ifstream file(
@@ -31,4 +59,146 @@ get_all_clients(const std::filesystem::path &file_path) {
   // Memory: Vector copies/moves to caller; destructor cleans up 'file', 'line',
   // and local vector.
 }
+
+stMappedClients get_all_clients_mapped(const std::filesystem::path &file_path) {
+  stMappedClients result{};
+  if (!result.mapping.open(file_path))
+    return result; // Same silent failure as get_all_clients.
+
+  // Memory: one contiguous read-only view of the file; nothing is copied.
+  const char *cursor = result.mapping.data();
+  const char *end = cursor + result.mapping.size();
+
+  while (cursor < end) {
+    // CPU: memchr is vectorised in every mainstream libc, so the newline scan
+    // runs many bytes per cycle instead of one getline char at a time.
+    const char *newline = static_cast<const char *>(
+        std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+    const char *line_end = newline != nullptr ? newline : end;
+
+    // Memory: 16-byte view per line instead of a heap-allocated std::string.
+    result.lines.emplace_back(cursor,
+                              static_cast<std::size_t>(line_end - cursor));
+
+    // A last line without '\n' ends the loop here; a trailing '\n' does not
+    // produce an extra empty line, matching std::getline.
+    cursor = newline != nullptr ? newline + 1 : end;
+  }
+  return result;
+}
+
+stIndexedClients
+get_all_clients_indexed(const std::filesystem::path &file_path) {
+  stIndexedClients result{};
+  if (!result.mapping.open(file_path))
+    return result; // Same silent failure as get_all_clients.
+
+  // CPU: the only pass over the bytes; all later splitting reuses the index.
+  result.index = structural_index::build_structural_index(result.mapping.view());
+  return result;
+}
+
+std::vector<client_data_structure::stClientData>
+load_clients_parallel(const std::filesystem::path &file_path,
+                      unsigned thread_count) {
+  platform_ops_map::clsMappedFile mapping;
+  if (!mapping.open(file_path) || mapping.size() == 0)
+    return {}; // Same silent failure as get_all_clients.
+
+  if (thread_count == 0)
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+  // Below ~1 MiB per range the thread start-up costs more than it saves.
+  constexpr std::size_t MIN_RANGE_BYTES = 1 << 20;
+  const std::size_t size = mapping.size();
+  const std::size_t max_ranges = std::max<std::size_t>(1, size / MIN_RANGE_BYTES);
+  const std::size_t range_count =
+      std::min<std::size_t>(thread_count, max_ranges);
+
+  // Range k is [bounds[k], bounds[k + 1]); every inner bound is pushed forward
+  // to the byte after the next '\n' so each range starts on a line.
+  const char *data = mapping.data();
+  std::vector<const char *> bounds(range_count + 1);
+  bounds[0] = data;
+  bounds[range_count] = data + size;
+  for (std::size_t k = 1; k < range_count; ++k) {
+    const char *target = std::max(data + k * (size / range_count), bounds[k - 1]);
+    const char *newline = target < data + size
+                              ? static_cast<const char *>(std::memchr(
+                                    target, '\n',
+                                    static_cast<std::size_t>(data + size - target)))
+                              : nullptr;
+    bounds[k] = newline != nullptr ? newline + 1 : data + size;
+  }
+
+  std::vector<std::vector<client_data_structure::stClientData>> parts(
+      range_count);
+  // Ranges run as tasks on the shared scheduler; the calling thread helps
+  // while it waits, and the first exception is rethrown here.
+  platform_ops_scheduler::parallel_for(range_count, [&](std::size_t k) {
+    parse_range(bounds[k], bounds[k + 1], parts[k]);
+  });
+
+  // Join in file order; strings are moved, never copied.
+  std::size_t total = 0;
+  for (const auto &part : parts)
+    total += part.size();
+  std::vector<client_data_structure::stClientData> all_clients = std::move(parts[0]);
+  all_clients.reserve(total);
+  for (std::size_t k = 1; k < range_count; ++k)
+    std::move(parts[k].begin(), parts[k].end(), std::back_inserter(all_clients));
+  return all_clients;
+}
+
+std::filesystem::path write_clients_temp(
+    const std::filesystem::path &file_path,
+    const std::vector<client_data_structure::stClientData> &records,
+    std::string_view tag) {
+  // One temp file per process: concurrent writers prepare their rewrites
+  // side by side and only serialize on the final rename.
+  std::filesystem::path temp_path =
+      file_path.parent_path() / infrastructure_names::TEMP_FILE_NAME;
+  temp_path += "." + std::to_string(platform_ops_lock::current_process_id());
+  if (!tag.empty())
+    temp_path += "." + std::string(tag);
+
+  // Memory: 1 MiB stream buffer so a multi-GB rewrite issues few write()
+  // calls; it must be installed before open().
+  std::vector<char> buffer(1 << 20);
+  std::ofstream temp_file;
+  temp_file.rdbuf()->pubsetbuf(buffer.data(),
+                               static_cast<std::streamsize>(buffer.size()));
+  temp_file.open(temp_path, std::ios::binary | std::ios::trunc);
+  if (!temp_file.is_open())
+    throw std::runtime_error("Failed to create the temp file: " +
+                             temp_path.string());
+
+  std::string line; // Reused for every record; grows once
+  for (const auto &record : records) {
+    if (record.delete_mark)
+      continue;
+    line.clear();
+    h_convert::append_record_line(record, line);
+    line.push_back('\n');
+    temp_file.write(line.data(), static_cast<std::streamsize>(line.size()));
+  }
+
+  temp_file.close(); // Flush before the rename makes it visible
+  if (temp_file.fail()) {
+    std::error_code ignored;
+    std::filesystem::remove(temp_path, ignored);
+    throw std::runtime_error("Failed to write the temp file: " +
+                             temp_path.string());
+  }
+  return temp_path;
+}
+
+void save_all_clients(
+    const std::filesystem::path &file_path,
+    const std::vector<client_data_structure::stClientData> &records) {
+  const std::filesystem::path temp_path = write_clients_temp(file_path, records);
+  // rename() replaces file_path in one step (MoveFileEx with
+  // MOVEFILE_REPLACE_EXISTING on Windows).
+  std::filesystem::rename(temp_path, file_path);
+}
 } // namespace file_ops
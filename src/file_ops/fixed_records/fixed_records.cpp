@@ -0,0 +1,264 @@
+// src/file_ops/fixed_records/fixed_records.cpp
+#include "file_ops/fixed_records/fixed_records.h"
+#include "services/balance/balance.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace fixed_records {
+namespace {
+constexpr std::uint32_t align_8(std::uint32_t value) noexcept {
+  return (value + 7u) & ~7u;
+}
+
+const std::string &text_field(const client_data_structure::stClientData &record,
+                              std::size_t k) noexcept {
+  switch (k) {
+  case 0:
+    return record.account_number;
+  case 1:
+    return record.pass_code;
+  case 2:
+    return record.phone_no;
+  default:
+    return record.name;
+  }
+}
+
+std::string &text_field(client_data_structure::stClientData &record,
+                        std::size_t k) noexcept {
+  return const_cast<std::string &>(
+      text_field(static_cast<const client_data_structure::stClientData &>(record), k));
+}
+
+// One record as stored; false if a value does not fit its width (refused,
+// never truncated). Shared by the converter and the in-place writers.
+bool encode(const stFixedLayout &layout,
+            const client_data_structure::stClientData &record,
+            std::vector<char> &bytes) {
+  bytes.assign(layout.record_size, '\0');
+  for (std::size_t k = 0; k < layout.widths.size(); ++k) {
+    const std::string &text = text_field(record, k);
+    if (text.size() > layout.widths[k])
+      return false;
+    std::memcpy(bytes.data() + layout.field_offsets[k], text.data(), text.size());
+  }
+  const std::int64_t minor = balance::to_minor_units(record.account_balance);
+  std::memcpy(bytes.data() + layout.balance_offset, &minor, sizeof(minor));
+  bytes[layout.flags_offset] =
+      static_cast<char>(record.delete_mark ? FLAG_DELETED : 0);
+  return true;
+}
+} // namespace
+
+stFixedLayout make_layout(const std::array<std::uint16_t, 4> &widths) noexcept {
+  stFixedLayout layout;
+  layout.widths = widths;
+  std::uint32_t offset = 0;
+  for (std::size_t k = 0; k < widths.size(); ++k) {
+    layout.field_offsets[k] = offset;
+    offset += widths[k];
+  }
+  // The balance is 8-byte aligned inside the record, and so inside the file
+  // (the header and every record_size are multiples of 8).
+  layout.balance_offset = align_8(offset);
+  layout.flags_offset = layout.balance_offset + sizeof(std::int64_t);
+  layout.record_size = align_8(layout.flags_offset + sizeof(std::uint8_t));
+  return layout;
+}
+
+std::array<std::uint16_t, 4> fit_widths(
+    const std::vector<client_data_structure::stClientData> &records) {
+  std::array<std::uint16_t, 4> widths = DEFAULT_WIDTHS;
+  for (const auto &record : records) {
+    if (record.delete_mark)
+      continue;
+    for (std::size_t k = 0; k < widths.size(); ++k) {
+      const std::size_t length = text_field(record, k).size();
+      if (length > UINT16_MAX)
+        throw std::runtime_error(
+            "A field of client " + record.account_number + " is " +
+            std::to_string(length) + " bytes, too long for the fixed-width format");
+      if (length > widths[k])
+        widths[k] = static_cast<std::uint16_t>(length);
+    }
+  }
+  return widths;
+}
+
+bool clsFixedRecordFile::open(const std::filesystem::path &file_path,
+                              bool writable) noexcept {
+  _header = {};
+  if (!_file.open(file_path, writable ? platform_ops_file_io::enOpenMode::read_write
+                                      : platform_ops_file_io::enOpenMode::read_only))
+    return false;
+  stFixedHeader header{};
+  if (!_file.read_at(0, &header, sizeof(header)) || header.magic != FIXED_MAGIC ||
+      header.version != FIXED_VERSION) {
+    _file.close();
+    return false;
+  }
+  _layout = make_layout(header.widths);
+  if (header.record_size != _layout.record_size ||
+      _file.size() < sizeof(stFixedHeader) + header.row_count * _layout.record_size) {
+    _file.close();
+    return false;
+  }
+  _header = header;
+  return true;
+}
+
+void clsFixedRecordFile::decode(const char *bytes,
+                                client_data_structure::stClientData &record) const {
+  for (std::size_t k = 0; k < _layout.widths.size(); ++k) {
+    const char *field = bytes + _layout.field_offsets[k];
+    const void *end = std::memchr(field, '\0', _layout.widths[k]);
+    text_field(record, k).assign(
+        field, end ? static_cast<const char *>(end) - field : _layout.widths[k]);
+  }
+  std::int64_t minor = 0;
+  std::memcpy(&minor, bytes + _layout.balance_offset, sizeof(minor));
+  record.account_balance = balance::to_major_units(minor);
+  record.delete_mark =
+      (static_cast<std::uint8_t>(bytes[_layout.flags_offset]) & FLAG_DELETED) != 0;
+}
+
+bool clsFixedRecordFile::read_row(std::uint64_t row,
+                                  client_data_structure::stClientData &record) const {
+  if (row >= _header.row_count)
+    return false;
+  std::vector<char> bytes(_layout.record_size);
+  if (!_file.read_at(row_offset(row), bytes.data(), bytes.size()))
+    return false;
+  decode(bytes.data(), record);
+  return true;
+}
+
+std::uint64_t clsFixedRecordFile::read_rows(
+    std::uint64_t first, std::uint64_t count,
+    std::vector<client_data_structure::stClientData> &records) const {
+  if (first >= _header.row_count)
+    return 0;
+  if (count > _header.row_count - first)
+    count = _header.row_count - first;
+  // I/O: the whole page in one pread, wherever it starts.
+  std::vector<char> bytes(static_cast<std::size_t>(count * _layout.record_size));
+  if (!_file.read_at(row_offset(first), bytes.data(), bytes.size()))
+    return 0;
+  client_data_structure::stClientData record{};
+  for (std::uint64_t i = 0; i < count; ++i) {
+    decode(bytes.data() + i * _layout.record_size, record);
+    if (!record.delete_mark)
+      records.push_back(record);
+  }
+  return count;
+}
+
+bool clsFixedRecordFile::unstamp() {
+  if (_header.source_version == UNSTAMPED_VERSION)
+    return true; // Already: every later write is one pwrite
+  const std::uint64_t version = UNSTAMPED_VERSION;
+  if (!_file.write_at(offsetof(stFixedHeader, source_version), &version,
+                      sizeof(version)))
+    return false;
+  _header.source_version = version;
+  return true;
+}
+
+bool clsFixedRecordFile::set_source(const stFixedSource &source) {
+  static_assert(offsetof(stFixedHeader, source_log_size) ==
+                    offsetof(stFixedHeader, source_version) + sizeof(std::uint64_t),
+                "the stamp is one contiguous write");
+  const std::uint64_t stamp[2] = {source.data_version, source.log_size};
+  if (!_file.write_at(offsetof(stFixedHeader, source_version), stamp,
+                      sizeof(stamp)))
+    return false;
+  _header.source_version = source.data_version;
+  _header.source_log_size = source.log_size;
+  return true;
+}
+
+bool clsFixedRecordFile::write_row(std::uint64_t row,
+                                   const client_data_structure::stClientData &record) {
+  std::vector<char> bytes;
+  return row < _header.row_count && encode(_layout, record, bytes) &&
+         unstamp() && _file.write_at(row_offset(row), bytes.data(), bytes.size());
+}
+
+bool clsFixedRecordFile::update_balance(std::uint64_t row,
+                                        std::int64_t balance_minor) {
+  return row < _header.row_count && unstamp() &&
+         _file.write_at(row_offset(row) + _layout.balance_offset, &balance_minor,
+                        sizeof(balance_minor));
+}
+
+bool clsFixedRecordFile::mark_deleted(std::uint64_t row) {
+  const std::uint8_t flags = FLAG_DELETED;
+  return row < _header.row_count && unstamp() &&
+         _file.write_at(row_offset(row) + _layout.flags_offset, &flags,
+                        sizeof(flags));
+}
+
+std::int64_t clsFixedRecordFile::append_row(
+    const client_data_structure::stClientData &record) {
+  std::vector<char> bytes;
+  const std::uint64_t row = _header.row_count;
+  if (!encode(_layout, record, bytes) || !unstamp() ||
+      !_file.write_at(row_offset(row), bytes.data(), bytes.size()))
+    return -1;
+  // The row counts only once the record is complete.
+  const std::uint64_t rows = row + 1;
+  if (!_file.write_at(offsetof(stFixedHeader, row_count), &rows, sizeof(rows)))
+    return -1;
+  _header.row_count = rows;
+  return static_cast<std::int64_t>(row);
+}
+
+std::uint64_t convert_to_fixed(
+    const std::vector<client_data_structure::stClientData> &records,
+    const std::filesystem::path &fixed_file_path, const stFixedSource &source) {
+  const stFixedLayout layout = make_layout(fit_widths(records));
+  stFixedHeader header{};
+  header.magic = FIXED_MAGIC;
+  header.version = FIXED_VERSION;
+  header.record_size = layout.record_size;
+  header.widths = layout.widths;
+  header.source_version = source.data_version;
+  header.source_log_size = source.log_size;
+
+  std::filesystem::path temp_path = fixed_file_path;
+  temp_path += ".tmp";
+  // Memory: 1 MiB stream buffer, as in file_ops::write_clients_temp.
+  std::vector<char> buffer(1 << 20);
+  std::ofstream out;
+  out.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  out.open(temp_path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open())
+    throw std::runtime_error("Failed to create the fixed-width file: " +
+                             temp_path.string());
+
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  std::vector<char> bytes;
+  for (const auto &record : records) {
+    if (record.delete_mark)
+      continue;
+    encode(layout, record, bytes); // fit_widths made every value fit
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    ++header.row_count;
+  }
+  // row_count last, as for an append.
+  out.seekp(static_cast<std::streamoff>(offsetof(stFixedHeader, row_count)));
+  out.write(reinterpret_cast<const char *>(&header.row_count), sizeof(header.row_count));
+  out.close();
+  if (out.fail()) {
+    std::error_code ignored;
+    std::filesystem::remove(temp_path, ignored);
+    throw std::runtime_error("Failed to write the fixed-width file: " +
+                             temp_path.string());
+  }
+  std::filesystem::rename(temp_path, fixed_file_path);
+  return header.row_count;
+}
+} // namespace fixed_records
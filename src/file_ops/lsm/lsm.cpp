@@ -0,0 +1,801 @@
+// src/file_ops/lsm/lsm.cpp
+#include "file_ops/lsm/lsm.h"
+#include "services/hash/h_hash.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <queue>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace lsm {
+namespace {
+constexpr std::string_view MANIFEST_TAG = "SCLSM";
+constexpr int MANIFEST_VERSION = 1;
+// 10 bits per key and 7 probes: about 1% false positives.
+constexpr std::uint64_t BLOOM_BITS_PER_KEY = 10;
+
+constexpr std::uint64_t align_8(std::uint64_t value) noexcept {
+  return (value + 7u) & ~std::uint64_t{7};
+}
+
+// account_number of an entry line (without its '\n'): the field after the
+// operation character, up to the next separator.
+std::string_view key_of(std::string_view line) noexcept {
+  constexpr std::string_view delim = infrastructure_names::SEPARATOR;
+  if (line.size() < 1 + delim.size())
+    return {};
+  line.remove_prefix(1 + delim.size());
+  return line.substr(0, line.find(delim));
+}
+
+bool is_tombstone(std::string_view line) noexcept {
+  return !line.empty() &&
+         line.front() == static_cast<char>(op_log::enOperation::remove);
+}
+
+// Same double hashing as account_filter: probe i is h1 + i * h2.
+struct stProbe {
+  std::uint64_t h1;
+  std::uint64_t h2;
+};
+
+stProbe probe_for(std::uint64_t hash) noexcept {
+  return {hash, h_hash::mix_64(hash ^ 0x9e3779b97f4a7c15ull) | 1};
+}
+
+std::uint64_t hash_key(std::string_view account_number) noexcept {
+  return h_hash::mix_64(h_hash::fnv1a_64(account_number));
+}
+
+// Writes @p bytes to @p path through a temp file renamed into place, synced
+// (file, then directory) when @p durable.
+void publish_file(const std::filesystem::path &path, std::string_view bytes,
+                  bool durable) {
+  std::filesystem::path temp_path = path;
+  temp_path += ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+      throw std::runtime_error("Failed to create " + temp_path.string());
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    out.close();
+    if (out.fail() || (durable && !platform_ops_sync::sync_file(temp_path))) {
+      std::error_code ignored;
+      std::filesystem::remove(temp_path, ignored);
+      throw std::runtime_error("Failed to write " + temp_path.string());
+    }
+  }
+  std::filesystem::rename(temp_path, path);
+  if (durable && !platform_ops_sync::sync_directory(path.parent_path()))
+    throw std::runtime_error("Failed to sync " + path.parent_path().string());
+}
+
+// One run being written: entry lines in key order, then the sparse index
+// and the Bloom filter once the key count is known.
+struct stRunBuilder {
+  std::string bytes = std::string(sizeof(stRunHeader), '\0');
+  std::vector<std::uint64_t> index;
+  std::vector<std::uint64_t> hashes;
+  std::uint64_t last_offset = 0;
+
+  void add(std::string_view line, std::string_view key) {
+    if (hashes.size() % SPARSE_INDEX_INTERVAL == 0)
+      index.push_back(bytes.size());
+    last_offset = bytes.size();
+    bytes.append(line);
+    bytes.push_back('\n');
+    hashes.push_back(hash_key(key));
+  }
+  bool empty() const noexcept { return hashes.empty(); }
+  std::uint64_t entry_bytes() const noexcept {
+    return bytes.size() - sizeof(stRunHeader);
+  }
+
+  // Memory: the run is assembled in memory (at most target_run_bytes, or one
+  // memtable) and written with one write().
+  void write(const std::filesystem::path &path, bool durable) {
+    stRunHeader header{};
+    header.magic = RUN_MAGIC;
+    header.version = RUN_VERSION;
+    header.entry_count = hashes.size();
+    header.entries_end = bytes.size();
+    header.last_offset = last_offset;
+    header.index_count = index.size();
+    header.bloom_bits = std::max<std::uint64_t>(64, hashes.size() * BLOOM_BITS_PER_KEY);
+    header.hash_count = static_cast<std::uint32_t>(
+        std::lround(static_cast<double>(BLOOM_BITS_PER_KEY) * std::log(2.0)));
+
+    bytes.resize(align_8(bytes.size()), '\0'); // The index is read in place
+    bytes.append(reinterpret_cast<const char *>(index.data()),
+                 index.size() * sizeof(std::uint64_t));
+    std::vector<unsigned char> bloom((header.bloom_bits + 7) / 8, 0);
+    for (std::uint64_t hash : hashes) {
+      const stProbe probe = probe_for(hash);
+      for (std::uint32_t i = 0; i < header.hash_count; ++i) {
+        const std::uint64_t bit = (probe.h1 + i * probe.h2) % header.bloom_bits;
+        bloom[bit / 8] |= static_cast<unsigned char>(1u << (bit % 8));
+      }
+    }
+    bytes.append(reinterpret_cast<const char *>(bloom.data()), bloom.size());
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    publish_file(path, bytes, durable);
+  }
+};
+
+// K-way merge of sorted entry regions, @p sources newest first. Calls
+// emit(line, key) once per account_number, with the newest entry for it.
+// CPU: O(n log k) for n lines in k sources; nothing is parsed.
+template <class Emit>
+void merge_sources(const std::vector<std::string_view> &sources, Emit emit) {
+  struct stCursor {
+    std::string_view rest;
+    std::string_view line;
+    std::string_view key;
+    std::size_t rank = 0; // Position in sources: lower is newer
+
+    bool next() noexcept {
+      while (!rest.empty()) {
+        const std::size_t newline = rest.find('\n');
+        if (newline == std::string_view::npos)
+          return false; // Torn tail; runs never have one
+        line = rest.substr(0, newline);
+        rest.remove_prefix(newline + 1);
+        key = key_of(line);
+        if (!key.empty())
+          return true;
+      }
+      return false;
+    }
+  };
+  auto later = [](const stCursor &a, const stCursor &b) {
+    return a.key != b.key ? a.key > b.key : a.rank > b.rank;
+  };
+  std::priority_queue<stCursor, std::vector<stCursor>, decltype(later)> heap(later);
+  for (std::size_t rank = 0; rank < sources.size(); ++rank) {
+    stCursor cursor{sources[rank], {}, {}, rank};
+    if (cursor.next())
+      heap.push(cursor);
+  }
+
+  std::string last_key;
+  bool any = false;
+  while (!heap.empty()) {
+    stCursor cursor = heap.top();
+    heap.pop();
+    if (!any || cursor.key != last_key) {
+      emit(cursor.line, cursor.key);
+      last_key.assign(cursor.key);
+      any = true;
+    }
+    if (cursor.next())
+      heap.push(cursor);
+  }
+}
+
+// The memtable as entry lines, in key order.
+std::string memtable_lines(
+    const std::map<std::string, op_log::stLogEntry, std::less<>> &memtable) {
+  std::string lines;
+  for (const auto &[key, entry] : memtable)
+    lines += op_log::convert_entry_to_line(entry);
+  return lines;
+}
+
+bool parse_sequence(std::string_view name, std::uint64_t &sequence) noexcept {
+  constexpr std::string_view prefix = infrastructure_names::LSM_RUN_PREFIX;
+  constexpr std::string_view extension = infrastructure_names::LSM_RUN_EXTENSION;
+  if (!name.starts_with(prefix) || !name.ends_with(extension))
+    return false;
+  name = name.substr(prefix.size(), name.size() - prefix.size() - extension.size());
+  const auto [end, ec] =
+      std::from_chars(name.data(), name.data() + name.size(), sequence);
+  return ec == std::errc{} && end == name.data() + name.size();
+}
+} // namespace
+
+bool clsRunFile::open(const std::filesystem::path &run_path,
+                      std::uint64_t sequence) noexcept {
+  _path = run_path;
+  _sequence = sequence;
+  if (!_mapping.open(run_path) || _mapping.size() < sizeof(stRunHeader))
+    return false;
+  std::memcpy(&_header, _mapping.data(), sizeof(_header));
+  const std::uint64_t index_offset = align_8(_header.entries_end);
+  const std::uint64_t bloom_offset =
+      index_offset + _header.index_count * sizeof(std::uint64_t);
+  if (_header.magic != RUN_MAGIC || _header.version != RUN_VERSION ||
+      _header.entry_count == 0 || _header.hash_count == 0 ||
+      _header.bloom_bits == 0 || _header.entries_end <= sizeof(stRunHeader) ||
+      _header.last_offset < sizeof(stRunHeader) ||
+      _header.last_offset >= _header.entries_end ||
+      _header.index_count !=
+          (_header.entry_count + SPARSE_INDEX_INTERVAL - 1) / SPARSE_INDEX_INTERVAL ||
+      _mapping.size() != bloom_offset + (_header.bloom_bits + 7) / 8 ||
+      _mapping.data()[_header.entries_end - 1] != '\n') {
+    _mapping.close();
+    return false;
+  }
+  _index = reinterpret_cast<const std::uint64_t *>(_mapping.data() + index_offset);
+  _bloom = reinterpret_cast<const unsigned char *>(_mapping.data() + bloom_offset);
+  for (std::uint64_t i = 0; i < _header.index_count; ++i)
+    if (_index[i] < sizeof(stRunHeader) || _index[i] >= _header.entries_end) {
+      _mapping.close();
+      return false;
+    }
+  _min_key = key_of(line_at(sizeof(stRunHeader)));
+  _max_key = key_of(line_at(_header.last_offset));
+  return true;
+}
+
+std::string_view clsRunFile::entries() const noexcept {
+  if (!_mapping.is_open())
+    return {};
+  return _mapping.view().substr(sizeof(stRunHeader),
+                                _header.entries_end - sizeof(stRunHeader));
+}
+
+std::string_view clsRunFile::line_at(std::uint64_t offset) const noexcept {
+  std::string_view rest = _mapping.view().substr(offset, _header.entries_end - offset);
+  return rest.substr(0, rest.find('\n'));
+}
+
+bool clsRunFile::may_contain(std::string_view account_number) const noexcept {
+  if (!_mapping.is_open())
+    return false;
+  const stProbe probe = probe_for(hash_key(account_number));
+  for (std::uint32_t i = 0; i < _header.hash_count; ++i) {
+    const std::uint64_t bit = (probe.h1 + i * probe.h2) % _header.bloom_bits;
+    if ((_bloom[bit / 8] & (1u << (bit % 8))) == 0)
+      return false;
+  }
+  return true;
+}
+
+bool clsRunFile::find(std::string_view account_number,
+                      op_log::stLogEntry &entry) const {
+  if (account_number < _min_key || account_number > _max_key ||
+      !may_contain(account_number))
+    return false;
+  // CPU: O(log(n / interval)) keys read from the mapped lines, then a scan
+  // of at most SPARSE_INDEX_INTERVAL lines.
+  const std::uint64_t *block = std::upper_bound(
+      _index, _index + _header.index_count, account_number,
+      [this](std::string_view key, std::uint64_t offset) {
+        return key < key_of(line_at(offset));
+      });
+  std::uint64_t offset = *(block - 1); // _index[0] is min_key <= account_number
+  for (std::uint64_t i = 0; i < SPARSE_INDEX_INTERVAL && offset < _header.entries_end;
+       ++i) {
+    const std::string_view line = line_at(offset);
+    const std::string_view key = key_of(line);
+    if (key == account_number)
+      return op_log::convert_line_to_entry(line, entry);
+    if (key > account_number)
+      return false;
+    offset += line.size() + 1;
+  }
+  return false;
+}
+
+clsLsmStore::clsLsmStore(const std::filesystem::path &directory,
+                         const stLsmOptions &options)
+    : _directory(directory), _options(options) {
+  const std::filesystem::path lock_path =
+      _directory / infrastructure_names::LSM_LOCK_FILE_NAME;
+  if (!_file_lock.open(lock_path) ||
+      !_file_lock.lock(_options.read_only ? platform_ops_lock::enLockMode::shared
+                                          : platform_ops_lock::enLockMode::exclusive))
+    throw std::runtime_error("Failed to lock the LSM store: " + lock_path.string());
+  recover();
+  if (_options.read_only)
+    return;
+  open_log(false);
+  std::lock_guard guard(_mutex);
+  schedule_compaction();
+}
+
+clsLsmStore::~clsLsmStore() {
+  // A queued task now returns at once; _compactions waits for a running one.
+  std::lock_guard guard(_mutex);
+  _stopping = true;
+}
+
+std::filesystem::path clsLsmStore::run_path(std::uint64_t sequence) const {
+  char digits[24];
+  std::snprintf(digits, sizeof(digits), "%08llu",
+                static_cast<unsigned long long>(sequence));
+  return _directory / (std::string(infrastructure_names::LSM_RUN_PREFIX) + digits +
+                       std::string(infrastructure_names::LSM_RUN_EXTENSION));
+}
+
+void clsLsmStore::recover() {
+  _levels.assign(1, {});
+  std::set<std::uint64_t> listed;
+  const std::filesystem::path manifest_path =
+      _directory / infrastructure_names::LSM_MANIFEST_FILE_NAME;
+  if (std::ifstream manifest{manifest_path}) {
+    std::string tag;
+    int version = 0;
+    if (!(manifest >> tag >> version >> _next_sequence) || tag != MANIFEST_TAG ||
+        version != MANIFEST_VERSION)
+      throw std::runtime_error("Corrupt LSM manifest: " + manifest_path.string());
+    std::size_t level = 0;
+    std::uint64_t sequence = 0;
+    while (manifest >> level >> sequence) {
+      auto run = std::make_shared<clsRunFile>();
+      if (sequence >= _next_sequence || !run->open(run_path(sequence), sequence))
+        throw std::runtime_error("Missing or corrupt LSM run: " +
+                                 run_path(sequence).string());
+      if (_levels.size() <= level)
+        _levels.resize(level + 1);
+      _levels[level].push_back(std::move(run));
+      listed.insert(sequence);
+    }
+    if (!manifest.eof())
+      throw std::runtime_error("Corrupt LSM manifest: " + manifest_path.string());
+  }
+  std::sort(_levels[0].begin(), _levels[0].end(),
+            [](const run_ptr &a, const run_ptr &b) { return a->sequence() < b->sequence(); });
+  for (std::size_t level = 1; level < _levels.size(); ++level)
+    std::sort(_levels[level].begin(), _levels[level].end(),
+              [](const run_ptr &a, const run_ptr &b) { return a->min_key() < b->min_key(); });
+
+  // Runs and temp files a flush or merge left behind before the manifest
+  // listed them.
+  std::error_code ec;
+  for (const auto &file : std::filesystem::directory_iterator(_directory, ec)) {
+    if (_options.read_only)
+      break;
+    const std::string name = file.path().filename().string();
+    std::uint64_t sequence = 0;
+    const bool stray_run = parse_sequence(name, sequence) && !listed.contains(sequence);
+    const bool stray_temp =
+        name.ends_with(".tmp") &&
+        (name.starts_with(infrastructure_names::LSM_RUN_PREFIX) ||
+         name.starts_with(infrastructure_names::LSM_MANIFEST_FILE_NAME));
+    if (stray_run || stray_temp) {
+      std::error_code ignored;
+      std::filesystem::remove(file.path(), ignored);
+    }
+  }
+
+  // The memtable: every complete line of the write-ahead log.
+  const std::filesystem::path log_path =
+      _directory / infrastructure_names::LSM_LOG_FILE_NAME;
+  std::ifstream log(log_path, std::ios::binary);
+  if (!log.is_open())
+    return;
+  const std::string bytes{std::istreambuf_iterator<char>(log), {}};
+  log.close();
+  std::size_t complete = 0;
+  for (std::size_t start = 0, newline;
+       (newline = bytes.find('\n', start)) != std::string::npos; start = newline + 1) {
+    complete = newline + 1;
+    op_log::stLogEntry entry{};
+    if (!op_log::convert_line_to_entry(
+            std::string_view(bytes).substr(start, newline - start), entry))
+      continue;
+    if (entry.operation == op_log::enOperation::add)
+      entry.operation = op_log::enOperation::update;
+    _memtable_bytes += newline + 1 - start;
+    std::string key = entry.record.account_number;
+    _memtable.insert_or_assign(std::move(key), std::move(entry));
+  }
+  if (complete != bytes.size() && !_options.read_only)
+    std::filesystem::resize_file(log_path, complete); // Cut the torn append
+}
+
+void clsLsmStore::require_writable() const {
+  if (_options.read_only)
+    throw std::runtime_error("The LSM store is open read-only: " +
+                             _directory.string());
+}
+
+void clsLsmStore::open_log(bool truncate) {
+  const std::filesystem::path log_path =
+      _directory / infrastructure_names::LSM_LOG_FILE_NAME;
+  _log.close();
+  _log.clear();
+  _log.open(log_path, std::ios::binary | (truncate ? std::ios::out | std::ios::trunc
+                                                   : std::ios::app));
+  if (!_log.is_open() || !_log_sync.open(log_path))
+    throw std::runtime_error("Failed to open the LSM log: " + log_path.string());
+}
+
+void clsLsmStore::write_manifest(const std::vector<std::vector<run_ptr>> &levels) const {
+  std::ostringstream manifest;
+  manifest << MANIFEST_TAG << ' ' << MANIFEST_VERSION << ' ' << _next_sequence << '\n';
+  for (std::size_t level = 0; level < levels.size(); ++level)
+    for (const auto &run : levels[level])
+      manifest << level << ' ' << run->sequence() << '\n';
+  publish_file(_directory / infrastructure_names::LSM_MANIFEST_FILE_NAME,
+               manifest.str(), _options.sync != op_log::enSyncPolicy::none);
+}
+
+void clsLsmStore::apply(std::span<const op_log::stLogEntry> entries) {
+  require_writable();
+  if (entries.empty())
+    return;
+  std::string lines;
+  std::vector<std::size_t> ends;
+  ends.reserve(entries.size());
+  for (const auto &entry : entries) {
+    lines += op_log::convert_entry_to_line(entry);
+    ends.push_back(lines.size());
+  }
+
+  std::unique_lock lock(_mutex);
+  // Write stall: level 0 is read run by run, so it may not grow unbounded
+  // while the worker catches up (unless merges are failing).
+  if (_options.background)
+    _changed.wait(lock, [this] {
+      return _levels[0].size() < _options.l0_stop_trigger || _retry_blocked;
+    });
+
+  // I/O: one append, and at most one fdatasync, for the whole span: the
+  // caller decides how many entries share it.
+  _log.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+  _log.flush();
+  if (_log.fail())
+    throw std::runtime_error("Failed to append to the LSM log");
+  if (_options.sync != op_log::enSyncPolicy::none && !_log_sync.sync_data())
+    throw std::runtime_error("Failed to sync the LSM log");
+
+  std::size_t start = 0;
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    op_log::stLogEntry entry = entries[i];
+    if (entry.operation == op_log::enOperation::add)
+      entry.operation = op_log::enOperation::update;
+    if (entry.operation == op_log::enOperation::remove)
+      entry.record = {entry.record.account_number, {}, {}, {}, 0, false};
+    _memtable_bytes += ends[i] - start;
+    start = ends[i];
+    std::string key = entry.record.account_number;
+    _memtable.insert_or_assign(std::move(key), std::move(entry));
+  }
+  if (_memtable_bytes >= _options.memtable_bytes)
+    flush_locked();
+}
+
+void clsLsmStore::flush() {
+  require_writable();
+  std::unique_lock lock(_mutex);
+  flush_locked();
+}
+
+void clsLsmStore::clear() {
+  require_writable();
+  std::unique_lock lock(_mutex);
+  // A merge in flight would install its output into the runs dropped here.
+  _changed.wait(lock, [this] { return !_compacting; });
+  const std::vector<std::vector<run_ptr>> empty(1);
+  write_manifest(empty);
+  const std::vector<std::vector<run_ptr>> dropped = std::exchange(_levels, empty);
+  open_log(true);
+  _memtable.clear();
+  _memtable_bytes = 0;
+  _retry_blocked = false;
+  for (const auto &level : dropped)
+    for (const auto &run : level) {
+      std::error_code ignored;
+      std::filesystem::remove(run->path(), ignored);
+    }
+  _changed.notify_all();
+}
+
+void clsLsmStore::flush_locked() {
+  if (_memtable.empty())
+    return;
+  // CPU / I/O: O(memtable), never O(table): the run holds only the entries
+  // written since the last flush.
+  stRunBuilder builder;
+  for (const auto &[key, entry] : _memtable) {
+    const std::string line = op_log::convert_entry_to_line(entry);
+    builder.add(std::string_view(line).substr(0, line.size() - 1), key);
+  }
+  const std::uint64_t sequence = _next_sequence++;
+  const bool durable = _options.sync != op_log::enSyncPolicy::none;
+  builder.write(run_path(sequence), durable);
+  auto run = std::make_shared<clsRunFile>();
+  if (!run->open(run_path(sequence), sequence))
+    throw std::runtime_error("Failed to open the LSM run: " +
+                             run_path(sequence).string());
+
+  std::vector<std::vector<run_ptr>> levels = _levels;
+  levels[0].push_back(run);
+  write_manifest(levels);
+  _levels = std::move(levels);
+  // The run is listed now; the entries it holds leave the log.
+  open_log(true);
+  _memtable.clear();
+  _memtable_bytes = 0;
+  _retry_blocked = false;
+  schedule_compaction();
+  _changed.notify_all();
+}
+
+std::uint64_t clsLsmStore::level_bytes(std::size_t level) const noexcept {
+  std::uint64_t bytes = 0;
+  for (const auto &run : _levels[level])
+    bytes += run->file_size();
+  return bytes;
+}
+
+std::uint64_t clsLsmStore::level_limit(std::size_t level) const noexcept {
+  std::uint64_t limit = _options.level_base_bytes;
+  for (std::size_t i = 1; i < level; ++i)
+    limit *= _options.level_ratio;
+  return limit;
+}
+
+clsLsmStore::stCompactionPlan clsLsmStore::plan_compaction() const {
+  stCompactionPlan plan;
+  if (_compacting)
+    return plan;
+
+  std::string_view low, high;
+  std::size_t source_level = 0;
+  if (_levels[0].size() >= _options.l0_compaction_trigger) {
+    // Level 0 runs overlap: all of them go, newest first.
+    plan.inputs.assign(_levels[0].rbegin(), _levels[0].rend());
+  } else {
+    for (std::size_t level = 1; level < _levels.size(); ++level)
+      if (level_bytes(level) > level_limit(level)) {
+        // The oldest run of the level, so every key range gets its turn.
+        plan.inputs.push_back(*std::min_element(
+            _levels[level].begin(), _levels[level].end(),
+            [](const run_ptr &a, const run_ptr &b) { return a->sequence() < b->sequence(); }));
+        source_level = level;
+        break;
+      }
+    if (plan.inputs.empty())
+      return plan;
+  }
+  low = plan.inputs.front()->min_key();
+  high = plan.inputs.front()->max_key();
+  for (const auto &run : plan.inputs) {
+    low = std::min(low, run->min_key());
+    high = std::max(high, run->max_key());
+  }
+
+  plan.output_level = source_level + 1;
+  if (plan.output_level < _levels.size())
+    for (const auto &run : _levels[plan.output_level])
+      if (run->max_key() >= low && run->min_key() <= high)
+        plan.inputs.push_back(run); // Older than every source run
+  plan.drop_tombstones = true;
+  for (std::size_t level = plan.output_level + 1; level < _levels.size(); ++level)
+    if (!_levels[level].empty())
+      plan.drop_tombstones = false; // Could still hide an older entry down there
+  return plan;
+}
+
+std::vector<clsLsmStore::run_ptr> clsLsmStore::merge(const stCompactionPlan &plan) {
+  std::vector<std::string_view> sources;
+  for (const auto &run : plan.inputs)
+    sources.push_back(run->entries());
+
+  const bool durable = _options.sync != op_log::enSyncPolicy::none;
+  std::vector<run_ptr> outputs;
+  stRunBuilder builder;
+  auto finish = [&] {
+    std::uint64_t sequence = 0;
+    {
+      std::lock_guard guard(_mutex);
+      sequence = _next_sequence++;
+    }
+    builder.write(run_path(sequence), durable);
+    auto run = std::make_shared<clsRunFile>();
+    if (!run->open(run_path(sequence), sequence))
+      throw std::runtime_error("Failed to open the LSM run: " +
+                               run_path(sequence).string());
+    outputs.push_back(std::move(run));
+    builder = stRunBuilder{};
+  };
+
+  try {
+    // CPU: O(input bytes), split at target_run_bytes, so outputs stay
+    // disjoint and ordered.
+    merge_sources(sources, [&](std::string_view line, std::string_view key) {
+      if (plan.drop_tombstones && is_tombstone(line))
+        return;
+      builder.add(line, key);
+      if (builder.entry_bytes() >= _options.target_run_bytes)
+        finish();
+    });
+    if (!builder.empty())
+      finish();
+  } catch (...) {
+    for (const auto &run : outputs) {
+      std::error_code ignored;
+      std::filesystem::remove(run->path(), ignored);
+    }
+    throw;
+  }
+  return outputs;
+}
+
+void clsLsmStore::install(const stCompactionPlan &plan,
+                          const std::vector<run_ptr> &outputs) {
+  std::vector<std::vector<run_ptr>> levels = _levels;
+  for (auto &level : levels)
+    std::erase_if(level, [&](const run_ptr &run) {
+      return std::find(plan.inputs.begin(), plan.inputs.end(), run) != plan.inputs.end();
+    });
+  if (levels.size() <= plan.output_level)
+    levels.resize(plan.output_level + 1);
+  auto &target = levels[plan.output_level];
+  target.insert(target.end(), outputs.begin(), outputs.end());
+  std::sort(target.begin(), target.end(),
+            [](const run_ptr &a, const run_ptr &b) { return a->min_key() < b->min_key(); });
+  write_manifest(levels);
+  _levels = std::move(levels);
+
+  // Readers that took the old runs keep their mappings; the files go now
+  // (on Windows a mapped file may refuse, and is removed at the next start).
+  for (const auto &run : plan.inputs) {
+    std::error_code ignored;
+    std::filesystem::remove(run->path(), ignored);
+  }
+}
+
+bool clsLsmStore::compact_once(std::unique_lock<std::mutex> &lock) {
+  const stCompactionPlan plan = plan_compaction();
+  if (plan.empty())
+    return false;
+  _compacting = true;
+  std::vector<run_ptr> outputs;
+  try {
+    lock.unlock();
+    outputs = merge(plan);
+    lock.lock();
+    install(plan, outputs);
+  } catch (...) {
+    if (!lock.owns_lock())
+      lock.lock();
+    for (const auto &run : outputs) {
+      std::error_code ignored;
+      std::filesystem::remove(run->path(), ignored);
+    }
+    _compacting = false;
+    _changed.notify_all();
+    throw;
+  }
+  _compacting = false;
+  schedule_compaction(); // The output may fill the next level
+  _changed.notify_all();
+  return true;
+}
+
+std::size_t clsLsmStore::compact_pending() {
+  require_writable();
+  std::unique_lock lock(_mutex);
+  std::size_t compactions = 0;
+  for (;;) {
+    _changed.wait(lock, [this] { return !_compacting; });
+    if (!compact_once(lock))
+      return compactions;
+    ++compactions;
+  }
+}
+
+void clsLsmStore::schedule_compaction() {
+  // CPU: merges share the process-wide pool with the loaders instead of
+  // keeping a thread of their own; one task per merge.
+  if (!_options.background || _options.read_only || _stopping ||
+      _compaction_queued || _retry_blocked || plan_compaction().empty())
+    return;
+  _compaction_queued = true;
+  _compactions.run([this] { run_compaction_task(); });
+}
+
+void clsLsmStore::run_compaction_task() {
+  std::unique_lock lock(_mutex);
+  _compaction_queued = false;
+  if (!_stopping) {
+    try {
+      compact_once(lock); // Queues the next merge itself
+    } catch (const std::exception &error) {
+      _last_error = error.what();
+      _retry_blocked = true;
+    }
+  }
+  _changed.notify_all();
+}
+
+void clsLsmStore::wait_idle() {
+  if (!_options.background || _options.read_only)
+    return;
+  std::unique_lock lock(_mutex);
+  _changed.wait(lock, [this] {
+    return !_compacting && !_compaction_queued &&
+           (_retry_blocked || plan_compaction().empty());
+  });
+}
+
+bool clsLsmStore::find(std::string_view account_number,
+                       client_data_structure::stClientData &record) const {
+  std::vector<std::vector<run_ptr>> levels;
+  {
+    std::lock_guard guard(_mutex);
+    auto found = _memtable.find(account_number);
+    if (found != _memtable.end()) {
+      if (found->second.operation == op_log::enOperation::remove)
+        return false;
+      record = found->second.record;
+      return true;
+    }
+    levels = _levels; // O(runs); the runs themselves are immutable
+  }
+
+  op_log::stLogEntry entry{};
+  auto answer = [&] {
+    if (entry.operation == op_log::enOperation::remove)
+      return false;
+    record = std::move(entry.record);
+    return true;
+  };
+  for (auto run = levels[0].rbegin(); run != levels[0].rend(); ++run)
+    if ((*run)->find(account_number, entry))
+      return answer();
+  for (std::size_t level = 1; level < levels.size(); ++level) {
+    // Disjoint ranges sorted by key: the only candidate is the first run
+    // that ends at or after account_number.
+    auto run = std::lower_bound(
+        levels[level].begin(), levels[level].end(), account_number,
+        [](const run_ptr &candidate, std::string_view key) {
+          return candidate->max_key() < key;
+        });
+    if (run != levels[level].end() && (*run)->find(account_number, entry))
+      return answer();
+  }
+  return false;
+}
+
+std::vector<client_data_structure::stClientData> clsLsmStore::load() const {
+  std::string memtable;
+  std::vector<run_ptr> runs;
+  {
+    std::lock_guard guard(_mutex);
+    memtable = memtable_lines(_memtable);
+    runs.assign(_levels[0].rbegin(), _levels[0].rend());
+    for (std::size_t level = 1; level < _levels.size(); ++level)
+      runs.insert(runs.end(), _levels[level].begin(), _levels[level].end());
+  }
+
+  std::vector<std::string_view> sources{memtable};
+  for (const auto &run : runs)
+    sources.push_back(run->entries());
+  std::vector<client_data_structure::stClientData> records;
+  merge_sources(sources, [&](std::string_view line, std::string_view) {
+    op_log::stLogEntry entry{};
+    if (!is_tombstone(line) && op_log::convert_line_to_entry(line, entry))
+      records.push_back(std::move(entry.record));
+  });
+  return records;
+}
+
+std::vector<std::size_t> clsLsmStore::run_counts() const {
+  std::lock_guard guard(_mutex);
+  std::vector<std::size_t> counts;
+  for (const auto &level : _levels)
+    counts.push_back(level.size());
+  return counts;
+}
+
+std::size_t clsLsmStore::memtable_size() const {
+  std::lock_guard guard(_mutex);
+  return _memtable.size();
+}
+
+std::string clsLsmStore::last_error() const {
+  std::lock_guard guard(_mutex);
+  return _last_error;
+}
+} // namespace lsm
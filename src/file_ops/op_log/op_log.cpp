@@ -0,0 +1,670 @@
+// src/file_ops/op_log/op_log.cpp
+#include "file_ops/op_log/op_log.h"
+#include "file_ops/file_ops.h"
+#include "platform_ops/map/map.h"
+#include "services/columnar_snapshot/columnar_snapshot.h"
+#include "services/convert/h_convert/h_convert.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace op_log {
+namespace {
+void append_entry_line(const stLogEntry &entry, std::string &out) {
+  out.push_back(static_cast<char>(entry.operation));
+  out.append(infrastructure_names::SEPARATOR);
+  if (entry.operation == enOperation::remove)
+    out.append(entry.record.account_number);
+  else
+    h_convert::append_record_line(entry.record, out);
+  out.push_back('\n');
+}
+
+// Cuts a partially written last line (no trailing '\n') left by a crash in
+// the middle of an append; returns the resulting file size.
+std::uintmax_t trim_torn_tail(const std::filesystem::path &log_path) {
+  std::uintmax_t keep = 0;
+  {
+    platform_ops_map::clsMappedFile mapping;
+    if (!mapping.open(log_path) || mapping.size() == 0)
+      return 0;
+    const char *data = mapping.data();
+    keep = mapping.size();
+    while (keep > 0 && data[keep - 1] != '\n')
+      --keep;
+    if (keep == mapping.size())
+      return keep; // Clean tail, nothing to cut
+  } // Unmap before resizing (required on Windows)
+  std::filesystem::resize_file(log_path, keep);
+  return keep;
+}
+
+// Applies every complete entry in `bytes` (log lines) to `records`; the
+// body of replay(), shared with compactions that read the log into memory.
+std::size_t
+apply_log_bytes(std::string_view bytes,
+                std::vector<client_data_structure::stClientData> &records) {
+  if (bytes.empty())
+    return 0;
+
+  // Memory: account_number -> position in records, built only when there is
+  // something to replay.
+  std::unordered_map<std::string, std::size_t> positions;
+  positions.reserve(records.size());
+  for (std::size_t i = 0; i < records.size(); ++i)
+    positions.emplace(records[i].account_number, i);
+
+  std::size_t applied = 0;
+  bool any_removed = false;
+  stLogEntry entry{};
+  const char *cursor = bytes.data();
+  const char *end = cursor + bytes.size();
+  while (cursor < end) {
+    const char *newline = static_cast<const char *>(
+        std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+    if (newline == nullptr)
+      break; // Torn last append: never acknowledged, so never applied
+    std::string_view line(cursor, static_cast<std::size_t>(newline - cursor));
+    cursor = newline + 1;
+
+    if (!convert_line_to_entry(line, entry))
+      continue;
+    ++applied;
+
+    auto found = positions.find(entry.record.account_number);
+    if (entry.operation == enOperation::remove) {
+      if (found != positions.end()) {
+        // Mark now, erase once at the end, so positions stay valid.
+        records[found->second].delete_mark = true;
+        positions.erase(found);
+        any_removed = true;
+      }
+    } else if (found != positions.end()) {
+      records[found->second] = std::move(entry.record);
+    } else {
+      positions.emplace(entry.record.account_number, records.size());
+      records.push_back(std::move(entry.record));
+    }
+  }
+
+  if (any_removed)
+    std::erase_if(records, [](const auto &record) { return record.delete_mark; });
+  return applied;
+}
+
+// Tombstones (remove entries) among the complete lines of `bytes`.
+// CPU: a memchr scan; no line is parsed.
+std::size_t count_tombstones(std::string_view bytes) {
+  constexpr std::string_view delim = infrastructure_names::SEPARATOR;
+  std::size_t tombstones = 0;
+  for (std::size_t start = 0, newline;
+       (newline = bytes.find('\n', start)) != std::string_view::npos;
+       start = newline + 1)
+    if (newline - start > 1 + delim.size() &&
+        bytes[start] == static_cast<char>(enOperation::remove) &&
+        bytes.substr(start + 1, delim.size()) == delim)
+      ++tombstones;
+  return tombstones;
+}
+
+// Reads [offset, offset + length) of the file with plain reads: unlike a
+// mapping, a file cut short meanwhile gives a short read, not SIGBUS.
+bool read_file_range(const std::filesystem::path &path, std::uintmax_t offset,
+                     std::uintmax_t length, std::string &out) {
+  out.assign(static_cast<std::size_t>(length), '\0');
+  std::ifstream in(path, std::ios::binary);
+  return in.seekg(static_cast<std::streamoff>(offset)) &&
+         in.read(out.data(), static_cast<std::streamsize>(length)) &&
+         static_cast<std::uintmax_t>(in.gcount()) == length;
+}
+
+// Live (not delete-marked) rows.
+std::size_t count_live(
+    const std::vector<client_data_structure::stClientData> &records) {
+  return static_cast<std::size_t>(
+      std::count_if(records.begin(), records.end(),
+                    [](const auto &record) { return !record.delete_mark; }));
+}
+
+// True if a replay may start at `offset`: inside the log and right after a
+// complete entry.
+bool is_entry_boundary(const std::filesystem::path &log_path,
+                       std::uintmax_t offset) {
+  if (offset == 0)
+    return true;
+  std::ifstream in(log_path, std::ios::binary);
+  char last = '\0';
+  return in.seekg(static_cast<std::streamoff>(offset - 1)) && in.get(last) &&
+         last == '\n';
+}
+} // namespace
+
+bool parse_sync_options(std::string_view spec, stSyncOptions &options) {
+  if (spec == "none" || spec == "operation") {
+    options = {spec == "none" ? enSyncPolicy::none : enSyncPolicy::operation,
+               std::chrono::microseconds{0}};
+    return true;
+  }
+  constexpr std::string_view group = "group";
+  if (spec.substr(0, group.size()) != group)
+    return false;
+  std::chrono::microseconds::rep window = 0;
+  if (spec.size() > group.size()) {
+    const std::string_view digits = spec.substr(group.size() + 1);
+    if (spec[group.size()] != ':' || digits.empty())
+      return false;
+    auto [end, error] =
+        std::from_chars(digits.data(), digits.data() + digits.size(), window);
+    if (error != std::errc{} || end != digits.data() + digits.size() || window < 0)
+      return false;
+  }
+  options = {enSyncPolicy::group, std::chrono::microseconds{window}};
+  return true;
+}
+
+std::string convert_entry_to_line(const stLogEntry &entry) {
+  std::string line;
+  append_entry_line(entry, line);
+  return line;
+}
+
+bool convert_line_to_entry(std::string_view line, stLogEntry &entry) {
+  constexpr std::string_view delim = infrastructure_names::SEPARATOR;
+  if (line.size() < 1 + delim.size() || line.substr(1, delim.size()) != delim)
+    return false;
+
+  std::string_view payload = line.substr(1 + delim.size());
+  switch (static_cast<enOperation>(line[0])) {
+  case enOperation::add:
+  case enOperation::update:
+    entry.operation = static_cast<enOperation>(line[0]);
+    return h_convert::convert_line_to_record(payload, entry.record);
+  case enOperation::remove:
+    if (payload.empty() || payload.find(delim) != std::string_view::npos)
+      return false;
+    entry.operation = enOperation::remove;
+    entry.record = {};
+    entry.record.account_number.assign(payload);
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::size_t replay(const std::filesystem::path &log_path,
+                   std::vector<client_data_structure::stClientData> &records,
+                   std::uintmax_t start_offset) {
+  platform_ops_map::clsMappedFile mapping;
+  if (!mapping.open(log_path) || mapping.size() <= start_offset)
+    return 0;
+  return apply_log_bytes(mapping.view().substr(start_offset), records);
+}
+
+std::vector<stLogEntry> read_entries(const std::filesystem::path &log_path,
+                                     std::uintmax_t start_offset) {
+  std::vector<stLogEntry> entries;
+  platform_ops_map::clsMappedFile mapping;
+  if (!mapping.open(log_path) || mapping.size() <= start_offset)
+    return entries;
+  const std::string_view bytes = mapping.view().substr(start_offset);
+  stLogEntry entry{};
+  // A final line without '\n' is a torn append and is left out, as in replay.
+  for (std::size_t start = 0, newline;
+       (newline = bytes.find('\n', start)) != std::string_view::npos;
+       start = newline + 1)
+    if (convert_line_to_entry(bytes.substr(start, newline - start), entry))
+      entries.push_back(std::move(entry));
+  return entries;
+}
+
+bool find_last_entry(const std::filesystem::path &log_path,
+                     std::string_view account_number, stLogEntry &entry) {
+  constexpr std::string_view delim = infrastructure_names::SEPARATOR;
+  platform_ops_map::clsMappedFile mapping;
+  if (!mapping.open(log_path) || mapping.size() == 0 || account_number.empty())
+    return false;
+  std::string_view bytes = mapping.view();
+  // A final line without '\n' is a torn append: never applied, so skipped.
+  bytes = bytes.substr(0, bytes.rfind('\n') + 1);
+
+  // CPU: newest line first; every line but the match costs one compare.
+  while (!bytes.empty()) {
+    bytes.remove_suffix(1); // The '\n' of the line below
+    const std::size_t newline = bytes.rfind('\n');
+    const std::size_t start = newline == std::string_view::npos ? 0 : newline + 1;
+    const std::string_view line = bytes.substr(start);
+    bytes = bytes.substr(0, start);
+
+    if (line.size() < 1 + delim.size() || line.substr(1, delim.size()) != delim)
+      continue;
+    const std::string_view payload = line.substr(1 + delim.size());
+    if (!payload.starts_with(account_number) ||
+        (payload.size() != account_number.size() &&
+         payload.substr(account_number.size(), delim.size()) != delim))
+      continue;
+    if (convert_line_to_entry(line, entry))
+      return true; // Malformed lines are skipped, as replay skips them
+  }
+  return false;
+}
+
+clsOpLog::clsOpLog(const std::filesystem::path &data_file_path,
+                   const std::filesystem::path &log_file_path,
+                   std::uintmax_t fold_threshold)
+    : _data_file_path(data_file_path), _log_file_path(log_file_path),
+      _fold_threshold(fold_threshold),
+      _lock(data_file_path.parent_path() / infrastructure_names::LOCK_FILE_NAME) {
+  // Exclusive: another process may be appending right now, and its
+  // half-written line is not a torn tail.
+  _lock.exclusive([this] { _log_size = trim_torn_tail(_log_file_path); });
+  open_log(false);
+  _version = _lock.current_version();
+}
+
+void clsOpLog::open_log(bool truncate) {
+  _log.close();
+  _log.clear();
+  _log.open(_log_file_path, std::ios::binary |
+                                (truncate ? std::ios::out | std::ios::trunc
+                                          : std::ios::app));
+  if (!_log.is_open() || !_log_sync.open(_log_file_path))
+    throw std::runtime_error("Failed to open the operation log: " +
+                             _log_file_path.string());
+}
+
+void clsOpLog::write_line_buffer() {
+  // CPU: one write() for everything in _line, independent of the data size.
+  _log.write(_line.data(), static_cast<std::streamsize>(_line.size()));
+  _log.flush();
+  if (_log.fail())
+    throw std::runtime_error("Failed to append to the operation log: " +
+                             _log_file_path.string());
+  // I/O: one fdatasync per call; the caller decides how many entries share it.
+  if (_sync_policy != enSyncPolicy::none && !_log_sync.sync_data())
+    throw std::runtime_error("Failed to sync the operation log: " +
+                             _log_file_path.string());
+}
+
+bool clsOpLog::truncate_log(std::uintmax_t size) noexcept {
+  _log.close();
+  std::error_code error;
+  std::filesystem::resize_file(_log_file_path, size, error);
+  try {
+    open_log(false);
+  } catch (const std::exception &) {
+    return false;
+  }
+  return !error;
+}
+
+void clsOpLog::commit_append(std::span<const stLogEntry> entries,
+                             const std::function<void()> &write) {
+  std::exception_ptr unacknowledged;
+  _version = _lock.commit(_version, [&] {
+    try {
+      write();
+      notify(entries);
+    } catch (...) {
+      // Part of the append may be in the log already. Cut it off so no
+      // reader replays a commit that was never acknowledged; if even that
+      // fails, let the version move so every process reloads what is there.
+      if (truncate_log(_log_size))
+        throw;
+      unacknowledged = std::current_exception();
+    }
+  });
+  if (unacknowledged) {
+    refresh_log_size();
+    std::rethrow_exception(unacknowledged);
+  }
+}
+
+void clsOpLog::refresh_log_size() {
+  std::error_code ignored;
+  const std::uintmax_t size = std::filesystem::file_size(_log_file_path, ignored);
+  _log_size = size == static_cast<std::uintmax_t>(-1) ? 0 : size;
+}
+
+std::filesystem::path clsOpLog::snapshot_path() const {
+  return _data_file_path.parent_path() / infrastructure_names::SNAPSHOT_FILE_NAME;
+}
+
+std::filesystem::path clsOpLog::account_index_path() const {
+  return _data_file_path.parent_path() /
+         infrastructure_names::ACCOUNT_INDEX_FILE_NAME;
+}
+
+void clsOpLog::notify(std::span<const stLogEntry> entries) {
+  if (_observer)
+    _observer(entries, _version + 1); // commit() stamps _version + 1 next
+}
+
+void clsOpLog::track(std::span<const stLogEntry> entries) noexcept {
+  // An estimate: an add that replaces a client or a remove of an unknown one
+  // is counted as if it changed the client count.
+  for (const auto &entry : entries) {
+    if (entry.operation == enOperation::remove) {
+      ++_tombstones;
+      if (_client_count != 0)
+        --_client_count;
+    } else if (entry.operation == enOperation::add) {
+      ++_client_count;
+    }
+  }
+}
+
+void clsOpLog::append(const stLogEntry &entry) {
+  _line.clear();
+  append_entry_line(entry, _line);
+  commit_append({&entry, 1}, [this] { write_line_buffer(); });
+  _log_size += _line.size();
+  track({&entry, 1});
+}
+
+std::vector<client_data_structure::stClientData> clsOpLog::load() {
+  std::vector<client_data_structure::stClientData> records;
+  // Shared lock: no other process can rename the data file or truncate the
+  // log halfway through; the version says which state was read.
+  _version = _lock.read_locked([&] {
+    // CPU: copies out of the mapped snapshot when it is current; parses the
+    // CSV (and writes a snapshot for next time) only when it is not.
+    std::uint64_t covered = 0;
+    records = columnar_snapshot::load_clients(_data_file_path, snapshot_path(),
+                                              &covered);
+    refresh_log_size(); // Other processes may have appended
+    if (covered > _log_size || !is_entry_boundary(_log_file_path, covered)) {
+      // A checkpoint of a log that was since cut short (e.g. deleted by
+      // hand): it no longer matches, so start from the data file alone.
+      records = file_ops::load_clients_parallel(_data_file_path);
+      covered = 0;
+    }
+    // CPU: only the entries after the checkpoint are parsed; the tombstones
+    // before it are counted with a byte scan.
+    replay(_log_file_path, records, covered);
+    _checkpoint_offset = covered;
+    platform_ops_map::clsMappedFile mapping;
+    _tombstones = mapping.open(_log_file_path) ? count_tombstones(mapping.view()) : 0;
+    _client_count = records.size();
+    ++_generation;
+    // A compaction of another process may have renamed a new log into place.
+    open_log(false);
+  });
+  return records;
+}
+
+void clsOpLog::publish_rewrite(
+    const std::vector<client_data_structure::stClientData> &records,
+    std::span<const stLogEntry> entries) {
+  // The slow part, unlocked; only the rename and the truncation are
+  // published under the exclusive lock.
+  const std::filesystem::path temp_path =
+      file_ops::write_clients_temp(_data_file_path, records);
+  const bool durable = _sync_policy != enSyncPolicy::none;
+  columnar_snapshot::stPreparedSnapshot snapshot;
+  std::filesystem::path prepared_index;
+  try {
+    // I/O: the slow sync of the whole new file also runs unlocked.
+    if (durable && !platform_ops_sync::sync_file(temp_path))
+      throw std::runtime_error("Failed to sync the temp file: " +
+                               temp_path.string());
+    snapshot = columnar_snapshot::prepare_snapshot_file(snapshot_path(), records);
+    // CPU: one more structural pass, paid only once someone uses the index.
+    if (std::filesystem::exists(account_index_path()))
+      prepared_index =
+          account_index::prepare_index_file(temp_path, account_index_path());
+    _version = _lock.commit(_version, [&] {
+      // If the process dies between these two steps, the next replay
+      // re-applies the same entries to the already-folded file: a no-op.
+      std::filesystem::rename(temp_path, _data_file_path);
+      // The rename must be on disk before the log is emptied. Throwing here
+      // leaves the version alone: the folded file plus the old log still
+      // replay to the same clients.
+      if (durable &&
+          !platform_ops_sync::sync_directory(_data_file_path.parent_path()))
+        throw std::runtime_error("Failed to sync the data directory: " +
+                                 _data_file_path.parent_path().string());
+      open_log(true);
+      if (durable && !_log_sync.sync_data())
+        throw std::runtime_error("Failed to sync the operation log: " +
+                                 _log_file_path.string());
+      // Stamped with the new data file; if this fails the old snapshot is
+      // stale and the next load parses the CSV instead.
+      columnar_snapshot::publish_snapshot_file(snapshot, snapshot_path(),
+                                               _data_file_path);
+      if (!prepared_index.empty())
+        account_index::publish_index_file(prepared_index, account_index_path());
+      notify(entries);
+    });
+  } catch (...) {
+    std::error_code ignored;
+    std::filesystem::remove(temp_path, ignored);
+    if (!snapshot.temp_path.empty())
+      std::filesystem::remove(snapshot.temp_path, ignored);
+    if (!prepared_index.empty())
+      std::filesystem::remove(prepared_index, ignored);
+    throw;
+  }
+  _log_size = 0;
+  _checkpoint_offset = 0;
+  _tombstones = 0;
+  _client_count = count_live(records);
+  ++_generation;
+}
+
+bool clsOpLog::checkpoint(
+    const std::vector<client_data_structure::stClientData> &current_records) {
+  // The O(n) encoding runs unlocked; the records belong to _version, so they
+  // cover exactly the _log_size bytes the log had at that version.
+  columnar_snapshot::stPreparedSnapshot snapshot =
+      columnar_snapshot::prepare_snapshot_file(snapshot_path(), current_records,
+                                               _log_size);
+  bool published = false;
+  const bool current = _lock.read_locked_if_current(_version, [&] {
+    published = columnar_snapshot::publish_snapshot_file(
+        snapshot, snapshot_path(), _data_file_path);
+  });
+  if (!current) {
+    std::error_code ignored;
+    std::filesystem::remove(snapshot.temp_path, ignored);
+    return false;
+  }
+  if (!published)
+    throw std::runtime_error("Failed to publish the checkpoint: " +
+                             snapshot_path().string());
+  _checkpoint_offset = _log_size;
+  return true;
+}
+
+bool clsOpLog::checkpoint_if_due(
+    const std::vector<client_data_structure::stClientData>
+        &current_records) noexcept {
+  if (!is_checkpoint_due())
+    return false;
+  try {
+    return checkpoint(current_records);
+  } catch (const std::exception &) {
+    return false; // The log still holds everything; try again next time
+  }
+}
+
+void clsOpLog::fold() { publish_rewrite(load(), {}); }
+
+bool clsOpLog::fold_if_due() {
+  if (!is_fold_due())
+    return false;
+  try {
+    fold();
+  } catch (const data_lock::clsVersionConflict &) {
+    return false; // Another process changed the data meanwhile; fold later
+  }
+  return true;
+}
+
+bool clsOpLog::commit_batch(
+    std::span<const stLogEntry> entries,
+    const std::vector<client_data_structure::stClientData> &current_records) {
+  if (entries.empty())
+    return false;
+  _line.clear();
+  for (const auto &entry : entries)
+    append_entry_line(entry, _line);
+
+  if (_log_size + _line.size() >= _fold_threshold) {
+    // One rewrite replaces both the append and the fold that would follow it.
+    publish_rewrite(current_records, entries);
+    return true;
+  }
+
+  const std::size_t batch_bytes = _line.size();
+  commit_append(entries, [&] {
+    if (_sync_policy == enSyncPolicy::operation) {
+      // Each entry durable on its own, as if appended one by one.
+      for (const auto &entry : entries) {
+        _line.clear();
+        append_entry_line(entry, _line);
+        write_line_buffer();
+      }
+    } else {
+      write_line_buffer(); // group: the whole batch shares one fdatasync
+    }
+  });
+  _log_size += batch_bytes;
+  track(entries);
+  return false;
+}
+stCompactionJob clsOpLog::begin_compaction() const {
+  stCompactionJob job;
+  job.data_file_path = _data_file_path;
+  job.log_file_path = _log_file_path;
+  job.snapshot_path = snapshot_path();
+  if (std::filesystem::exists(account_index_path()))
+    job.account_index_path = account_index_path();
+  job.log_offset = _log_size;
+  job.generation = _generation;
+  job.durable = _sync_policy != enSyncPolicy::none;
+  return job;
+}
+
+void clsOpLog::prepare_compaction(stCompactionJob &job) {
+  // Memory: the covered log prefix (below the fold threshold) plus the state.
+  std::string log_prefix;
+  if (!read_file_range(job.log_file_path, 0, job.log_offset, log_prefix))
+    throw std::runtime_error("The operation log was rewritten meanwhile: " +
+                             job.log_file_path.string());
+
+  std::vector<client_data_structure::stClientData> records;
+  std::uintmax_t covered = 0;
+  {
+    // A checkpoint taken after begin_compaction() covers too much; then the
+    // data file is parsed instead.
+    columnar_snapshot::clsSnapshotFile snapshot;
+    if (snapshot.open(job.snapshot_path, job.data_file_path) &&
+        snapshot.log_offset() <= job.log_offset &&
+        (snapshot.log_offset() == 0 ||
+         log_prefix[snapshot.log_offset() - 1] == '\n') &&
+        snapshot.verify()) {
+      records = snapshot.to_records();
+      covered = snapshot.log_offset();
+    } else {
+      records = file_ops::load_clients_parallel(job.data_file_path);
+    }
+  }
+  apply_log_bytes(std::string_view(log_prefix).substr(covered), records);
+
+  // The "compact" tags keep these temp files apart from a rewrite or a
+  // checkpoint the owning thread may write at the same time.
+  job.temp_path = file_ops::write_clients_temp(job.data_file_path, records, "compact");
+  try {
+    if (job.durable && !platform_ops_sync::sync_file(job.temp_path))
+      throw std::runtime_error("Failed to sync the temp file: " +
+                               job.temp_path.string());
+    std::filesystem::path tagged = job.snapshot_path;
+    tagged += ".compact";
+    job.snapshot = columnar_snapshot::prepare_snapshot_file(tagged, records);
+    if (!job.account_index_path.empty())
+      job.account_index = account_index::prepare_index_file(
+          job.temp_path, job.account_index_path);
+  } catch (...) {
+    discard_compaction(job);
+    throw;
+  }
+}
+
+bool clsOpLog::finish_compaction(stCompactionJob &job) {
+  if (job.temp_path.empty() || job.generation != _generation ||
+      job.log_offset > _log_size) {
+    discard_compaction(job);
+    return false;
+  }
+  const bool durable = _sync_policy != enSyncPolicy::none;
+  const std::filesystem::path directory = _data_file_path.parent_path();
+  std::filesystem::path new_log = _log_file_path;
+  new_log += ".tmp";
+  std::string tail;
+  try {
+    _version = _lock.commit(_version, [&] {
+      // CPU: proportional to the entries appended while the rewrite ran.
+      if (!read_file_range(_log_file_path, job.log_offset,
+                           _log_size - job.log_offset, tail))
+        throw std::runtime_error("Failed to read the operation log: " +
+                                 _log_file_path.string());
+      {
+        std::ofstream out(new_log, std::ios::binary | std::ios::trunc);
+        out.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+        out.close();
+        if (out.fail() || (durable && !platform_ops_sync::sync_file(new_log)))
+          throw std::runtime_error("Failed to write the operation log: " +
+                                   new_log.string());
+      }
+      std::filesystem::rename(job.temp_path, _data_file_path);
+      // Until the log is replaced too, a crash replays the whole old log
+      // over the compacted file; upserts and deletes make that a no-op.
+      if (durable && !platform_ops_sync::sync_directory(directory))
+        throw std::runtime_error("Failed to sync the data directory: " +
+                                 directory.string());
+      std::filesystem::rename(new_log, _log_file_path);
+      open_log(false);
+      if (durable && !platform_ops_sync::sync_directory(directory))
+        throw std::runtime_error("Failed to sync the data directory: " +
+                                 directory.string());
+      columnar_snapshot::publish_snapshot_file(job.snapshot, snapshot_path(),
+                                               _data_file_path);
+      if (!job.account_index.empty())
+        account_index::publish_index_file(job.account_index,
+                                          job.account_index_path);
+      notify({}); // Same clients
+    });
+  } catch (const data_lock::clsVersionConflict &) {
+    std::error_code ignored;
+    std::filesystem::remove(new_log, ignored);
+    discard_compaction(job);
+    return false;
+  } catch (...) {
+    std::error_code ignored;
+    std::filesystem::remove(new_log, ignored);
+    discard_compaction(job);
+    throw;
+  }
+  _log_size = tail.size();
+  _checkpoint_offset = 0;
+  _tombstones = count_tombstones(tail);
+  ++_generation;
+  return true;
+}
+
+void clsOpLog::discard_compaction(stCompactionJob &job) noexcept {
+  std::error_code ignored;
+  if (!job.temp_path.empty())
+    std::filesystem::remove(job.temp_path, ignored);
+  if (!job.snapshot.temp_path.empty())
+    std::filesystem::remove(job.snapshot.temp_path, ignored);
+  if (!job.account_index.empty())
+    std::filesystem::remove(job.account_index, ignored);
+  job.temp_path.clear();
+  job.snapshot.temp_path.clear();
+  job.account_index.clear();
+}
+} // namespace op_log
@@ -2,11 +2,133 @@
 // and ends there.
 //
 
+#include "controller/add_client/handle_add_client.h"
+#include "controller/batch/handle_batch.h"
+#include "controller/daemon/handle_daemon.h"
+#include "controller/find_client/handle_find_client.h"
+#include "controller/fixed_records/handle_fixed_records.h"
 #include "controller/helper/h_handle_file_exist.h"
+#include "controller/lsm/handle_lsm.h"
+#include "controller/report/handle_report.h"
 #include "platform_ops/paths/paths.h"
+#include "services/balance/balance.h"
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <string_view>
 
-int main() {
+int main(int argc, char *argv[]) {
+  // Durability: `Safecoin --sync <none|operation|group[:microseconds]> ...`
+  // in front of a write mode sets when commits reach the disk and the
+  // daemon's group window (op_log::stSyncOptions); the default is group.
+  op_log::stSyncOptions sync;
+  if (argc >= 3 && std::string_view(argv[1]) == "--sync") {
+    if (!op_log::parse_sync_options(argv[2], sync)) {
+      std::cerr << "invalid sync policy: " << argv[2] << '\n';
+      return 1;
+    }
+    argc -= 2;
+    argv += 2;
+  }
+  // Batch mode: `Safecoin --batch [script]` runs a command script (or piped
+  // stdin when no script or "-" is given) without menus.
+  if (argc >= 2 && std::string_view(argv[1]) == "--batch") {
+    if (argc < 3 || std::string_view(argv[2]) == "-")
+      return batch_controller::run_batch_program(std::cin, sync);
+    std::ifstream script(argv[2]);
+    if (!script.is_open()) {
+      std::cerr << "cannot open batch script: " << argv[2] << '\n';
+      return 1;
+    }
+    return batch_controller::run_batch_program(script, sync);
+  }
+  // Daemon mode: `Safecoin --serve [socket]` keeps the clients in memory and
+  // serves the same commands over a Unix domain socket until SIGINT/SIGTERM.
+  if (argc >= 2 && std::string_view(argv[1]) == "--serve")
+    return daemon_controller::run_daemon_program(argc >= 3 ? argv[2] : "",
+                                                 sync);
+  // Add mode: `Safecoin --add <record line>` adds one client; the account
+  // filter spares the full duplicate scan for numbers that are definitely new.
+  if (argc >= 3 && std::string_view(argv[1]) == "--add")
+    return add_client_controller::run_add_program(argv[2], sync);
+  // Account lookup: `Safecoin --find <account>` prints that client's record
+  // line through the account index.
+  if (argc >= 3 && std::string_view(argv[1]) == "--find")
+    return find_client_controller::run_find_account_program(argv[2]);
+  // Name search: `Safecoin --find-name <prefix>` lists the clients whose name
+  // starts with prefix (any case) through the persisted name index.
+  if (argc >= 3 && std::string_view(argv[1]) == "--find-name")
+    return find_client_controller::run_find_name_program(argv[2]);
+  // Balance queries through the persisted balance index:
+  // `Safecoin --balance-range <min> <max>` (inclusive) and `Safecoin --overdrawn`.
+  if (argc >= 4 && std::string_view(argv[1]) == "--balance-range") {
+    std::int64_t low = 0, high = 0;
+    if (!balance::parse_minor_units(argv[2], low) ||
+        !balance::parse_minor_units(argv[3], high)) {
+      std::cerr << "invalid balance range: " << argv[2] << ' ' << argv[3] << '\n';
+      return 1;
+    }
+    return find_client_controller::run_balance_range_program(low, high);
+  }
+  if (argc >= 2 && std::string_view(argv[1]) == "--overdrawn")
+    return find_client_controller::run_balance_range_program(
+        std::numeric_limits<std::int64_t>::min(),
+        balance_index::OVERDRAWN_MAX_MINOR);
+  // Report: `Safecoin --totals` prints the portfolio totals of all clients.
+  if (argc >= 2 && std::string_view(argv[1]) == "--totals")
+    return report_controller::run_totals_program();
+  // Fixed-width copy: `Safecoin --to-fixed` converts the current clients once;
+  // `Safecoin --page <first> <count>` then reads rows by number from it.
+  if (argc >= 2 && std::string_view(argv[1]) == "--to-fixed")
+    return fixed_records_controller::run_convert_fixed_program();
+  if (argc >= 4 && std::string_view(argv[1]) == "--page") {
+    char *first_end = nullptr, *count_end = nullptr;
+    const std::uint64_t first = std::strtoull(argv[2], &first_end, 10);
+    const std::uint64_t count = std::strtoull(argv[3], &count_end, 10);
+    if (*argv[2] == '\0' || *first_end != '\0' || *argv[3] == '\0' ||
+        *count_end != '\0') {
+      std::cerr << "invalid page: " << argv[2] << ' ' << argv[3] << '\n';
+      return 1;
+    }
+    return fixed_records_controller::run_page_program(first, count);
+  }
+  // In-place changes of the fixed-width copy, committed to the log first:
+  // `Safecoin --fixed-balance <row> <amount>` and `Safecoin --fixed-delete <row>`.
+  if (argc >= 4 && std::string_view(argv[1]) == "--fixed-balance") {
+    char *row_end = nullptr;
+    const std::uint64_t row = std::strtoull(argv[2], &row_end, 10);
+    std::int64_t balance_minor = 0;
+    if (*argv[2] == '\0' || *row_end != '\0' ||
+        !balance::parse_minor_units(argv[3], balance_minor)) {
+      std::cerr << "invalid row or balance: " << argv[2] << ' ' << argv[3] << '\n';
+      return 1;
+    }
+    return fixed_records_controller::run_fixed_balance_program(row, balance_minor,
+                                                               sync);
+  }
+  if (argc >= 3 && std::string_view(argv[1]) == "--fixed-delete") {
+    char *row_end = nullptr;
+    const std::uint64_t row = std::strtoull(argv[2], &row_end, 10);
+    if (*argv[2] == '\0' || *row_end != '\0') {
+      std::cerr << "invalid row: " << argv[2] << '\n';
+      return 1;
+    }
+    return fixed_records_controller::run_fixed_delete_program(row, sync);
+  }
+  // Bulk load: `Safecoin --ingest [file]` upserts record lines (stdin when no
+  // file or "-" is given), staged in the LSM store and committed as one batch.
+  if (argc >= 2 && std::string_view(argv[1]) == "--ingest") {
+    if (argc < 3 || std::string_view(argv[2]) == "-")
+      return lsm_controller::run_ingest_program(std::cin, sync);
+    std::ifstream input(argv[2]);
+    if (!input.is_open()) {
+      std::cerr << "cannot open ingest file: " << argv[2] << '\n';
+      return 1;
+    }
+    return lsm_controller::run_ingest_program(input, sync);
+  }
 
   auto path = platform_ops_paths::get_exe_dir_path();
   std::cout << "exe path: " << path << '\n';
@@ -0,0 +1,44 @@
+// platform_ops/cpu/cpu.cpp
+
+#include "platform_ops/cpu/cpu.h"
+#if defined(_MSC_VER) && defined(PLATFORM_OPS_X86)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace platform_ops_cpu {
+bool has_sse2() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+  return true; // SSE2 is mandatory on x86-64.
+#elif defined(PLATFORM_OPS_X86) && (defined(__GNUC__) || defined(__clang__))
+  return __builtin_cpu_supports("sse2");
+#else
+  return false;
+#endif
+}
+
+bool has_avx2() noexcept {
+  // Evaluated once, on first call; later calls are a single load.
+  static const bool supported = []() noexcept {
+#if defined(PLATFORM_OPS_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#elif defined(PLATFORM_OPS_X86) && defined(_MSC_VER)
+    int regs[4]{};
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+      return false;
+    __cpuid(regs, 1);
+    const bool os_saves_ymm = (regs[2] & (1 << 27)) != 0 && // OSXSAVE
+                              (_xgetbv(0) & 0x6) == 0x6;     // XMM + YMM state
+    if (!os_saves_ymm)
+      return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0; // EBX bit 5 = AVX2
+#else
+    return false;
+#endif
+  }();
+  return supported;
+}
+} // namespace platform_ops_cpu
@@ -29,10 +29,12 @@ void create_original_file(const std::filesystem::path &exe_file_path) {
 
   // original_file_path now holds something like "C:\\MyApp\\data\\original.csv"
 
-  std::ofstream original_file(original_file_path);
+  std::ofstream original_file(original_file_path, std::ios::app);
   // Constructs an ofstream and attempts to open (or create) the file at
   // original_file_path Internally, this calls the OS create/open system call,
   // transitioning CPU from user to kernel mode
+  // std::ios::app creates a missing file but never truncates: if another
+  // process created and filled it after our existence check, its data stays.
 
   if (!original_file.is_open())
     // is_open() checks if the stream has an associated file descriptor; returns
@@ -0,0 +1,88 @@
+// platform_ops/epoch/epoch.cpp
+
+#include "platform_ops/epoch/epoch.h"
+#include <algorithm>
+#include <thread>
+
+namespace platform_ops_epoch {
+clsEpochDomain::clsGuard &
+clsEpochDomain::clsGuard::operator=(clsGuard &&other) noexcept {
+  if (this != &other) {
+    unpin();
+    _slot = other._slot;
+    other._slot = nullptr;
+  }
+  return *this;
+}
+
+void clsEpochDomain::clsGuard::unpin() noexcept {
+  if (_slot != nullptr)
+    _slot->store(IDLE, std::memory_order_release);
+  _slot = nullptr;
+}
+
+clsEpochDomain::~clsEpochDomain() {
+  for (auto &retired : _retired)
+    retired.deleter();
+}
+
+clsEpochDomain::clsGuard clsEpochDomain::pin() noexcept {
+  // Start the slot search at a per-thread position so concurrent readers
+  // usually claim different slots on the first try.
+  const std::size_t start =
+      std::hash<std::thread::id>{}(std::this_thread::get_id()) % MAX_READERS;
+  for (;;) {
+    for (std::size_t k = 0; k < MAX_READERS; ++k) {
+      std::atomic<std::uint64_t> &slot = _slots[(start + k) % MAX_READERS].epoch;
+      std::uint64_t expected = IDLE;
+      // seq_cst: this store must be ordered before the reader's next load
+      // of a shared pointer, and against the writer's epoch advance.
+      if (slot.load(std::memory_order_relaxed) == IDLE &&
+          slot.compare_exchange_strong(
+              expected, _global_epoch.load(std::memory_order_seq_cst),
+              std::memory_order_seq_cst))
+        return clsGuard(&slot);
+    }
+    std::this_thread::yield(); // Every slot pinned: wait for one to free up
+  }
+}
+
+void clsEpochDomain::retire(std::function<void()> deleter) {
+  // Stamp with the epoch before the advance: a reader that pins afterwards
+  // records a later epoch and cannot have loaded the unlinked pointer.
+  std::lock_guard lock(_retired_mutex);
+  const std::uint64_t epoch =
+      _global_epoch.fetch_add(1, std::memory_order_seq_cst);
+  _retired.push_back({epoch, std::move(deleter)});
+}
+
+std::size_t clsEpochDomain::reclaim() {
+  // Objects retired after this load are stamped with it or later and stay,
+  // even if the scan below finds no reader pinned.
+  std::uint64_t oldest_pinned = _global_epoch.load(std::memory_order_seq_cst);
+  for (const auto &slot : _slots)
+    oldest_pinned =
+        std::min(oldest_pinned, slot.epoch.load(std::memory_order_seq_cst));
+
+  std::vector<std::function<void()>> ready;
+  {
+    std::lock_guard lock(_retired_mutex);
+    auto keep = std::partition(_retired.begin(), _retired.end(),
+                               [oldest_pinned](const stRetired &retired) {
+                                 return retired.epoch >= oldest_pinned;
+                               });
+    for (auto it = keep; it != _retired.end(); ++it)
+      ready.push_back(std::move(it->deleter));
+    _retired.erase(keep, _retired.end());
+  }
+  // Run the deleters outside the lock; they may be slow (large tables).
+  for (auto &deleter : ready)
+    deleter();
+  return ready.size();
+}
+
+std::size_t clsEpochDomain::retired_count() const {
+  std::lock_guard lock(_retired_mutex);
+  return _retired.size();
+}
+} // namespace platform_ops_epoch
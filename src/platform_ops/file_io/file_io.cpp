@@ -0,0 +1,199 @@
+// platform_ops/file_io/file_io.cpp
+
+#include "platform_ops/file_io/file_io.h"
+#include <utility>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace platform_ops_file_io {
+clsRandomAccessFile::~clsRandomAccessFile() { close(); }
+
+clsRandomAccessFile::clsRandomAccessFile(clsRandomAccessFile &&other) noexcept {
+  *this = std::move(other);
+}
+
+clsRandomAccessFile &
+clsRandomAccessFile::operator=(clsRandomAccessFile &&other) noexcept {
+  if (this == &other)
+    return *this;
+  close();
+#ifdef _WIN32
+  _handle = std::exchange(other._handle, nullptr);
+#else
+  _fd = std::exchange(other._fd, -1);
+#endif
+  return *this;
+}
+
+#ifdef _WIN32
+namespace {
+OVERLAPPED at(std::uint64_t offset) noexcept {
+  OVERLAPPED position{};
+  position.Offset = static_cast<DWORD>(offset);
+  position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+  return position;
+}
+
+// One ReadFile/WriteFile moves at most 4 GiB - 1.
+constexpr std::size_t MAX_CHUNK = 1u << 30;
+} // namespace
+
+bool clsRandomAccessFile::open(const std::filesystem::path &file_path,
+                               enOpenMode mode) noexcept {
+  close();
+  const DWORD access = mode == enOpenMode::read_only
+                           ? GENERIC_READ
+                           : GENERIC_READ | GENERIC_WRITE;
+  const DWORD disposition =
+      mode == enOpenMode::create ? CREATE_ALWAYS : OPEN_EXISTING;
+  HANDLE file = CreateFileW(file_path.c_str(), access,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  _handle = file;
+  return true;
+}
+
+void clsRandomAccessFile::close() noexcept {
+  if (_handle != nullptr)
+    CloseHandle(_handle);
+  _handle = nullptr;
+}
+
+bool clsRandomAccessFile::is_open() const noexcept { return _handle != nullptr; }
+
+std::uint64_t clsRandomAccessFile::size() const noexcept {
+  LARGE_INTEGER size{};
+  if (_handle == nullptr || !GetFileSizeEx(_handle, &size))
+    return 0;
+  return static_cast<std::uint64_t>(size.QuadPart);
+}
+
+bool clsRandomAccessFile::read_at(std::uint64_t offset, void *buffer,
+                                  std::size_t bytes) const noexcept {
+  auto *cursor = static_cast<char *>(buffer);
+  while (bytes > 0) {
+    OVERLAPPED position = at(offset);
+    DWORD moved = 0;
+    const DWORD chunk = static_cast<DWORD>(bytes < MAX_CHUNK ? bytes : MAX_CHUNK);
+    if (_handle == nullptr || !ReadFile(_handle, cursor, chunk, &moved, &position) ||
+        moved == 0)
+      return false;
+    cursor += moved;
+    offset += moved;
+    bytes -= moved;
+  }
+  return true;
+}
+
+bool clsRandomAccessFile::write_at(std::uint64_t offset, const void *buffer,
+                                   std::size_t bytes) noexcept {
+  const auto *cursor = static_cast<const char *>(buffer);
+  while (bytes > 0) {
+    OVERLAPPED position = at(offset);
+    DWORD moved = 0;
+    const DWORD chunk = static_cast<DWORD>(bytes < MAX_CHUNK ? bytes : MAX_CHUNK);
+    if (_handle == nullptr ||
+        !WriteFile(_handle, cursor, chunk, &moved, &position) || moved == 0)
+      return false;
+    cursor += moved;
+    offset += moved;
+    bytes -= moved;
+  }
+  return true;
+}
+
+bool clsRandomAccessFile::sync_data() noexcept {
+  return _handle != nullptr && FlushFileBuffers(_handle) != 0;
+}
+#else
+bool clsRandomAccessFile::open(const std::filesystem::path &file_path,
+                               enOpenMode mode) noexcept {
+  close();
+  int flags = O_CLOEXEC;
+  switch (mode) {
+  case enOpenMode::read_only:
+    flags |= O_RDONLY;
+    break;
+  case enOpenMode::read_write:
+    flags |= O_RDWR;
+    break;
+  case enOpenMode::create:
+    flags |= O_RDWR | O_CREAT | O_TRUNC;
+    break;
+  }
+  _fd = ::open(file_path.c_str(), flags, 0644);
+  return _fd != -1;
+}
+
+void clsRandomAccessFile::close() noexcept {
+  if (_fd != -1)
+    ::close(_fd);
+  _fd = -1;
+}
+
+bool clsRandomAccessFile::is_open() const noexcept { return _fd != -1; }
+
+std::uint64_t clsRandomAccessFile::size() const noexcept {
+  struct stat info{};
+  if (_fd == -1 || ::fstat(_fd, &info) != 0)
+    return 0;
+  return static_cast<std::uint64_t>(info.st_size);
+}
+
+bool clsRandomAccessFile::read_at(std::uint64_t offset, void *buffer,
+                                  std::size_t bytes) const noexcept {
+  auto *cursor = static_cast<char *>(buffer);
+  while (bytes > 0) {
+    const ssize_t moved =
+        ::pread(_fd, cursor, bytes, static_cast<off_t>(offset));
+    if (moved == -1 && errno == EINTR)
+      continue;
+    if (moved <= 0)
+      return false; // Error, or past the end
+    cursor += moved;
+    offset += static_cast<std::uint64_t>(moved);
+    bytes -= static_cast<std::size_t>(moved);
+  }
+  return true;
+}
+
+bool clsRandomAccessFile::write_at(std::uint64_t offset, const void *buffer,
+                                   std::size_t bytes) noexcept {
+  const auto *cursor = static_cast<const char *>(buffer);
+  while (bytes > 0) {
+    const ssize_t moved =
+        ::pwrite(_fd, cursor, bytes, static_cast<off_t>(offset));
+    if (moved == -1 && errno == EINTR)
+      continue;
+    if (moved <= 0)
+      return false;
+    cursor += moved;
+    offset += static_cast<std::uint64_t>(moved);
+    bytes -= static_cast<std::size_t>(moved);
+  }
+  return true;
+}
+
+bool clsRandomAccessFile::sync_data() noexcept {
+  if (_fd == -1)
+    return false;
+  int result;
+  do
+#ifdef __linux__
+    result = ::fdatasync(_fd);
+#else
+    result = ::fsync(_fd);
+#endif
+  while (result == -1 && errno == EINTR);
+  return result == 0;
+}
+#endif
+} // namespace platform_ops_file_io
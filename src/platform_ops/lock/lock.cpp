@@ -0,0 +1,186 @@
+// platform_ops/lock/lock.cpp
+
+#include "platform_ops/lock/lock.h"
+#include <cstring>
+#include <utility>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace platform_ops_lock {
+clsFileLock::~clsFileLock() { close(); }
+
+clsFileLock::clsFileLock(clsFileLock &&other) noexcept {
+  *this = std::move(other);
+}
+
+clsFileLock &clsFileLock::operator=(clsFileLock &&other) noexcept {
+  if (this == &other)
+    return *this;
+  close();
+#ifdef _WIN32
+  _handle = std::exchange(other._handle, nullptr);
+#else
+  _fd = std::exchange(other._fd, -1);
+#endif
+  return *this;
+}
+
+#ifdef _WIN32
+namespace {
+// A single byte far beyond any real stamp file; locking it never blocks I/O
+// on the bytes that hold the stamp.
+constexpr DWORD LOCK_OFFSET_HIGH = 0x7fffffff;
+} // namespace
+
+bool clsFileLock::open(const std::filesystem::path &lock_file_path) noexcept {
+  close();
+  HANDLE file = CreateFileW(lock_file_path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  _handle = file;
+  return true;
+}
+
+void clsFileLock::close() noexcept {
+  if (_handle != nullptr) {
+    unlock();
+    CloseHandle(_handle);
+  }
+  _handle = nullptr;
+}
+
+bool clsFileLock::is_open() const noexcept { return _handle != nullptr; }
+
+bool clsFileLock::set_lock(enLockMode mode, bool wait) noexcept {
+  if (_handle == nullptr)
+    return false;
+  unlock(); // LockFileEx does not convert modes; drop the old one first
+  OVERLAPPED region{};
+  region.OffsetHigh = LOCK_OFFSET_HIGH;
+  DWORD flags = mode == enLockMode::exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0;
+  if (!wait)
+    flags |= LOCKFILE_FAIL_IMMEDIATELY;
+  return LockFileEx(_handle, flags, 0, 1, 0, &region) != 0;
+}
+
+void clsFileLock::unlock() noexcept {
+  if (_handle == nullptr)
+    return;
+  OVERLAPPED region{};
+  region.OffsetHigh = LOCK_OFFSET_HIGH;
+  UnlockFileEx(_handle, 0, 1, 0, &region); // Fails harmlessly if not locked
+}
+
+bool clsFileLock::read_stamp(std::uint64_t &stamp) const noexcept {
+  stamp = 0;
+  if (_handle == nullptr)
+    return false;
+  unsigned char bytes[8]{};
+  OVERLAPPED at_start{};
+  DWORD read = 0;
+  if (!ReadFile(_handle, bytes, sizeof(bytes), &read, &at_start) &&
+      GetLastError() != ERROR_HANDLE_EOF)
+    return false;
+  if (read == sizeof(bytes))
+    std::memcpy(&stamp, bytes, sizeof(stamp));
+  return true;
+}
+
+bool clsFileLock::write_stamp(std::uint64_t stamp) noexcept {
+  if (_handle == nullptr)
+    return false;
+  OVERLAPPED at_start{};
+  DWORD written = 0;
+  return WriteFile(_handle, &stamp, sizeof(stamp), &written, &at_start) &&
+         written == sizeof(stamp) && FlushFileBuffers(_handle);
+}
+
+std::uint64_t current_process_id() noexcept { return GetCurrentProcessId(); }
+#else
+bool clsFileLock::open(const std::filesystem::path &lock_file_path) noexcept {
+  close();
+  _fd = ::open(lock_file_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  return _fd != -1;
+}
+
+void clsFileLock::close() noexcept {
+  if (_fd != -1)
+    ::close(_fd); // Releases the lock with the descriptor
+  _fd = -1;
+}
+
+bool clsFileLock::is_open() const noexcept { return _fd != -1; }
+
+bool clsFileLock::set_lock(enLockMode mode, bool wait) noexcept {
+  if (_fd == -1)
+    return false;
+  int result;
+#ifdef F_OFD_SETLKW
+  struct flock request{};
+  request.l_type = mode == enLockMode::exclusive ? F_WRLCK : F_RDLCK;
+  request.l_whence = SEEK_SET; // l_start = l_len = 0: the whole file
+  do
+    result = ::fcntl(_fd, wait ? F_OFD_SETLKW : F_OFD_SETLK, &request);
+  while (result == -1 && errno == EINTR);
+#else
+  const int operation =
+      (mode == enLockMode::exclusive ? LOCK_EX : LOCK_SH) | (wait ? 0 : LOCK_NB);
+  do
+    result = ::flock(_fd, operation);
+  while (result == -1 && errno == EINTR);
+#endif
+  return result == 0;
+}
+
+void clsFileLock::unlock() noexcept {
+  if (_fd == -1)
+    return;
+#ifdef F_OFD_SETLK
+  struct flock request{};
+  request.l_type = F_UNLCK;
+  request.l_whence = SEEK_SET;
+  ::fcntl(_fd, F_OFD_SETLK, &request);
+#else
+  ::flock(_fd, LOCK_UN);
+#endif
+}
+
+bool clsFileLock::read_stamp(std::uint64_t &stamp) const noexcept {
+  stamp = 0;
+  if (_fd == -1)
+    return false;
+  unsigned char bytes[8]{};
+  const ssize_t read = ::pread(_fd, bytes, sizeof(bytes), 0);
+  if (read == -1)
+    return false;
+  if (read == static_cast<ssize_t>(sizeof(bytes)))
+    std::memcpy(&stamp, bytes, sizeof(stamp));
+  return true;
+}
+
+bool clsFileLock::write_stamp(std::uint64_t stamp) noexcept {
+  if (_fd == -1)
+    return false;
+  return ::pwrite(_fd, &stamp, sizeof(stamp), 0) ==
+         static_cast<ssize_t>(sizeof(stamp));
+}
+
+std::uint64_t current_process_id() noexcept {
+  return static_cast<std::uint64_t>(::getpid());
+}
+#endif
+
+bool clsFileLock::lock(enLockMode mode) noexcept { return set_lock(mode, true); }
+
+bool clsFileLock::try_lock(enLockMode mode) noexcept {
+  return set_lock(mode, false);
+}
+} // namespace platform_ops_lock
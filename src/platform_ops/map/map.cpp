@@ -0,0 +1,150 @@
+// platform_ops/map/map.cpp
+
+#include "platform_ops/map/map.h"
+#include <utility>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace platform_ops_map {
+clsMappedFile::~clsMappedFile() { close(); }
+
+clsMappedFile::clsMappedFile(clsMappedFile &&other) noexcept {
+  *this = std::move(other);
+}
+
+clsMappedFile &clsMappedFile::operator=(clsMappedFile &&other) noexcept {
+  if (this == &other)
+    return *this;
+  close();
+  // Steal the handles; the mapped address itself does not move, so every
+  // string_view previously taken from other.view() stays valid.
+  _data = std::exchange(other._data, nullptr);
+  _size = std::exchange(other._size, 0);
+  _is_open = std::exchange(other._is_open, false);
+  _writable = std::exchange(other._writable, false);
+#ifdef _WIN32
+  _file_handle = std::exchange(other._file_handle, nullptr);
+  _map_handle = std::exchange(other._map_handle, nullptr);
+#else
+  _fd = std::exchange(other._fd, -1);
+#endif
+  return *this;
+}
+
+bool clsMappedFile::open(const std::filesystem::path &file_path,
+                         enMapMode mode) noexcept {
+  close();
+  const bool writable = mode == enMapMode::read_write;
+#ifdef _WIN32
+  // Share everything: writers (the operation log, a rewrite + rename) must not
+  // be blocked by a reader holding a mapping.
+  HANDLE file = CreateFileW(file_path.c_str(),
+                            writable ? GENERIC_READ | GENERIC_WRITE
+                                     : GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE |
+                                FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  _file_handle = file;
+
+  LARGE_INTEGER file_size{};
+  if (!GetFileSizeEx(file, &file_size)) {
+    close();
+    return false;
+  }
+  _size = static_cast<std::size_t>(file_size.QuadPart);
+  _is_open = true;
+  if (_size == 0)
+    return true; // Nothing to map; CreateFileMapping rejects empty files.
+
+  HANDLE mapping =
+      CreateFileMappingW(file, nullptr,
+                         writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0,
+                         nullptr);
+  if (mapping == nullptr) {
+    close();
+    return false;
+  }
+  _map_handle = mapping;
+
+  void *view = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ,
+                             0, 0, 0);
+  if (view == nullptr) {
+    close();
+    return false;
+  }
+  _data = static_cast<const char *>(view);
+#else
+  // CPU: open + fstat are two kernel transitions; no data is read yet.
+  _fd = ::open(file_path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+  if (_fd == -1)
+    return false;
+
+  struct stat file_stat{};
+  if (::fstat(_fd, &file_stat) == -1 || !S_ISREG(file_stat.st_mode)) {
+    close();
+    return false;
+  }
+  _size = static_cast<std::size_t>(file_stat.st_size);
+  _is_open = true;
+  if (_size == 0)
+    return true; // mmap rejects a zero length; an empty view is enough.
+
+  // Memory: reserves address space only; pages are faulted in on first touch
+  // straight from the page cache, without copying into a user buffer.
+  void *view = ::mmap(nullptr, _size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                      writable ? MAP_SHARED : MAP_PRIVATE, _fd, 0);
+  if (view == MAP_FAILED) {
+    close();
+    return false;
+  }
+  // Hint only; failure is harmless. Writable mappings are index files that
+  // are probed at random, so read-ahead would only waste page cache.
+  ::madvise(view, _size, writable ? MADV_RANDOM : MADV_SEQUENTIAL);
+  _data = static_cast<const char *>(view);
+#endif
+  _writable = writable;
+  return true;
+}
+
+bool clsMappedFile::flush() noexcept {
+  if (!_writable || _data == nullptr)
+    return true; // Nothing dirty to write back
+#ifdef _WIN32
+  return FlushViewOfFile(_data, 0) != 0;
+#else
+  return ::msync(const_cast<char *>(_data), _size, MS_SYNC) == 0;
+#endif
+}
+
+void clsMappedFile::close() noexcept {
+#ifdef _WIN32
+  if (_data != nullptr)
+    UnmapViewOfFile(_data);
+  if (_map_handle != nullptr)
+    CloseHandle(_map_handle);
+  if (_file_handle != nullptr)
+    CloseHandle(_file_handle);
+  _map_handle = nullptr;
+  _file_handle = nullptr;
+#else
+  if (_data != nullptr)
+    ::munmap(const_cast<char *>(_data), _size);
+  if (_fd != -1)
+    ::close(_fd);
+  _fd = -1;
+#endif
+  _data = nullptr;
+  _size = 0;
+  _is_open = false;
+  _writable = false;
+}
+} // namespace platform_ops_map
@@ -89,6 +89,13 @@ get_original_file_path(const std::filesystem::path &exe_dir_path) {
                                                    // string) as the filename
 }
 
+std::filesystem::path
+get_data_file_path(const std::filesystem::path &exe_dir_path,
+                   std::string_view file_name) {
+  // Same layout as get_original_file_path, for any file under the data dir
+  return exe_dir_path / infrastructure_names::DATA_DIR_NAME / file_name;
+}
+
 bool is_file_exist(const std::filesystem::path &file_path) {
   // file_path: bound as a const reference, so no deep copy of the path’s
   // internal string occurs here Returns true if the given path names a regular
@@ -0,0 +1,181 @@
+// platform_ops/scheduler/scheduler.cpp
+
+#include "platform_ops/scheduler/scheduler.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace platform_ops_scheduler {
+namespace {
+// Which scheduler (if any) the current thread works for, and its deque.
+thread_local const clsTaskScheduler *current_scheduler = nullptr;
+thread_local unsigned current_index = 0;
+
+// xorshift64: victim selection only needs to be cheap and spread out.
+std::uint64_t next_random() noexcept {
+  thread_local std::uint64_t state =
+      0x9e3779b97f4a7c15ull ^
+      reinterpret_cast<std::uintptr_t>(&current_index); // Distinct per thread
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+} // namespace
+
+clsTaskScheduler::clsTaskScheduler(unsigned worker_count) {
+  if (worker_count == 0)
+    worker_count = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned i = 0; i <= worker_count; ++i) // +1: the injection queue
+    _queues.push_back(std::make_unique<stTaskQueue>());
+  _workers.reserve(worker_count);
+  for (unsigned i = 0; i < worker_count; ++i)
+    _workers.emplace_back([this, i] { worker_loop(i); });
+}
+
+clsTaskScheduler::~clsTaskScheduler() {
+  {
+    std::lock_guard lock(_sleep_mutex);
+    _stopping = true;
+  }
+  _wake.notify_all();
+  _workers.clear(); // jthreads join here, after draining the queues
+}
+
+void clsTaskScheduler::submit(task_type task) {
+  const bool on_worker = current_scheduler == this;
+  stTaskQueue &queue = *_queues[on_worker ? current_index : _workers.size()];
+  {
+    std::lock_guard lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  _queued.fetch_add(1, std::memory_order_release);
+  // Taking the sleep mutex orders this push against a worker that has just
+  // seen _queued == 0 and is about to wait, so the wake-up cannot be lost.
+  { std::lock_guard lock(_sleep_mutex); }
+  _wake.notify_one();
+}
+
+bool clsTaskScheduler::try_take(task_type &task) {
+  if (_queued.load(std::memory_order_acquire) == 0)
+    return false;
+
+  const std::size_t worker_total = _workers.size();
+  auto pop = [&](std::size_t index, bool from_back) {
+    stTaskQueue &queue = *_queues[index];
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty())
+      return false;
+    if (from_back) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    _queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  };
+
+  // Own deque (newest first), then the injection queue (oldest first).
+  if (current_scheduler == this && pop(current_index, true))
+    return true;
+  if (pop(worker_total, false))
+    return true;
+
+  // Steal the oldest task of a random victim, trying each worker once.
+  const std::size_t start = static_cast<std::size_t>(next_random() % worker_total);
+  for (std::size_t k = 0; k < worker_total; ++k) {
+    const std::size_t victim = (start + k) % worker_total;
+    if (current_scheduler == this && victim == current_index)
+      continue;
+    if (pop(victim, false))
+      return true;
+  }
+  return false;
+}
+
+bool clsTaskScheduler::run_one() {
+  task_type task;
+  if (!try_take(task))
+    return false;
+  task();
+  return true;
+}
+
+void clsTaskScheduler::worker_loop(unsigned index) {
+  current_scheduler = this;
+  current_index = index;
+  task_type task;
+  for (;;) {
+    if (try_take(task)) {
+      task();
+      task = nullptr; // Release captures before sleeping
+      continue;
+    }
+    std::unique_lock lock(_sleep_mutex);
+    _wake.wait(lock, [this] {
+      return _stopping || _queued.load(std::memory_order_acquire) != 0;
+    });
+    if (_stopping && _queued.load(std::memory_order_acquire) == 0)
+      return;
+  }
+}
+
+clsTaskScheduler &default_scheduler() {
+  // Created on first use and shared by every parallel path in the process.
+  static clsTaskScheduler scheduler;
+  return scheduler;
+}
+
+clsTaskGroup::~clsTaskGroup() { wait_for_tasks(); }
+
+void clsTaskGroup::run(std::function<void()> task) {
+  {
+    std::lock_guard lock(_state_mutex);
+    ++_pending;
+  }
+  _scheduler.submit([this, task = std::move(task)] {
+    std::exception_ptr error;
+    try {
+      task();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    // Notify while holding the lock: a waiter can only see _pending == 0
+    // after this unlock, so *this outlives every access made here.
+    std::lock_guard lock(_state_mutex);
+    if (error && !_error)
+      _error = std::move(error);
+    if (--_pending == 0)
+      _done.notify_all();
+  });
+}
+
+void clsTaskGroup::wait_for_tasks() noexcept {
+  for (;;) {
+    {
+      std::lock_guard lock(_state_mutex);
+      if (_pending == 0)
+        return;
+    }
+    // Help with queued work (ours or anyone's) rather than block; block
+    // only when everything left is already running on other threads.
+    if (_scheduler.run_one())
+      continue;
+    std::unique_lock lock(_state_mutex);
+    _done.wait(lock, [this] { return _pending == 0; });
+  }
+}
+
+void clsTaskGroup::wait() {
+  wait_for_tasks();
+  std::exception_ptr error;
+  {
+    std::lock_guard lock(_state_mutex);
+    error = std::exchange(_error, nullptr);
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+} // namespace platform_ops_scheduler
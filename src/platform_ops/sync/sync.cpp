@@ -0,0 +1,104 @@
+// platform_ops/sync/sync.cpp
+
+#include "platform_ops/sync/sync.h"
+#include <utility>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace platform_ops_sync {
+clsFileSync::~clsFileSync() { close(); }
+
+clsFileSync::clsFileSync(clsFileSync &&other) noexcept {
+  *this = std::move(other);
+}
+
+clsFileSync &clsFileSync::operator=(clsFileSync &&other) noexcept {
+  if (this == &other)
+    return *this;
+  close();
+#ifdef _WIN32
+  _handle = std::exchange(other._handle, nullptr);
+#else
+  _fd = std::exchange(other._fd, -1);
+#endif
+  return *this;
+}
+
+#ifdef _WIN32
+bool clsFileSync::open(const std::filesystem::path &file_path) noexcept {
+  close();
+  // FlushFileBuffers needs write access to the handle.
+  HANDLE file = CreateFileW(file_path.c_str(), GENERIC_WRITE,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  _handle = file;
+  return true;
+}
+
+void clsFileSync::close() noexcept {
+  if (_handle != nullptr)
+    CloseHandle(_handle);
+  _handle = nullptr;
+}
+
+bool clsFileSync::is_open() const noexcept { return _handle != nullptr; }
+
+bool clsFileSync::sync_data() noexcept {
+  return _handle != nullptr && FlushFileBuffers(_handle) != 0;
+}
+
+bool sync_directory(const std::filesystem::path &) noexcept { return true; }
+#else
+bool clsFileSync::open(const std::filesystem::path &file_path) noexcept {
+  close();
+  _fd = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+  return _fd != -1;
+}
+
+void clsFileSync::close() noexcept {
+  if (_fd != -1)
+    ::close(_fd);
+  _fd = -1;
+}
+
+bool clsFileSync::is_open() const noexcept { return _fd != -1; }
+
+bool clsFileSync::sync_data() noexcept {
+  if (_fd == -1)
+    return false;
+  int result;
+  do
+#ifdef __linux__
+    result = ::fdatasync(_fd);
+#else
+    result = ::fsync(_fd);
+#endif
+  while (result == -1 && errno == EINTR);
+  return result == 0;
+}
+
+bool sync_directory(const std::filesystem::path &directory_path) noexcept {
+  const int fd = ::open(directory_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd == -1)
+    return false;
+  int result;
+  do
+    result = ::fsync(fd);
+  while (result == -1 && errno == EINTR);
+  ::close(fd);
+  return result == 0;
+}
+#endif
+
+bool sync_file(const std::filesystem::path &file_path) noexcept {
+  clsFileSync file;
+  return file.open(file_path) && file.sync_data();
+}
+} // namespace platform_ops_sync
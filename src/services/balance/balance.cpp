@@ -0,0 +1,297 @@
+// client_data_app/src/services/balance/balance.cpp
+
+#include "services/balance/balance.h"
+#include "platform_ops/cpu/cpu.h"
+#include <charconv>
+#include <cmath>
+#include <limits>
+#ifdef PLATFORM_OPS_X86
+#include <immintrin.h>
+#endif
+
+namespace balance {
+
+namespace {
+constexpr std::int64_t INT64_MAX_VALUE = std::numeric_limits<std::int64_t>::max();
+constexpr std::int64_t INT64_MIN_VALUE = std::numeric_limits<std::int64_t>::min();
+
+// Anything the plain-decimal fast path does not handle (exponents, "inf").
+bool parse_via_double(std::string_view text, std::int64_t &minor_units) noexcept {
+  double value{};
+  auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (ec != std::errc{} || ptr != text.data() + text.size() || !std::isfinite(value))
+    return false;
+  double scaled = std::round(value * static_cast<double>(MINOR_UNITS_PER_MAJOR));
+  // 2^63 is exactly representable; anything at or beyond it does not fit.
+  if (scaled >= 9223372036854775808.0 || scaled < -9223372036854775808.0)
+    return false;
+  minor_units = static_cast<std::int64_t>(scaled);
+  return true;
+}
+} // namespace
+
+bool parse_minor_units(std::string_view text, std::int64_t &minor_units) noexcept {
+  std::size_t i = 0;
+  // No leading '+': std::from_chars, and so h_convert::convert_line_to_record,
+  // rejects it too, and both must agree on which lines hold a balance.
+  const bool negative = !text.empty() && text[0] == '-';
+  if (negative)
+    ++i;
+
+  // Magnitude accumulates in unsigned so that INT64_MIN is reachable.
+  std::uint64_t major = 0;
+  std::size_t digits = 0;
+  for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i, ++digits) {
+    if (major > (std::numeric_limits<std::uint64_t>::max() - 9) / 10)
+      return parse_via_double(text, minor_units);
+    major = major * 10 + static_cast<std::uint64_t>(text[i] - '0');
+  }
+
+  std::uint64_t minor = 0;
+  bool round_up = false;
+  if (i < text.size() && text[i] == '.') {
+    ++i;
+    std::size_t fraction_digits = 0;
+    for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i, ++fraction_digits) {
+      if (fraction_digits < 2)
+        minor = minor * 10 + static_cast<std::uint64_t>(text[i] - '0');
+      else if (fraction_digits == 2)
+        round_up = text[i] >= '5'; // Half away from zero
+    }
+    if (fraction_digits == 1)
+      minor *= 10; // "0.5" is 50 minor units
+    digits += fraction_digits;
+  }
+
+  if (i != text.size())
+    return parse_via_double(text, minor_units); // Exponent or junk
+  if (digits == 0)
+    return false;
+
+  constexpr std::uint64_t LIMIT = static_cast<std::uint64_t>(INT64_MAX_VALUE) + 1; // |INT64_MIN|
+  // uint64 has room above LIMIT, so this only guards the multiplication itself.
+  if (major > (std::numeric_limits<std::uint64_t>::max() - 100) / MINOR_UNITS_PER_MAJOR)
+    return false;
+  std::uint64_t magnitude = major * MINOR_UNITS_PER_MAJOR + minor + (round_up ? 1 : 0);
+  if (magnitude > (negative ? LIMIT : LIMIT - 1))
+    return false;
+
+  minor_units = negative ? static_cast<std::int64_t>(0 - magnitude)
+                         : static_cast<std::int64_t>(magnitude);
+  return true;
+}
+
+void append_minor_units(std::int64_t minor_units, std::string &out) {
+  const bool negative = minor_units < 0;
+  const std::uint64_t magnitude =
+      negative ? 0 - static_cast<std::uint64_t>(minor_units)
+               : static_cast<std::uint64_t>(minor_units);
+  if (negative)
+    out.push_back('-');
+
+  char digits[24];
+  auto result = std::to_chars(digits, digits + sizeof(digits),
+                              magnitude / MINOR_UNITS_PER_MAJOR);
+  out.append(digits, result.ptr);
+  const auto cents = static_cast<unsigned>(magnitude % MINOR_UNITS_PER_MAJOR);
+  out.push_back('.');
+  out.push_back(static_cast<char>('0' + cents / 10));
+  out.push_back(static_cast<char>('0' + cents % 10));
+}
+
+std::int64_t to_minor_units(double major_units) noexcept {
+  const std::int64_t rounded =
+      std::llround(major_units * static_cast<double>(MINOR_UNITS_PER_MAJOR));
+  if (to_major_units(rounded) == major_units)
+    return rounded; // Whole cents, the common case
+  // CPU: one to_chars + parse only for sub-cent values. The shortest text is
+  // what the data file and the log hold for this double, so 1.005 gives 101
+  // like parse_minor_units("1.005"), not llround(100.49999999999999) = 100.
+  char text[32];
+  auto result = std::to_chars(text, text + sizeof(text), major_units);
+  std::int64_t minor_units{};
+  if (result.ec != std::errc{} ||
+      !parse_minor_units(std::string_view(text, static_cast<std::size_t>(result.ptr - text)),
+                         minor_units))
+    return rounded;
+  return minor_units;
+}
+
+std::int64_t sum_minor_scalar(std::span<const std::int64_t> balances) noexcept {
+  // Unsigned adds: overflow wraps instead of being undefined behaviour.
+  std::uint64_t total = 0;
+  for (std::int64_t value : balances)
+    total += static_cast<std::uint64_t>(value);
+  return static_cast<std::int64_t>(total);
+}
+
+std::int64_t min_minor_scalar(std::span<const std::int64_t> balances) noexcept {
+  std::int64_t lowest = INT64_MAX_VALUE;
+  for (std::int64_t value : balances)
+    lowest = value < lowest ? value : lowest;
+  return lowest;
+}
+
+std::int64_t max_minor_scalar(std::span<const std::int64_t> balances) noexcept {
+  std::int64_t highest = INT64_MIN_VALUE;
+  for (std::int64_t value : balances)
+    highest = value > highest ? value : highest;
+  return highest;
+}
+
+std::size_t count_between_scalar(std::span<const std::int64_t> balances,
+                                 std::int64_t low, std::int64_t high) noexcept {
+  std::size_t count = 0;
+  for (std::int64_t value : balances)
+    count += (value >= low && value <= high) ? 1 : 0;
+  return count;
+}
+
+#ifdef PLATFORM_OPS_X86
+namespace {
+PLATFORM_OPS_TARGET_AVX2
+inline __m256i load4(const std::int64_t *p) noexcept {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+PLATFORM_OPS_TARGET_AVX2
+inline void store4(std::int64_t (&lanes)[4], __m256i v) noexcept {
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), v);
+}
+} // namespace
+
+PLATFORM_OPS_TARGET_AVX2
+std::int64_t sum_minor_avx2(std::span<const std::int64_t> balances) noexcept {
+  const std::int64_t *data = balances.data();
+  const std::size_t n = balances.size();
+  // Two accumulators hide the add latency; 8 balances per iteration.
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm256_add_epi64(acc0, load4(data + i));
+    acc1 = _mm256_add_epi64(acc1, load4(data + i + 4));
+  }
+  for (; i + 4 <= n; i += 4)
+    acc0 = _mm256_add_epi64(acc0, load4(data + i));
+
+  std::int64_t lanes[4];
+  store4(lanes, _mm256_add_epi64(acc0, acc1));
+  std::uint64_t total = 0;
+  for (std::int64_t lane : lanes)
+    total += static_cast<std::uint64_t>(lane);
+  return static_cast<std::int64_t>(
+      total + static_cast<std::uint64_t>(sum_minor_scalar(balances.subspan(i))));
+}
+
+PLATFORM_OPS_TARGET_AVX2
+std::int64_t min_minor_avx2(std::span<const std::int64_t> balances) noexcept {
+  const std::int64_t *data = balances.data();
+  const std::size_t n = balances.size();
+  __m256i lowest = _mm256_set1_epi64x(INT64_MAX_VALUE);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i value = load4(data + i);
+    // Take value wherever lowest > value (no _mm256_min_epi64 before AVX-512)
+    lowest = _mm256_blendv_epi8(lowest, value, _mm256_cmpgt_epi64(lowest, value));
+  }
+  std::int64_t lanes[4];
+  store4(lanes, lowest);
+  std::int64_t result = min_minor_scalar(balances.subspan(i));
+  for (std::int64_t lane : lanes)
+    result = lane < result ? lane : result;
+  return result;
+}
+
+PLATFORM_OPS_TARGET_AVX2
+std::int64_t max_minor_avx2(std::span<const std::int64_t> balances) noexcept {
+  const std::int64_t *data = balances.data();
+  const std::size_t n = balances.size();
+  __m256i highest = _mm256_set1_epi64x(INT64_MIN_VALUE);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i value = load4(data + i);
+    highest = _mm256_blendv_epi8(highest, value, _mm256_cmpgt_epi64(value, highest));
+  }
+  std::int64_t lanes[4];
+  store4(lanes, highest);
+  std::int64_t result = max_minor_scalar(balances.subspan(i));
+  for (std::int64_t lane : lanes)
+    result = lane > result ? lane : result;
+  return result;
+}
+
+PLATFORM_OPS_TARGET_AVX2
+std::size_t count_between_avx2(std::span<const std::int64_t> balances,
+                               std::int64_t low, std::int64_t high) noexcept {
+  const std::int64_t *data = balances.data();
+  const std::size_t n = balances.size();
+  const __m256i lows = _mm256_set1_epi64x(low);
+  const __m256i highs = _mm256_set1_epi64x(high);
+  __m256i counts = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i value = load4(data + i);
+    // outside = (low > value) | (value > high); inside lanes are all-zero
+    __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi64(lows, value),
+                                      _mm256_cmpgt_epi64(value, highs));
+    // ~outside is -1 for inside lanes; subtracting it adds one
+    counts = _mm256_sub_epi64(
+        counts, _mm256_andnot_si256(outside, _mm256_set1_epi64x(-1)));
+  }
+  std::int64_t lanes[4];
+  store4(lanes, counts);
+  return static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]) +
+         count_between_scalar(balances.subspan(i), low, high);
+}
+#else
+std::int64_t sum_minor_avx2(std::span<const std::int64_t> balances) noexcept {
+  return sum_minor_scalar(balances);
+}
+std::int64_t min_minor_avx2(std::span<const std::int64_t> balances) noexcept {
+  return min_minor_scalar(balances);
+}
+std::int64_t max_minor_avx2(std::span<const std::int64_t> balances) noexcept {
+  return max_minor_scalar(balances);
+}
+std::size_t count_between_avx2(std::span<const std::int64_t> balances,
+                               std::int64_t low, std::int64_t high) noexcept {
+  return count_between_scalar(balances, low, high);
+}
+#endif
+
+std::int64_t sum_minor(std::span<const std::int64_t> balances) noexcept {
+  return platform_ops_cpu::has_avx2() ? sum_minor_avx2(balances)
+                                      : sum_minor_scalar(balances);
+}
+
+std::int64_t min_minor(std::span<const std::int64_t> balances) noexcept {
+  return platform_ops_cpu::has_avx2() ? min_minor_avx2(balances)
+                                      : min_minor_scalar(balances);
+}
+
+std::int64_t max_minor(std::span<const std::int64_t> balances) noexcept {
+  return platform_ops_cpu::has_avx2() ? max_minor_avx2(balances)
+                                      : max_minor_scalar(balances);
+}
+
+std::size_t count_between(std::span<const std::int64_t> balances,
+                          std::int64_t low, std::int64_t high) noexcept {
+  return platform_ops_cpu::has_avx2() ? count_between_avx2(balances, low, high)
+                                      : count_between_scalar(balances, low, high);
+}
+
+stPortfolioTotals
+compute_portfolio_totals(std::span<const std::int64_t> balances) noexcept {
+  stPortfolioTotals totals{};
+  totals.client_count = balances.size();
+  if (balances.empty())
+    return totals;
+  totals.total_minor = sum_minor(balances);
+  totals.lowest_minor = min_minor(balances);
+  totals.highest_minor = max_minor(balances);
+  totals.overdrawn_count = count_between(balances, INT64_MIN_VALUE, -1);
+  totals.zero_count = count_between(balances, 0, 0);
+  return totals;
+}
+} // namespace balance
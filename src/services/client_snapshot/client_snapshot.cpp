@@ -0,0 +1,107 @@
+// client_data_app/src/services/client_snapshot/client_snapshot.cpp
+#include "services/client_snapshot/client_snapshot.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace client_snapshot {
+namespace {
+std::unique_ptr<stTableVersion>
+make_version(client_table::clsClientTable table, std::uint64_t number) {
+  auto version = std::make_unique<stTableVersion>();
+  version->number = number;
+  version->table = std::move(table);
+  // Built after the table reached its final address, so the views into its
+  // blob stay valid for the version's whole life.
+  version->positions.reserve(version->table.size());
+  for (std::size_t i = 0; i < version->table.size(); ++i) {
+    const client_table::stClientRow row = version->table.row(i);
+    if (!row.delete_mark)
+      version->positions.emplace(row.account_number, i);
+  }
+  return version;
+}
+} // namespace
+
+std::optional<client_table::stClientRow>
+clsReadView::find(std::string_view account_number) const {
+  auto found = _version->positions.find(account_number);
+  if (found == _version->positions.end())
+    return std::nullopt;
+  return _version->table.row(found->second);
+}
+
+clsSnapshotTable::clsSnapshotTable(client_table::clsClientTable initial) {
+  _current.store(make_version(std::move(initial), 1).release(),
+                 std::memory_order_release);
+}
+
+clsSnapshotTable::~clsSnapshotTable() {
+  delete _current.load(std::memory_order_acquire);
+  // _epochs frees the retired versions in its own destructor.
+}
+
+clsReadView clsSnapshotTable::read() const noexcept {
+  // Pin first, then load: the version loaded cannot be reclaimed before the
+  // guard is released (see clsEpochDomain).
+  auto guard = _epochs.pin();
+  const stTableVersion *version = _current.load(std::memory_order_seq_cst);
+  return clsReadView(std::move(guard), version);
+}
+
+void clsSnapshotTable::apply(std::span<const op_log::stLogEntry> entries) {
+  if (entries.empty())
+    return;
+  std::lock_guard lock(_writer_mutex);
+  const stTableVersion &current = *_current.load(std::memory_order_acquire);
+
+  // Collapse the batch to the final state of each touched account:
+  // a record to write, or nullptr for a delete. First-seen order is kept
+  // for accounts that are new.
+  std::unordered_map<std::string_view, const client_data_structure::stClientData *> final_state;
+  std::vector<std::string_view> touched;
+  for (const auto &entry : entries) {
+    auto [it, inserted] = final_state.try_emplace(entry.record.account_number);
+    if (inserted)
+      touched.push_back(entry.record.account_number);
+    it->second = entry.operation == op_log::enOperation::remove ? nullptr
+                                                                 : &entry.record;
+  }
+
+  // CPU: one pass copying untouched rows column to column; touched rows are
+  // written from their final record and deleted ones are simply left out.
+  client_table::clsClientTable next;
+  next.reserve(current.table.size() + touched.size(), 0);
+  for (client_table::stClientRow row : current.table) {
+    if (row.delete_mark)
+      continue; // Only reachable through publish(); dropped here
+    auto found = final_state.find(row.account_number);
+    if (found == final_state.end()) {
+      next.push_back_row(row);
+      continue;
+    }
+    if (found->second != nullptr)
+      next.push_back(*found->second);
+    final_state.erase(found); // Handled; whatever is left is new
+  }
+  for (std::string_view account : touched) {
+    auto found = final_state.find(account);
+    if (found != final_state.end() && found->second != nullptr)
+      next.push_back(*found->second);
+  }
+  swap_in(std::move(next));
+}
+
+void clsSnapshotTable::publish(client_table::clsClientTable table) {
+  std::lock_guard lock(_writer_mutex);
+  swap_in(std::move(table));
+}
+
+void clsSnapshotTable::swap_in(client_table::clsClientTable table) {
+  const stTableVersion *old = _current.load(std::memory_order_acquire);
+  const stTableVersion *next = make_version(std::move(table), old->number + 1).release();
+  _current.store(next, std::memory_order_seq_cst);
+  _epochs.retire(old);
+  _epochs.reclaim();
+}
+} // namespace client_snapshot
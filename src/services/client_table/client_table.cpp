@@ -0,0 +1,156 @@
+// client_data_app/src/services/client_table/client_table.cpp
+
+#include "services/client_table/client_table.h"
+#include "file_ops/file_ops.h"
+#include "services/balance/balance.h"
+
+namespace client_table {
+
+client_data_structure::stClientData stClientRow::to_record() const {
+  return {std::string(account_number), std::string(pass_code),
+          std::string(phone_no),       std::string(name),
+          account_balance,             delete_mark};
+}
+
+void clsClientTable::reserve(std::size_t rows, std::size_t text_bytes) {
+  _text.reserve(text_bytes);
+  _offsets.reserve(rows * STRING_FIELDS);
+  _lengths.reserve(rows * STRING_FIELDS);
+  _balances.reserve(rows);
+  _delete_marks.reserve(rows);
+}
+
+void clsClientTable::append_field(std::string_view text) {
+  _offsets.push_back(_text.size());
+  _lengths.push_back(static_cast<std::uint32_t>(text.size()));
+  _text.append(text);
+}
+
+void clsClientTable::push_back(const client_data_structure::stClientData &record) {
+  append_field(record.account_number);
+  append_field(record.pass_code);
+  append_field(record.phone_no);
+  append_field(record.name);
+  _balances.push_back(balance::to_minor_units(record.account_balance));
+  _delete_marks.push_back(record.delete_mark ? 1 : 0);
+}
+
+void clsClientTable::push_back_row(const stClientRow &row) {
+  append_field(row.account_number);
+  append_field(row.pass_code);
+  append_field(row.phone_no);
+  append_field(row.name);
+  _balances.push_back(row.balance_minor);
+  _delete_marks.push_back(row.delete_mark ? 1 : 0);
+}
+
+std::string_view clsClientTable::field(std::size_t i,
+                                       std::size_t k) const noexcept {
+  const std::size_t slot = i * STRING_FIELDS + k;
+  return std::string_view(_text).substr(_offsets[slot], _lengths[slot]);
+}
+
+stClientRow clsClientTable::row(std::size_t i) const noexcept {
+  return {field(i, 0),
+          field(i, 1),
+          field(i, 2),
+          field(i, 3),
+          balance::to_major_units(_balances[i]),
+          _delete_marks[i] != 0,
+          _balances[i]};
+}
+
+void clsClientTable::set_balance(std::size_t i, double balance) noexcept {
+  _balances[i] = balance::to_minor_units(balance);
+}
+
+void clsClientTable::update(std::size_t i,
+                            const client_data_structure::stClientData &record) {
+  const std::string_view values[STRING_FIELDS] = {
+      record.account_number, record.pass_code, record.phone_no, record.name};
+  for (std::size_t k = 0; k < STRING_FIELDS; ++k) {
+    const std::size_t slot = i * STRING_FIELDS + k;
+    if (field(i, k) == values[k])
+      continue; // Unchanged text keeps its bytes
+    // The old bytes stay in the blob until compact().
+    _garbage_bytes += _lengths[slot];
+    _offsets[slot] = _text.size();
+    _lengths[slot] = static_cast<std::uint32_t>(values[k].size());
+    _text.append(values[k]);
+  }
+  _balances[i] = balance::to_minor_units(record.account_balance);
+  _delete_marks[i] = record.delete_mark ? 1 : 0;
+
+  if (_garbage_bytes > _text.size() / 2)
+    compact();
+}
+
+std::size_t
+clsClientTable::find_row(std::string_view account_number) const noexcept {
+  for (std::size_t i = 0; i < size(); ++i)
+    if (field(i, 0) == account_number)
+      return i;
+  return size();
+}
+
+void clsClientTable::compact() {
+  std::string text;
+  text.reserve(_text.size() - _garbage_bytes);
+  for (std::size_t slot = 0; slot < _offsets.size(); ++slot) {
+    std::uint64_t offset = text.size();
+    text.append(_text, _offsets[slot], _lengths[slot]);
+    _offsets[slot] = offset;
+  }
+  _text = std::move(text);
+  _garbage_bytes = 0;
+}
+
+std::size_t clsClientTable::memory_usage() const noexcept {
+  return _text.capacity() + _offsets.capacity() * sizeof(std::uint64_t) +
+         _lengths.capacity() * sizeof(std::uint32_t) +
+         _balances.capacity() * sizeof(std::int64_t) + _delete_marks.capacity();
+}
+
+std::vector<client_data_structure::stClientData>
+clsClientTable::to_records() const {
+  std::vector<client_data_structure::stClientData> records;
+  records.reserve(size());
+  for (stClientRow client : *this)
+    records.push_back(client.to_record());
+  return records;
+}
+
+clsClientTable load_client_table(const std::filesystem::path &file_path) {
+  clsClientTable table;
+  file_ops::stIndexedClients clients = file_ops::get_all_clients_indexed(file_path);
+  const std::string_view buffer = clients.mapping.view();
+  const std::size_t rows = structural_index::row_count(clients.index);
+
+  // Memory: the blob can never exceed the file, and every row is one record.
+  table.reserve(rows, buffer.size());
+
+  using client_data_structure::enClientField;
+  for (std::size_t r = 0; r < rows; ++r) {
+    if (structural_index::get_field_count(clients.index, r) !=
+        client_data_structure::FIELD_COUNT)
+      continue;
+    auto get = [&](enClientField f) {
+      return structural_index::get_field(clients.index, buffer, r,
+                                         static_cast<std::size_t>(f));
+    };
+
+    std::int64_t balance_minor{};
+    if (!balance::parse_minor_units(get(enClientField::account_balance),
+                                    balance_minor))
+      continue;
+
+    table.push_back_row(stClientRow{get(enClientField::account_number),
+                                    get(enClientField::pass_code),
+                                    get(enClientField::phone_no),
+                                    get(enClientField::name),
+                                    balance::to_major_units(balance_minor),
+                                    false, balance_minor});
+  }
+  return table;
+}
+} // namespace client_table
@@ -0,0 +1,372 @@
+// client_data_app/src/services/columnar_snapshot/columnar_snapshot.cpp
+
+#include "services/columnar_snapshot/columnar_snapshot.h"
+#include "file_ops/file_ops.h"
+#include "services/balance/balance.h"
+#include "services/hash/h_hash.h"
+#include "services/index/sidecar/sidecar.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+namespace columnar_snapshot {
+
+namespace {
+using client_data_structure::enClientField;
+
+constexpr std::size_t DIRECTORY_BYTES = COLUMN_BLOCKS * sizeof(stColumnBlock);
+constexpr std::uint64_t FIRST_BLOCK_OFFSET = sizeof(stSnapshotHeader) + DIRECTORY_BYTES;
+
+// Block order of the four string columns; matches stClientRow's members.
+constexpr enClientField STRING_COLUMNS[] = {
+    enClientField::account_number, enClientField::pass_code,
+    enClientField::phone_no, enClientField::name};
+
+std::uint64_t align_8(std::uint64_t value) noexcept { return (value + 7) & ~std::uint64_t{7}; }
+
+std::uint64_t directory_checksum(
+    stSnapshotHeader header,
+    const std::array<stColumnBlock, COLUMN_BLOCKS> &directory) noexcept {
+  header.directory_checksum = 0;
+  std::string bytes(reinterpret_cast<const char *>(&header), sizeof(header));
+  bytes.append(reinterpret_cast<const char *>(directory.data()), DIRECTORY_BYTES);
+  return h_hash::checksum_64(bytes);
+}
+
+template <class T> void append_pod(std::string &out, const T &value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <class T> void append_array(std::string &out, const std::vector<T> &items) {
+  out.append(reinterpret_cast<const char *>(items.data()), items.size() * sizeof(T));
+}
+
+void pad_to_8(std::string &out) { out.append(align_8(out.size()) - out.size(), '\0'); }
+
+const std::string &string_field(const client_data_structure::stClientData &record,
+                                std::size_t k) noexcept {
+  switch (k) {
+  case 0:
+    return record.account_number;
+  case 1:
+    return record.pass_code;
+  case 2:
+    return record.phone_no;
+  default:
+    return record.name;
+  }
+}
+
+// Encodes string column k of the live records; a dictionary when at most
+// half of the values are distinct.
+enColumnEncoding encode_strings(
+    const std::vector<const client_data_structure::stClientData *> &rows,
+    std::size_t k, std::string &block) {
+  std::unordered_map<std::string_view, std::uint32_t> dictionary;
+  std::vector<std::string_view> entries;
+  std::vector<std::uint32_t> codes;
+  codes.reserve(rows.size());
+  bool use_dictionary = !rows.empty();
+  for (const auto *record : rows) {
+    auto [found, inserted] = dictionary.try_emplace(
+        string_field(*record, k), static_cast<std::uint32_t>(entries.size()));
+    if (inserted) {
+      entries.push_back(found->first);
+      if (entries.size() * 2 > rows.size()) {
+        use_dictionary = false; // Mostly distinct: plain is smaller
+        break;
+      }
+    }
+    codes.push_back(found->second);
+  }
+
+  std::vector<std::uint64_t> offsets;
+  std::string bytes;
+  auto add_string = [&](std::string_view text) {
+    offsets.push_back(bytes.size());
+    bytes.append(text);
+  };
+  if (use_dictionary) {
+    for (std::string_view entry : entries)
+      add_string(entry);
+  } else {
+    for (const auto *record : rows)
+      add_string(string_field(*record, k));
+  }
+  offsets.push_back(bytes.size());
+
+  if (use_dictionary) {
+    append_pod(block, static_cast<std::uint64_t>(entries.size()));
+    append_array(block, codes);
+    pad_to_8(block);
+  }
+  append_array(block, offsets);
+  block.append(bytes);
+  return use_dictionary ? enColumnEncoding::dictionary_strings
+                        : enColumnEncoding::plain_strings;
+}
+} // namespace
+
+std::string_view
+clsSnapshotFile::stStringColumn::get(std::size_t row) const noexcept {
+  std::size_t entry = row;
+  if (codes != nullptr) {
+    entry = codes[row];
+    if (entry >= entries)
+      return {}; // Corrupt code; verify() would have caught it
+  }
+  const std::uint64_t begin = offsets[entry];
+  const std::uint64_t end = offsets[entry + 1];
+  if (begin > end || end > byte_count)
+    return {};
+  return {bytes + begin, static_cast<std::size_t>(end - begin)};
+}
+
+bool clsSnapshotFile::bind_string_column(const stColumnBlock &block,
+                                         stStringColumn &column) const noexcept {
+  const char *base = _mapping.data() + block.offset;
+  std::uint64_t used = 0;
+  column = {};
+  if (block.encoding ==
+      static_cast<std::uint32_t>(enColumnEncoding::dictionary_strings)) {
+    if (block.bytes < sizeof(std::uint64_t))
+      return false;
+    std::memcpy(&column.entries, base, sizeof(std::uint64_t));
+    column.codes = reinterpret_cast<const std::uint32_t *>(base + sizeof(std::uint64_t));
+    used = align_8(sizeof(std::uint64_t) + _rows * sizeof(std::uint32_t));
+  } else if (block.encoding ==
+             static_cast<std::uint32_t>(enColumnEncoding::plain_strings)) {
+    column.entries = _rows;
+  } else {
+    return false;
+  }
+  const std::uint64_t offsets_bytes = (column.entries + 1) * sizeof(std::uint64_t);
+  if (column.entries > block.bytes || used + offsets_bytes > block.bytes)
+    return false;
+  column.offsets = reinterpret_cast<const std::uint64_t *>(base + used);
+  column.bytes = base + used + offsets_bytes;
+  column.byte_count = block.bytes - used - offsets_bytes;
+  return true;
+}
+
+bool clsSnapshotFile::open(const std::filesystem::path &snapshot_path,
+                           const std::filesystem::path &data_file_path) noexcept {
+  _rows = 0;
+  if (!_mapping.open(snapshot_path))
+    return false;
+  auto reject = [this] {
+    _mapping.close();
+    _rows = 0;
+    return false;
+  };
+  if (_mapping.size() < FIRST_BLOCK_OFFSET)
+    return reject();
+
+  // CPU: O(1) in the row count; only the header and directory are read.
+  stSnapshotHeader header{};
+  std::array<stColumnBlock, COLUMN_BLOCKS> directory{};
+  std::memcpy(&header, _mapping.data(), sizeof(header));
+  std::memcpy(directory.data(), _mapping.data() + sizeof(header), DIRECTORY_BYTES);
+  if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION ||
+      header.block_count != COLUMN_BLOCKS || header.file_size != _mapping.size() ||
+      header.directory_checksum != directory_checksum(header, directory) ||
+      !sidecar::is_current(header, data_file_path))
+    return reject();
+
+  _rows = static_cast<std::size_t>(header.row_count);
+  _log_offset = header.log_offset;
+  for (const stColumnBlock &block : directory)
+    if (block.offset % 8 != 0 || block.offset > _mapping.size() ||
+        block.bytes > _mapping.size() - block.offset)
+      return reject();
+
+  for (std::size_t k = 0; k < _strings.size(); ++k)
+    if (directory[k].field != static_cast<std::uint32_t>(STRING_COLUMNS[k]) ||
+        !bind_string_column(directory[k], _strings[k]))
+      return reject();
+
+  const stColumnBlock &doubles = directory[4];
+  const stColumnBlock &minors = directory[5];
+  if (doubles.encoding != static_cast<std::uint32_t>(enColumnEncoding::float64) ||
+      minors.encoding != static_cast<std::uint32_t>(enColumnEncoding::int64_minor) ||
+      doubles.bytes != _rows * sizeof(double) ||
+      minors.bytes != _rows * sizeof(std::int64_t))
+    return reject();
+  _balances = reinterpret_cast<const double *>(_mapping.data() + doubles.offset);
+  _balances_minor =
+      reinterpret_cast<const std::int64_t *>(_mapping.data() + minors.offset);
+  return true;
+}
+
+bool clsSnapshotFile::verify() const noexcept {
+  if (!is_open())
+    return false;
+  std::array<stColumnBlock, COLUMN_BLOCKS> directory{};
+  std::memcpy(directory.data(), _mapping.data() + sizeof(stSnapshotHeader),
+              DIRECTORY_BYTES);
+  // CPU: one pass over the file at 8 bytes per step.
+  for (const stColumnBlock &block : directory)
+    if (h_hash::checksum_64(_mapping.view().substr(block.offset, block.bytes)) !=
+        block.checksum)
+      return false;
+  return true;
+}
+
+client_table::stClientRow clsSnapshotFile::row(std::size_t i) const noexcept {
+  return {_strings[0].get(i), _strings[1].get(i), _strings[2].get(i),
+          _strings[3].get(i), _balances[i],       false,
+          _balances_minor[i]};
+}
+
+std::vector<client_data_structure::stClientData>
+clsSnapshotFile::to_records() const {
+  std::vector<client_data_structure::stClientData> records;
+  records.reserve(_rows);
+  // CPU: copies only; no separator search and no number parsing.
+  for (std::size_t i = 0; i < _rows; ++i)
+    records.push_back(row(i).to_record());
+  return records;
+}
+
+client_table::clsClientTable clsSnapshotFile::to_table() const {
+  client_table::clsClientTable table;
+  std::size_t text_bytes = 0;
+  for (const auto &column : _strings)
+    text_bytes += column.byte_count;
+  table.reserve(_rows, text_bytes);
+  for (std::size_t i = 0; i < _rows; ++i)
+    table.push_back_row(row(i));
+  return table;
+}
+
+stPreparedSnapshot prepare_snapshot_file(
+    const std::filesystem::path &snapshot_path,
+    const std::vector<client_data_structure::stClientData> &records,
+    std::uint64_t log_offset) {
+  std::vector<const client_data_structure::stClientData *> rows;
+  rows.reserve(records.size());
+  for (const auto &record : records)
+    if (!record.delete_mark)
+      rows.push_back(&record);
+
+  stPreparedSnapshot prepared;
+  prepared.temp_path = sidecar::temp_path(snapshot_path);
+  std::ofstream out(prepared.temp_path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open())
+    throw std::runtime_error("Failed to create the snapshot: " +
+                             prepared.temp_path.string());
+
+  // The header and directory are written last, once the blocks are known.
+  out.write(std::string(FIRST_BLOCK_OFFSET, '\0').data(), FIRST_BLOCK_OFFSET);
+  std::uint64_t offset = FIRST_BLOCK_OFFSET;
+  // Memory: one column block at a time, never the whole file.
+  std::string block;
+  auto emit = [&](std::size_t index, enClientField field,
+                  enColumnEncoding encoding) {
+    pad_to_8(block);
+    prepared.directory[index] = {static_cast<std::uint32_t>(field),
+                                 static_cast<std::uint32_t>(encoding), offset,
+                                 block.size(), h_hash::checksum_64(block)};
+    out.write(block.data(), static_cast<std::streamsize>(block.size()));
+    offset += block.size();
+    block.clear();
+  };
+
+  for (std::size_t k = 0; k < 4; ++k) {
+    const enColumnEncoding encoding = encode_strings(rows, k, block);
+    emit(k, STRING_COLUMNS[k], encoding);
+  }
+  for (const auto *record : rows)
+    append_pod(block, record->account_balance);
+  emit(4, enClientField::account_balance, enColumnEncoding::float64);
+  for (const auto *record : rows)
+    append_pod(block, balance::to_minor_units(record->account_balance));
+  emit(5, enClientField::account_balance, enColumnEncoding::int64_minor);
+
+  prepared.header.magic = SNAPSHOT_MAGIC;
+  prepared.header.version = SNAPSHOT_VERSION;
+  prepared.header.block_count = COLUMN_BLOCKS;
+  prepared.header.row_count = rows.size();
+  prepared.header.file_size = offset;
+  prepared.header.log_offset = log_offset;
+  out.close();
+  if (out.fail()) {
+    std::error_code ignored;
+    std::filesystem::remove(prepared.temp_path, ignored);
+    throw std::runtime_error("Failed to write the snapshot: " +
+                             prepared.temp_path.string());
+  }
+  return prepared;
+}
+
+bool publish_snapshot_file(stPreparedSnapshot &prepared,
+                           const std::filesystem::path &snapshot_path,
+                           const std::filesystem::path &data_file_path) noexcept {
+  try {
+    sidecar::stamp(prepared.header, data_file_path);
+    prepared.header.directory_checksum =
+        directory_checksum(prepared.header, prepared.directory);
+    {
+      std::fstream out(prepared.temp_path,
+                       std::ios::binary | std::ios::in | std::ios::out);
+      out.write(reinterpret_cast<const char *>(&prepared.header),
+                sizeof(prepared.header));
+      out.write(reinterpret_cast<const char *>(prepared.directory.data()),
+                DIRECTORY_BYTES);
+      out.close();
+      if (out.fail())
+        throw std::runtime_error("Failed to stamp the snapshot");
+    }
+    std::filesystem::rename(prepared.temp_path, snapshot_path);
+    return true;
+  } catch (...) {
+    std::error_code ignored;
+    std::filesystem::remove(prepared.temp_path, ignored);
+    return false;
+  }
+}
+
+void write_snapshot_file(
+    const std::filesystem::path &snapshot_path,
+    const std::vector<client_data_structure::stClientData> &records,
+    const std::filesystem::path &data_file_path) {
+  stPreparedSnapshot prepared = prepare_snapshot_file(snapshot_path, records);
+  if (!publish_snapshot_file(prepared, snapshot_path, data_file_path))
+    throw std::runtime_error("Failed to publish the snapshot: " +
+                             snapshot_path.string());
+}
+
+std::vector<client_data_structure::stClientData>
+load_clients(const std::filesystem::path &data_file_path,
+             const std::filesystem::path &snapshot_path,
+             std::uint64_t *log_offset) {
+  bool keep_checkpoint = false;
+  {
+    clsSnapshotFile snapshot;
+    if (snapshot.open(snapshot_path, data_file_path)) {
+      keep_checkpoint = snapshot.log_offset() != 0 && log_offset == nullptr;
+      if (!keep_checkpoint && snapshot.verify()) {
+        if (log_offset != nullptr)
+          *log_offset = snapshot.log_offset();
+        return snapshot.to_records();
+      }
+    }
+  }
+
+  if (log_offset != nullptr)
+    *log_offset = 0;
+  auto records = file_ops::load_clients_parallel(data_file_path);
+  if (keep_checkpoint)
+    return records; // Current for the log readers; not ours to replace
+  try {
+    // The next start-up maps this instead of parsing again.
+    write_snapshot_file(snapshot_path, records, data_file_path);
+  } catch (const std::exception &) {
+    // Best effort: the CSV stays the source of truth.
+  }
+  return records;
+}
+} // namespace columnar_snapshot
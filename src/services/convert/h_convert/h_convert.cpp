@@ -1,60 +1,250 @@
 // client_data_app/src/services/convert/h_convert/h_con_str_to_v_str.cpp
 
 
+#include <charconv>
 #include <cstddef>
+#include <cstring>
 #include <string>
 #include <string_view>
 #include <vector>
 #include "infrastructure.h"
+#include "platform_ops/cpu/cpu.h"
+#include "services/convert/h_convert/h_convert.h"
+#ifdef PLATFORM_OPS_X86
+#include <immintrin.h>
+#endif
 
 namespace h_convert {
 
+    namespace {
+        // Scalar scan starting at `start`; shared by the scalar kernel and by the SIMD kernels
+        // for the tail that is too short for one more vector load.
+        void scan_scalar_from(std::string_view str, std::string_view delim, size_t start, std::vector<short>& indexes)
+        {
+            size_t str_size = str.length();
+            size_t delim_size = delim.length();
+            size_t i = start;
+            bool delim_found{};
+
+            // Loop through the string, stopping when remaining characters are fewer than delimiter length
+            while(i + delim_size <= str_size)
+            {
+                delim_found = false;
+
+                // Optimization: Check the first character match before starting the expensive inner loop
+                if (str[i] == delim[0])
+                {
+                    bool full_loop = true;
+                    // Inner Loop: Check the remaining characters of the delimiter
+                    for(size_t j = 1; j < delim_size; j++)
+                    {
+                        if (str[i + j] != delim[j]) 
+                        {
+                            full_loop = false;
+                            break; // Mismatch found, break early
+                        }
+                    }
+                    if(full_loop) delim_found = true;
+                }
+
+                if (delim_found)
+                {
+                    indexes.push_back(static_cast<short>(i)); // Store the start index of the found delimiter
+                    i += delim_size;      // Jump forward by delimiter length to avoid overlapping checks
+                }
+                else 
+                {
+                    i++; // Move to the next character
+                }
+            }
+        }
+
+        // Turns one block's candidate bitmask into recorded indexes.
+        // Bit k set means "first and last delimiter bytes match at block_start + k".
+        // Returns the first position a new match may start at (non-overlap rule).
+        inline size_t consume_mask(unsigned mask, size_t block_start, size_t next_allowed,
+            std::string_view str, std::string_view delim, std::vector<short>& indexes)
+        {
+            const size_t delim_size = delim.length();
+            while (mask != 0)
+            {
+                unsigned bit = platform_ops_cpu::lowest_bit(mask);
+                mask &= mask - 1; // Clear the lowest set bit
+                size_t pos = block_start + bit;
+                if (pos < next_allowed)
+                    continue; // Starts inside the previous match
+
+                // First and last bytes already match; verify whatever lies between them
+                if (delim_size > 2 && std::memcmp(str.data() + pos + 1, delim.data() + 1, delim_size - 2) != 0)
+                    continue;
+
+                indexes.push_back(static_cast<short>(pos));
+                next_allowed = pos + delim_size;
+            }
+            return next_allowed;
+        }
+
+        using detect_kernel = void (*)(std::string_view, std::string_view, std::vector<short>&);
+
+        detect_kernel select_kernel() noexcept
+        {
+            if (platform_ops_cpu::has_avx2())
+                return &detect_delim_avx2;
+            if (platform_ops_cpu::has_sse2())
+                return &detect_delim_sse2;
+            return &detect_delim_scalar;
+        }
+    } // namespace
+
     void detect_delim(std::string_view str, std::string_view delim, std::vector<short>& indexes)
+    {
+        // Resolved once; afterwards every call is one indirect jump.
+        static const detect_kernel kernel = select_kernel();
+        kernel(str, delim, indexes);
+    }
+
+    void detect_delim_scalar(std::string_view str, std::string_view delim, std::vector<short>& indexes)
     {
         // Guard Clause: Check if the string is valid and large enough to contain the delimiter
-        if (str.empty() || str.length() < delim.length()) 
+        if (str.empty() || delim.empty() || str.length() < delim.length()) 
         {
             return; // Impossible to find anything. Goodbye.
         }
+        scan_scalar_from(str, delim, 0, indexes);
+    }
+
+#ifdef PLATFORM_OPS_X86
+    void detect_delim_sse2(std::string_view str, std::string_view delim, std::vector<short>& indexes)
+    {
+        if (str.empty() || delim.empty() || str.length() < delim.length())
+        {
+            return;
+        }
 
-        size_t str_size = str.length();
-        size_t delim_size = delim.length();
+        const size_t str_size = str.length();
+        const size_t last = delim.length() - 1;
+        const __m128i first_byte = _mm_set1_epi8(delim[0]);
+        const __m128i last_byte = _mm_set1_epi8(delim[last]);
+        size_t next_allowed = 0;
         size_t i = 0;
-        bool delim_found{};
 
-        // Loop through the string, stopping when remaining characters are fewer than delimiter length
-        while(i <= (str_size - delim_size))
+        // Each iteration tests 16 start positions; the shifted load must stay inside str
+        for (; i + last + 16 <= str_size; i += 16)
         {
-            delim_found = false;
+            __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + i));
+            __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + i + last));
+            __m128i hits = _mm_and_si128(_mm_cmpeq_epi8(head, first_byte), _mm_cmpeq_epi8(tail, last_byte));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+            if (mask != 0)
+                next_allowed = consume_mask(mask, i, next_allowed, str, delim, indexes);
+        }
 
-            // Optimization: Check the first character match before starting the expensive inner loop
-            if (str[i] == delim[0])
-            {
-                bool full_loop = true;
-                // Inner Loop: Check the remaining characters of the delimiter
-                for(size_t j = 1; j < delim_size; j++)
-                {
-                    if (str[i + j] != delim[j]) 
-                    {
-                        full_loop = false;
-                        break; // Mismatch found, break early
-                    }
-                }
-                if(full_loop) delim_found = true;
-            }
+        scan_scalar_from(str, delim, i > next_allowed ? i : next_allowed, indexes);
+    }
 
-            if (delim_found)
-            {
-                indexes.push_back(i); // Store the start index of the found delimiter
-                i += delim_size;      // Jump forward by delimiter length to avoid overlapping checks
-            }
-            else 
-            {
-                i++; // Move to the next character
-            }
+    PLATFORM_OPS_TARGET_AVX2
+    void detect_delim_avx2(std::string_view str, std::string_view delim, std::vector<short>& indexes)
+    {
+        if (str.empty() || delim.empty() || str.length() < delim.length())
+        {
+            return;
         }
+
+        const size_t str_size = str.length();
+        const size_t last = delim.length() - 1;
+        const __m256i first_byte = _mm256_set1_epi8(delim[0]);
+        const __m256i last_byte = _mm256_set1_epi8(delim[last]);
+        size_t next_allowed = 0;
+        size_t i = 0;
+
+        // Each iteration tests 32 start positions; the shifted load must stay inside str
+        for (; i + last + 32 <= str_size; i += 32)
+        {
+            __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str.data() + i));
+            __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str.data() + i + last));
+            __m256i hits = _mm256_and_si256(_mm256_cmpeq_epi8(head, first_byte), _mm256_cmpeq_epi8(tail, last_byte));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+            if (mask != 0)
+                next_allowed = consume_mask(mask, i, next_allowed, str, delim, indexes);
+        }
+
+        scan_scalar_from(str, delim, i > next_allowed ? i : next_allowed, indexes);
+    }
+#else
+    void detect_delim_sse2(std::string_view str, std::string_view delim, std::vector<short>& indexes)
+    {
+        detect_delim_scalar(str, delim, indexes);
     }
-    
+
+    void detect_delim_avx2(std::string_view str, std::string_view delim, std::vector<short>& indexes)
+    {
+        detect_delim_scalar(str, delim, indexes);
+    }
+#endif
+
+    bool convert_line_to_record(std::string_view line, client_data_structure::stClientData& record)
+    {
+        constexpr std::string_view delim = infrastructure_names::SEPARATOR;
+
+        // Reused across calls on the same thread: no allocation once it has grown to 4 slots
+        thread_local std::vector<short> indexes;
+        indexes.clear();
+        detect_delim(line, delim, indexes);
+
+        if (indexes.size() != client_data_structure::FIELD_COUNT - 1)
+        {
+            return false; // Wrong column count: not a record line
+        }
+
+        // Field k spans from the end of separator k-1 to the start of separator k
+        auto field = [&](size_t k) -> std::string_view
+        {
+            size_t begin = (k == 0) ? 0 : static_cast<size_t>(indexes[k - 1]) + delim.length();
+            size_t end = (k < indexes.size()) ? static_cast<size_t>(indexes[k]) : line.length();
+            return line.substr(begin, end - begin);
+        };
+
+        using client_data_structure::enClientField;
+        std::string_view balance = field(static_cast<size_t>(enClientField::account_balance));
+        double value{};
+        auto [ptr, ec] = std::from_chars(balance.data(), balance.data() + balance.length(), value);
+        if (ec != std::errc{} || ptr != balance.data() + balance.length())
+        {
+            return false; // Balance is not a complete number
+        }
+
+        record.account_number.assign(field(static_cast<size_t>(enClientField::account_number)));
+        record.pass_code.assign(field(static_cast<size_t>(enClientField::pass_code)));
+        record.phone_no.assign(field(static_cast<size_t>(enClientField::phone_no)));
+        record.name.assign(field(static_cast<size_t>(enClientField::name)));
+        record.account_balance = value;
+        record.delete_mark = false;
+        return true;
+    }
+
+    void append_record_line(const client_data_structure::stClientData& record, std::string& out)
+    {
+        constexpr std::string_view delim = infrastructure_names::SEPARATOR;
+
+        out.append(record.account_number).append(delim);
+        out.append(record.pass_code).append(delim);
+        out.append(record.phone_no).append(delim);
+        out.append(record.name).append(delim);
+
+        // Shortest representation that parses back to the same double
+        char balance[32];
+        // 32 chars always fit a double, so to_chars cannot fail here
+        auto result = std::to_chars(balance, balance + sizeof(balance), record.account_balance);
+        out.append(balance, result.ptr);
+    }
+
+    std::string convert_record_to_line(const client_data_structure::stClientData& record)
+    {
+        std::string line;
+        append_record_line(record, line);
+        return line;
+    }
+
 
     // std::vector<std::string> h_conv_str_vstr(std::string_view str_record)
     // {
@@ -75,4 +265,4 @@ namespace h_convert {
 
 
 
-} // namespace h_convert
\ No newline at end of file
+} // namespace h_convert
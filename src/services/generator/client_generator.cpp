@@ -0,0 +1,162 @@
+// client_data_app/src/services/generator/client_generator.cpp
+#include "services/generator/client_generator.h"
+#include "infrastructure.h"
+#include "platform_ops/scheduler/scheduler.h"
+#include "services/balance/balance.h"
+#include "services/hash/h_hash.h"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace client_generator {
+namespace {
+// splitmix64: one add and one mix per draw; good enough for test data and
+// trivially seekable, so any row can be generated on its own.
+class clsRowRandom {
+public:
+  clsRowRandom(std::uint64_t seed, std::uint64_t row)
+      : _state(h_hash::mix_64(seed ^ h_hash::mix_64(row + 1))) {}
+
+  std::uint64_t next() noexcept {
+    _state += 0x9e3779b97f4a7c15ull;
+    return h_hash::mix_64(_state);
+  }
+  // Uniform in [0, bound); the modulo bias is irrelevant for test data.
+  std::uint64_t below(std::uint64_t bound) noexcept {
+    return bound == 0 ? 0 : next() % bound;
+  }
+  // Uniform in [0, 1) from the top 53 bits.
+  double unit() noexcept { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+private:
+  std::uint64_t _state;
+};
+
+void append_number(std::uint64_t value, std::string &out) {
+  char digits[24];
+  auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  out.append(digits, result.ptr);
+}
+
+void validate(const stGeneratorOptions &options) {
+  if (options.name_length_min == 0 ||
+      options.name_length_min > options.name_length_max)
+    throw std::invalid_argument("name length range is empty");
+  if (options.balance_min_minor > options.balance_max_minor)
+    throw std::invalid_argument("balance range is empty");
+  if (!(options.duplicate_ratio >= 0.0 && options.duplicate_ratio <= 1.0))
+    throw std::invalid_argument("duplicate ratio must be within [0, 1]");
+}
+} // namespace
+
+std::string generated_account_number(std::uint64_t row) {
+  std::string account_number = "AC";
+  append_number(1'000'000'000ull + row, account_number);
+  return account_number;
+}
+
+void append_generated_line(const stGeneratorOptions &options, std::uint64_t row,
+                           std::string &out) {
+  clsRowRandom random(options.seed, row);
+  const std::string_view separator = infrastructure_names::SEPARATOR;
+
+  // A duplicate points back at a random earlier row, which is what a bad
+  // import or a replayed batch would leave behind.
+  std::uint64_t account_row = row;
+  if (row > 0 && random.unit() < options.duplicate_ratio)
+    account_row = random.below(row);
+  out += "AC";
+  append_number(1'000'000'000ull + account_row, out);
+  out += separator;
+
+  append_number(1000 + random.below(9000), out); // pass_code: 4 digits
+  out += separator;
+
+  out += "01"; // phone_no: "01" + 9 digits
+  append_number(100'000'000 + random.below(900'000'000), out);
+  out += separator;
+
+  const std::size_t name_length =
+      options.name_length_min +
+      random.below(options.name_length_max - options.name_length_min + 1);
+  out.push_back(static_cast<char>('A' + random.below(26)));
+  for (std::size_t i = 1; i < name_length; ++i)
+    out.push_back(static_cast<char>('a' + random.below(26)));
+  out += separator;
+
+  // Span computed unsigned: max - min can exceed INT64_MAX.
+  const std::uint64_t span =
+      static_cast<std::uint64_t>(options.balance_max_minor) -
+      static_cast<std::uint64_t>(options.balance_min_minor);
+  std::uint64_t step = 0;
+  if (options.balance_distribution == enBalanceDistribution::uniform) {
+    step = span == UINT64_MAX ? random.next() : random.below(span + 1);
+  } else {
+    const double u = random.unit();
+    step = static_cast<std::uint64_t>(static_cast<double>(span) * (u * u * u * u));
+    step = std::min(step, span);
+  }
+  balance::append_minor_units(
+      static_cast<std::int64_t>(
+          static_cast<std::uint64_t>(options.balance_min_minor) + step),
+      out);
+}
+
+std::uint64_t generate_clients_file(const std::filesystem::path &file_path,
+                                    const stGeneratorOptions &options) {
+  validate(options);
+
+  // 64K rows is ~5 MiB of text: large enough to amortise scheduling a task,
+  // small enough that a round of blocks stays in the hundreds of MiB.
+  constexpr std::uint64_t BLOCK_ROWS = 1 << 16;
+  const unsigned thread_count =
+      options.thread_count != 0
+          ? options.thread_count
+          : std::max(1u, std::thread::hardware_concurrency());
+  const std::uint64_t block_count = (options.rows + BLOCK_ROWS - 1) / BLOCK_ROWS;
+
+  std::filesystem::path temp_path = file_path;
+  temp_path += ".tmp";
+  std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open())
+    throw std::runtime_error("Failed to create the temp file: " +
+                             temp_path.string());
+
+  auto format_block = [&options](std::uint64_t block, std::string &buffer) {
+    buffer.clear();
+    const std::uint64_t end = std::min(options.rows, (block + 1) * BLOCK_ROWS);
+    for (std::uint64_t row = block * BLOCK_ROWS; row < end; ++row) {
+      append_generated_line(options, row, buffer);
+      buffer.push_back('\n');
+    }
+  };
+
+  // Buffers are reused across rounds, so each grows once.
+  std::vector<std::string> buffers(thread_count);
+  std::uint64_t bytes_written = 0;
+  for (std::uint64_t first = 0; first < block_count; first += thread_count) {
+    const std::size_t round = static_cast<std::size_t>(
+        std::min<std::uint64_t>(thread_count, block_count - first));
+    platform_ops_scheduler::parallel_for(round, [&](std::size_t k) {
+      format_block(first + k, buffers[k]);
+    });
+
+    // CPU: one large write per block, in row order.
+    for (std::size_t k = 0; k < round; ++k) {
+      out.write(buffers[k].data(),
+                static_cast<std::streamsize>(buffers[k].size()));
+      bytes_written += buffers[k].size();
+    }
+  }
+
+  out.close(); // Flush before the rename makes it visible
+  if (out.fail())
+    throw std::runtime_error("Failed to write the temp file: " +
+                             temp_path.string());
+  std::filesystem::rename(temp_path, file_path);
+  return bytes_written;
+}
+} // namespace client_generator
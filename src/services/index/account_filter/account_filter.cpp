@@ -0,0 +1,207 @@
+// client_data_app/src/services/index/account_filter/account_filter.cpp
+
+#include "services/index/account_filter/account_filter.h"
+#include "services/hash/h_hash.h"
+#include "services/index/sidecar/sidecar.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace account_filter {
+
+namespace {
+constexpr std::uint64_t MIN_CAPACITY = 1024;
+constexpr std::uint8_t SATURATED = 255;
+
+// Double hashing (Kirsch-Mitzenmacher): probe i is h1 + i * h2, so one
+// 64-bit hash of the key yields all hash_count positions.
+struct stProbe {
+  std::uint64_t h1;
+  std::uint64_t h2;
+};
+
+stProbe probe_for(std::string_view account_number) noexcept {
+  const std::uint64_t hash = h_hash::mix_64(h_hash::fnv1a_64(account_number));
+  return {hash, h_hash::mix_64(hash ^ 0x9e3779b97f4a7c15ull) | 1};
+}
+
+// No data file stamp: the filter is checked against the data version instead.
+bool is_usable(const platform_ops_map::clsMappedFile &filter) {
+  stFilterHeader header{};
+  return sidecar::read_header(filter, header) && header.magic == FILTER_MAGIC && header.version == FILTER_VERSION &&
+         header.hash_count > 0 && header.counter_count > 0 &&
+         filter.size() == sizeof(stFilterHeader) + header.counter_count;
+}
+} // namespace
+
+void build_filter_file(
+    const std::filesystem::path &filter_file_path,
+    const std::vector<client_data_structure::stClientData> &records,
+    std::uint64_t data_version, std::uint64_t min_capacity) {
+  // Memory: sized for twice the current clients, so adds have room to grow
+  // before the next rebuild.
+  const std::uint64_t capacity = std::max(
+      {MIN_CAPACITY, static_cast<std::uint64_t>(records.size()) * 2, min_capacity});
+  const double ln2 = std::log(2.0);
+  const std::uint64_t counter_count = static_cast<std::uint64_t>(std::ceil(
+      static_cast<double>(capacity) * -std::log(FALSE_POSITIVE_RATE) /
+      (ln2 * ln2)));
+  const std::uint32_t hash_count = std::max<std::uint32_t>(
+      1, static_cast<std::uint32_t>(std::lround(
+             static_cast<double>(counter_count) / capacity * ln2)));
+
+  std::vector<std::uint8_t> counters(counter_count, 0);
+  std::uint64_t count = 0;
+  for (const auto &record : records) {
+    if (record.delete_mark)
+      continue;
+    const stProbe probe = probe_for(record.account_number);
+    for (std::uint32_t i = 0; i < hash_count; ++i) {
+      std::uint8_t &counter = counters[(probe.h1 + i * probe.h2) % counter_count];
+      if (counter != SATURATED)
+        ++counter;
+    }
+    ++count;
+  }
+
+  stFilterHeader header{};
+  header.magic = FILTER_MAGIC;
+  header.version = FILTER_VERSION;
+  header.hash_count = hash_count;
+  header.counter_count = counter_count;
+  header.capacity = capacity;
+  header.count = count;
+  header.data_version = data_version;
+
+  sidecar::write_file(filter_file_path, "the account filter", [&](std::ofstream &out) {
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(counters.data()),
+              static_cast<std::streamsize>(counters.size()));
+  });
+}
+
+bool clsAccountFilter::open(const std::filesystem::path &filter_file_path) noexcept {
+  _filter_file_path = filter_file_path;
+  _filter.close();
+  if (!_filter.open(_filter_file_path, platform_ops_map::enMapMode::read_write))
+    return false;
+  if (!is_usable(_filter)) {
+    _filter.close();
+    return false;
+  }
+  return true;
+}
+
+stFilterHeader *clsAccountFilter::header() const noexcept {
+  return reinterpret_cast<stFilterHeader *>(_filter.writable_data());
+}
+
+std::uint8_t *clsAccountFilter::counters() const noexcept {
+  return reinterpret_cast<std::uint8_t *>(_filter.writable_data() +
+                                          sizeof(stFilterHeader));
+}
+
+std::uint64_t clsAccountFilter::size() const noexcept {
+  return is_open() ? header()->count : 0;
+}
+
+std::uint64_t clsAccountFilter::capacity() const noexcept {
+  return is_open() ? header()->capacity : 0;
+}
+
+std::uint64_t clsAccountFilter::data_version() const noexcept {
+  return is_open() ? header()->data_version : 0;
+}
+
+bool clsAccountFilter::is_current(std::uint64_t version) const noexcept {
+  return is_open() && header()->data_version == version;
+}
+
+bool clsAccountFilter::is_overfull() const noexcept {
+  return is_open() && header()->count > header()->capacity;
+}
+
+bool clsAccountFilter::possibly_contains(
+    std::string_view account_number) const noexcept {
+  if (!is_open())
+    return true;
+  // CPU: hash_count (~7) counter reads; no access to the data file at all.
+  const stFilterHeader *head = header();
+  const std::uint8_t *table = counters();
+  const stProbe probe = probe_for(account_number);
+  for (std::uint32_t i = 0; i < head->hash_count; ++i)
+    if (table[(probe.h1 + i * probe.h2) % head->counter_count] == 0)
+      return false;
+  return true;
+}
+
+void clsAccountFilter::insert(std::string_view account_number) noexcept {
+  if (!is_open())
+    return;
+  stFilterHeader *head = header();
+  std::uint8_t *table = counters();
+  const stProbe probe = probe_for(account_number);
+  for (std::uint32_t i = 0; i < head->hash_count; ++i) {
+    std::uint8_t &counter = table[(probe.h1 + i * probe.h2) % head->counter_count];
+    if (counter != SATURATED)
+      ++counter;
+  }
+  ++head->count;
+}
+
+void clsAccountFilter::erase(std::string_view account_number) noexcept {
+  if (!is_open())
+    return;
+  stFilterHeader *head = header();
+  std::uint8_t *table = counters();
+  const stProbe probe = probe_for(account_number);
+  for (std::uint32_t i = 0; i < head->hash_count; ++i) {
+    std::uint8_t &counter = table[(probe.h1 + i * probe.h2) % head->counter_count];
+    // A saturated counter may stand for more keys than it can count.
+    if (counter != SATURATED && counter != 0)
+      --counter;
+  }
+  if (head->count > 0)
+    --head->count;
+}
+
+void clsAccountFilter::apply(std::span<const op_log::stLogEntry> entries,
+                             std::uint64_t new_version) noexcept {
+  if (!is_current(new_version - 1))
+    return; // Missed a commit: stays stale until open_current() rebuilds it
+  for (const auto &entry : entries) {
+    if (entry.operation == op_log::enOperation::add)
+      insert(entry.record.account_number);
+    else if (entry.operation == op_log::enOperation::remove)
+      erase(entry.record.account_number);
+    // update: same account number, nothing to change
+  }
+  // Stamped last: a crash halfway leaves the old version, i.e. stale.
+  header()->data_version = new_version;
+}
+
+bool open_current(clsAccountFilter &filter,
+                  const std::filesystem::path &filter_file_path,
+                  op_log::clsOpLog &operation_log) {
+  if (filter.open(filter_file_path) &&
+      filter.is_current(operation_log.version()) && !filter.is_overfull())
+    return false;
+
+  // CPU: one full load; the version it returns is the one the filter gets.
+  filter.close(); // Unmap before replacing the file (required on Windows)
+  const auto records = operation_log.load();
+  build_filter_file(filter_file_path, records, operation_log.version());
+  if (!filter.open(filter_file_path))
+    throw std::runtime_error("Failed to open the account filter: " +
+                             filter_file_path.string());
+  return true;
+}
+
+void attach(clsAccountFilter &filter, op_log::clsOpLog &operation_log) {
+  operation_log.set_commit_observer(
+      [&filter](std::span<const op_log::stLogEntry> entries,
+                std::uint64_t new_version) { filter.apply(entries, new_version); });
+}
+} // namespace account_filter
@@ -0,0 +1,293 @@
+// client_data_app/src/services/index/account_index/account_index.cpp
+
+#include "services/index/account_index/account_index.h"
+#include "file_ops/file_ops.h"
+#include "services/convert/h_convert/h_convert.h"
+#include "services/hash/h_hash.h"
+#include "services/index/sidecar/sidecar.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace account_index {
+
+namespace {
+constexpr std::uint64_t MIN_CAPACITY = 1024;
+
+// Mixed hash with the two reserved marker values moved out of the way.
+std::uint64_t slot_hash(std::string_view account_number) noexcept {
+  std::uint64_t hash = h_hash::mix_64(h_hash::fnv1a_64(account_number));
+  return hash <= DELETED_SLOT ? hash + 2 : hash;
+}
+
+// True if the line at offset in buffer starts with "<account_number>#//#".
+bool line_has_account(std::string_view buffer, std::uint64_t offset,
+                      std::string_view account_number) noexcept {
+  constexpr std::string_view sep = infrastructure_names::SEPARATOR;
+  if (offset > buffer.size() ||
+      buffer.size() - offset < account_number.size() + sep.size())
+    return false;
+  std::string_view head = buffer.substr(offset, account_number.size() + sep.size());
+  return head.starts_with(account_number) && head.ends_with(sep);
+}
+
+bool is_usable(const platform_ops_map::clsMappedFile &index,
+               const std::filesystem::path &data_file_path) {
+  stIndexHeader header{};
+  return sidecar::read_header(index, header) && header.magic == INDEX_MAGIC && header.version == INDEX_VERSION &&
+         std::has_single_bit(header.capacity) &&
+         index.size() == sizeof(stIndexHeader) +
+                             header.capacity * sizeof(stIndexSlot) &&
+         sidecar::is_current(header, data_file_path);
+}
+} // namespace
+
+void build_index_file(const std::filesystem::path &data_file_path,
+                      const std::filesystem::path &index_file_path,
+                      std::uint64_t min_capacity) {
+  // CPU: one structural pass over the data file; only field 0 is looked at.
+  file_ops::stIndexedClients clients =
+      file_ops::get_all_clients_indexed(data_file_path);
+  const std::string_view buffer = clients.mapping.view();
+  const std::size_t rows = structural_index::row_count(clients.index);
+
+  // Memory: keep the table at most half full so probes stay short.
+  const std::uint64_t capacity = std::max(
+      {MIN_CAPACITY, std::bit_ceil<std::uint64_t>(rows * 2 + 1), min_capacity});
+  std::vector<stIndexSlot> slots(capacity, stIndexSlot{EMPTY_SLOT, 0});
+  std::uint64_t count = 0;
+
+  for (std::size_t row = 0; row < rows; ++row) {
+    if (structural_index::get_field_count(clients.index, row) !=
+        client_data_structure::FIELD_COUNT)
+      continue; // Blank or malformed line
+    std::string_view account =
+        structural_index::get_field(clients.index, buffer, row, 0);
+    if (account.empty())
+      continue;
+    const std::uint64_t offset = static_cast<std::uint64_t>(
+        structural_index::get_row(clients.index, buffer, row).data() -
+        buffer.data());
+
+    const std::uint64_t hash = slot_hash(account);
+    std::uint64_t i = hash & (capacity - 1);
+    while (slots[i].hash != EMPTY_SLOT &&
+           !(slots[i].hash == hash &&
+             line_has_account(buffer, slots[i].offset, account)))
+      i = (i + 1) & (capacity - 1);
+    if (slots[i].hash == EMPTY_SLOT)
+      ++count;
+    slots[i] = {hash, offset}; // A later duplicate line wins
+  }
+
+  stIndexHeader header{};
+  header.magic = INDEX_MAGIC;
+  header.version = INDEX_VERSION;
+  header.capacity = capacity;
+  header.count = count;
+  sidecar::stamp(header, data_file_path);
+
+  sidecar::write_file(index_file_path, "the account index", [&](std::ofstream &out) {
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    sidecar::write_array(out, slots);
+  });
+}
+
+std::filesystem::path
+prepare_index_file(const std::filesystem::path &new_data_file_path,
+                   const std::filesystem::path &index_file_path) {
+  std::filesystem::path prepared = index_file_path;
+  prepared += ".next";
+  prepared = sidecar::temp_path(prepared);
+  build_index_file(new_data_file_path, prepared);
+  return prepared;
+}
+
+bool publish_index_file(const std::filesystem::path &prepared,
+                        const std::filesystem::path &index_file_path) noexcept {
+  std::error_code ec;
+  std::filesystem::rename(prepared, index_file_path, ec);
+  if (!ec)
+    return true;
+  std::filesystem::remove(prepared, ec);
+  return false;
+}
+
+bool clsAccountIndex::open(const std::filesystem::path &data_file_path,
+                           const std::filesystem::path &index_file_path) {
+  _data_file_path = data_file_path;
+  _index_file_path = index_file_path;
+  _index.close();
+  if (!_data.open(_data_file_path))
+    return false;
+
+  sidecar::ensure_current(
+      _index_file_path,
+      [&](const platform_ops_map::clsMappedFile &existing) {
+        return is_usable(existing, _data_file_path);
+      },
+      [&] { build_index_file(_data_file_path, _index_file_path); });
+  return _index.open(_index_file_path, platform_ops_map::enMapMode::read_write);
+}
+
+stIndexHeader *clsAccountIndex::header() const noexcept {
+  return reinterpret_cast<stIndexHeader *>(_index.writable_data());
+}
+
+stIndexSlot *clsAccountIndex::slots() const noexcept {
+  return reinterpret_cast<stIndexSlot *>(_index.writable_data() +
+                                         sizeof(stIndexHeader));
+}
+
+std::uint64_t clsAccountIndex::size() const noexcept {
+  return is_open() ? header()->count : 0;
+}
+
+std::uint64_t clsAccountIndex::capacity() const noexcept {
+  return is_open() ? header()->capacity : 0;
+}
+
+bool clsAccountIndex::matches(std::uint64_t offset,
+                              std::string_view account_number) const noexcept {
+  return line_has_account(_data.view(), offset, account_number);
+}
+
+std::optional<std::uint64_t>
+clsAccountIndex::find(std::string_view account_number) const {
+  if (!is_open())
+    return std::nullopt;
+  const std::uint64_t mask = header()->capacity - 1;
+  const std::uint64_t hash = slot_hash(account_number);
+  const stIndexSlot *table = slots();
+
+  // Memory: the first probe is one page of the index; the confirming
+  // compare is one page of the data file.
+  for (std::uint64_t i = hash & mask;; i = (i + 1) & mask) {
+    if (table[i].hash == EMPTY_SLOT)
+      return std::nullopt; // Tables are never full, so this always ends
+    if (table[i].hash == hash && matches(table[i].offset, account_number))
+      return table[i].offset;
+  }
+}
+
+bool clsAccountIndex::find_record(
+    std::string_view account_number,
+    client_data_structure::stClientData &record) const {
+  std::optional<std::uint64_t> offset = find(account_number);
+  if (!offset)
+    return false;
+  std::string_view rest = _data.view().substr(*offset);
+  return h_convert::convert_line_to_record(rest.substr(0, rest.find('\n')),
+                                           record);
+}
+
+bool clsAccountIndex::remap_data() noexcept {
+  return _data.open(_data_file_path);
+}
+
+void clsAccountIndex::stamp_data_file() {
+  sidecar::stamp(*header(), _data_file_path);
+}
+
+bool clsAccountIndex::rehash(std::uint64_t new_capacity) {
+  // CPU: O(capacity), from the stored hashes alone; the data file is not
+  // re-read, so an entry erased but still in the data file stays erased.
+  const stIndexHeader old_header = *header();
+  const stIndexSlot *old_slots = slots();
+  std::vector<stIndexSlot> table(new_capacity, stIndexSlot{EMPTY_SLOT, 0});
+  const std::uint64_t mask = new_capacity - 1;
+  for (std::uint64_t i = 0; i < old_header.capacity; ++i) {
+    if (old_slots[i].hash == EMPTY_SLOT || old_slots[i].hash == DELETED_SLOT)
+      continue;
+    std::uint64_t j = old_slots[i].hash & mask;
+    while (table[j].hash != EMPTY_SLOT)
+      j = (j + 1) & mask;
+    table[j] = old_slots[i]; // Keys are unique, so no compare is needed
+  }
+
+  stIndexHeader new_header = old_header;
+  new_header.capacity = new_capacity;
+  new_header.tombstones = 0;
+  _index.close();
+  sidecar::write_file(_index_file_path, "the account index", [&](std::ofstream &out) {
+    out.write(reinterpret_cast<const char *>(&new_header), sizeof(new_header));
+    sidecar::write_array(out, table);
+  });
+  return _index.open(_index_file_path, platform_ops_map::enMapMode::read_write);
+}
+
+void clsAccountIndex::insert(std::string_view account_number,
+                             std::uint64_t offset) {
+  if (!is_open())
+    return;
+  // The caller just appended to the data file; see the new bytes.
+  if (offset >= _data.size() && !remap_data())
+    return;
+
+  // Tombstones fill probe chains like live slots: without the second check,
+  // insert/erase churn could leave no EMPTY_SLOT and find() would never end.
+  const std::uint64_t capacity = header()->capacity;
+  if ((header()->count + 1) * 2 > capacity) {
+    if (!rehash(capacity * 2))
+      return;
+  } else if ((header()->count + header()->tombstones + 1) * 2 > capacity) {
+    if (!rehash(capacity))
+      return;
+  }
+
+  const std::uint64_t mask = header()->capacity - 1;
+  const std::uint64_t hash = slot_hash(account_number);
+  stIndexSlot *table = slots();
+  stIndexSlot *reusable = nullptr;
+  for (std::uint64_t i = hash & mask;; i = (i + 1) & mask) {
+    if (table[i].hash == EMPTY_SLOT) {
+      if (reusable != nullptr) {
+        *reusable = {hash, offset};
+        --header()->tombstones;
+      } else {
+        table[i] = {hash, offset};
+      }
+      ++header()->count;
+      break;
+    }
+    if (table[i].hash == DELETED_SLOT) {
+      if (reusable == nullptr)
+        reusable = &table[i];
+    } else if (table[i].hash == hash && matches(table[i].offset, account_number)) {
+      table[i].offset = offset; // Same account, new line
+      break;
+    }
+  }
+  stamp_data_file();
+}
+
+bool clsAccountIndex::erase(std::string_view account_number) {
+  if (!is_open())
+    return false;
+  const std::uint64_t mask = header()->capacity - 1;
+  const std::uint64_t hash = slot_hash(account_number);
+  stIndexSlot *table = slots();
+  for (std::uint64_t i = hash & mask;; i = (i + 1) & mask) {
+    if (table[i].hash == EMPTY_SLOT)
+      return false;
+    if (table[i].hash == hash && matches(table[i].offset, account_number)) {
+      // A tombstone keeps later entries of the same probe chain reachable.
+      table[i].hash = DELETED_SLOT;
+      --header()->count;
+      ++header()->tombstones;
+      stamp_data_file();
+      return true;
+    }
+  }
+}
+
+void clsAccountIndex::rebuild() {
+  _index.close();
+  _data.close();
+  build_index_file(_data_file_path, _index_file_path);
+  _data.open(_data_file_path);
+  _index.open(_index_file_path, platform_ops_map::enMapMode::read_write);
+}
+} // namespace account_index
@@ -0,0 +1,227 @@
+// client_data_app/src/services/index/balance_index/balance_index.cpp
+
+#include "services/index/balance_index/balance_index.h"
+#include "file_ops/file_ops.h"
+#include "services/balance/balance.h"
+#include "services/convert/h_convert/h_convert.h"
+#include "services/index/sidecar/sidecar.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <utility>
+
+namespace balance_index {
+
+namespace {
+constexpr std::size_t BALANCE_FIELD = static_cast<std::size_t>(
+    client_data_structure::enClientField::account_balance);
+
+// Keys per cache line: prefetching slot k * KEYS_PER_LINE fetches the line
+// holding all 8 descendants of k three levels down.
+constexpr std::uint64_t KEYS_PER_LINE = 64 / sizeof(std::int64_t);
+
+std::uint64_t expected_size(std::uint64_t count) noexcept {
+  return sizeof(stBalanceHeader) + (count + 1) * sizeof(std::int64_t) +
+         (count + 1) * sizeof(std::uint64_t) + count * sizeof(std::uint64_t);
+}
+
+bool is_usable(const platform_ops_map::clsMappedFile &index,
+               const std::filesystem::path &data_file_path) {
+  stBalanceHeader header{};
+  return sidecar::read_header(index, header) &&
+         header.magic == BALANCE_INDEX_MAGIC &&
+         header.version == BALANCE_INDEX_VERSION &&
+         index.size() == expected_size(header.count) &&
+         sidecar::is_current(header, data_file_path);
+}
+
+// In-order walk of the implicit tree: slot k receives the next sorted key,
+// so an in-order read of the tree gives back the sorted column.
+void fill_eytzinger(const std::vector<std::pair<std::int64_t, std::uint64_t>> &sorted,
+                    std::vector<std::int64_t> &keys,
+                    std::vector<std::uint64_t> &ranks, std::uint64_t &next,
+                    std::uint64_t k) {
+  if (k > sorted.size())
+    return;
+  fill_eytzinger(sorted, keys, ranks, next, 2 * k);
+  keys[k] = sorted[next].first;
+  ranks[k] = next++;
+  fill_eytzinger(sorted, keys, ranks, next, 2 * k + 1);
+}
+
+void prefetch(const void *address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#else
+  (void)address;
+#endif
+}
+} // namespace
+
+void build_index_file(const std::filesystem::path &data_file_path,
+                      const std::filesystem::path &index_file_path) {
+  // CPU: one structural pass over the data file; only field 4 is parsed.
+  file_ops::stIndexedClients clients =
+      file_ops::get_all_clients_indexed(data_file_path);
+  const std::string_view buffer = clients.mapping.view();
+  const std::size_t rows = structural_index::row_count(clients.index);
+
+  std::vector<std::pair<std::int64_t, std::uint64_t>> sorted; // (minor, offset)
+  sorted.reserve(rows);
+  for (std::size_t row = 0; row < rows; ++row) {
+    if (structural_index::get_field_count(clients.index, row) !=
+        client_data_structure::FIELD_COUNT)
+      continue; // Blank or malformed line
+    std::int64_t minor = 0;
+    if (!balance::parse_minor_units(
+            structural_index::get_field(clients.index, buffer, row,
+                                        BALANCE_FIELD),
+            minor))
+      continue;
+    sorted.emplace_back(
+        minor, static_cast<std::uint64_t>(
+                   structural_index::get_row(clients.index, buffer, row).data() -
+                   buffer.data()));
+  }
+  // CPU: O(n log n); offsets break ties, so equal balances keep file order.
+  std::sort(sorted.begin(), sorted.end());
+
+  // Memory: 24 bytes per row (key, rank, posting).
+  const std::uint64_t count = sorted.size();
+  std::vector<std::int64_t> keys(sorted.size() + 1, 0);
+  std::vector<std::uint64_t> ranks(keys.size(), 0);
+  std::vector<std::uint64_t> postings;
+  postings.reserve(sorted.size());
+  for (const auto &entry : sorted)
+    postings.push_back(entry.second);
+  std::uint64_t next = 0;
+  fill_eytzinger(sorted, keys, ranks, next, 1);
+
+  stBalanceHeader header{};
+  header.magic = BALANCE_INDEX_MAGIC;
+  header.version = BALANCE_INDEX_VERSION;
+  header.count = count;
+  sidecar::stamp(header, data_file_path);
+
+  sidecar::write_file(index_file_path, "the balance index", [&](std::ofstream &out) {
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    sidecar::write_array(out, keys);
+    sidecar::write_array(out, ranks);
+    sidecar::write_array(out, postings);
+  });
+}
+
+bool clsBalanceIndex::open(const std::filesystem::path &data_file_path,
+                           const std::filesystem::path &index_file_path) {
+  _data_file_path = data_file_path;
+  _index_file_path = index_file_path;
+  _index.close();
+  if (!_data.open(_data_file_path))
+    return false;
+
+  sidecar::ensure_current(
+      _index_file_path,
+      [&](const platform_ops_map::clsMappedFile &existing) {
+        return is_usable(existing, _data_file_path);
+      },
+      [&] { build_index_file(_data_file_path, _index_file_path); });
+  return _index.open(_index_file_path) && is_usable(_index, _data_file_path);
+}
+
+void clsBalanceIndex::rebuild() {
+  _index.close();
+  build_index_file(_data_file_path, _index_file_path);
+  _data.open(_data_file_path);
+  _index.open(_index_file_path);
+}
+
+const stBalanceHeader *clsBalanceIndex::header() const noexcept {
+  return reinterpret_cast<const stBalanceHeader *>(_index.data());
+}
+
+const std::int64_t *clsBalanceIndex::keys() const noexcept {
+  return reinterpret_cast<const std::int64_t *>(_index.data() +
+                                                sizeof(stBalanceHeader));
+}
+
+const std::uint64_t *clsBalanceIndex::ranks() const noexcept {
+  return reinterpret_cast<const std::uint64_t *>(keys() + header()->count + 1);
+}
+
+const std::uint64_t *clsBalanceIndex::postings() const noexcept {
+  return ranks() + header()->count + 1;
+}
+
+std::uint64_t clsBalanceIndex::size() const noexcept {
+  return is_open() ? header()->count : 0;
+}
+
+template <bool Inclusive>
+std::uint64_t clsBalanceIndex::search(std::int64_t minor) const noexcept {
+  if (!is_open())
+    return 0;
+  const std::uint64_t count = header()->count;
+  const std::int64_t *key = keys();
+
+  // CPU: log2(n) steps, each a compare folded into the next slot number (no
+  // branch on the data). The prefetch runs three levels ahead.
+  std::uint64_t k = 1;
+  while (k <= count) {
+    prefetch(key + k * KEYS_PER_LINE);
+    k = 2 * k + static_cast<std::uint64_t>(Inclusive ? key[k] <= minor
+                                                     : key[k] < minor);
+  }
+  // Undo the trailing right turns plus one left turn: the last slot whose
+  // key did not go right is the answer. k == 0 means "past the end".
+  k >>= std::countr_one(k) + 1;
+  return k == 0 ? count : ranks()[k];
+}
+
+std::uint64_t clsBalanceIndex::lower_rank(std::int64_t minor) const noexcept {
+  return search<false>(minor);
+}
+
+std::uint64_t clsBalanceIndex::upper_rank(std::int64_t minor) const noexcept {
+  return search<true>(minor);
+}
+
+std::span<const std::uint64_t>
+clsBalanceIndex::find_range(std::int64_t low_minor,
+                            std::int64_t high_minor) const noexcept {
+  if (!is_open() || low_minor > high_minor)
+    return {};
+  const std::uint64_t begin = lower_rank(low_minor);
+  const std::uint64_t end = upper_rank(high_minor);
+  return {postings() + begin, end - begin};
+}
+
+std::size_t clsBalanceIndex::find_range_records(
+    std::int64_t low_minor, std::int64_t high_minor,
+    std::vector<client_data_structure::stClientData> &records,
+    std::size_t limit, std::vector<std::int64_t> *balances_minor) const {
+  const std::string_view buffer = _data.view();
+  std::size_t found = 0;
+  for (std::uint64_t offset : find_range(low_minor, high_minor)) {
+    if (limit != 0 && found == limit)
+      break;
+    if (offset >= buffer.size())
+      continue;
+    std::string_view rest = buffer.substr(offset);
+    const std::string_view line = rest.substr(0, rest.find('\n'));
+    client_data_structure::stClientData record{};
+    if (!h_convert::convert_line_to_record(line, record))
+      continue;
+    if (balances_minor != nullptr) {
+      // The balance is the last field; parsed as build_index_file did.
+      std::int64_t minor = 0;
+      const std::size_t last = line.rfind(infrastructure_names::SEPARATOR);
+      balance::parse_minor_units(
+          line.substr(last + infrastructure_names::SEPARATOR.size()), minor);
+      balances_minor->push_back(minor);
+    }
+    records.push_back(std::move(record));
+    ++found;
+  }
+  return found;
+}
+} // namespace balance_index
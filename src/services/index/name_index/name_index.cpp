@@ -0,0 +1,319 @@
+// client_data_app/src/services/index/name_index/name_index.cpp
+
+#include "services/index/name_index/name_index.h"
+#include "file_ops/file_ops.h"
+#include "services/convert/h_convert/h_convert.h"
+#include "services/index/sidecar/sidecar.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace name_index {
+
+namespace {
+constexpr std::size_t NAME_FIELD =
+    static_cast<std::size_t>(client_data_structure::enClientField::name);
+
+char fold_char(char c) noexcept {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+std::uint64_t expected_size(const stNameHeader &header) noexcept {
+  return sizeof(stNameHeader) + header.posting_count * sizeof(std::uint64_t) +
+         header.node_count * sizeof(stNameNode) +
+         header.edge_count * sizeof(stNameEdge) + header.label_bytes;
+}
+
+bool is_usable(const platform_ops_map::clsMappedFile &index,
+               const std::filesystem::path &data_file_path) {
+  stNameHeader header{};
+  return sidecar::read_header(index, header) &&
+         header.magic == NAME_INDEX_MAGIC &&
+         header.version == NAME_INDEX_VERSION && header.node_count > 0 &&
+         index.size() == expected_size(header) &&
+         sidecar::is_current(header, data_file_path);
+}
+
+// One indexed record: its folded name (a slice of the shared key buffer) and
+// the offset of its line in the data file.
+struct stKey {
+  std::string_view folded;
+  std::uint64_t offset;
+};
+
+// Builds the radix trie over keys sorted by folded name. Nodes are created in
+// pre-order, so the keys below a node are exactly keys[begin, end).
+class clsTrieBuilder {
+public:
+  explicit clsTrieBuilder(const std::vector<stKey> &keys) : _keys(keys) {}
+
+  void build() {
+    nodes.reserve(_keys.size() * 2 + 1);
+    build_node(0, _keys.size(), 0);
+  }
+
+  std::vector<stNameNode> nodes;
+  std::vector<stNameEdge> edges;
+  std::string labels;
+
+private:
+  std::uint32_t build_node(std::size_t begin, std::size_t end,
+                           std::size_t depth) {
+    const auto node_index = static_cast<std::uint32_t>(nodes.size());
+    nodes.push_back({0, 0, static_cast<std::uint32_t>(begin),
+                      static_cast<std::uint32_t>(end)});
+
+    // Keys ending here sort first; the rest group by their next byte.
+    std::size_t cursor = begin;
+    while (cursor < end && _keys[cursor].folded.size() == depth)
+      ++cursor;
+
+    struct stGroup {
+      std::size_t begin, end, label_end;
+    };
+    std::vector<stGroup> groups;
+    while (cursor < end) {
+      const char next = _keys[cursor].folded[depth];
+      std::size_t group_end = cursor + 1;
+      while (group_end < end && _keys[group_end].folded[depth] == next)
+        ++group_end;
+      // Sorted, so the common prefix of the group is that of its ends.
+      std::string_view first = _keys[cursor].folded;
+      std::string_view last = _keys[group_end - 1].folded;
+      std::size_t common = depth + 1;
+      while (common < first.size() && common < last.size() &&
+             first[common] == last[common])
+        ++common;
+      groups.push_back({cursor, group_end, common});
+      cursor = group_end;
+    }
+
+    // The edges of one node stay contiguous: reserve them before recursing.
+    const auto first_edge = static_cast<std::uint32_t>(edges.size());
+    nodes[node_index].first_edge = first_edge;
+    nodes[node_index].edge_count = static_cast<std::uint32_t>(groups.size());
+    edges.resize(edges.size() + groups.size());
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+      const stGroup &group = groups[i];
+      std::string_view label = _keys[group.begin].folded.substr(
+          depth, group.label_end - depth);
+      stNameEdge edge{static_cast<std::uint32_t>(labels.size()),
+                      static_cast<std::uint32_t>(label.size()), 0};
+      labels.append(label);
+      edge.child = build_node(group.begin, group.end, group.label_end);
+      edges[first_edge + i] = edge;
+    }
+    return node_index;
+  }
+
+  const std::vector<stKey> &_keys;
+};
+} // namespace
+
+std::string fold_name(std::string_view name) {
+  std::string folded(name);
+  for (char &c : folded)
+    c = fold_char(c);
+  return folded;
+}
+
+void build_index_file(const std::filesystem::path &data_file_path,
+                      const std::filesystem::path &index_file_path) {
+  // CPU: one structural pass over the data file; only field 3 is looked at.
+  file_ops::stIndexedClients clients =
+      file_ops::get_all_clients_indexed(data_file_path);
+  const std::string_view buffer = clients.mapping.view();
+  const std::size_t rows = structural_index::row_count(clients.index);
+  if (rows >= std::numeric_limits<std::uint32_t>::max())
+    throw std::runtime_error("Too many rows for the name index: " +
+                             data_file_path.string());
+
+  // Memory: every folded name once in a shared buffer; keys point into it.
+  std::string folded_names;
+  std::vector<std::pair<std::size_t, std::size_t>> spans; // (start, length)
+  std::vector<std::uint64_t> offsets;
+  spans.reserve(rows);
+  offsets.reserve(rows);
+  for (std::size_t row = 0; row < rows; ++row) {
+    if (structural_index::get_field_count(clients.index, row) !=
+        client_data_structure::FIELD_COUNT)
+      continue; // Blank or malformed line
+    std::string_view name =
+        structural_index::get_field(clients.index, buffer, row, NAME_FIELD);
+    spans.emplace_back(folded_names.size(), name.size());
+    for (char c : name)
+      folded_names.push_back(fold_char(c));
+    offsets.push_back(static_cast<std::uint64_t>(
+        structural_index::get_row(clients.index, buffer, row).data() -
+        buffer.data()));
+  }
+
+  std::vector<stKey> keys(spans.size());
+  for (std::size_t i = 0; i < spans.size(); ++i)
+    keys[i] = {std::string_view(folded_names).substr(spans[i].first,
+                                                     spans[i].second),
+               offsets[i]};
+  // CPU: O(n log n) string compares; equal names keep file order.
+  std::sort(keys.begin(), keys.end(), [](const stKey &a, const stKey &b) {
+    return a.folded != b.folded ? a.folded < b.folded : a.offset < b.offset;
+  });
+
+  clsTrieBuilder trie(keys);
+  trie.build();
+  std::vector<std::uint64_t> postings(keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    postings[i] = keys[i].offset;
+
+  stNameHeader header{};
+  header.magic = NAME_INDEX_MAGIC;
+  header.version = NAME_INDEX_VERSION;
+  header.posting_count = postings.size();
+  header.node_count = trie.nodes.size();
+  header.edge_count = trie.edges.size();
+  header.label_bytes = trie.labels.size();
+  sidecar::stamp(header, data_file_path);
+
+  sidecar::write_file(index_file_path, "the name index", [&](std::ofstream &out) {
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    sidecar::write_array(out, postings);
+    sidecar::write_array(out, trie.nodes);
+    sidecar::write_array(out, trie.edges);
+    out.write(trie.labels.data(),
+              static_cast<std::streamsize>(trie.labels.size()));
+  });
+}
+
+bool clsNameIndex::open(const std::filesystem::path &data_file_path,
+                        const std::filesystem::path &index_file_path) {
+  _data_file_path = data_file_path;
+  _index_file_path = index_file_path;
+  _index.close();
+  if (!_data.open(_data_file_path))
+    return false;
+
+  sidecar::ensure_current(
+      _index_file_path,
+      [&](const platform_ops_map::clsMappedFile &existing) {
+        return is_usable(existing, _data_file_path);
+      },
+      [&] { build_index_file(_data_file_path, _index_file_path); });
+  return _index.open(_index_file_path) && is_usable(_index, _data_file_path);
+}
+
+void clsNameIndex::rebuild() {
+  _index.close();
+  build_index_file(_data_file_path, _index_file_path);
+  _data.open(_data_file_path);
+  _index.open(_index_file_path);
+}
+
+const stNameHeader *clsNameIndex::header() const noexcept {
+  return reinterpret_cast<const stNameHeader *>(_index.data());
+}
+
+const std::uint64_t *clsNameIndex::postings() const noexcept {
+  return reinterpret_cast<const std::uint64_t *>(_index.data() +
+                                                 sizeof(stNameHeader));
+}
+
+const stNameNode *clsNameIndex::nodes() const noexcept {
+  return reinterpret_cast<const stNameNode *>(postings() +
+                                              header()->posting_count);
+}
+
+const stNameEdge *clsNameIndex::edges() const noexcept {
+  return reinterpret_cast<const stNameEdge *>(nodes() + header()->node_count);
+}
+
+const char *clsNameIndex::labels() const noexcept {
+  return reinterpret_cast<const char *>(edges() + header()->edge_count);
+}
+
+std::uint64_t clsNameIndex::size() const noexcept {
+  return is_open() ? header()->posting_count : 0;
+}
+
+bool clsNameIndex::descend(std::string_view folded, stNameNode &node,
+                           bool &at_node) const noexcept {
+  const stNameNode *all_nodes = nodes();
+  const stNameEdge *all_edges = edges();
+  const char *all_labels = labels();
+  node = all_nodes[0];
+  at_node = true;
+
+  // CPU: one binary search per edge followed; each edge consumes its whole
+  // label, so the walk is O(prefix length), independent of the row count.
+  while (!folded.empty()) {
+    const stNameEdge *first = all_edges + node.first_edge;
+    const stNameEdge *last = first + node.edge_count;
+    const auto next = static_cast<unsigned char>(folded.front());
+    const stNameEdge *edge = std::lower_bound(
+        first, last, next, [all_labels](const stNameEdge &e, unsigned char c) {
+          return static_cast<unsigned char>(all_labels[e.label_offset]) < c;
+        });
+    if (edge == last ||
+        static_cast<unsigned char>(all_labels[edge->label_offset]) != next)
+      return false;
+
+    std::string_view label(all_labels + edge->label_offset, edge->label_length);
+    const std::size_t compared = std::min(label.size(), folded.size());
+    if (label.compare(0, compared, folded, 0, compared) != 0)
+      return false;
+    node = all_nodes[edge->child];
+    at_node = compared == label.size();
+    folded.remove_prefix(compared);
+  }
+  return true;
+}
+
+std::span<const std::uint64_t>
+clsNameIndex::find_prefix(std::string_view prefix) const {
+  if (!is_open())
+    return {};
+  stNameNode node{};
+  bool at_node = false;
+  if (!descend(fold_name(prefix), node, at_node))
+    return {};
+  return {postings() + node.posting_begin, node.posting_end - node.posting_begin};
+}
+
+std::span<const std::uint64_t>
+clsNameIndex::find_exact(std::string_view name) const {
+  if (!is_open())
+    return {};
+  stNameNode node{};
+  bool at_node = false;
+  if (!descend(fold_name(name), node, at_node) || !at_node)
+    return {};
+  // Names ending exactly at this node sort before those that go on.
+  const std::uint32_t own_end =
+      node.edge_count == 0
+          ? node.posting_end
+          : nodes()[edges()[node.first_edge].child].posting_begin;
+  return {postings() + node.posting_begin, own_end - node.posting_begin};
+}
+
+std::size_t clsNameIndex::find_prefix_records(
+    std::string_view prefix,
+    std::vector<client_data_structure::stClientData> &records,
+    std::size_t limit) const {
+  const std::string_view buffer = _data.view();
+  std::size_t found = 0;
+  for (std::uint64_t offset : find_prefix(prefix)) {
+    if (limit != 0 && found == limit)
+      break;
+    if (offset >= buffer.size())
+      continue;
+    std::string_view rest = buffer.substr(offset);
+    client_data_structure::stClientData record{};
+    if (!h_convert::convert_line_to_record(rest.substr(0, rest.find('\n')),
+                                           record))
+      continue;
+    records.push_back(std::move(record));
+    ++found;
+  }
+  return found;
+}
+} // namespace name_index
@@ -0,0 +1,24 @@
+// client_data_app/src/services/index/sidecar/sidecar.cpp
+
+#include "services/index/sidecar/sidecar.h"
+#include "platform_ops/lock/lock.h"
+
+namespace sidecar {
+stDataStamp stamp_of(const std::filesystem::path &data_file_path) noexcept {
+  stDataStamp stamp;
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(data_file_path, ec);
+  if (!ec)
+    stamp.size = static_cast<std::uint64_t>(size);
+  const auto time = std::filesystem::last_write_time(data_file_path, ec);
+  if (!ec)
+    stamp.mtime = static_cast<std::int64_t>(time.time_since_epoch().count());
+  return stamp;
+}
+
+std::filesystem::path temp_path(const std::filesystem::path &file_path) {
+  std::filesystem::path temp = file_path;
+  temp += ".tmp." + std::to_string(platform_ops_lock::current_process_id());
+  return temp;
+}
+} // namespace sidecar
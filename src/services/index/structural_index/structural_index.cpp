@@ -0,0 +1,154 @@
+// client_data_app/src/services/index/structural_index/structural_index.cpp
+
+#include "services/index/structural_index/structural_index.h"
+#include "infrastructure.h"
+#include "platform_ops/cpu/cpu.h"
+#include <cstring>
+#ifdef PLATFORM_OPS_X86
+#include <immintrin.h>
+#endif
+
+namespace structural_index {
+
+namespace {
+// Shared state of one build pass, so the AVX2 body and the scalar tail emit
+// into the same arrays with the same non-overlap rule.
+struct stBuildState {
+  std::string_view buffer;
+  stStructuralIndex &index;
+  std::size_t next_allowed = 0; // First byte a new separator may start at
+};
+
+inline void push_newline(stBuildState &state, std::size_t pos) {
+  state.index.offsets.push_back(pos);
+  state.index.row_ends.push_back(state.index.offsets.size() - 1);
+}
+
+inline bool is_separator_at(std::string_view buffer, std::size_t pos) {
+  constexpr std::string_view sep = infrastructure_names::SEPARATOR;
+  return pos + sep.size() <= buffer.size() &&
+         std::memcmp(buffer.data() + pos, sep.data(), sep.size()) == 0;
+}
+
+void scan_scalar_from(stBuildState &state, std::size_t start) {
+  constexpr std::string_view sep = infrastructure_names::SEPARATOR;
+  const std::string_view buffer = state.buffer;
+  std::size_t i = start;
+  while (i < buffer.size()) {
+    const char c = buffer[i];
+    if (c == '\n') {
+      push_newline(state, i);
+      ++i;
+    } else if (c == sep[0] && is_separator_at(buffer, i)) {
+      state.index.offsets.push_back(i);
+      i += sep.size(); // A separator never contains '\n', so skipping is safe
+      state.next_allowed = i;
+    } else {
+      ++i;
+    }
+  }
+}
+
+#ifdef PLATFORM_OPS_X86
+PLATFORM_OPS_TARGET_AVX2
+std::size_t scan_avx2(stBuildState &state) {
+  constexpr std::string_view sep = infrastructure_names::SEPARATOR;
+  constexpr std::size_t last = sep.size() - 1;
+  const std::string_view buffer = state.buffer;
+  const __m256i newline_byte = _mm256_set1_epi8('\n');
+  const __m256i first_byte = _mm256_set1_epi8(sep[0]);
+  const __m256i last_byte = _mm256_set1_epi8(sep[last]);
+
+  std::size_t i = 0;
+  for (; i + last + 32 <= buffer.size(); i += 32) {
+    const char *p = buffer.data() + i;
+    __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    __m256i tail =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + last));
+
+    unsigned newlines = static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(head, newline_byte)));
+    unsigned candidates = static_cast<unsigned>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(head, first_byte),
+                         _mm256_cmpeq_epi8(tail, last_byte))));
+
+    // CPU: most 32-byte blocks of a record have at most one or two bits set,
+    // so the loop below runs a handful of times per block.
+    unsigned mask = newlines | candidates;
+    while (mask != 0) {
+      unsigned bit = platform_ops_cpu::lowest_bit(mask);
+      mask &= mask - 1;
+      std::size_t pos = i + bit;
+      if ((newlines >> bit) & 1u) {
+        push_newline(state, pos);
+      } else if (pos >= state.next_allowed &&
+                 std::memcmp(p + bit + 1, sep.data() + 1, sep.size() - 2) ==
+                     0) {
+        state.index.offsets.push_back(pos);
+        state.next_allowed = pos + sep.size();
+      }
+    }
+  }
+  return i;
+}
+#endif
+} // namespace
+
+stStructuralIndex build_structural_index(std::string_view buffer) {
+  stStructuralIndex index{};
+  if (buffer.empty())
+    return index;
+
+  // Memory: a record line is ~60 bytes carrying 5 structural characters, so
+  // one entry per 16 bytes avoids most regrowth without over-reserving much.
+  index.offsets.reserve(buffer.size() / 16);
+  index.row_ends.reserve(buffer.size() / 64);
+
+  stBuildState state{buffer, index};
+  std::size_t scanned = 0;
+#ifdef PLATFORM_OPS_X86
+  if (platform_ops_cpu::has_avx2())
+    scanned = scan_avx2(state);
+#endif
+  scan_scalar_from(state, scanned > state.next_allowed ? scanned
+                                                       : state.next_allowed);
+
+  // A last line without '\n' is still a row; close it at the buffer end.
+  if (buffer.back() != '\n') {
+    index.offsets.push_back(buffer.size());
+    index.row_ends.push_back(index.offsets.size() - 1);
+  }
+  return index;
+}
+
+std::string_view get_row(const stStructuralIndex &index,
+                         std::string_view buffer, std::size_t row) noexcept {
+  std::size_t begin = row == 0 ? 0 : index.offsets[index.row_ends[row - 1]] + 1;
+  std::size_t end = index.offsets[index.row_ends[row]];
+  return buffer.substr(begin, end - begin);
+}
+
+std::size_t get_field_count(const stStructuralIndex &index,
+                            std::size_t row) noexcept {
+  std::size_t first = row == 0 ? 0 : index.row_ends[row - 1] + 1;
+  // Entries strictly between the previous row end and this row end are the
+  // row's separators.
+  return index.row_ends[row] - first + 1;
+}
+
+std::string_view get_field(const stStructuralIndex &index,
+                           std::string_view buffer, std::size_t row,
+                           std::size_t field_no) noexcept {
+  constexpr std::size_t sep_size = infrastructure_names::SEPARATOR.size();
+  const std::size_t first = row == 0 ? 0 : index.row_ends[row - 1] + 1;
+  const std::size_t last = index.row_ends[row];
+  if (field_no > last - first)
+    return {};
+
+  std::size_t begin = field_no == 0
+                          ? (row == 0 ? 0 : index.offsets[first - 1] + 1)
+                          : index.offsets[first + field_no - 1] + sep_size;
+  std::size_t end = index.offsets[first + field_no];
+  return buffer.substr(begin, end - begin);
+}
+} // namespace structural_index
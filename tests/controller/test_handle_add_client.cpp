@@ -0,0 +1,104 @@
+// tests/controller/test_handle_add_client.cpp
+#include "catch_amalgamated.hpp"
+#include "controller/add_client/handle_add_client.h"
+#include "controller/batch/handle_batch.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace add_client_controller;
+
+namespace {
+struct TestAddEnv {
+  std::filesystem::path dir;
+  std::filesystem::path data_file;
+  std::filesystem::path log_file;
+  std::filesystem::path filter_file;
+
+  explicit TestAddEnv(const std::string &subdir) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+    log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+    filter_file = dir / std::string(infrastructure_names::ACCOUNT_FILTER_FILE_NAME);
+    std::ofstream out(data_file, std::ios::binary);
+    out << "1#//#p1#//#555#//#Alice#//#100\n"
+        << "2#//#p2#//#556#//#Bob#//#200\n";
+  }
+  ~TestAddEnv() { std::filesystem::remove_all(dir); }
+};
+
+client_data_structure::stClientData client(const std::string &account) {
+  return {account, "pin", "0100", "Client " + account, 10.0};
+}
+} // namespace
+
+TEST_CASE("add_new_client skips the scan for definitely new accounts",
+          "[add_client]") {
+  TestAddEnv env("add_client_fast");
+  op_log::clsOpLog log(env.data_file, env.log_file);
+  account_filter::clsAccountFilter filter;
+  account_filter::attach(filter, log);
+  account_filter::build_filter_file(env.filter_file, log.load(), log.version());
+  REQUIRE(filter.open(env.filter_file));
+
+  stAddResult result = add_new_client(log, filter, client("NEW1"));
+  REQUIRE(result.status == enAddStatus::added);
+  REQUIRE_FALSE(result.scanned);
+  REQUIRE(filter.is_current(log.version())); // The append updated the filter
+
+  // Now a possible hit: confirmed exactly, and nothing is written.
+  const auto log_size = log.log_size();
+  result = add_new_client(log, filter, client("NEW1"));
+  REQUIRE(result.status == enAddStatus::duplicate);
+  REQUIRE(result.scanned);
+  REQUIRE(add_new_client(log, filter, client("1")).status ==
+          enAddStatus::duplicate);
+  REQUIRE(log.log_size() == log_size);
+  REQUIRE(log.load().size() == 3);
+}
+
+TEST_CASE("add_new_client rebuilds a missing or stale filter",
+          "[add_client]") {
+  TestAddEnv env("add_client_stale");
+  op_log::clsOpLog log(env.data_file, env.log_file);
+  account_filter::clsAccountFilter filter;
+  account_filter::attach(filter, log);
+  REQUIRE_FALSE(filter.open(env.filter_file));
+
+  // The first add builds the filter from a full load.
+  REQUIRE(add_new_client(log, filter, client("NEW1")).scanned);
+
+  // A commit made without the filter attached leaves it behind its version.
+  log.set_commit_observer({});
+  log.append({op_log::enOperation::add, client("NEW2")});
+  account_filter::attach(filter, log);
+  REQUIRE_FALSE(filter.is_current(log.version()));
+
+  const stAddResult result = add_new_client(log, filter, client("NEW2"));
+  REQUIRE(result.status == enAddStatus::duplicate);
+  REQUIRE(filter.is_current(log.version()));
+}
+
+TEST_CASE("batch deletes keep an attached filter current", "[add_client]") {
+  TestAddEnv env("add_client_batch");
+  op_log::clsOpLog log(env.data_file, env.log_file);
+  account_filter::clsAccountFilter filter;
+  account_filter::build_filter_file(env.filter_file, log.load(), log.version());
+  REQUIRE(filter.open(env.filter_file));
+  account_filter::attach(filter, log);
+
+  std::istringstream script("delete 2\nadd 3#//#p3#//#557#//#Carol#//#300\n");
+  std::ostringstream out, err;
+  REQUIRE(batch_controller::run_batch(script, out, err, log).errors == 0);
+  REQUIRE(filter.is_current(log.version()));
+  REQUIRE_FALSE(filter.possibly_contains("2"));
+  REQUIRE(filter.possibly_contains("3"));
+
+  // The freed account number goes through without a scan.
+  const stAddResult result = add_new_client(log, filter, client("2"));
+  REQUIRE(result.status == enAddStatus::added);
+  REQUIRE_FALSE(result.scanned);
+}
@@ -0,0 +1,107 @@
+// tests/controller/test_handle_batch.cpp
+#include "catch_amalgamated.hpp"
+#include "controller/batch/handle_batch.h"
+#include "file_ops/file_ops.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace batch_controller;
+
+namespace {
+struct TestBatchEnv {
+  std::filesystem::path dir;
+  std::filesystem::path data_file;
+  std::filesystem::path log_file;
+
+  explicit TestBatchEnv(const std::string &subdir) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+    log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+    std::ofstream out(data_file, std::ios::binary);
+    out << "1#//#p1#//#555#//#Alice#//#100\n"
+        << "2#//#p2#//#556#//#Bob#//#200\n";
+  }
+  ~TestBatchEnv() { std::filesystem::remove_all(dir); }
+};
+} // namespace
+
+TEST_CASE("run_batch applies a script and appends its mutations once", "[batch]") {
+  TestBatchEnv env("batch_append");
+  const auto data_before = std::filesystem::file_size(env.data_file);
+  std::istringstream script("# bulk job\n"
+                            "add 3#//#p3#//#557#//#Carol Smith#//#300\n"
+                            "find 3\n"
+                            "update 1#//#p1#//#555#//#Alice#//#150.5\r\n"
+                            "\n"
+                            "delete 2\n"
+                            "list\n");
+  std::ostringstream out, err;
+  {
+    op_log::clsOpLog log(env.data_file, env.log_file);
+    stBatchResult result = run_batch(script, out, err, log);
+    REQUIRE(result.commands == 5);
+    REQUIRE(result.mutations == 3);
+    REQUIRE(result.errors == 0);
+    REQUIRE_FALSE(result.rewrote);
+  }
+  REQUIRE(err.str().empty());
+  REQUIRE(out.str() == "3#//#p3#//#557#//#Carol Smith#//#300\n"
+                       "1#//#p1#//#555#//#Alice#//#150.5\n"
+                       "3#//#p3#//#557#//#Carol Smith#//#300\n");
+
+  // Data file untouched; the three mutations sit in the log as one append.
+  REQUIRE(std::filesystem::file_size(env.data_file) == data_before);
+  std::ifstream log_in(env.log_file, std::ios::binary);
+  std::string log_text((std::istreambuf_iterator<char>(log_in)),
+                       std::istreambuf_iterator<char>());
+  REQUIRE(log_text == "A#//#3#//#p3#//#557#//#Carol Smith#//#300\n"
+                      "U#//#1#//#p1#//#555#//#Alice#//#150.5\n"
+                      "D#//#2\n");
+
+  op_log::clsOpLog reopened(env.data_file, env.log_file);
+  auto records = reopened.load();
+  REQUIRE(records.size() == 2);
+  REQUIRE(records[0].account_balance == 150.5);
+  REQUIRE(records[1].name == "Carol Smith");
+}
+
+TEST_CASE("run_batch reports bad lines and keeps going", "[batch]") {
+  TestBatchEnv env("batch_errors");
+  std::istringstream script("add 1#//#p#//#0#//#Dup#//#1\n"
+                            "update 9#//#p#//#0#//#Nobody#//#1\n"
+                            "add not a record\n"
+                            "delete 7\n"
+                            "find\n"
+                            "transfer 1 2\n"
+                            "add 4#//#p4#//#558#//#Dina#//#40\n");
+  std::ostringstream out, err;
+  op_log::clsOpLog log(env.data_file, env.log_file);
+  stBatchResult result = run_batch(script, out, err, log);
+  REQUIRE(result.commands == 7);
+  REQUIRE(result.errors == 6);
+  REQUIRE(result.mutations == 1);
+  REQUIRE(err.str().find("line 1: account 1 already exists") != std::string::npos);
+  REQUIRE(err.str().find("line 6: unknown command 'transfer'") != std::string::npos);
+  REQUIRE(log.load().size() == 3);
+}
+
+TEST_CASE("run_batch rewrites the data file when the batch outgrows the log", "[batch]") {
+  TestBatchEnv env("batch_rewrite");
+  std::istringstream script("delete 1\n"
+                            "add 3#//#p3#//#557#//#Carol#//#300\n");
+  std::ostringstream out, err;
+  op_log::clsOpLog log(env.data_file, env.log_file, /*fold_threshold=*/16);
+  stBatchResult result = run_batch(script, out, err, log);
+  REQUIRE(result.rewrote);
+  REQUIRE(log.log_size() == 0);
+  REQUIRE(std::filesystem::file_size(env.log_file) == 0);
+
+  auto records = file_ops::load_clients_parallel(env.data_file);
+  REQUIRE(records.size() == 2);
+  REQUIRE(records[0].account_number == "2");
+  REQUIRE(records[1].account_number == "3");
+}
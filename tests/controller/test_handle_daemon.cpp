@@ -0,0 +1,282 @@
+// tests/controller/test_handle_daemon.cpp
+#include "catch_amalgamated.hpp"
+#ifdef __linux__
+#include "controller/daemon/handle_daemon.h"
+#include "file_ops/file_ops.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+using namespace daemon_controller;
+
+namespace {
+struct TestDaemonEnv {
+  std::filesystem::path dir;
+  std::filesystem::path data_file;
+  std::filesystem::path log_file;
+  std::filesystem::path socket_file;
+
+  explicit TestDaemonEnv(const std::string &subdir) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+    log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+    socket_file = dir / std::string(infrastructure_names::SOCKET_FILE_NAME);
+    std::ofstream out(data_file, std::ios::binary);
+    out << "1#//#p1#//#555#//#Alice#//#100\n";
+  }
+  ~TestDaemonEnv() { std::filesystem::remove_all(dir); }
+};
+
+int connect_to(const std::filesystem::path &socket_file) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, socket_file.c_str(), sizeof(address.sun_path) - 1);
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  REQUIRE(::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0);
+  return fd;
+}
+
+// Reads until `status_lines` lines starting with OK/ERR have arrived.
+std::string read_replies(int fd, int status_lines) {
+  std::string reply;
+  char buffer[4096];
+  auto count = [&reply] {
+    int statuses = 0;
+    std::size_t start = 0;
+    for (std::size_t end; (end = reply.find('\n', start)) != std::string::npos; start = end + 1)
+      if (reply.compare(start, 2, "OK") == 0 || reply.compare(start, 3, "ERR") == 0)
+        ++statuses;
+    return statuses;
+  };
+  while (count() < status_lines) {
+    const ssize_t received = ::recv(fd, buffer, sizeof(buffer), 0);
+    if (received <= 0)
+      break;
+    reply.append(buffer, static_cast<std::size_t>(received));
+  }
+  return reply;
+}
+
+void send_all(int fd, const std::string &text) {
+  REQUIRE(::send(fd, text.data(), text.size(), 0) == static_cast<ssize_t>(text.size()));
+}
+} // namespace
+
+TEST_CASE("clsDaemon serves commands over its socket and logs before replying", "[daemon]") {
+  TestDaemonEnv env("daemon_serve");
+  op_log::clsOpLog log(env.data_file, env.log_file);
+  clsDaemon server(env.socket_file, log);
+  std::jthread loop([&server] { server.run(); });
+
+  int first = connect_to(env.socket_file);
+  int second = connect_to(env.socket_file);
+
+  send_all(first, "add 2#//#p2#//#556#//#Bob Stone#//#200\n# comment\nfind 2\nbogus\n");
+  REQUIRE(read_replies(first, 3) == "OK\n"
+                                     "2#//#p2#//#556#//#Bob Stone#//#200\n"
+                                     "OK\n"
+                                     "ERR unknown command 'bogus'\n");
+  // The add was committed before its OK was sent.
+  REQUIRE(std::filesystem::file_size(env.log_file) > 0);
+
+  // Another client sees the same warm state; a command split across sends works.
+  send_all(second, "delete ");
+  send_all(second, "1\nlist\n");
+  REQUIRE(read_replies(second, 2) == "OK\n"
+                                      "2#//#p2#//#556#//#Bob Stone#//#200\n"
+                                      "OK\n");
+
+  ::close(first);
+  ::close(second);
+  server.stop();
+  loop.join();
+
+  auto records = log.load();
+  REQUIRE(records.size() == 1);
+  REQUIRE(records[0].account_number == "2");
+}
+
+TEST_CASE("clsDaemon publishes every commit and reads from the published table", "[daemon]") {
+  TestDaemonEnv env("daemon_published");
+  op_log::clsOpLog log(env.data_file, env.log_file);
+  clsDaemon server(env.socket_file, log);
+  std::jthread loop([&server] { server.run(); });
+  int client = connect_to(env.socket_file);
+
+  send_all(client, "list\n");
+  REQUIRE(read_replies(client, 1) == "1#//#p1#//#555#//#Alice#//#100\nOK\n");
+  const std::uint64_t loaded = server.published().version();
+
+  send_all(client, "add 2#//#p2#//#556#//#Bob#//#200.5\n");
+  REQUIRE(read_replies(client, 1) == "OK\n");
+  {
+    // Another thread reads the committed state without going through the loop.
+    const client_snapshot::clsReadView view = server.published().read();
+    REQUIRE(view.version() == loaded + 1);
+    REQUIRE(view.size() == 2);
+    REQUIRE(view.find("2")->balance_minor == 20050);
+  }
+  send_all(client, "find 2\n");
+  REQUIRE(read_replies(client, 1) == "2#//#p2#//#556#//#Bob#//#200.5\nOK\n");
+
+  // A read behind a staged mutation of its group still sees that mutation.
+  send_all(client, "delete 1\nfind 1\n");
+  REQUIRE(read_replies(client, 2) == "OK\nERR account 1 not found\n");
+  REQUIRE_FALSE(server.published().read().find("1").has_value());
+  REQUIRE(server.published().version() == loaded + 2);
+
+  ::close(client);
+  server.stop();
+  loop.join();
+}
+
+TEST_CASE("clsDaemon replaces a stale socket but never a regular file", "[daemon]") {
+  TestDaemonEnv env("daemon_stale");
+  op_log::clsOpLog log(env.data_file, env.log_file);
+  {
+    clsDaemon first(env.socket_file, log);
+  }
+  REQUIRE_FALSE(std::filesystem::exists(env.socket_file)); // Removed on destruction
+
+  {
+    // Simulate a crash: bind a socket file and leave it behind.
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, env.socket_file.c_str(), sizeof(address.sun_path) - 1);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    REQUIRE(::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0);
+    ::close(fd);
+  }
+  REQUIRE_NOTHROW(clsDaemon(env.socket_file, log));
+
+  std::ofstream(env.socket_file) << "not a socket";
+  REQUIRE_THROWS_AS(clsDaemon(env.socket_file, log), std::system_error);
+  REQUIRE(std::filesystem::is_regular_file(env.socket_file));
+}
+TEST_CASE("clsDaemon answers ERR and reloads after another process commits", "[daemon]") {
+  TestDaemonEnv env("daemon_conflict");
+  op_log::clsOpLog log(env.data_file, env.log_file);
+  clsDaemon server(env.socket_file, log);
+  std::jthread loop([&server] { server.run(); });
+  int client = connect_to(env.socket_file);
+  send_all(client, "list\n");
+  REQUIRE(read_replies(client, 1) == "1#//#p1#//#555#//#Alice#//#100\nOK\n");
+
+  {
+    op_log::clsOpLog other(env.data_file, env.log_file); // Another operator
+    other.append({op_log::enOperation::add, {"9", "p9", "559", "Zed", 9.0}});
+  }
+
+  send_all(client, "add 2#//#p2#//#556#//#Bob#//#200\n");
+  REQUIRE(read_replies(client, 1).starts_with("ERR The data was changed by another process"));
+
+  // The daemon reloaded: the other operator's client is visible and a retry works.
+  send_all(client, "find 9\nadd 2#//#p2#//#556#//#Bob#//#200\n");
+  REQUIRE(read_replies(client, 2) == "9#//#p9#//#559#//#Zed#//#9\nOK\nOK\n");
+
+  ::close(client);
+  server.stop();
+  loop.join();
+  REQUIRE(log.load().size() == 3);
+}
+
+TEST_CASE("clsDaemon answers ERR and keeps serving when a commit fails", "[daemon]") {
+  TestDaemonEnv env("daemon_commit_failure");
+  op_log::clsOpLog log(env.data_file, env.log_file);
+  bool fail = true;
+  log.set_commit_observer([&fail](std::span<const op_log::stLogEntry>, std::uint64_t) {
+    if (std::exchange(fail, false))
+      throw std::runtime_error("Failed to sync the operation log");
+  });
+  clsDaemon server(env.socket_file, log);
+  std::jthread loop([&server] { server.run(); });
+  int client = connect_to(env.socket_file);
+
+  send_all(client, "add 2#//#p2#//#556#//#Bob#//#200\n");
+  REQUIRE(read_replies(client, 1) == "ERR Failed to sync the operation log\n");
+
+  // Still serving, from state reloaded off disk.
+  send_all(client, "add 3#//#p3#//#557#//#Cy#//#300\nfind 3\n");
+  REQUIRE(read_replies(client, 2) == "OK\n3#//#p3#//#557#//#Cy#//#300\nOK\n");
+
+  ::close(client);
+  server.stop();
+  loop.join();
+}
+
+TEST_CASE("clsDaemon holds a group window open so concurrent writers share a commit", "[daemon]") {
+  TestDaemonEnv env("daemon_group_window");
+  op_log::clsOpLog log(env.data_file, env.log_file);
+  log.set_sync_policy(op_log::enSyncPolicy::group);
+  const auto window = std::chrono::milliseconds(200);
+  clsDaemon server(env.socket_file, log, window);
+  std::jthread loop([&server] { server.run(); });
+  int first = connect_to(env.socket_file);
+  int second = connect_to(env.socket_file);
+
+  // A read alone is not held back.
+  send_all(first, "find 1\n");
+  REQUIRE(read_replies(first, 1) == "1#//#p1#//#555#//#Alice#//#100\nOK\n");
+
+  const auto start = std::chrono::steady_clock::now();
+  send_all(first, "add 2#//#p2#//#556#//#Bob#//#200\n");
+  send_all(second, "add 3#//#p3#//#557#//#Cleo#//#300\n");
+  REQUIRE(read_replies(second, 1) == "OK\n");
+  REQUIRE(read_replies(first, 1) == "OK\n");
+  REQUIRE(std::chrono::steady_clock::now() - start >= window);
+  // One group: both adds went out in the same append.
+  REQUIRE(std::filesystem::file_size(env.log_file) ==
+          op_log::convert_entry_to_line({op_log::enOperation::add, {"2", "p2", "556", "Bob", 200}}).size() +
+              op_log::convert_entry_to_line({op_log::enOperation::add, {"3", "p3", "557", "Cleo", 300}}).size());
+
+  // Hanging up ends the window at once.
+  send_all(second, "delete 3\n");
+  ::shutdown(second, SHUT_WR);
+  const auto hang_up = std::chrono::steady_clock::now();
+  REQUIRE(read_replies(second, 1) == "OK\n");
+  REQUIRE(std::chrono::steady_clock::now() - hang_up < window);
+
+  ::close(first);
+  ::close(second);
+  server.stop();
+  loop.join();
+  REQUIRE(log.load().size() == 2);
+}
+
+TEST_CASE("clsDaemon compacts tombstoned clients in the background", "[daemon]") {
+  TestDaemonEnv env("daemon_compaction");
+  {
+    std::ofstream out(env.data_file, std::ios::binary | std::ios::app);
+    out << "2#//#p2#//#556#//#Bob#//#200\n3#//#p3#//#557#//#Cleo#//#300\n";
+  }
+  op_log::clsOpLog log(env.data_file, env.log_file);
+  clsDaemon server(env.socket_file, log);
+  std::jthread loop([&server] { server.run(); });
+  int client = connect_to(env.socket_file);
+
+  send_all(client, "delete 1\n");
+  REQUIRE(read_replies(client, 1) == "OK\n");
+  // The worker's signal wakes the loop, which publishes the rewrite.
+  for (int i = 0; i < 200 && file_ops::get_all_clients(env.data_file).size() != 2; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  REQUIRE(file_ops::get_all_clients(env.data_file).size() == 2);
+
+  send_all(client, "list\n");
+  REQUIRE(read_replies(client, 1) == "2#//#p2#//#556#//#Bob#//#200\n"
+                                     "3#//#p3#//#557#//#Cleo#//#300\n"
+                                     "OK\n");
+  ::close(client);
+  server.stop();
+  loop.join();
+  REQUIRE(std::filesystem::file_size(env.log_file) == 0);
+}
+#endif
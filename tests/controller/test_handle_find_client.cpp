@@ -0,0 +1,155 @@
+// tests/controller/test_handle_find_client.cpp
+#include "catch_amalgamated.hpp"
+#include "controller/find_client/handle_find_client.h"
+#include "file_ops/op_log/op_log.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace find_client_controller;
+
+TEST_CASE("find_clients_by_name applies the pending log to index hits",
+          "[find_client]") {
+  const auto dir = std::filesystem::temp_directory_path() / "find_client_log";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const auto data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+  const auto log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+  const auto index_file = dir / std::string(infrastructure_names::NAME_INDEX_FILE_NAME);
+  {
+    std::ofstream out(data_file, std::ios::binary);
+    out << "1#//#p1#//#555#//#Alice#//#100\n"
+        << "2#//#p2#//#556#//#Alfred#//#200\n"
+        << "3#//#p3#//#557#//#Bob#//#300\n";
+  }
+  {
+    op_log::clsOpLog log(data_file, log_file);
+    log.append({op_log::enOperation::remove, {"1", "", "", "", 0}});
+    log.append({op_log::enOperation::update, {"3", "p3", "557", "Albert", 300}});
+    log.append({op_log::enOperation::add, {"4", "p4", "558", "ALAN", 400}});
+    log.append({op_log::enOperation::add, {"5", "p5", "559", "Zoe", 500}});
+  }
+
+  name_index::clsNameIndex index;
+  REQUIRE(index.open(data_file, index_file));
+  const auto found = find_clients_by_name(index, log_file, "al");
+  REQUIRE(found.size() == 3);
+  REQUIRE(found[0].name == "ALAN");
+  REQUIRE(found[1].name == "Albert");
+  REQUIRE(found[2].name == "Alfred");
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("find_clients_by_balance applies the pending log to index hits",
+          "[find_client]") {
+  const auto dir = std::filesystem::temp_directory_path() / "find_client_balance";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const auto data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+  const auto log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+  const auto index_file = dir / std::string(infrastructure_names::BALANCE_INDEX_FILE_NAME);
+  {
+    std::ofstream out(data_file, std::ios::binary);
+    out << "1#//#p1#//#555#//#Alice#//#-10\n"
+        << "2#//#p2#//#556#//#Bob#//#-20\n"
+        << "3#//#p3#//#557#//#Carol#//#300\n";
+  }
+  {
+    op_log::clsOpLog log(data_file, log_file);
+    log.append({op_log::enOperation::update, {"1", "p1", "555", "Alice", 5}});
+    log.append({op_log::enOperation::update, {"3", "p3", "557", "Carol", -1}});
+    log.append({op_log::enOperation::add, {"4", "p4", "558", "Dan", -99.5}});
+  }
+
+  balance_index::clsBalanceIndex index;
+  REQUIRE(index.open(data_file, index_file));
+  REQUIRE(index.find_overdrawn().size() == 2); // The data file alone
+  const auto found = find_clients_by_balance(
+      index, log_file, INT64_MIN, balance_index::OVERDRAWN_MAX_MINOR);
+  REQUIRE(found.size() == 3);
+  REQUIRE(found[0].account_number == "4");
+  REQUIRE(found[1].account_number == "2");
+  REQUIRE(found[2].account_number == "3");
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("find_clients_by_balance keeps the indexed minor units after a replay",
+          "[find_client]") {
+  const auto dir = std::filesystem::temp_directory_path() / "find_client_balance_exact";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const auto data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+  const auto log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+  const auto index_file = dir / std::string(infrastructure_names::BALANCE_INDEX_FILE_NAME);
+  {
+    // Both parse as the double 1.005, but their texts round to 1.01 and 1.00.
+    std::ofstream out(data_file, std::ios::binary);
+    out << "A1#//#p#//#555#//#Ann#//#1.005\n"
+        << "A2#//#p#//#556#//#Bo#//#1.00499999999999999999\n";
+  }
+  {
+    op_log::clsOpLog log(data_file, log_file);
+    log.append({op_log::enOperation::add, {"A3", "p", "555", "Cy", 7}});
+    log.append({op_log::enOperation::add, {"A4", "p", "557", "Di", 1.005}});
+  }
+
+  balance_index::clsBalanceIndex index;
+  REQUIRE(index.open(data_file, index_file));
+  const auto cent = find_clients_by_balance(index, log_file, 101, 101);
+  REQUIRE(cent.size() == 2);
+  REQUIRE(cent[0].account_number == "A1");
+  REQUIRE(cent[1].account_number == "A4"); // The log line says "1.005"
+  const auto whole = find_clients_by_balance(index, log_file, 100, 100);
+  REQUIRE(whole.size() == 1);
+  REQUIRE(whole[0].account_number == "A2");
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("find_client_by_account applies the pending log and survives a fold",
+          "[find_client]") {
+  const auto dir = std::filesystem::temp_directory_path() / "find_client_account";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const auto data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+  const auto log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+  const auto index_file = dir / std::string(infrastructure_names::ACCOUNT_INDEX_FILE_NAME);
+  {
+    std::ofstream out(data_file, std::ios::binary);
+    out << "1#//#p1#//#555#//#Alice#//#100\n"
+        << "2#//#p2#//#556#//#Bob#//#200\n";
+  }
+  op_log::clsOpLog log(data_file, log_file);
+  log.append({op_log::enOperation::remove, {"1", "", "", "", 0}});
+  log.append({op_log::enOperation::update, {"2", "p2", "556", "Bobby", 250}});
+  log.append({op_log::enOperation::add, {"3", "p3", "557", "Carol", 300}});
+  {
+    account_index::clsAccountIndex index;
+    REQUIRE(index.open(data_file, index_file));
+    REQUIRE(find_client_by_account(index, log_file, "1").empty());
+    const auto found = find_client_by_account(index, log_file, "2");
+    REQUIRE(found.size() == 1);
+    REQUIRE(found[0].name == "Bobby");
+    REQUIRE(find_client_by_account(index, log_file, "3").size() == 1);
+    REQUIRE(find_client_by_account(index, log_file, "9").empty());
+  }
+
+  // The fold publishes the index of the new data file along with it
+  log.fold();
+  account_index::stIndexHeader header{};
+  {
+    std::ifstream in(index_file, std::ios::binary);
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  }
+  REQUIRE(header.data_file_size == std::filesystem::file_size(data_file));
+  REQUIRE(header.count == 2);
+
+  account_index::clsAccountIndex index;
+  REQUIRE(index.open(data_file, index_file));
+  REQUIRE(find_client_by_account(index, log_file, "3").size() == 1);
+  REQUIRE(find_client_by_account(index, log_file, "1").empty());
+
+  std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,52 @@
+// tests/controller/test_handle_fixed_records.cpp
+#include "catch_amalgamated.hpp"
+#include "controller/fixed_records/handle_fixed_records.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace fixed_records_controller;
+
+TEST_CASE("In-place fixed-width changes go through the operation log",
+          "[fixed_records]") {
+  const auto dir = std::filesystem::temp_directory_path() / "fixed_records_controller";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const auto data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+  const auto log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+  const auto fixed_file = dir / std::string(infrastructure_names::FIXED_FILE_NAME);
+  {
+    std::ofstream out(data_file, std::ios::binary);
+    out << "1#//#p1#//#555#//#Alice#//#100\n"
+        << "2#//#p2#//#556#//#Bob#//#200\n";
+  }
+  op_log::clsOpLog log(data_file, log_file);
+  fixed_records::convert_to_fixed(log.load(), fixed_file, {log.version(), log.log_size()});
+  fixed_records::clsFixedRecordFile file;
+  REQUIRE(file.open(fixed_file, true));
+
+  std::string error;
+  REQUIRE(update_fixed_balance(log, file, 0, -1250, error));
+  REQUIRE(delete_fixed_row(log, file, 1, error));
+  REQUIRE_FALSE(delete_fixed_row(log, file, 1, error)); // Already deleted
+  REQUIRE_FALSE(update_fixed_balance(log, file, 2, 0, error)); // Past the end
+
+  // The primary store has both changes and the copy is stamped as current.
+  op_log::clsOpLog reader(data_file, log_file);
+  const auto records = reader.load();
+  REQUIRE(records.size() == 1);
+  REQUIRE(records[0].account_balance == -12.5);
+  REQUIRE(file.source() == fixed_records::stFixedSource{reader.version(), reader.log_size()});
+
+  // Another commit makes the copy stale: changes are refused, nothing is written.
+  reader.append({op_log::enOperation::add, {"3", "p3", "557", "Cy", 1}});
+  REQUIRE_THROWS_AS(update_fixed_balance(log, file, 0, 0, error),
+                    data_lock::clsVersionConflict);
+  op_log::clsOpLog current(data_file, log_file);
+  REQUIRE_FALSE(update_fixed_balance(current, file, 0, 0, error));
+  REQUIRE(error.find("stale") != std::string::npos);
+  REQUIRE(std::filesystem::file_size(log_file) == reader.log_size());
+
+  file.close();
+  std::filesystem::remove_all(dir);
+}
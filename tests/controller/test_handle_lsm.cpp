@@ -0,0 +1,48 @@
+// tests/controller/test_handle_lsm.cpp
+#include "catch_amalgamated.hpp"
+#include "controller/lsm/handle_lsm.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace lsm_controller;
+
+TEST_CASE("An ingest is staged, then committed to the operation log as one batch",
+          "[lsm]") {
+  const auto dir = std::filesystem::temp_directory_path() / "lsm_ingest";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const auto data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+  const auto log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+  {
+    std::ofstream out(data_file, std::ios::binary);
+    out << "1#//#p1#//#555#//#Alice#//#100\n";
+  }
+  op_log::clsOpLog log(data_file, log_file);
+  lsm::clsLsmStore staging(dir);
+
+  std::istringstream input("2#//#p2#//#556#//#Bob#//#200\n"
+                           "not a record\n"
+                           "1#//#p1#//#555#//#Alice#//#150\n"
+                           "2#//#p2#//#556#//#Bob#//#250\n");
+  std::size_t malformed = 0;
+  REQUIRE(ingest_clients(staging, input, malformed) == 3);
+  REQUIRE(malformed == 1);
+  REQUIRE(std::filesystem::file_size(log_file) == 0); // Staged only
+
+  REQUIRE(publish_staged(staging, log) == 2); // One entry per account
+  REQUIRE(staging.load().empty());
+
+  // Every reader of the clients sees the ingest.
+  op_log::stLogEntry entry{};
+  REQUIRE(op_log::find_last_entry(log_file, "2", entry));
+  REQUIRE(entry.operation == op_log::enOperation::add);
+  REQUIRE(entry.record.account_balance == 250);
+  op_log::clsOpLog reader(data_file, log_file);
+  const auto records = reader.load();
+  REQUIRE(records.size() == 2);
+  REQUIRE(records[0].account_balance == 150);
+
+  std::filesystem::remove_all(dir);
+}
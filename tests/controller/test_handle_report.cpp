@@ -0,0 +1,49 @@
+// tests/controller/test_handle_report.cpp
+#include "catch_amalgamated.hpp"
+#include "controller/report/handle_report.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("portfolio_totals sums the clients' balances exactly", "[report]") {
+  const std::vector<client_data_structure::stClientData> records{
+      {"1", "p1", "555", "Alice", 100.10, false},
+      {"2", "p2", "556", "Bob", -20.05, false},
+      {"3", "p3", "557", "Carol", 0, false},
+  };
+  const balance::stPortfolioTotals totals = report_controller::portfolio_totals(records);
+  REQUIRE(totals.client_count == 3);
+  REQUIRE(totals.total_minor == 8005);
+  REQUIRE(totals.lowest_minor == -2005);
+  REQUIRE(totals.highest_minor == 10010);
+  REQUIRE(totals.overdrawn_count == 1);
+  REQUIRE(totals.zero_count == 1);
+
+  REQUIRE(report_controller::portfolio_totals({}).client_count == 0);
+}
+
+TEST_CASE("load_portfolio_totals reads balances exactly from the files", "[report]") {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path() / "report_totals";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const auto data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+  const auto log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+  {
+    std::ofstream out(data_file, std::ios::binary);
+    out << "A1#//#p#//#555#//#Ann#//#1.005\n"
+        << "A2#//#p#//#556#//#Bo#//#-3\n";
+    std::ofstream log(log_file, std::ios::binary);
+    log << "A#//#A3#//#p#//#557#//#Cy#//#7\n"
+        << "D#//#A2\n";
+  }
+
+  const balance::stPortfolioTotals totals =
+      report_controller::load_portfolio_totals(data_file, log_file);
+  REQUIRE(totals.client_count == 2);
+  REQUIRE(totals.lowest_minor == 101); // "1.005" rounds half away from zero
+  REQUIRE(totals.highest_minor == 700);
+  REQUIRE(totals.total_minor == 801);
+  REQUIRE(totals.overdrawn_count == 0);
+  std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,69 @@
+// tests/file_ops/test_client_stream.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/client_stream/client_stream.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <string>
+
+using namespace file_ops;
+
+static_assert(std::ranges::input_range<clsClientStream>);
+
+TEST_CASE("clsClientStream yields parsed records in file order",
+          "[client_stream]") {
+  std::string file_name = "clients_stream.csv";
+  {
+    std::ofstream out(file_name, std::ios::binary);
+    out << "1#//#p#//#5#//#Alice#//#10\n"
+        << "\n"
+        << "not a record\n"
+        << "2#//#q#//#6#//#Bob#//#-2.5\n"
+        << "3#//#r#//#7#//#Carol#//#0";
+  }
+  std::vector<std::string> names;
+  double total = 0;
+  for (const auto &client : clsClientStream(file_name)) {
+    names.push_back(client.name);
+    total += client.account_balance;
+  }
+  std::filesystem::remove(file_name);
+
+  REQUIRE(names == std::vector<std::string>{"Alice", "Bob", "Carol"});
+  REQUIRE(total == 7.5);
+}
+
+TEST_CASE("clsClientStream works with std::ranges algorithms",
+          "[client_stream]") {
+  std::string file_name = "clients_stream_ranges.csv";
+  {
+    std::ofstream out(file_name, std::ios::binary);
+    for (int i = 0; i < 10000; ++i)
+      out << i << "#//#p#//#0#//#Client" << i << "#//#" << (i % 2 ? -1 : 1)
+          << "\n";
+  }
+  clsClientStream stream(file_name);
+  auto overdrawn = std::ranges::count_if(
+      stream, [](const auto &client) { return client.account_balance < 0; });
+  std::filesystem::remove(file_name);
+  REQUIRE(overdrawn == 5000);
+}
+
+TEST_CASE("clsClientStream on a missing or empty file is an empty range",
+          "[client_stream]") {
+  clsClientStream missing("no_such_stream_file.csv");
+  REQUIRE_FALSE(missing.is_open());
+  REQUIRE(missing.begin() == missing.end());
+
+  std::string file_name = "clients_stream_empty.csv";
+  {
+    std::ofstream out(file_name);
+  }
+  {
+    clsClientStream empty(file_name);
+    REQUIRE(empty.is_open());
+    REQUIRE(empty.begin() == empty.end());
+  }
+  std::filesystem::remove(file_name);
+}
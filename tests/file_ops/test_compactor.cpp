@@ -0,0 +1,146 @@
+// tests/file_ops/test_compactor.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/compactor/compactor.h"
+#include "file_ops/file_ops.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace op_log;
+using client_data_structure::stClientData;
+
+namespace {
+struct TestCompactorEnv {
+  std::filesystem::path dir;
+  std::filesystem::path data_file;
+  std::filesystem::path log_file;
+
+  explicit TestCompactorEnv(const std::string &subdir) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+    log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+    std::ofstream out(data_file, std::ios::binary);
+    for (int i = 1; i <= 8; ++i)
+      out << i << "#//#p#//#55" << i << "#//#Client " << i << "#//#" << i * 100 << '\n';
+  }
+  ~TestCompactorEnv() { std::filesystem::remove_all(dir); }
+
+  std::size_t temp_files() const {
+    std::size_t count = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(dir))
+      if (entry.path().string().find(".compact") != std::string::npos ||
+          entry.path().extension() == ".tmp")
+        ++count;
+    return count;
+  }
+};
+
+stLogEntry remove_entry(const std::string &account) {
+  stLogEntry entry{enOperation::remove, {}};
+  entry.record.account_number = account;
+  return entry;
+}
+
+void wait_for(const std::atomic<bool> &flag) {
+  while (!flag.load())
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+} // namespace
+
+TEST_CASE("Deletes are logged as tombstones until their ratio calls for compaction", "[compactor]") {
+  TestCompactorEnv env("compactor_ratio");
+  clsOpLog log(env.data_file, env.log_file);
+  REQUIRE(log.load().size() == 8);
+  const auto data_before = std::filesystem::file_size(env.data_file);
+
+  log.append(remove_entry("1"));
+  REQUIRE(log.tombstone_count() == 1);
+  REQUIRE(log.client_count() == 7);
+  REQUIRE_FALSE(log.is_compaction_due()); // 1 of 8 rows
+  log.append(remove_entry("2"));
+  REQUIRE(log.is_compaction_due()); // 2 of 8 rows
+  REQUIRE(std::filesystem::file_size(env.data_file) == data_before);
+
+  // A reopened log counts the same tombstones from the file.
+  clsOpLog reopened(env.data_file, env.log_file);
+  REQUIRE(reopened.load().size() == 6);
+  REQUIRE(reopened.tombstone_count() == 2);
+  REQUIRE(reopened.is_fold_due());
+  REQUIRE(reopened.fold_if_due());
+  REQUIRE(reopened.tombstone_count() == 0);
+  REQUIRE(file_ops::get_all_clients(env.data_file).size() == 6);
+}
+
+TEST_CASE("clsCompactor rewrites in the background and keeps entries appended meanwhile", "[compactor]") {
+  TestCompactorEnv env("compactor_background");
+  clsOpLog log(env.data_file, env.log_file);
+  log.set_sync_policy(enSyncPolicy::group);
+  log.load();
+  log.append(remove_entry("1"));
+  log.append(remove_entry("2"));
+  log.append({enOperation::update, {"3", "p", "553", "Carla", 333}});
+
+  std::atomic<bool> ready{false};
+  compactor::clsCompactor compaction(log, [&ready] { ready = true; });
+  REQUIRE(compaction.start_if_due());
+  REQUIRE_FALSE(compaction.start_if_due()); // One job at a time
+
+  // The owner keeps writing while the worker rewrites.
+  log.append(remove_entry("4"));
+  log.append({enOperation::add, {"9", "p", "559", "Nina", 900}});
+  const auto tail_bytes =
+      convert_entry_to_line(remove_entry("4")).size() +
+      convert_entry_to_line({enOperation::add, {"9", "p", "559", "Nina", 900}}).size();
+
+  wait_for(ready);
+  REQUIRE(compaction.finish_if_ready());
+  REQUIRE_FALSE(compaction.is_running());
+
+  // The data file lost the tombstoned rows; the log kept only the tail.
+  const auto lines = file_ops::get_all_clients(env.data_file);
+  REQUIRE(lines.size() == 6);
+  REQUIRE(lines[0] == "3#//#p#//#553#//#Carla#//#333");
+  REQUIRE(std::filesystem::file_size(env.log_file) == tail_bytes);
+  REQUIRE(log.log_size() == tail_bytes);
+  REQUIRE(log.tombstone_count() == 1);
+  REQUIRE(env.temp_files() == 0);
+
+  // Appends go to the new log, and a fresh reader sees the same state.
+  log.append(remove_entry("5"));
+  clsOpLog reader(env.data_file, env.log_file);
+  const auto records = reader.load();
+  REQUIRE(records.size() == 5);
+  REQUIRE(records[0].name == "Carla");
+  REQUIRE(records.back().name == "Nina");
+}
+
+TEST_CASE("clsCompactor discards a job overtaken by a reload", "[compactor]") {
+  TestCompactorEnv env("compactor_overtaken");
+  clsOpLog log(env.data_file, env.log_file);
+  log.load();
+  log.append(remove_entry("1"));
+  log.append(remove_entry("2"));
+
+  std::atomic<bool> ready{false};
+  compactor::clsCompactor compaction(log, [&ready] { ready = true; });
+  REQUIRE(compaction.start_if_due());
+  wait_for(ready);
+  log.load(); // e.g. after a version conflict: the job's log may be gone
+  const auto data_before = std::filesystem::file_size(env.data_file);
+  REQUIRE_FALSE(compaction.finish_if_ready());
+  REQUIRE(std::filesystem::file_size(env.data_file) == data_before);
+  REQUIRE(env.temp_files() == 0);
+
+  // The next job goes through.
+  ready = false;
+  REQUIRE(compaction.start_if_due());
+  wait_for(ready);
+  REQUIRE(compaction.finish_if_ready());
+  REQUIRE(file_ops::get_all_clients(env.data_file).size() == 6);
+  REQUIRE(std::filesystem::file_size(env.log_file) == 0);
+}
@@ -0,0 +1,50 @@
+// tests/file_ops/test_data_lock.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/data_lock/data_lock.h"
+#include <filesystem>
+#include <stdexcept>
+
+using namespace data_lock;
+
+TEST_CASE("clsDataLock::commit bumps the version or fails fast", "[data_lock]") {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "data_lock_commit.lock";
+  std::filesystem::remove(path);
+
+  clsDataLock first(path), second(path); // Two "processes"
+  const std::uint64_t seen_by_first = first.current_version();
+  const std::uint64_t seen_by_second = second.current_version();
+  REQUIRE(seen_by_first == 0);
+
+  int published = 0;
+  REQUIRE(first.commit(seen_by_first, [&] { ++published; }) == 1);
+
+  // second's view is stale: its publish step must not run.
+  try {
+    second.commit(seen_by_second, [&] { ++published; });
+    FAIL("commit with a stale version succeeded");
+  } catch (const clsVersionConflict &conflict) {
+    REQUIRE(conflict.expected_version() == 0);
+    REQUIRE(conflict.actual_version() == 1);
+  }
+  REQUIRE(published == 1);
+
+  // After re-reading, second commits fine.
+  REQUIRE(second.commit(second.current_version(), [&] { ++published; }) == 2);
+  REQUIRE(published == 2);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("A failed publish leaves the version unchanged", "[data_lock]") {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "data_lock_failed.lock";
+  std::filesystem::remove(path);
+
+  clsDataLock lock(path);
+  REQUIRE_THROWS_AS(lock.commit(0, [] { throw std::runtime_error("disk full"); }),
+                    std::runtime_error);
+  REQUIRE(lock.current_version() == 0);
+  // The lock was released on the exception: a read still gets through.
+  REQUIRE(lock.read_locked([] {}) == 0);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,190 @@
+// tests/file_ops/test_fixed_records.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/fixed_records/fixed_records.h"
+#include "services/balance/balance.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace fixed_records;
+using client_data_structure::stClientData;
+
+namespace {
+struct TestFixedEnv {
+  std::filesystem::path dir;
+  std::filesystem::path fixed_file;
+
+  explicit TestFixedEnv(const std::string &subdir) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    fixed_file = dir / std::string(infrastructure_names::FIXED_FILE_NAME);
+  }
+  ~TestFixedEnv() { std::filesystem::remove_all(dir); }
+};
+
+std::vector<stClientData> sample_clients(int count) {
+  std::vector<stClientData> records;
+  for (int i = 0; i < count; ++i)
+    records.push_back({"A" + std::to_string(i), "p" + std::to_string(i),
+                       "555" + std::to_string(i), "Client " + std::to_string(i),
+                       i * 10.25, false});
+  return records;
+}
+} // namespace
+
+TEST_CASE("make_layout keeps the balance aligned and the default record at 112 bytes",
+          "[fixed_records]") {
+  const stFixedLayout layout = make_layout(DEFAULT_WIDTHS);
+  REQUIRE(layout.record_size == 112);
+  REQUIRE(layout.balance_offset % 8 == 0);
+  REQUIRE(layout.flags_offset == layout.balance_offset + 8);
+
+  const stFixedLayout odd = make_layout({3, 1, 1, 2});
+  REQUIRE(odd.field_offsets[3] == 5);
+  REQUIRE(odd.balance_offset == 8);
+  REQUIRE(odd.record_size % 8 == 0);
+}
+
+TEST_CASE("convert_to_fixed drops deleted rows and reads back by row number",
+          "[fixed_records]") {
+  TestFixedEnv env("fixed_records_convert");
+  std::vector<stClientData> records = sample_clients(50);
+  records[3].delete_mark = true;
+  records[7].name = std::string(60, 'n'); // Wider than the default name field
+
+  REQUIRE(convert_to_fixed(records, env.fixed_file) == 49);
+  records.erase(records.begin() + 3);
+
+  clsFixedRecordFile file;
+  REQUIRE(file.open(env.fixed_file));
+  REQUIRE(file.size() == 49);
+  REQUIRE(file.layout().widths[3] == 60);
+
+  stClientData row{};
+  REQUIRE(file.read_row(6, row));
+  REQUIRE(row.account_number == records[6].account_number);
+  REQUIRE(row.name == records[6].name);
+  REQUIRE(row.account_balance == records[6].account_balance);
+  REQUIRE_FALSE(file.read_row(49, row));
+
+  std::vector<stClientData> page;
+  REQUIRE(file.read_rows(40, 20, page) == 9); // Clamped to the last row
+  REQUIRE(page.size() == 9);
+  REQUIRE(page.front().account_number == records[40].account_number);
+  REQUIRE(page.back().account_number == records[48].account_number);
+  page.clear();
+  REQUIRE(file.read_rows(49, 5, page) == 0);
+}
+
+TEST_CASE("clsFixedRecordFile updates rows in place and appends", "[fixed_records]") {
+  TestFixedEnv env("fixed_records_update");
+  convert_to_fixed(sample_clients(10), env.fixed_file);
+  const auto size_before = std::filesystem::file_size(env.fixed_file);
+
+  clsFixedRecordFile file;
+  REQUIRE(file.open(env.fixed_file, true));
+  REQUIRE(file.update_balance(2, balance::to_minor_units(-12.5)));
+  REQUIRE(file.mark_deleted(4));
+  stClientData changed = sample_clients(10)[5];
+  changed.phone_no = "999";
+  REQUIRE(file.write_row(5, changed));
+  REQUIRE(std::filesystem::file_size(env.fixed_file) == size_before);
+
+  changed.name = std::string(49, 'x'); // Too wide: refused, not truncated
+  REQUIRE_FALSE(file.write_row(5, changed));
+  REQUIRE_FALSE(file.update_balance(10, 0));
+
+  stClientData added = sample_clients(11)[10];
+  REQUIRE(file.append_row(added) == 10);
+  REQUIRE(file.sync());
+  file.close();
+
+  clsFixedRecordFile reopened;
+  REQUIRE(reopened.open(env.fixed_file));
+  REQUIRE(reopened.size() == 11);
+  stClientData row{};
+  REQUIRE(reopened.read_row(2, row));
+  REQUIRE(row.account_balance == -12.5);
+  REQUIRE(reopened.read_row(4, row));
+  REQUIRE(row.delete_mark);
+  REQUIRE(reopened.read_row(5, row));
+  REQUIRE(row.phone_no == "999");
+  REQUIRE(row.name == "Client 5");
+  REQUIRE(reopened.read_row(10, row));
+  REQUIRE(row.account_number == added.account_number);
+
+  std::vector<stClientData> page;
+  REQUIRE(reopened.read_rows(0, 11, page) == 11);
+  REQUIRE(page.size() == 10); // Row 4 is tombstoned
+
+  // Written in place: no longer a copy of any state until restamped.
+  REQUIRE(reopened.source().data_version == UNSTAMPED_VERSION);
+}
+
+TEST_CASE("clsFixedRecordFile restamps only through set_source", "[fixed_records]") {
+  TestFixedEnv env("fixed_records_stamp");
+  convert_to_fixed(sample_clients(3), env.fixed_file, {4, 100});
+  clsFixedRecordFile file;
+  REQUIRE(file.open(env.fixed_file, true));
+  REQUIRE(file.update_balance(1, 500));
+  REQUIRE(file.source() != stFixedSource{4, 100});
+  REQUIRE(file.set_source({5, 140}));
+  file.close();
+
+  REQUIRE(file.open(env.fixed_file));
+  REQUIRE(file.source() == stFixedSource{5, 140});
+}
+
+TEST_CASE("clsFixedRecordFile rejects other files and ignores a torn append",
+          "[fixed_records]") {
+  TestFixedEnv env("fixed_records_reject");
+  {
+    std::ofstream out(env.fixed_file, std::ios::binary);
+    out << "A#//#p#//#555#//#Client#//#10\n";
+  }
+  clsFixedRecordFile file;
+  REQUIRE_FALSE(file.open(env.fixed_file));
+
+  convert_to_fixed(sample_clients(3), env.fixed_file);
+  {
+    std::ofstream out(env.fixed_file, std::ios::binary | std::ios::app);
+    out << "partial record";
+  }
+  REQUIRE(file.open(env.fixed_file, true));
+  REQUIRE(file.size() == 3);
+  REQUIRE(file.append_row(sample_clients(4)[3]) == 3);
+  stClientData row{};
+  REQUIRE(file.read_row(3, row));
+  REQUIRE(row.account_number == "A3");
+
+  std::filesystem::resize_file(env.fixed_file, 64 + 2 * 112);
+  REQUIRE_FALSE(file.open(env.fixed_file)); // Shorter than row_count rows
+}
+
+TEST_CASE("convert_to_fixed stamps its source and refuses oversize fields",
+          "[fixed_records]") {
+  TestFixedEnv env("fixed_records_source");
+  std::vector<stClientData> records = sample_clients(3);
+  REQUIRE(convert_to_fixed(records, env.fixed_file, {7, 1234}) == 3);
+  {
+    clsFixedRecordFile file;
+    REQUIRE(file.open(env.fixed_file));
+    REQUIRE(file.source() == stFixedSource{7, 1234});
+  }
+
+  // Longer than a uint16 width can say: thrown, never silently cut.
+  records[1].name = std::string(UINT16_MAX + 1u, 'n');
+  REQUIRE_THROWS_AS(convert_to_fixed(records, env.fixed_file), std::runtime_error);
+  clsFixedRecordFile file;
+  REQUIRE(file.open(env.fixed_file)); // The previous file is untouched
+  REQUIRE(file.source() == stFixedSource{7, 1234});
+
+  records[1].name = std::string(UINT16_MAX, 'n'); // The widest that fits
+  REQUIRE(convert_to_fixed(records, env.fixed_file) == 3);
+  REQUIRE(file.open(env.fixed_file));
+  stClientData row{};
+  REQUIRE(file.read_row(1, row));
+  REQUIRE(row.name.size() == UINT16_MAX);
+}
@@ -0,0 +1,79 @@
+// tests/file_ops/test_get_all_clients_mapped.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/file_ops.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+using namespace file_ops;
+
+TEST_CASE("Mapped: file with multiple client lines", "[get_all_clients_mapped]") {
+  std::string tempFileName = "clients_mapped_multi.txt";
+  {
+    std::ofstream out(tempFileName);
+    out << "Alice\nBob\nCharlie\n";
+  }
+  auto result = get_all_clients_mapped(tempFileName);
+  REQUIRE(result.lines.size() == 3);
+  REQUIRE(result.lines[0] == "Alice");
+  REQUIRE(result.lines[1] == "Bob");
+  REQUIRE(result.lines[2] == "Charlie");
+  result.mapping.close();
+  std::filesystem::remove(tempFileName);
+}
+
+TEST_CASE("Mapped: file is empty", "[get_all_clients_mapped]") {
+  std::string tempFileName = "clients_mapped_empty.txt";
+  {
+    std::ofstream out(tempFileName);
+  }
+  auto result = get_all_clients_mapped(tempFileName);
+  REQUIRE(result.mapping.is_open());
+  REQUIRE(result.lines.empty());
+  std::filesystem::remove(tempFileName);
+}
+
+TEST_CASE("Mapped: file does not exist", "[get_all_clients_mapped]") {
+  auto result = get_all_clients_mapped("no_such_mapped_file.txt");
+  REQUIRE_FALSE(result.mapping.is_open());
+  REQUIRE(result.lines.empty());
+}
+
+TEST_CASE("Mapped: matches get_all_clients on special characters, blank "
+          "lines and missing final newline",
+          "[get_all_clients_mapped]") {
+  std::string tempFileName = "clients_mapped_special.txt";
+  {
+    std::ofstream out(tempFileName, std::ios::binary);
+    out << "A!@#\n \n\nBob\t\nCharlie";
+  }
+  auto expected = get_all_clients(tempFileName);
+  auto result = get_all_clients_mapped(tempFileName);
+  REQUIRE(result.lines.size() == expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    REQUIRE(result.lines[i] == expected[i]);
+  result.mapping.close();
+  std::filesystem::remove(tempFileName);
+}
+
+TEST_CASE("Mapped: views survive moving the owning result",
+          "[get_all_clients_mapped]") {
+  std::string tempFileName = "clients_mapped_large.txt";
+  std::size_t numLines = 10000;
+  {
+    std::ofstream out(tempFileName);
+    for (std::size_t i = 0; i < numLines; ++i)
+      out << "Client" << i << "\n";
+  }
+  stMappedClients moved;
+  {
+    auto result = get_all_clients_mapped(tempFileName);
+    moved = std::move(result);
+  }
+  REQUIRE(moved.lines.size() == numLines);
+  REQUIRE(moved.lines[0] == "Client0");
+  REQUIRE(moved.lines[numLines - 1] == "Client9999");
+  moved.mapping.close();
+  std::filesystem::remove(tempFileName);
+}
@@ -0,0 +1,107 @@
+// tests/file_ops/test_load_clients_parallel.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/file_ops.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace file_ops;
+
+namespace {
+// Writes `rows` records; every 1000th line is blank and every 997th malformed.
+int write_records(const std::string &file_name, int rows) {
+  std::ofstream out(file_name, std::ios::binary);
+  int valid = 0;
+  for (int i = 0; i < rows; ++i) {
+    if (i % 1000 == 0)
+      out << "\n";
+    if (i % 997 == 0) {
+      out << "broken line without separators\n";
+      continue;
+    }
+    out << "A" << i << "#//#pin" << i << "#//#0100" << i << "#//#Client Name "
+        << i << "#//#" << i << ".25\n";
+    ++valid;
+  }
+  return valid;
+}
+} // namespace
+
+TEST_CASE("load_clients_parallel parses records in file order",
+          "[load_clients_parallel]") {
+  std::string file_name = "clients_parallel.csv";
+  // ~5 MiB so that several 1 MiB ranges are really used
+  const int rows = 90000;
+  const int valid = write_records(file_name, rows);
+
+  auto single = load_clients_parallel(file_name, 1);
+  auto multi = load_clients_parallel(file_name, 4);
+  std::filesystem::remove(file_name);
+
+  REQUIRE(single.size() == static_cast<std::size_t>(valid));
+  REQUIRE(multi.size() == single.size());
+  for (std::size_t i = 0; i < single.size(); ++i) {
+    REQUIRE(multi[i].account_number == single[i].account_number);
+    REQUIRE(multi[i].account_balance == single[i].account_balance);
+  }
+  REQUIRE(multi[0].account_number == "A1");
+  REQUIRE(multi[0].pass_code == "pin1");
+  REQUIRE(multi[0].phone_no == "01001");
+  REQUIRE(multi[0].name == "Client Name 1");
+  REQUIRE(multi[0].account_balance == 1.25);
+  REQUIRE(multi.back().account_number == "A" + std::to_string(rows - 1));
+}
+
+TEST_CASE("load_clients_parallel handles empty and missing files",
+          "[load_clients_parallel]") {
+  std::string file_name = "clients_parallel_empty.csv";
+  {
+    std::ofstream out(file_name);
+  }
+  REQUIRE(load_clients_parallel(file_name).empty());
+  std::filesystem::remove(file_name);
+
+  REQUIRE(load_clients_parallel("no_such_parallel_file.csv").empty());
+}
+
+TEST_CASE("load_clients_parallel keeps a last line without newline",
+          "[load_clients_parallel]") {
+  std::string file_name = "clients_parallel_nonl.csv";
+  {
+    std::ofstream out(file_name, std::ios::binary);
+    out << "1#//#p#//#5#//#Alice#//#1\n2#//#q#//#6#//#Bob#//#-2.5";
+  }
+  auto result = load_clients_parallel(file_name, 8);
+  std::filesystem::remove(file_name);
+  REQUIRE(result.size() == 2);
+  REQUIRE(result[1].name == "Bob");
+  REQUIRE(result[1].account_balance == -2.5);
+}
+
+TEST_CASE("save_all_clients rewrites through the temp file and skips deleted "
+          "records",
+          "[save_all_clients]") {
+  std::filesystem::path dir =
+      std::filesystem::temp_directory_path() / "save_all_clients_test";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  std::filesystem::path file_path = dir / "clients.csv";
+  {
+    std::ofstream out(file_path);
+    out << "old content\n";
+  }
+
+  std::vector<client_data_structure::stClientData> records = {
+      {"1", "p", "5", "Alice", 1.5},
+      {"2", "q", "6", "Bob", 2, true},
+      {"3", "r", "7", "Carol", 3}};
+  save_all_clients(file_path, records);
+
+  auto lines = get_all_clients(file_path);
+  REQUIRE(lines.size() == 2);
+  REQUIRE(lines[0] == "1#//#p#//#5#//#Alice#//#1.5");
+  REQUIRE(lines[1] == "3#//#r#//#7#//#Carol#//#3");
+  REQUIRE_FALSE(std::filesystem::exists(
+      dir / std::string(infrastructure_names::TEMP_FILE_NAME)));
+  std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,299 @@
+// tests/file_ops/test_lsm.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/lsm/lsm.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lsm;
+using client_data_structure::stClientData;
+
+namespace {
+struct TestLsmEnv {
+  std::filesystem::path dir;
+
+  explicit TestLsmEnv(const std::string &subdir) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+  }
+  ~TestLsmEnv() { std::filesystem::remove_all(dir); }
+
+  std::size_t run_files() const {
+    std::size_t count = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(dir))
+      if (entry.path().extension() == infrastructure_names::LSM_RUN_EXTENSION)
+        ++count;
+    return count;
+  }
+};
+
+// Small enough that a few hundred clients flush and compact many times.
+stLsmOptions small_options(bool background = false) {
+  stLsmOptions options;
+  options.memtable_bytes = 2048;
+  options.l0_compaction_trigger = 3;
+  options.l0_stop_trigger = 6;
+  options.level_base_bytes = 8192;
+  options.level_ratio = 4;
+  options.target_run_bytes = 2048;
+  options.background = background;
+  return options;
+}
+
+stClientData client(int i, double balance) {
+  char account[16];
+  std::snprintf(account, sizeof(account), "C%05d", i);
+  return {account, "p", "555" + std::to_string(i), "Client " + std::to_string(i),
+          balance, false};
+}
+
+op_log::stLogEntry put(int i, double balance) {
+  return {op_log::enOperation::update, client(i, balance)};
+}
+
+op_log::stLogEntry remove_entry(int i) {
+  return {op_log::enOperation::remove, client(i, 0)};
+}
+
+void require_matches(const clsLsmStore &store, const std::map<int, double> &expected) {
+  const std::vector<stClientData> records = store.load();
+  REQUIRE(records.size() == expected.size());
+  auto record = records.begin();
+  for (const auto &[i, balance] : expected) {
+    REQUIRE(record->account_number == client(i, 0).account_number);
+    REQUIRE(record->account_balance == balance);
+    ++record;
+  }
+}
+} // namespace
+
+TEST_CASE("clsLsmStore finds clients in the memtable and in flushed runs", "[lsm]") {
+  TestLsmEnv env("lsm_basic");
+  clsLsmStore store(env.dir, small_options());
+  const std::vector<op_log::stLogEntry> first{put(1, 10), put(2, 20), put(3, 30)};
+  store.apply(first);
+  REQUIRE(store.memtable_size() == 3);
+
+  stClientData record{};
+  REQUIRE(store.find("C00002", record));
+  REQUIRE(record.account_balance == 20);
+
+  store.flush();
+  REQUIRE(store.memtable_size() == 0);
+  REQUIRE(store.run_counts() == std::vector<std::size_t>{1});
+  REQUIRE(std::filesystem::file_size(env.dir / infrastructure_names::LSM_LOG_FILE_NAME) == 0);
+
+  const std::vector<op_log::stLogEntry> second{put(2, 25), remove_entry(3)};
+  store.apply(second);
+  REQUIRE(store.find("C00002", record));
+  REQUIRE(record.account_balance == 25); // Memtable wins over the run
+  REQUIRE_FALSE(store.find("C00003", record)); // Tombstone hides the run entry
+  REQUIRE(store.find("C00001", record));
+  REQUIRE_FALSE(store.find("C00009", record));
+  require_matches(store, {{1, 10}, {2, 25}});
+}
+
+TEST_CASE("clsRunFile answers lookups through its sparse index", "[lsm]") {
+  TestLsmEnv env("lsm_run_file");
+  {
+    clsLsmStore store(env.dir, small_options());
+    std::vector<op_log::stLogEntry> entries;
+    for (int i = 0; i < 100; i += 2)
+      entries.push_back(put(i, i));
+    store.apply(entries);
+    store.flush();
+  }
+  std::filesystem::path path;
+  for (const auto &entry : std::filesystem::directory_iterator(env.dir))
+    if (entry.path().extension() == infrastructure_names::LSM_RUN_EXTENSION)
+      path = entry.path();
+
+  clsRunFile run;
+  REQUIRE(run.open(path, 1));
+  REQUIRE(run.entry_count() == 50);
+  REQUIRE(run.min_key() == "C00000");
+  REQUIRE(run.max_key() == "C00098");
+  op_log::stLogEntry entry{};
+  for (int i = 0; i < 100; ++i) {
+    const std::string key = client(i, 0).account_number;
+    REQUIRE(run.find(key, entry) == (i % 2 == 0));
+    if (i % 2 == 0)
+      REQUIRE(entry.record.account_balance == i);
+  }
+  REQUIRE_FALSE(run.find("C10000", entry));
+
+  std::ofstream(env.dir / "not_a_run.run", std::ios::binary) << "C00001#//#x\n";
+  clsRunFile bad;
+  REQUIRE_FALSE(bad.open(env.dir / "not_a_run.run", 2));
+}
+
+TEST_CASE("clsLsmStore compacts into disjoint levels and keeps the newest entries",
+          "[lsm]") {
+  TestLsmEnv env("lsm_compaction");
+  clsLsmStore store(env.dir, small_options());
+  std::map<int, double> expected;
+
+  // Three rounds over the same keys: updates, then deletes of every third.
+  for (int round = 0; round < 3; ++round)
+    for (int i = 0; i < 300; i += 10) {
+      std::vector<op_log::stLogEntry> batch;
+      for (int j = i; j < i + 10; ++j) {
+        if (round == 2 && j % 3 == 0) {
+          batch.push_back(remove_entry(j));
+          expected.erase(j);
+        } else {
+          batch.push_back(put(j, round * 1000 + j));
+          expected[j] = round * 1000 + j;
+        }
+      }
+      store.apply(batch);
+      store.compact_pending();
+    }
+  store.flush();
+  store.compact_pending();
+
+  const std::vector<std::size_t> counts = store.run_counts();
+  REQUIRE(counts.size() >= 3); // Reached level 2
+  REQUIRE(counts[0] < small_options().l0_compaction_trigger);
+  require_matches(store, expected);
+
+  stClientData record{};
+  REQUIRE(store.find("C00007", record));
+  REQUIRE(record.account_balance == 2007);
+  REQUIRE_FALSE(store.find("C00009", record));
+  std::size_t listed = 0;
+  for (std::size_t count : counts)
+    listed += count;
+  REQUIRE(env.run_files() == listed); // Merged inputs are deleted
+}
+
+TEST_CASE("clsLsmStore recovers its memtable and drops unlisted runs", "[lsm]") {
+  TestLsmEnv env("lsm_recovery");
+  {
+    clsLsmStore store(env.dir, small_options());
+    const std::vector<op_log::stLogEntry> flushed{put(1, 1), put(2, 2)};
+    store.apply(flushed);
+    store.flush();
+    const std::vector<op_log::stLogEntry> pending{put(2, 22), remove_entry(1), put(3, 3)};
+    store.apply(pending);
+  }
+  // A flush that died before the manifest listed its run, and a torn append.
+  std::ofstream(env.dir / "clients-00000999.run", std::ios::binary) << "partial";
+  std::ofstream(env.dir / infrastructure_names::LSM_LOG_FILE_NAME,
+                std::ios::binary | std::ios::app)
+      << "U#//#C00004#//#p";
+
+  {
+    clsLsmStore store(env.dir, small_options());
+    REQUIRE_FALSE(std::filesystem::exists(env.dir / "clients-00000999.run"));
+    REQUIRE(store.memtable_size() == 3);
+    require_matches(store, {{2, 22}, {3, 3}});
+
+    const std::vector<op_log::stLogEntry> next{put(5, 5)};
+    store.apply(next); // Starts on a clean line
+    store.flush();
+    require_matches(store, {{2, 22}, {3, 3}, {5, 5}});
+  }
+
+  std::ofstream(env.dir / infrastructure_names::LSM_MANIFEST_FILE_NAME) << "garbage";
+  REQUIRE_THROWS_AS(clsLsmStore(env.dir, small_options()), std::runtime_error);
+}
+
+TEST_CASE("clsLsmStore compacts on its worker thread", "[lsm]") {
+  TestLsmEnv env("lsm_background");
+  std::map<int, double> expected;
+  {
+    clsLsmStore store(env.dir, small_options(true));
+    for (int i = 0; i < 2000; ++i) {
+      const op_log::stLogEntry entry = put(i % 500, i);
+      store.apply({&entry, 1});
+      expected[i % 500] = i;
+    }
+    store.wait_idle();
+    REQUIRE(store.last_error().empty());
+    REQUIRE(store.run_counts()[0] < small_options().l0_compaction_trigger);
+    require_matches(store, expected);
+  }
+  clsLsmStore reopened(env.dir, small_options(true));
+  require_matches(reopened, expected);
+}
+
+TEST_CASE("clsLsmStore opens read-only without touching the files", "[lsm]") {
+  TestLsmEnv env("lsm_read_only");
+  {
+    clsLsmStore store(env.dir, small_options());
+    const std::vector<op_log::stLogEntry> entries{put(1, 1), put(2, 2)};
+    store.apply(entries);
+    store.flush();
+    const std::vector<op_log::stLogEntry> pending{put(3, 3)};
+    store.apply(pending);
+
+    // The writer holds the store exclusively, even against a reader.
+    platform_ops_lock::clsFileLock reader;
+    REQUIRE(reader.open(env.dir / infrastructure_names::LSM_LOCK_FILE_NAME));
+    REQUIRE_FALSE(reader.try_lock(platform_ops_lock::enLockMode::shared));
+  }
+  const std::filesystem::path log_path = env.dir / infrastructure_names::LSM_LOG_FILE_NAME;
+  std::ofstream(env.dir / "clients-00000999.run", std::ios::binary) << "partial";
+  std::ofstream(log_path, std::ios::binary | std::ios::app) << "U#//#C00004#//#p";
+  const auto log_size = std::filesystem::file_size(log_path);
+
+  stLsmOptions options = small_options(true);
+  options.read_only = true;
+  clsLsmStore store(env.dir, options);
+  clsLsmStore second(env.dir, options); // Readers share the lock
+  require_matches(store, {{1, 1}, {2, 2}, {3, 3}});
+  REQUIRE(std::filesystem::exists(env.dir / "clients-00000999.run"));
+  REQUIRE(std::filesystem::file_size(log_path) == log_size);
+  const std::vector<op_log::stLogEntry> write{put(5, 5)};
+  REQUIRE_THROWS_AS(store.apply(write), std::runtime_error);
+  REQUIRE_THROWS_AS(store.flush(), std::runtime_error);
+}
+
+TEST_CASE("clsLsmStore runs two writers on one directory one after the other", "[lsm]") {
+  TestLsmEnv env("lsm_two_writers");
+  auto ingest = [&](int first) {
+    clsLsmStore store(env.dir, small_options(true));
+    for (int i = first; i < first + 300; ++i) {
+      const op_log::stLogEntry entry = put(i, i);
+      store.apply({&entry, 1});
+    }
+    store.wait_idle();
+  };
+  {
+    std::jthread a(ingest, 0);
+    std::jthread b(ingest, 300);
+  }
+  std::map<int, double> expected;
+  for (int i = 0; i < 600; ++i)
+    expected[i] = i;
+  clsLsmStore store(env.dir, small_options());
+  require_matches(store, expected);
+}
+
+TEST_CASE("clsLsmStore clear drops every run and the memtable", "[lsm]") {
+  TestLsmEnv env("lsm_clear");
+  {
+    clsLsmStore store(env.dir, small_options());
+    for (int i = 0; i < 200; ++i)
+      store.apply(std::vector{put(i, i)});
+    store.compact_pending();
+    REQUIRE(env.run_files() > 0);
+    store.clear();
+    REQUIRE(env.run_files() == 0);
+    REQUIRE(store.memtable_size() == 0);
+    REQUIRE(store.load().empty());
+
+    store.apply(std::vector{put(7, 70)});
+    store.flush();
+  }
+  clsLsmStore reopened(env.dir, small_options()); // The manifest lists only the new run
+  const auto records = reopened.load();
+  REQUIRE(records.size() == 1);
+  REQUIRE(records[0].account_balance == 70);
+}
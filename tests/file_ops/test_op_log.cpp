@@ -0,0 +1,309 @@
+// tests/file_ops/test_op_log.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/file_ops.h"
+#include "file_ops/op_log/op_log.h"
+#include "services/columnar_snapshot/columnar_snapshot.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace op_log;
+using client_data_structure::stClientData;
+
+namespace {
+struct TestLogEnv {
+  std::filesystem::path dir;
+  std::filesystem::path data_file;
+  std::filesystem::path log_file;
+
+  explicit TestLogEnv(const std::string &subdir) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+    log_file = dir / std::string(infrastructure_names::LOG_FILE_NAME);
+    std::ofstream out(data_file, std::ios::binary);
+    out << "1#//#p1#//#555#//#Alice#//#100\n"
+        << "2#//#p2#//#556#//#Bob#//#200\n"
+        << "3#//#p3#//#557#//#Carol#//#300\n";
+  }
+  ~TestLogEnv() { std::filesystem::remove_all(dir); }
+};
+
+stClientData make_client(const std::string &account, const std::string &name,
+                         double balance) {
+  return {account, "pin", "0100", name, balance};
+}
+} // namespace
+
+TEST_CASE("Log entries round-trip through their text form", "[op_log]") {
+  stLogEntry entry{enOperation::update, make_client("7", "Dina", 12.5)};
+  std::string line = convert_entry_to_line(entry);
+  REQUIRE(line == "U#//#7#//#pin#//#0100#//#Dina#//#12.5\n");
+
+  stLogEntry parsed{};
+  REQUIRE(convert_line_to_entry(std::string_view(line).substr(0, line.size() - 1), parsed));
+  REQUIRE(parsed.operation == enOperation::update);
+  REQUIRE(parsed.record.name == "Dina");
+
+  REQUIRE(convert_line_to_entry("D#//#7", parsed));
+  REQUIRE(parsed.operation == enOperation::remove);
+  REQUIRE(parsed.record.account_number == "7");
+
+  REQUIRE_FALSE(convert_line_to_entry("X#//#7", parsed));
+  REQUIRE_FALSE(convert_line_to_entry("D#//#", parsed));
+  REQUIRE_FALSE(convert_line_to_entry("A#//#not a record", parsed));
+}
+
+TEST_CASE("clsOpLog appends mutations and replays them on load", "[op_log]") {
+  TestLogEnv env("op_log_replay");
+  auto data_before = std::filesystem::file_size(env.data_file);
+  {
+    clsOpLog log(env.data_file, env.log_file);
+    log.append({enOperation::add, make_client("4", "Dave", 400)});
+    log.append({enOperation::update, make_client("2", "Bobby", 250)});
+    log.append({enOperation::remove, make_client("1", "", 0)});
+    // Data file untouched; only small appends happened
+    REQUIRE(std::filesystem::file_size(env.data_file) == data_before);
+    REQUIRE(log.log_size() == std::filesystem::file_size(env.log_file));
+  }
+
+  clsOpLog reopened(env.data_file, env.log_file);
+  auto records = reopened.load();
+  REQUIRE(records.size() == 3);
+  REQUIRE(records[0].name == "Bobby");
+  REQUIRE(records[0].account_balance == 250);
+  REQUIRE(records[1].name == "Carol");
+  REQUIRE(records[2].name == "Dave");
+}
+
+TEST_CASE("clsOpLog folds into the data file and empties the log",
+          "[op_log]") {
+  TestLogEnv env("op_log_fold");
+  clsOpLog log(env.data_file, env.log_file, 1); // Fold after any append
+  REQUIRE_FALSE(log.fold_if_due());
+
+  log.append({enOperation::remove, make_client("3", "", 0)});
+  REQUIRE(log.is_fold_due());
+  REQUIRE(log.fold_if_due());
+  REQUIRE(log.log_size() == 0);
+  REQUIRE(std::filesystem::file_size(env.log_file) == 0);
+
+  auto lines = file_ops::get_all_clients(env.data_file);
+  REQUIRE(lines.size() == 2);
+  REQUIRE(lines[1] == "2#//#p2#//#556#//#Bob#//#200");
+
+  // Appending after a fold still works
+  log.append({enOperation::add, make_client("9", "Zed", 1)});
+  REQUIRE(log.load().size() == 3);
+}
+
+TEST_CASE("Replay is idempotent and ignores a torn last append", "[op_log]") {
+  TestLogEnv env("op_log_torn");
+  {
+    std::ofstream out(env.log_file, std::ios::binary);
+    out << "A#//#4#//#p#//#5#//#Dave#//#4\n"
+        << "D#//#2\n"
+        << "U#//#1#//#p#//#5#//#Al"; // crash mid-append
+  }
+  auto records = file_ops::load_clients_parallel(env.data_file);
+  REQUIRE(replay(env.log_file, records) == 2);
+  REQUIRE(records.size() == 3);
+  REQUIRE(records[0].name == "Alice");
+
+  // Replaying the same log over its own result changes nothing
+  auto again = records;
+  replay(env.log_file, again);
+  REQUIRE(again.size() == records.size());
+
+  // Opening the log cuts the torn line so new appends start cleanly
+  clsOpLog log(env.data_file, env.log_file);
+  log.append({enOperation::update, make_client("1", "Alicia", 1)});
+  auto loaded = log.load();
+  REQUIRE(loaded.size() == 3);
+  REQUIRE(loaded[0].name == "Alicia");
+}
+
+TEST_CASE("clsOpLog writes fail fast when another process committed first", "[op_log]") {
+  TestLogEnv env("op_log_conflict");
+  clsOpLog first(env.data_file, env.log_file);
+  clsOpLog second(env.data_file, env.log_file); // Stands in for another process
+
+  first.append({enOperation::add, make_client("4", "Dina", 400)});
+  REQUIRE_THROWS_AS(second.append({enOperation::add, make_client("4", "Other", 1)}),
+                    data_lock::clsVersionConflict);
+
+  // Reloading picks up first's change and makes second current again.
+  auto records = second.load();
+  REQUIRE(records.size() == 4);
+  REQUIRE(records[3].name == "Dina");
+  second.append({enOperation::remove, make_client("1", "", 0)});
+
+  // Now first is the stale one; its fold reloads, so it goes through.
+  REQUIRE_THROWS_AS(first.append({enOperation::remove, make_client("2", "", 0)}),
+                    data_lock::clsVersionConflict);
+  first.fold();
+  REQUIRE(file_ops::load_clients_parallel(env.data_file).size() == 3);
+  REQUIRE(std::filesystem::file_size(env.log_file) == 0);
+  REQUIRE(second.load().size() == 3);
+}
+
+TEST_CASE("find_last_entry returns the newest entry of one account", "[op_log]") {
+  TestLogEnv env("op_log_find_last");
+  {
+    std::ofstream log(env.log_file, std::ios::binary);
+    log << "A#//#12#//#p#//#0100#//#Twelve#//#12\n"
+        << "U#//#1#//#p#//#0100#//#One#//#1\n"
+        << "D#//#12\n"
+        << "U#//#1#//#garbage\n" // Malformed: skipped, as replay skips it
+        << "A#//#3#//#p#//#0100#//#Three#//#3\n"
+        << "U#//#3#//#p#//#0100#//#Torn"; // Torn tail: never applied
+  }
+  stLogEntry entry{};
+  REQUIRE(find_last_entry(env.log_file, "1", entry));
+  REQUIRE(entry.operation == enOperation::update);
+  REQUIRE(entry.record.name == "One");
+  REQUIRE(find_last_entry(env.log_file, "12", entry));
+  REQUIRE(entry.operation == enOperation::remove);
+  REQUIRE(find_last_entry(env.log_file, "3", entry));
+  REQUIRE(entry.record.name == "Three");
+  REQUIRE_FALSE(find_last_entry(env.log_file, "2", entry));
+  REQUIRE_FALSE(find_last_entry(env.dir / "missing.log", "1", entry));
+}
+
+TEST_CASE("clsOpLog cuts a failed append back off the log", "[op_log]") {
+  TestLogEnv env("op_log_failed_append");
+  clsOpLog log(env.data_file, env.log_file);
+  log.append({enOperation::add, make_client("4", "Dina", 400)});
+  const auto size = std::filesystem::file_size(env.log_file);
+  const auto version = log.version();
+
+  // Fails after the bytes are written, as a failed fdatasync would.
+  bool fail = true;
+  log.set_commit_observer([&fail](std::span<const stLogEntry>, std::uint64_t) {
+    if (std::exchange(fail, false))
+      throw std::runtime_error("Failed to sync the operation log");
+  });
+  const std::vector<stLogEntry> batch{{enOperation::add, make_client("5", "Eve", 500)},
+                                      {enOperation::remove, make_client("1", "", 0)}};
+  REQUIRE_THROWS_AS(log.commit_batch(batch, {}), std::runtime_error);
+  REQUIRE(std::filesystem::file_size(env.log_file) == size);
+  REQUIRE(log.version() == version);
+
+  clsOpLog other(env.data_file, env.log_file); // Another process sees no trace of it
+  REQUIRE(other.load().size() == 4);
+
+  log.append({enOperation::add, make_client("6", "Fay", 600)});
+  REQUIRE(log.load().size() == 5);
+}
+
+TEST_CASE("clsOpLog loads from a checkpoint and replays only newer entries", "[op_log]") {
+  TestLogEnv env("op_log_checkpoint");
+  {
+    clsOpLog log(env.data_file, env.log_file);
+    log.append({enOperation::update, make_client("1", "Alicia", 1)});
+    log.append({enOperation::remove, make_client("2", "", 0)});
+    REQUIRE(log.checkpoint(log.load()));
+    REQUIRE(log.checkpoint_offset() == log.log_size());
+    log.append({enOperation::add, make_client("4", "Dave", 400)});
+  }
+
+  // Rewrite the first entry in place: a load that re-read the covered part
+  // of the log would pick this up.
+  {
+    std::fstream log_file(env.log_file, std::ios::binary | std::ios::in | std::ios::out);
+    const std::string changed = convert_entry_to_line({enOperation::update, make_client("1", "Alicix", 1)});
+    log_file.write(changed.data(), static_cast<std::streamsize>(changed.size()));
+  }
+
+  clsOpLog reopened(env.data_file, env.log_file);
+  auto records = reopened.load();
+  REQUIRE(reopened.checkpoint_offset() > 0);
+  REQUIRE(records.size() == 3);
+  REQUIRE(records[0].name == "Alicia");
+  REQUIRE(records[1].name == "Carol");
+  REQUIRE(records[2].name == "Dave");
+
+  // A reader of the data file alone skips the checkpoint and leaves it there.
+  const std::filesystem::path snapshot = env.dir / infrastructure_names::SNAPSHOT_FILE_NAME;
+  REQUIRE(columnar_snapshot::load_clients(env.data_file, snapshot).size() == 3);
+  REQUIRE(reopened.load().size() == 3);
+  REQUIRE(reopened.checkpoint_offset() > 0);
+
+  // A fold starts over from a plain snapshot.
+  reopened.fold();
+  REQUIRE(reopened.checkpoint_offset() == 0);
+  REQUIRE(reopened.load().size() == 3);
+}
+
+TEST_CASE("clsOpLog checkpoints only current state and drops a checkpoint of a cut log", "[op_log]") {
+  TestLogEnv env("op_log_checkpoint_stale");
+  clsOpLog first(env.data_file, env.log_file, 400); // Checkpoint every 100 bytes
+  clsOpLog second(env.data_file, env.log_file);
+  auto records = first.load();
+  second.append({enOperation::add, make_client("4", "Dave", 400)});
+  REQUIRE_FALSE(first.checkpoint(records)); // Misses second's append
+
+  records = first.load();
+  REQUIRE_FALSE(first.is_checkpoint_due());
+  std::vector<stLogEntry> entries;
+  for (int i = 5; i < 9; ++i) {
+    entries.push_back({enOperation::add, make_client(std::to_string(i), "Eve", i)});
+    records.push_back(entries.back().record);
+  }
+  REQUIRE_FALSE(first.commit_batch(entries, records));
+  REQUIRE(first.is_checkpoint_due());
+  REQUIRE(first.checkpoint_if_due(records));
+  REQUIRE_FALSE(first.is_checkpoint_due());
+
+  // The log is emptied behind the checkpoint's back: it no longer applies.
+  std::filesystem::resize_file(env.log_file, 0);
+  clsOpLog reopened(env.data_file, env.log_file);
+  REQUIRE(reopened.load().size() == 3);
+  REQUIRE(reopened.checkpoint_offset() == 0);
+}
+
+TEST_CASE("Sync options parse from their command-line form", "[op_log]") {
+  stSyncOptions options;
+  REQUIRE(options.policy == enSyncPolicy::group);
+  REQUIRE(parse_sync_options("none", options));
+  REQUIRE(options.policy == enSyncPolicy::none);
+  REQUIRE(parse_sync_options("operation", options));
+  REQUIRE(options.policy == enSyncPolicy::operation);
+  REQUIRE(parse_sync_options("group:500", options));
+  REQUIRE(options.policy == enSyncPolicy::group);
+  REQUIRE(options.group_window == std::chrono::microseconds{500});
+  REQUIRE(parse_sync_options("group", options));
+  REQUIRE(options.group_window == std::chrono::microseconds{0});
+
+  REQUIRE_FALSE(parse_sync_options("group:", options));
+  REQUIRE_FALSE(parse_sync_options("group:-1", options));
+  REQUIRE_FALSE(parse_sync_options("group:5ms", options));
+  REQUIRE_FALSE(parse_sync_options("groups", options));
+  REQUIRE_FALSE(parse_sync_options("always", options));
+}
+
+TEST_CASE("clsOpLog commits the same entries under every sync policy", "[op_log]") {
+  const enSyncPolicy policy =
+      GENERATE(enSyncPolicy::none, enSyncPolicy::group, enSyncPolicy::operation);
+  TestLogEnv env("op_log_sync");
+  clsOpLog log(env.data_file, env.log_file);
+  log.set_sync_policy(policy);
+
+  auto records = log.load();
+  std::vector<stLogEntry> entries{{enOperation::add, make_client("4", "Dave", 400)},
+                                  {enOperation::remove, make_client("1", "", 0)}};
+  records.push_back(entries[0].record);
+  records[0].delete_mark = true;
+  REQUIRE_FALSE(log.commit_batch(entries, records));
+  log.append({enOperation::update, make_client("2", "Bobby", 250)});
+  REQUIRE(log.log_size() == std::filesystem::file_size(env.log_file));
+
+  log.fold(); // Syncs the new data file, the directory and the emptied log
+  REQUIRE(std::filesystem::file_size(env.log_file) == 0);
+  auto lines = file_ops::get_all_clients(env.data_file);
+  REQUIRE(lines.size() == 3);
+  REQUIRE(lines[0] == "2#//#pin#//#0100#//#Bobby#//#250");
+}
@@ -0,0 +1,44 @@
+// tests/platform_ops/epoch_epoch_domain.cpp
+#include "catch_amalgamated.hpp"
+#include "platform_ops/epoch/epoch.h"
+
+using namespace platform_ops_epoch;
+
+TEST_CASE("Retired objects wait for readers pinned before the retire", "[epoch]") {
+  clsEpochDomain domain;
+  int freed = 0;
+
+  auto early_reader = domain.pin();
+  domain.retire([&freed] { ++freed; });
+  auto late_reader = domain.pin(); // Pinned after the retire; cannot hold it
+
+  REQUIRE(domain.reclaim() == 0);
+  REQUIRE(domain.retired_count() == 1);
+
+  early_reader.unpin();
+  REQUIRE(domain.reclaim() == 1);
+  REQUIRE(freed == 1);
+  REQUIRE(late_reader.is_pinned());
+}
+
+TEST_CASE("clsEpochDomain frees what is left on destruction", "[epoch]") {
+  int freed = 0;
+  {
+    clsEpochDomain domain;
+    auto reader = domain.pin();
+    domain.retire([&freed] { ++freed; });
+    domain.retire([&freed] { ++freed; });
+    REQUIRE(domain.reclaim() == 0);
+    reader.unpin();
+  }
+  REQUIRE(freed == 2);
+}
+
+TEST_CASE("Every reader slot can be pinned at once", "[epoch]") {
+  clsEpochDomain domain;
+  std::vector<clsEpochDomain::clsGuard> guards;
+  for (std::size_t i = 0; i < clsEpochDomain::MAX_READERS; ++i)
+    guards.push_back(domain.pin());
+  for (const auto &guard : guards)
+    REQUIRE(guard.is_pinned());
+}
@@ -0,0 +1,43 @@
+// tests/platform_ops/file_io_random_access.cpp
+#include "catch_amalgamated.hpp"
+#include "platform_ops/file_io/file_io.h"
+#include <filesystem>
+#include <string>
+
+using namespace platform_ops_file_io;
+
+TEST_CASE("clsRandomAccessFile reads and writes at explicit offsets", "[file_io]") {
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path() / "file_io_random_access";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const std::filesystem::path path = dir / "rows.bin";
+
+  clsRandomAccessFile missing;
+  REQUIRE_FALSE(missing.open(path, enOpenMode::read_only));
+  REQUIRE_FALSE(std::filesystem::exists(path));
+
+  {
+    clsRandomAccessFile file;
+    REQUIRE(file.open(path, enOpenMode::create));
+    REQUIRE(file.size() == 0);
+    REQUIRE(file.write_at(0, "abcdefgh", 8));
+    REQUIRE(file.write_at(16, "XY", 2)); // Leaves a hole of zeros
+    REQUIRE(file.write_at(2, "CD", 2));
+    REQUIRE(file.size() == 18);
+    REQUIRE(file.sync_data());
+  }
+
+  clsRandomAccessFile file;
+  REQUIRE(file.open(path, enOpenMode::read_only));
+  std::string bytes(18, '?');
+  REQUIRE(file.read_at(0, bytes.data(), bytes.size()));
+  REQUIRE(bytes == std::string("abCDefgh\0\0\0\0\0\0\0\0XY", 18));
+  char past_end[4];
+  REQUIRE_FALSE(file.read_at(16, past_end, sizeof(past_end)));
+  REQUIRE_FALSE(file.write_at(0, "z", 1)); // Opened read-only
+
+  file.close();
+  REQUIRE_FALSE(file.is_open());
+  std::filesystem::remove_all(dir);
+}
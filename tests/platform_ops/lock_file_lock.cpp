@@ -0,0 +1,55 @@
+// tests/platform_ops/lock_file_lock.cpp
+#include "catch_amalgamated.hpp"
+#include "platform_ops/lock/lock.h"
+#include <filesystem>
+
+using namespace platform_ops_lock;
+
+TEST_CASE("Shared locks coexist and block an exclusive one", "[lock]") {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "file_lock_modes.lock";
+  std::filesystem::remove(path);
+
+  // Two objects on one file behave like two processes (per-descriptor locks).
+  clsFileLock first, second;
+  REQUIRE(first.open(path));
+  REQUIRE(second.open(path));
+
+  REQUIRE(first.try_lock(enLockMode::shared));
+  REQUIRE(second.try_lock(enLockMode::shared));
+  second.unlock();
+  REQUIRE_FALSE(second.try_lock(enLockMode::exclusive));
+
+  first.unlock();
+  REQUIRE(second.try_lock(enLockMode::exclusive));
+  REQUIRE_FALSE(first.try_lock(enLockMode::shared));
+
+  second.close(); // Closing releases the lock
+  REQUIRE(first.try_lock(enLockMode::exclusive));
+  first.close();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("The lock file carries an 8-byte stamp", "[lock]") {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "file_lock_stamp.lock";
+  std::filesystem::remove(path);
+
+  clsFileLock lock;
+  REQUIRE(lock.open(path));
+  std::uint64_t stamp = 99;
+  REQUIRE(lock.read_stamp(stamp));
+  REQUIRE(stamp == 0); // New file
+
+  REQUIRE(lock.lock(enLockMode::exclusive));
+  REQUIRE(lock.write_stamp(0x1122334455667788ull));
+  lock.unlock();
+
+  clsFileLock other;
+  REQUIRE(other.open(path));
+  REQUIRE(other.read_stamp(stamp));
+  REQUIRE(stamp == 0x1122334455667788ull);
+  lock.close();
+  other.close();
+  std::filesystem::remove(path);
+}
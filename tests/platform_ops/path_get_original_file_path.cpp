@@ -44,4 +44,10 @@ TEST_CASE("get_original_file_path works for Windows-style path") {
   // normalization
   REQUIRE(get_original_file_path(base).lexically_normal() ==
           expected.lexically_normal());
-}
\ No newline at end of file
+}
+
+TEST_CASE("get_data_file_path places any data file under the data directory") {
+  std::filesystem::path base = "bin";
+  std::filesystem::path expected = "bin/data/clients.log";
+  REQUIRE(get_data_file_path(base, "clients.log") == expected);
+}
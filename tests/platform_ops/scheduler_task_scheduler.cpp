@@ -0,0 +1,74 @@
+// tests/platform_ops/scheduler_task_scheduler.cpp
+#include "catch_amalgamated.hpp"
+#include "platform_ops/scheduler/scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace platform_ops_scheduler;
+
+TEST_CASE("parallel_for runs every index exactly once", "[scheduler]") {
+  clsTaskScheduler scheduler(4);
+  std::vector<std::atomic<int>> hits(10'000);
+  parallel_for(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); }, scheduler);
+  for (const auto &hit : hits)
+    REQUIRE(hit.load() == 1);
+}
+
+TEST_CASE("Nested groups on a single worker do not deadlock", "[scheduler]") {
+  // One worker: an outer task waiting on inner tasks must run them itself.
+  clsTaskScheduler scheduler(1);
+  std::atomic<int> total{0};
+  parallel_for(8, [&](std::size_t) {
+    parallel_for(8, [&](std::size_t) { total.fetch_add(1); }, scheduler);
+  }, scheduler);
+  REQUIRE(total.load() == 64);
+}
+
+TEST_CASE("Idle workers steal from a busy worker's deque", "[scheduler]") {
+  clsTaskScheduler scheduler(4);
+  std::vector<std::thread::id> ran_on(64);
+  clsTaskGroup outer(scheduler);
+  // The outer task pushes every inner task onto its own deque; the other
+  // workers can only get them by stealing.
+  outer.run([&] {
+    clsTaskGroup inner(scheduler);
+    for (std::size_t i = 0; i < ran_on.size(); ++i)
+      inner.run([&, i] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ran_on[i] = std::this_thread::get_id();
+      });
+    inner.wait();
+  });
+  outer.wait();
+  std::vector<std::thread::id> distinct = ran_on;
+  std::sort(distinct.begin(), distinct.end());
+  distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+  REQUIRE(distinct.size() > 1);
+}
+
+TEST_CASE("clsTaskGroup::wait rethrows the first task exception", "[scheduler]") {
+  clsTaskScheduler scheduler(2);
+  std::atomic<int> finished{0};
+  clsTaskGroup group(scheduler);
+  group.run([] { throw std::runtime_error("range failed"); });
+  for (int i = 0; i < 16; ++i)
+    group.run([&] { finished.fetch_add(1); });
+  REQUIRE_THROWS_WITH(group.wait(), "range failed");
+  REQUIRE(finished.load() == 16); // The others still ran
+  REQUIRE_NOTHROW(group.wait());   // The error is reported once
+}
+
+TEST_CASE("clsTaskScheduler runs queued tasks before shutting down", "[scheduler]") {
+  std::atomic<int> ran{0};
+  {
+    clsTaskScheduler scheduler(2);
+    for (int i = 0; i < 100; ++i)
+      scheduler.submit([&] { ran.fetch_add(1); });
+  }
+  REQUIRE(ran.load() == 100);
+}
@@ -0,0 +1,38 @@
+// tests/platform_ops/sync_file_sync.cpp
+#include "catch_amalgamated.hpp"
+#include "platform_ops/sync/sync.h"
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+using namespace platform_ops_sync;
+
+TEST_CASE("clsFileSync syncs an existing file and never creates one", "[sync]") {
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path() / "file_sync";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const std::filesystem::path path = dir / "log.txt";
+
+  clsFileSync missing;
+  REQUIRE_FALSE(missing.open(path));
+  REQUIRE_FALSE(missing.sync_data());
+  REQUIRE_FALSE(std::filesystem::exists(path));
+
+  std::ofstream out(path, std::ios::binary);
+  out << "A#//#1\n";
+  out.flush();
+
+  clsFileSync file;
+  REQUIRE(file.open(path));
+  REQUIRE(file.sync_data());
+  clsFileSync moved = std::move(file);
+  REQUIRE_FALSE(file.is_open());
+  REQUIRE(moved.sync_data());
+
+  REQUIRE(sync_file(path));
+  REQUIRE(sync_directory(dir));
+  moved.close();
+  out.close();
+  std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,119 @@
+// tests/services/balance/test_balance.cpp
+#include "catch_amalgamated.hpp"
+#include "platform_ops/cpu/cpu.h"
+#include "services/balance/balance.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace balance;
+
+TEST_CASE("parse_minor_units reads balances exactly", "[balance]") {
+  std::int64_t minor = 0;
+  REQUIRE(parse_minor_units("2500.75", minor));
+  REQUIRE(minor == 250075);
+  REQUIRE(parse_minor_units("-12", minor));
+  REQUIRE(minor == -1200);
+  REQUIRE(parse_minor_units("0.5", minor));
+  REQUIRE(minor == 50);
+  REQUIRE(parse_minor_units(".05", minor));
+  REQUIRE(minor == 5);
+  REQUIRE(parse_minor_units("7.", minor));
+  REQUIRE(minor == 700);
+
+  SECTION("Extra fraction digits round half away from zero") {
+    REQUIRE(parse_minor_units("0.30000000000000004", minor));
+    REQUIRE(minor == 30);
+    REQUIRE(parse_minor_units("12.345", minor));
+    REQUIRE(minor == 1235);
+    REQUIRE(parse_minor_units("-12.345", minor));
+    REQUIRE(minor == -1235);
+  }
+
+  SECTION("Exponent form falls back to double parsing") {
+    REQUIRE(parse_minor_units("1e+3", minor));
+    REQUIRE(minor == 100000);
+  }
+
+  SECTION("Invalid and out-of-range text is rejected") {
+    REQUIRE_FALSE(parse_minor_units("", minor));
+    REQUIRE_FALSE(parse_minor_units("-", minor));
+    REQUIRE_FALSE(parse_minor_units(".", minor));
+    REQUIRE_FALSE(parse_minor_units("12abc", minor));
+    REQUIRE_FALSE(parse_minor_units("+7", minor)); // As the record parser
+    REQUIRE_FALSE(parse_minor_units("1e+30", minor));
+    REQUIRE_FALSE(parse_minor_units("99999999999999999999", minor));
+  }
+}
+
+TEST_CASE("append_minor_units writes two decimals", "[balance]") {
+  auto text = [](std::int64_t minor) {
+    std::string out;
+    append_minor_units(minor, out);
+    return out;
+  };
+  REQUIRE(text(250075) == "2500.75");
+  REQUIRE(text(-5) == "-0.05");
+  REQUIRE(text(1230) == "12.30");
+  REQUIRE(text(0) == "0.00");
+
+  std::int64_t back = 0;
+  std::int64_t lowest = std::numeric_limits<std::int64_t>::min();
+  REQUIRE(parse_minor_units(text(lowest), back));
+  REQUIRE(back == lowest);
+  REQUIRE(to_minor_units(0.29) == 29);
+  REQUIRE(to_major_units(29) == 0.29);
+}
+
+TEST_CASE("to_minor_units agrees with parse_minor_units on the written text", "[balance]") {
+  // 1.005 is stored as 1.00499999..., but the data file and the log say "1.005".
+  std::int64_t parsed = 0;
+  REQUIRE(parse_minor_units("1.005", parsed));
+  REQUIRE(to_minor_units(1.005) == parsed);
+  REQUIRE(to_minor_units(-1.005) == -parsed);
+  REQUIRE(to_minor_units(0.30000000000000004) == 30);
+  REQUIRE(to_minor_units(-20.05) == -2005);
+}
+
+TEST_CASE("Balance kernels agree with the scalar loops", "[balance]") {
+  std::vector<std::int64_t> balances;
+  std::uint64_t state = 42;
+  for (int i = 0; i < 1003; ++i) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    balances.push_back(static_cast<std::int64_t>(state >> 40) - (1ll << 23));
+  }
+  balances[17] = 0;
+  balances[500] = std::numeric_limits<std::int64_t>::min() / 2;
+
+  for (std::size_t length : {0u, 1u, 3u, 4u, 7u, 8u, 9u, 1003u}) {
+    std::span<const std::int64_t> column(balances.data(), length);
+    REQUIRE(sum_minor(column) == sum_minor_scalar(column));
+    REQUIRE(min_minor(column) == min_minor_scalar(column));
+    REQUIRE(max_minor(column) == max_minor_scalar(column));
+    REQUIRE(count_between(column, -1000000, 1000000) ==
+            count_between_scalar(column, -1000000, 1000000));
+    if (platform_ops_cpu::has_avx2()) {
+      REQUIRE(sum_minor_avx2(column) == sum_minor_scalar(column));
+      REQUIRE(min_minor_avx2(column) == min_minor_scalar(column));
+      REQUIRE(max_minor_avx2(column) == max_minor_scalar(column));
+      REQUIRE(count_between_avx2(column, std::numeric_limits<std::int64_t>::min(), -1) ==
+              count_between_scalar(column, std::numeric_limits<std::int64_t>::min(), -1));
+    }
+  }
+}
+
+TEST_CASE("compute_portfolio_totals summarises a column", "[balance]") {
+  std::vector<std::int64_t> balances = {10010, -2550, 0, 99999, -1, 0, 7};
+  auto totals = compute_portfolio_totals(balances);
+  REQUIRE(totals.client_count == 7);
+  REQUIRE(totals.total_minor == 10010 - 2550 + 99999 - 1 + 7);
+  REQUIRE(totals.lowest_minor == -2550);
+  REQUIRE(totals.highest_minor == 99999);
+  REQUIRE(totals.overdrawn_count == 2);
+  REQUIRE(totals.zero_count == 2);
+
+  auto empty = compute_portfolio_totals({});
+  REQUIRE(empty.client_count == 0);
+  REQUIRE(empty.total_minor == 0);
+}
@@ -0,0 +1,85 @@
+// tests/services/client_table/test_client_table.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/file_ops.h"
+#include "services/client_table/client_table.h"
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string>
+
+using namespace client_table;
+
+TEST_CASE("clsClientTable stores rows column-wise and hands out row views",
+          "[client_table]") {
+  clsClientTable table;
+  table.push_back({"A1", "p1", "0100", "Alice", 10.5});
+  table.push_back({"A2", "p2", "0101", "Bob", -3, true});
+
+  REQUIRE(table.size() == 2);
+  stClientRow bob = table[1];
+  REQUIRE(bob.account_number == "A2");
+  REQUIRE(bob.name == "Bob");
+  REQUIRE(bob.account_balance == -3);
+  REQUIRE(bob.delete_mark);
+
+  auto record = table[0].to_record();
+  REQUIRE(record.pass_code == "p1");
+  REQUIRE(record.account_balance == 10.5);
+
+  auto balances = table.balances_minor();
+  REQUIRE(std::accumulate(balances.begin(), balances.end(), std::int64_t{0}) == 750);
+  REQUIRE(table[0].balance_minor == 1050);
+  REQUIRE(table.find_row("A2") == 1);
+  REQUIRE(table.find_row("A3") == table.size());
+}
+
+TEST_CASE("clsClientTable update re-points strings and compact reclaims them",
+          "[client_table]") {
+  clsClientTable table;
+  table.push_back({"A1", "p1", "0100", "Alice", 1});
+  table.push_back({"A2", "p2", "0101", "Bob", 2});
+
+  table.update(0, {"A1", "p1", "0100", "Alice Cooper", 5});
+  REQUIRE(table[0].name == "Alice Cooper");
+  REQUIRE(table[0].account_balance == 5);
+  REQUIRE(table[1].name == "Bob");
+  REQUIRE(table.garbage_bytes() == 5);
+
+  table.compact();
+  REQUIRE(table.garbage_bytes() == 0);
+  REQUIRE(table[0].name == "Alice Cooper");
+  REQUIRE(table[0].account_number == "A1");
+  REQUIRE(table[1].phone_no == "0101");
+}
+
+TEST_CASE("load_client_table matches load_clients_parallel", "[client_table]") {
+  std::string file_name = "clients_table.csv";
+  {
+    std::ofstream out(file_name, std::ios::binary);
+    for (int i = 0; i < 2000; ++i) {
+      out << "AC" << i << "#//#pin#//#0100" << i << "#//#Name " << i << "#//#"
+          << i * 0.5 << "\n";
+      if (i % 500 == 0)
+        out << "malformed\n\n";
+    }
+  }
+  auto table = load_client_table(file_name);
+  auto records = file_ops::load_clients_parallel(file_name);
+  std::filesystem::remove(file_name);
+
+  REQUIRE(table.size() == records.size());
+  std::size_t i = 0;
+  for (stClientRow client : table) {
+    REQUIRE(client.account_number == records[i].account_number);
+    REQUIRE(client.name == records[i].name);
+    REQUIRE(client.account_balance == records[i].account_balance);
+    ++i;
+  }
+  // Columnar layout is much smaller than a vector of stClientData
+  REQUIRE(table.memory_usage() <
+          records.size() * sizeof(client_data_structure::stClientData));
+}
+
+TEST_CASE("load_client_table on a missing file is empty", "[client_table]") {
+  REQUIRE(load_client_table("no_such_table_file.csv").empty());
+}
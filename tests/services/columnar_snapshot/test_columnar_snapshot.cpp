@@ -0,0 +1,135 @@
+// tests/services/columnar_snapshot/test_columnar_snapshot.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/file_ops.h"
+#include "file_ops/op_log/op_log.h"
+#include "services/columnar_snapshot/columnar_snapshot.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace columnar_snapshot;
+
+namespace {
+struct TestSnapshotEnv {
+  std::filesystem::path dir;
+  std::filesystem::path data_file;
+  std::filesystem::path snapshot_file;
+
+  TestSnapshotEnv(const std::string &subdir, int rows) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+    snapshot_file = dir / std::string(infrastructure_names::SNAPSHOT_FILE_NAME);
+    std::ofstream out(data_file, std::ios::binary);
+    // Few distinct names and pass codes (dictionary), unique accounts (plain),
+    // and balances that are not exact in binary.
+    const char *balances[] = {"0.1", "1.005", "-3", "2500.75", "1e3"};
+    for (int i = 0; i < rows; ++i)
+      out << "AC" << i << "#//#pin" << i % 7 << "#//#0100" << i
+          << "#//#Client " << i % 13 << "#//#" << balances[i % 5] << "\n";
+    out << "broken line\n";
+  }
+  ~TestSnapshotEnv() { std::filesystem::remove_all(dir); }
+};
+
+void require_same_records(
+    const std::vector<client_data_structure::stClientData> &actual,
+    const std::vector<client_data_structure::stClientData> &expected) {
+  REQUIRE(actual.size() == expected.size());
+  for (std::size_t i = 0; i < actual.size(); ++i) {
+    REQUIRE(actual[i].account_number == expected[i].account_number);
+    REQUIRE(actual[i].pass_code == expected[i].pass_code);
+    REQUIRE(actual[i].phone_no == expected[i].phone_no);
+    REQUIRE(actual[i].name == expected[i].name);
+    REQUIRE(actual[i].account_balance == expected[i].account_balance);
+  }
+}
+} // namespace
+
+TEST_CASE("columnar snapshot round-trips the parsed CSV exactly",
+          "[columnar_snapshot]") {
+  TestSnapshotEnv env("columnar_snapshot_round_trip", 1000);
+  const auto parsed = file_ops::load_clients_parallel(env.data_file);
+  write_snapshot_file(env.snapshot_file, parsed, env.data_file);
+
+  clsSnapshotFile snapshot;
+  REQUIRE(snapshot.open(env.snapshot_file, env.data_file));
+  REQUIRE(snapshot.verify());
+  REQUIRE(snapshot.size() == 1000);
+  require_same_records(snapshot.to_records(), parsed);
+
+  const client_table::stClientRow row = snapshot.row(8);
+  REQUIRE(row.account_number == "AC8");
+  REQUIRE(row.pass_code == "pin1");
+  REQUIRE(row.name == "Client 8");
+  REQUIRE(row.balance_minor == 250075);
+  REQUIRE(snapshot.balances_minor()[2] == -300);
+  REQUIRE(snapshot.to_table().size() == 1000);
+
+  // Dictionary-encoded columns make the snapshot smaller than the text.
+  REQUIRE(std::filesystem::file_size(env.snapshot_file) <
+          std::filesystem::file_size(env.data_file) + 1000 * 16);
+}
+
+TEST_CASE("columnar snapshot is ignored once the CSV changes",
+          "[columnar_snapshot]") {
+  TestSnapshotEnv env("columnar_snapshot_stale", 20);
+  require_same_records(load_clients(env.data_file, env.snapshot_file),
+                       file_ops::load_clients_parallel(env.data_file));
+  clsSnapshotFile snapshot;
+  REQUIRE(snapshot.open(env.snapshot_file, env.data_file)); // Written by the load
+
+  {
+    std::ofstream out(env.data_file, std::ios::binary | std::ios::app);
+    out << "NEW#//#p#//#1#//#Newbie#//#5\n";
+  }
+  REQUIRE_FALSE(snapshot.open(env.snapshot_file, env.data_file));
+  const auto records = load_clients(env.data_file, env.snapshot_file);
+  REQUIRE(records.size() == 21);
+  REQUIRE(records.back().account_number == "NEW");
+  REQUIRE(snapshot.open(env.snapshot_file, env.data_file)); // Refreshed
+}
+
+TEST_CASE("columnar snapshot checksums catch corrupted blocks",
+          "[columnar_snapshot]") {
+  TestSnapshotEnv env("columnar_snapshot_corrupt", 50);
+  const auto parsed = file_ops::load_clients_parallel(env.data_file);
+  write_snapshot_file(env.snapshot_file, parsed, env.data_file);
+  const auto mtime = std::filesystem::last_write_time(env.snapshot_file);
+  {
+    // Flip one byte near the end (the balance columns).
+    std::fstream file(env.snapshot_file,
+                      std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-20, std::ios::end);
+    file.put('\x7f');
+  }
+  std::filesystem::last_write_time(env.snapshot_file, mtime);
+
+  clsSnapshotFile snapshot;
+  REQUIRE(snapshot.open(env.snapshot_file, env.data_file)); // Header still fine
+  REQUIRE_FALSE(snapshot.verify());
+  snapshot = {};
+  // load_clients falls back to the CSV and replaces the bad snapshot.
+  require_same_records(load_clients(env.data_file, env.snapshot_file), parsed);
+  REQUIRE(snapshot.open(env.snapshot_file, env.data_file));
+  REQUIRE(snapshot.verify());
+}
+
+TEST_CASE("clsOpLog::fold publishes a snapshot of the new data file",
+          "[columnar_snapshot]") {
+  TestSnapshotEnv env("columnar_snapshot_fold", 10);
+  const auto log_file = env.dir / std::string(infrastructure_names::LOG_FILE_NAME);
+  op_log::clsOpLog log(env.data_file, log_file);
+  log.append({op_log::enOperation::add, {"NEW", "p", "1", "Newbie", 5}});
+  log.append({op_log::enOperation::remove, {"AC0", "", "", "", 0}});
+  log.fold();
+
+  clsSnapshotFile snapshot;
+  REQUIRE(snapshot.open(env.snapshot_file, env.data_file));
+  REQUIRE(snapshot.verify());
+  require_same_records(snapshot.to_records(),
+                       file_ops::load_clients_parallel(env.data_file));
+  REQUIRE(snapshot.size() == 10);
+  REQUIRE(log.load().size() == 10);
+}
@@ -1,6 +1,8 @@
 #include "catch_amalgamated.hpp"
+#include <string>
 #include <string_view>
 #include <vector>
+#include "platform_ops/cpu/cpu.h"
 #include "services/convert/h_convert/h_convert.h"
 
 TEST_CASE("detect_delim basic functionality", "[h_convert]") {
@@ -57,3 +59,101 @@ TEST_CASE("detect_delim edge cases", "[h_convert]") {
         REQUIRE(indexes[0] == 0);
     }
 }
+
+TEST_CASE("detect_delim handles records longer than one vector", "[h_convert]") {
+    std::string_view delim = "#//#";
+    std::vector<short> indexes;
+
+    // 40-character fields push matches across 16- and 32-byte block boundaries
+    std::string field(40, 'x');
+    std::string record = field + "#//#" + field + "#//#" + field + "#//#" + field;
+    h_convert::detect_delim(record, delim, indexes);
+
+    REQUIRE(indexes.size() == 3);
+    REQUIRE(indexes[0] == 40);
+    REQUIRE(indexes[1] == 84);
+    REQUIRE(indexes[2] == 128);
+}
+
+TEST_CASE("detect_delim SIMD kernels agree with the scalar kernel", "[h_convert]") {
+    std::string_view delim = "#//#";
+
+    // Deterministic pseudo-random text drawn from the delimiter's own alphabet,
+    // so partial matches, overlaps and block-boundary straddles are frequent
+    std::string text;
+    unsigned state = 12345u;
+    for (int i = 0; i < 4096; i++)
+    {
+        state = state * 1103515245u + 12345u;
+        text.push_back("#/a"[(state >> 16) % 3]);
+    }
+
+    for (size_t length : {0u, 3u, 4u, 15u, 16u, 19u, 31u, 32u, 35u, 64u, 100u, 1000u, 4096u})
+    {
+        std::string_view str(text.data(), length);
+        std::vector<short> expected;
+        h_convert::detect_delim_scalar(str, delim, expected);
+
+        std::vector<short> sse2;
+        if (platform_ops_cpu::has_sse2())
+        {
+            h_convert::detect_delim_sse2(str, delim, sse2);
+            REQUIRE(sse2 == expected);
+        }
+
+        std::vector<short> avx2;
+        if (platform_ops_cpu::has_avx2())
+        {
+            h_convert::detect_delim_avx2(str, delim, avx2);
+            REQUIRE(avx2 == expected);
+        }
+
+        std::vector<short> dispatched;
+        h_convert::detect_delim(str, delim, dispatched);
+        REQUIRE(dispatched == expected);
+    }
+}
+
+TEST_CASE("convert_line_to_record parses one record line", "[h_convert]") {
+    client_data_structure::stClientData record{};
+    record.delete_mark = true;
+
+    SECTION("Valid line") {
+        REQUIRE(h_convert::convert_line_to_record("A100#//#1234#//#0100200#//#Mohamed Ali#//#2500.75", record));
+        REQUIRE(record.account_number == "A100");
+        REQUIRE(record.pass_code == "1234");
+        REQUIRE(record.phone_no == "0100200");
+        REQUIRE(record.name == "Mohamed Ali");
+        REQUIRE(record.account_balance == 2500.75);
+        REQUIRE_FALSE(record.delete_mark);
+    }
+
+    SECTION("Empty fields are allowed") {
+        REQUIRE(h_convert::convert_line_to_record("A1#//##//##//##//#0", record));
+        REQUIRE(record.pass_code.empty());
+        REQUIRE(record.name.empty());
+    }
+
+    SECTION("Wrong column count is rejected") {
+        REQUIRE_FALSE(h_convert::convert_line_to_record("", record));
+        REQUIRE_FALSE(h_convert::convert_line_to_record("A1#//#1234#//#0100#//#Ali", record));
+        REQUIRE_FALSE(h_convert::convert_line_to_record("A1#//#1#//#2#//#3#//#4#//#5", record));
+    }
+
+    SECTION("Non-numeric balance is rejected") {
+        REQUIRE_FALSE(h_convert::convert_line_to_record("A1#//#1#//#2#//#Ali#//#12abc", record));
+        REQUIRE_FALSE(h_convert::convert_line_to_record("A1#//#1#//#2#//#Ali#//#", record));
+    }
+}
+
+TEST_CASE("convert_record_to_line is the inverse of convert_line_to_record", "[h_convert]") {
+    client_data_structure::stClientData record{"A7", "9999", "0111", "Sara Adel", -0.1};
+    std::string line = h_convert::convert_record_to_line(record);
+    REQUIRE(line == "A7#//#9999#//#0111#//#Sara Adel#//#-0.1");
+
+    client_data_structure::stClientData parsed{};
+    REQUIRE(h_convert::convert_line_to_record(line, parsed));
+    REQUIRE(parsed.account_number == record.account_number);
+    REQUIRE(parsed.name == record.name);
+    REQUIRE(parsed.account_balance == record.account_balance);
+}
@@ -0,0 +1,95 @@
+// tests/services/generator/test_client_generator.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/file_ops.h"
+#include "services/balance/balance.h"
+#include "services/generator/client_generator.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using namespace client_generator;
+
+namespace {
+std::string read_file(const std::filesystem::path &path) {
+  std::ifstream in(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+} // namespace
+
+TEST_CASE("generate_clients_file writes parseable rows in the record format") {
+  const std::filesystem::path path = "generated_clients.csv";
+  stGeneratorOptions options;
+  options.rows = 70'000; // More than one 64K block
+  options.name_length_min = 3;
+  options.name_length_max = 9;
+  options.balance_min_minor = -5'000;
+  options.balance_max_minor = 5'000;
+
+  const std::uint64_t bytes = generate_clients_file(path, options);
+  REQUIRE(bytes == std::filesystem::file_size(path));
+
+  const auto records = file_ops::load_clients_parallel(path);
+  REQUIRE(records.size() == options.rows);
+  std::set<std::string> accounts;
+  for (const auto &record : records) {
+    accounts.insert(record.account_number);
+    REQUIRE(record.name.size() >= 3);
+    REQUIRE(record.name.size() <= 9);
+    const std::int64_t minor = balance::to_minor_units(record.account_balance);
+    REQUIRE(minor >= -5'000);
+    REQUIRE(minor <= 5'000);
+  }
+  REQUIRE(accounts.size() == options.rows); // No duplicates requested
+  REQUIRE(records[42].account_number == generated_account_number(42));
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("generate_clients_file output depends only on the options, not the thread count") {
+  stGeneratorOptions options;
+  options.rows = 150'000;
+  options.seed = 7;
+  options.duplicate_ratio = 0.1;
+  options.balance_distribution = enBalanceDistribution::skewed;
+
+  options.thread_count = 1;
+  generate_clients_file("generated_one.csv", options);
+  options.thread_count = 5;
+  generate_clients_file("generated_five.csv", options);
+  REQUIRE(read_file("generated_one.csv") == read_file("generated_five.csv"));
+
+  options.seed = 8;
+  generate_clients_file("generated_five.csv", options);
+  REQUIRE(read_file("generated_one.csv") != read_file("generated_five.csv"));
+
+  std::filesystem::remove("generated_one.csv");
+  std::filesystem::remove("generated_five.csv");
+}
+
+TEST_CASE("duplicate_ratio reuses earlier account numbers") {
+  stGeneratorOptions options;
+  options.duplicate_ratio = 0.25;
+  std::size_t reused = 0;
+  std::string line;
+  for (std::uint64_t row = 0; row < options.rows; ++row) {
+    line.clear();
+    append_generated_line(options, row, line);
+    if (line.substr(0, line.find('#')) != generated_account_number(row))
+      ++reused;
+  }
+  const double duplicates =
+      static_cast<double>(reused) / static_cast<double>(options.rows);
+  REQUIRE(duplicates > 0.20);
+  REQUIRE(duplicates < 0.30);
+}
+
+TEST_CASE("generate_clients_file rejects empty ranges") {
+  stGeneratorOptions options;
+  options.name_length_min = 10;
+  options.name_length_max = 2;
+  REQUIRE_THROWS_AS(generate_clients_file("never_written.csv", options),
+                    std::invalid_argument);
+  REQUIRE_FALSE(std::filesystem::exists("never_written.csv"));
+}
@@ -0,0 +1,109 @@
+// tests/services/index/test_account_filter.cpp
+#include "catch_amalgamated.hpp"
+#include "services/index/account_filter/account_filter.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace account_filter;
+
+namespace {
+struct TestFilterEnv {
+  std::filesystem::path dir;
+  std::filesystem::path filter_file;
+
+  explicit TestFilterEnv(const std::string &subdir) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    filter_file = dir / std::string(infrastructure_names::ACCOUNT_FILTER_FILE_NAME);
+  }
+  ~TestFilterEnv() { std::filesystem::remove_all(dir); }
+};
+
+std::vector<client_data_structure::stClientData> make_clients(int rows) {
+  std::vector<client_data_structure::stClientData> records(rows);
+  for (int i = 0; i < rows; ++i)
+    records[i].account_number = "AC" + std::to_string(i);
+  return records;
+}
+} // namespace
+
+TEST_CASE("clsAccountFilter has no false negatives and few false positives",
+          "[account_filter]") {
+  TestFilterEnv env("account_filter_build");
+  build_filter_file(env.filter_file, make_clients(20000), 7);
+  clsAccountFilter filter;
+  REQUIRE(filter.open(env.filter_file));
+  REQUIRE(filter.size() == 20000);
+  REQUIRE(filter.capacity() >= 40000);
+  REQUIRE(filter.is_current(7));
+  REQUIRE_FALSE(filter.is_current(6));
+
+  for (int i = 0; i < 20000; ++i)
+    REQUIRE(filter.possibly_contains("AC" + std::to_string(i)));
+
+  // Half full, so well under the 1% design rate.
+  int false_positives = 0;
+  for (int i = 0; i < 20000; ++i)
+    false_positives += filter.possibly_contains("NEW" + std::to_string(i));
+  REQUIRE(false_positives < 200);
+}
+
+TEST_CASE("clsAccountFilter erases keys and persists its counters",
+          "[account_filter]") {
+  TestFilterEnv env("account_filter_update");
+  build_filter_file(env.filter_file, make_clients(10), 1);
+  {
+    clsAccountFilter filter;
+    REQUIRE(filter.open(env.filter_file));
+    REQUIRE_FALSE(filter.possibly_contains("NEW1"));
+    filter.insert("NEW1");
+    REQUIRE(filter.possibly_contains("NEW1"));
+    filter.erase("AC3");
+    REQUIRE_FALSE(filter.possibly_contains("AC3"));
+    REQUIRE(filter.size() == 10);
+  }
+
+  // Reopening maps the same sidecar: the edits are still there
+  clsAccountFilter reopened;
+  REQUIRE(reopened.open(env.filter_file));
+  REQUIRE(reopened.possibly_contains("NEW1"));
+  REQUIRE_FALSE(reopened.possibly_contains("AC3"));
+}
+
+TEST_CASE("clsAccountFilter::apply only follows consecutive versions",
+          "[account_filter]") {
+  TestFilterEnv env("account_filter_apply");
+  build_filter_file(env.filter_file, make_clients(3), 4);
+  clsAccountFilter filter;
+  REQUIRE(filter.open(env.filter_file));
+
+  std::vector<op_log::stLogEntry> entries(2);
+  entries[0].operation = op_log::enOperation::add;
+  entries[0].record.account_number = "NEW";
+  entries[1].operation = op_log::enOperation::remove;
+  entries[1].record.account_number = "AC0";
+  filter.apply(entries, 5);
+  REQUIRE(filter.is_current(5));
+  REQUIRE(filter.possibly_contains("NEW"));
+  REQUIRE_FALSE(filter.possibly_contains("AC0"));
+
+  // A commit was missed (5 -> 7): the filter must not pretend to be current.
+  entries[0].record.account_number = "LATE";
+  filter.apply({entries.data(), 1}, 7);
+  REQUIRE(filter.data_version() == 5);
+  REQUIRE_FALSE(filter.possibly_contains("LATE"));
+}
+
+TEST_CASE("clsAccountFilter::open rejects a missing or corrupt sidecar",
+          "[account_filter]") {
+  TestFilterEnv env("account_filter_corrupt");
+  clsAccountFilter filter;
+  REQUIRE_FALSE(filter.open(env.filter_file));
+  REQUIRE(filter.possibly_contains("anything")); // Closed: never "definitely new"
+
+  build_filter_file(env.filter_file, make_clients(3), 1);
+  std::filesystem::resize_file(env.filter_file, 100);
+  REQUIRE_FALSE(filter.open(env.filter_file));
+}
@@ -0,0 +1,145 @@
+// tests/services/index/test_account_index.cpp
+#include "catch_amalgamated.hpp"
+#include "services/index/account_index/account_index.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace account_index;
+
+namespace {
+struct TestIndexEnv {
+  std::filesystem::path dir;
+  std::filesystem::path data_file;
+  std::filesystem::path index_file;
+
+  TestIndexEnv(const std::string &subdir, int rows) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+    index_file = dir / std::string(infrastructure_names::ACCOUNT_INDEX_FILE_NAME);
+    std::ofstream out(data_file, std::ios::binary);
+    for (int i = 0; i < rows; ++i)
+      out << "AC" << i << "#//#pin#//#0100#//#Client " << i << "#//#" << i
+          << "\n";
+  }
+  ~TestIndexEnv() { std::filesystem::remove_all(dir); }
+
+  // Appends one record and returns the offset its line starts at.
+  std::uint64_t append(const std::string &line) {
+    std::uint64_t offset = std::filesystem::file_size(data_file);
+    std::ofstream out(data_file, std::ios::binary | std::ios::app);
+    out << line << "\n";
+    return offset;
+  }
+};
+} // namespace
+
+TEST_CASE("clsAccountIndex builds the sidecar and finds every account",
+          "[account_index]") {
+  TestIndexEnv env("account_index_build", 5000);
+  clsAccountIndex index;
+  REQUIRE(index.open(env.data_file, env.index_file));
+  REQUIRE(std::filesystem::exists(env.index_file));
+  REQUIRE(index.size() == 5000);
+  REQUIRE(index.capacity() >= 10000);
+
+  client_data_structure::stClientData record{};
+  REQUIRE(index.find_record("AC0", record));
+  REQUIRE(record.name == "Client 0");
+  REQUIRE(index.find_record("AC4999", record));
+  REQUIRE(record.account_balance == 4999);
+  REQUIRE(index.find("AC") == std::nullopt);      // prefix of a real key
+  REQUIRE(index.find("AC49999") == std::nullopt); // extension of a real key
+  REQUIRE(index.find("missing") == std::nullopt);
+}
+
+TEST_CASE("clsAccountIndex keeps up with appends and erases and persists",
+          "[account_index]") {
+  TestIndexEnv env("account_index_update", 10);
+  {
+    clsAccountIndex index;
+    REQUIRE(index.open(env.data_file, env.index_file));
+
+    std::uint64_t offset = env.append("NEW1#//#pin#//#0#//#Newbie#//#5");
+    index.insert("NEW1", offset);
+    REQUIRE(index.find("NEW1") == offset);
+
+    REQUIRE(index.erase("AC3"));
+    REQUIRE_FALSE(index.erase("AC3"));
+    REQUIRE(index.find("AC3") == std::nullopt);
+    REQUIRE(index.size() == 10);
+  }
+
+  // Reopening maps the same sidecar: the edits are still there
+  clsAccountIndex reopened;
+  REQUIRE(reopened.open(env.data_file, env.index_file));
+  REQUIRE(reopened.find("NEW1").has_value());
+  REQUIRE(reopened.find("AC3") == std::nullopt);
+}
+
+TEST_CASE("clsAccountIndex grows past half full", "[account_index]") {
+  TestIndexEnv env("account_index_grow", 0);
+  clsAccountIndex index;
+  REQUIRE(index.open(env.data_file, env.index_file));
+  const std::uint64_t initial = index.capacity();
+
+  for (std::uint64_t i = 0; i < initial; ++i) {
+    std::string account = "G" + std::to_string(i);
+    index.insert(account, env.append(account + "#//#p#//#0#//#n#//#0"));
+  }
+  REQUIRE(index.capacity() > initial);
+  REQUIRE(index.size() == initial);
+  REQUIRE(index.find("G0").has_value());
+  REQUIRE(index.find("G" + std::to_string(initial - 1)).has_value());
+}
+
+TEST_CASE("clsAccountIndex rebuilds a stale or corrupt sidecar",
+          "[account_index]") {
+  TestIndexEnv env("account_index_stale", 3);
+  {
+    clsAccountIndex index;
+    REQUIRE(index.open(env.data_file, env.index_file));
+  }
+  // Rewrite the data file behind the index's back
+  {
+    std::ofstream out(env.data_file, std::ios::binary | std::ios::trunc);
+    out << "X1#//#p#//#0#//#Only#//#1\n";
+  }
+  {
+    clsAccountIndex index;
+    REQUIRE(index.open(env.data_file, env.index_file));
+    REQUIRE(index.size() == 1);
+    REQUIRE(index.find("AC0") == std::nullopt);
+    REQUIRE(index.find("X1") == 0);
+  }
+
+  {
+    std::ofstream out(env.index_file, std::ios::binary | std::ios::trunc);
+    out << "garbage";
+  }
+  clsAccountIndex index;
+  REQUIRE(index.open(env.data_file, env.index_file));
+  REQUIRE(index.find("X1") == 0);
+}
+
+TEST_CASE("clsAccountIndex clears tombstones left by insert/erase churn",
+          "[account_index]") {
+  TestIndexEnv env("account_index_churn", 10);
+  clsAccountIndex index;
+  REQUIRE(index.open(env.data_file, env.index_file));
+  const std::uint64_t initial = index.capacity();
+
+  // Each round leaves one tombstone; far more rounds than the table has slots.
+  for (std::uint64_t i = 0; i < initial * 4; ++i) {
+    std::string account = "T" + std::to_string(i);
+    index.insert(account, env.append(account + "#//#p#//#0#//#n#//#0"));
+    REQUIRE(index.erase(account));
+  }
+  REQUIRE(index.capacity() == initial); // Cleared in place, not grown
+  REQUIRE(index.size() == 10);
+  REQUIRE(index.find("missing") == std::nullopt); // Must reach an empty slot
+  REQUIRE(index.find("T0") == std::nullopt);
+  REQUIRE(index.find("AC9").has_value());
+}
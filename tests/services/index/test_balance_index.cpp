@@ -0,0 +1,110 @@
+// tests/services/index/test_balance_index.cpp
+#include "catch_amalgamated.hpp"
+#include "services/index/balance_index/balance_index.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace balance_index;
+
+namespace {
+struct TestBalanceEnv {
+  std::filesystem::path dir;
+  std::filesystem::path data_file;
+  std::filesystem::path index_file;
+
+  TestBalanceEnv(const std::string &subdir,
+                 const std::vector<std::string> &balances) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+    index_file = dir / std::string(infrastructure_names::BALANCE_INDEX_FILE_NAME);
+    std::ofstream out(data_file, std::ios::binary);
+    for (std::size_t i = 0; i < balances.size(); ++i)
+      out << "AC" << i << "#//#pin#//#0100#//#Client " << i << "#//#"
+          << balances[i] << "\n";
+  }
+  ~TestBalanceEnv() { std::filesystem::remove_all(dir); }
+};
+
+std::vector<std::string> accounts_in(const clsBalanceIndex &index,
+                                     std::int64_t low, std::int64_t high) {
+  std::vector<client_data_structure::stClientData> records;
+  index.find_range_records(low, high, records);
+  std::vector<std::string> accounts;
+  for (const auto &record : records)
+    accounts.push_back(record.account_number);
+  return accounts;
+}
+} // namespace
+
+TEST_CASE("clsBalanceIndex answers inclusive ranges in balance order",
+          "[balance_index]") {
+  TestBalanceEnv env("balance_index_range",
+                     {"100", "-5.5", "0", "250.75", "100", "-0.01", "99.99"});
+  clsBalanceIndex index;
+  REQUIRE(index.open(env.data_file, env.index_file));
+  REQUIRE(std::filesystem::exists(env.index_file));
+  REQUIRE(index.size() == 7);
+
+  REQUIRE(accounts_in(index, 0, 10000) ==
+          std::vector<std::string>{"AC2", "AC6", "AC0", "AC4"});
+  REQUIRE(accounts_in(index, 10000, 10000) ==
+          std::vector<std::string>{"AC0", "AC4"}); // ties in file order
+  REQUIRE(accounts_in(index, 10001, 25074).empty());
+  REQUIRE(accounts_in(index, 25075, 1000000) == std::vector<std::string>{"AC3"});
+  REQUIRE(index.find_range(5, 1).empty()); // low > high
+
+  for (std::uint64_t offset : index.find_overdrawn())
+    REQUIRE(offset < std::filesystem::file_size(env.data_file));
+  REQUIRE(index.find_overdrawn().size() == 2);
+}
+
+TEST_CASE("clsBalanceIndex ranks match a sorted column", "[balance_index]") {
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<int> amount(-500, 500);
+  std::vector<std::string> balances;
+  std::vector<std::int64_t> sorted;
+  for (int i = 0; i < 3001; ++i) {
+    const int value = amount(random);
+    balances.push_back(std::to_string(value));
+    sorted.push_back(static_cast<std::int64_t>(value) * 100);
+  }
+  std::sort(sorted.begin(), sorted.end());
+  TestBalanceEnv env("balance_index_ranks", balances);
+  clsBalanceIndex index;
+  REQUIRE(index.open(env.data_file, env.index_file));
+
+  for (std::int64_t probe = -51000; probe <= 51000; probe += 50) {
+    REQUIRE(index.lower_rank(probe) ==
+            static_cast<std::uint64_t>(
+                std::lower_bound(sorted.begin(), sorted.end(), probe) -
+                sorted.begin()));
+    REQUIRE(index.upper_rank(probe) ==
+            static_cast<std::uint64_t>(
+                std::upper_bound(sorted.begin(), sorted.end(), probe) -
+                sorted.begin()));
+  }
+}
+
+TEST_CASE("clsBalanceIndex handles an empty data file and rebuilds when stale",
+          "[balance_index]") {
+  TestBalanceEnv env("balance_index_stale", {});
+  {
+    clsBalanceIndex index;
+    REQUIRE(index.open(env.data_file, env.index_file));
+    REQUIRE(index.size() == 0);
+    REQUIRE(index.find_overdrawn().empty());
+  }
+  {
+    std::ofstream out(env.data_file, std::ios::binary | std::ios::app);
+    out << "AC9#//#pin#//#0100#//#Late#//#-3\n";
+  }
+  clsBalanceIndex reopened;
+  REQUIRE(reopened.open(env.data_file, env.index_file));
+  REQUIRE(accounts_in(reopened, INT64_MIN, -1) == std::vector<std::string>{"AC9"});
+}
@@ -0,0 +1,96 @@
+// tests/services/index/test_name_index.cpp
+#include "catch_amalgamated.hpp"
+#include "services/index/name_index/name_index.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace name_index;
+
+namespace {
+struct TestNameEnv {
+  std::filesystem::path dir;
+  std::filesystem::path data_file;
+  std::filesystem::path index_file;
+
+  TestNameEnv(const std::string &subdir, const std::vector<std::string> &names) {
+    dir = std::filesystem::temp_directory_path() / subdir;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    data_file = dir / std::string(infrastructure_names::ORIGINAL_FILE_NAME);
+    index_file = dir / std::string(infrastructure_names::NAME_INDEX_FILE_NAME);
+    std::ofstream out(data_file, std::ios::binary);
+    for (std::size_t i = 0; i < names.size(); ++i)
+      out << "AC" << i << "#//#pin#//#0100#//#" << names[i] << "#//#" << i
+          << "\n";
+  }
+  ~TestNameEnv() { std::filesystem::remove_all(dir); }
+};
+
+std::vector<std::string> accounts_of(const clsNameIndex &index,
+                                     std::string_view prefix) {
+  std::vector<client_data_structure::stClientData> records;
+  index.find_prefix_records(prefix, records);
+  std::vector<std::string> accounts;
+  for (const auto &record : records)
+    accounts.push_back(record.account_number);
+  return accounts;
+}
+} // namespace
+
+TEST_CASE("clsNameIndex answers prefix lookups in name order, any case",
+          "[name_index]") {
+  TestNameEnv env("name_index_prefix",
+                  {"Carol Smith", "alice Jones", "Alicia Keys", "ALI", "Bob",
+                   "Carl", "Alice Jones"});
+  clsNameIndex index;
+  REQUIRE(index.open(env.data_file, env.index_file));
+  REQUIRE(std::filesystem::exists(env.index_file));
+  REQUIRE(index.size() == 7);
+
+  // Folded order: "ali" < "alice jones" (x2, file order) < "alicia keys"
+  REQUIRE(accounts_of(index, "ali") ==
+          std::vector<std::string>{"AC3", "AC1", "AC6", "AC2"});
+  REQUIRE(accounts_of(index, "ALICE") == std::vector<std::string>{"AC1", "AC6"});
+  REQUIRE(accounts_of(index, "alice jo") == std::vector<std::string>{"AC1", "AC6"});
+  REQUIRE(accounts_of(index, "car") == std::vector<std::string>{"AC5", "AC0"});
+  REQUIRE(accounts_of(index, "carla").empty()); // extends a leaf
+  REQUIRE(accounts_of(index, "alx").empty());   // diverges mid-edge
+  REQUIRE(accounts_of(index, "Zed").empty());
+  REQUIRE(index.find_prefix("").size() == 7);
+
+  REQUIRE(index.find_exact("ali").size() == 1);
+  REQUIRE(index.find_exact("alice jones").size() == 2);
+  REQUIRE(index.find_exact("alic").empty());
+}
+
+TEST_CASE("clsNameIndex rebuilds when the data file changes", "[name_index]") {
+  TestNameEnv env("name_index_stale", {"Dana", "Dave"});
+  {
+    clsNameIndex index;
+    REQUIRE(index.open(env.data_file, env.index_file));
+    REQUIRE(index.find_prefix("da").size() == 2);
+  }
+  {
+    std::ofstream out(env.data_file, std::ios::binary | std::ios::app);
+    out << "AC9#//#pin#//#0100#//#DAVID#//#9\n";
+  }
+  clsNameIndex reopened;
+  REQUIRE(reopened.open(env.data_file, env.index_file));
+  REQUIRE(accounts_of(reopened, "dav") == std::vector<std::string>{"AC1", "AC9"});
+}
+
+TEST_CASE("clsNameIndex handles many rows sharing long prefixes",
+          "[name_index]") {
+  std::vector<std::string> names;
+  for (int i = 0; i < 5000; ++i)
+    names.push_back("Client " + std::to_string(i));
+  TestNameEnv env("name_index_many", names);
+  clsNameIndex index;
+  REQUIRE(index.open(env.data_file, env.index_file));
+  REQUIRE(index.find_prefix("client ").size() == 5000);
+  REQUIRE(index.find_prefix("CLIENT 1").size() == 1111); // 1, 1x, 1xx, 1xxx
+  REQUIRE(index.find_prefix("client 4999").size() == 1);
+  REQUIRE(index.find_exact("client 499").size() == 1);
+}
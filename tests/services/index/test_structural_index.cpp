@@ -0,0 +1,108 @@
+// tests/services/index/test_structural_index.cpp
+#include "catch_amalgamated.hpp"
+#include "file_ops/file_ops.h"
+#include "services/convert/h_convert/h_convert.h"
+#include "services/index/structural_index/structural_index.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace structural_index;
+
+TEST_CASE("build_structural_index records newlines and separators in order",
+          "[structural_index]") {
+  // 0         1
+  // 0123456789012345678
+  // A#//#B\nC#//#D#//#E
+  std::string_view buffer = "A#//#B\nC#//#D#//#E";
+  auto index = build_structural_index(buffer);
+
+  REQUIRE(index.offsets == std::vector<std::uint64_t>{1, 6, 8, 13, 18});
+  REQUIRE(row_count(index) == 2);
+  REQUIRE(get_row(index, buffer, 0) == "A#//#B");
+  REQUIRE(get_row(index, buffer, 1) == "C#//#D#//#E");
+  REQUIRE(get_field_count(index, 0) == 2);
+  REQUIRE(get_field_count(index, 1) == 3);
+  REQUIRE(get_field(index, buffer, 0, 1) == "B");
+  REQUIRE(get_field(index, buffer, 1, 0) == "C");
+  REQUIRE(get_field(index, buffer, 1, 2) == "E");
+  REQUIRE(get_field(index, buffer, 1, 3).empty());
+}
+
+TEST_CASE("build_structural_index edge cases", "[structural_index]") {
+  SECTION("Empty buffer") {
+    auto index = build_structural_index("");
+    REQUIRE(row_count(index) == 0);
+    REQUIRE(index.offsets.empty());
+  }
+
+  SECTION("Blank lines and trailing newline follow std::getline") {
+    std::string_view buffer = "\n\nA\n";
+    auto index = build_structural_index(buffer);
+    REQUIRE(row_count(index) == 3);
+    REQUIRE(get_row(index, buffer, 0).empty());
+    REQUIRE(get_row(index, buffer, 1).empty());
+    REQUIRE(get_row(index, buffer, 2) == "A");
+  }
+
+  SECTION("Overlapping separators are not double counted") {
+    std::string_view buffer = "#//#//#";
+    auto index = build_structural_index(buffer);
+    REQUIRE(index.offsets == std::vector<std::uint64_t>{0, 7});
+    REQUIRE(get_field(index, buffer, 0, 0).empty());
+    REQUIRE(get_field(index, buffer, 0, 1) == "//#");
+  }
+}
+
+TEST_CASE("build_structural_index agrees with line splitting and detect_delim",
+          "[structural_index]") {
+  // Long, irregular lines so the SIMD body, block straddles and the scalar
+  // tail are all exercised
+  std::string buffer;
+  for (int i = 0; i < 500; ++i) {
+    buffer += "ACC" + std::to_string(i) + "#//#" + std::string(i % 37, 'p') +
+              "#//#01" + std::to_string(i * 7) + "#//#Name " +
+              std::string(i % 11, '#') + "#//#" + std::to_string(i * 3.5) +
+              "\n";
+    if (i % 50 == 0)
+      buffer += "\n"; // blank line
+  }
+  buffer += "last#//#line"; // no final newline
+
+  std::string file_name = "structural_index_roundtrip.csv";
+  {
+    std::ofstream out(file_name, std::ios::binary);
+    out << buffer;
+  }
+  auto lines = file_ops::get_all_clients(file_name);
+  std::filesystem::remove(file_name);
+
+  auto index = build_structural_index(buffer);
+  REQUIRE(row_count(index) == lines.size());
+  for (std::size_t row = 0; row < lines.size(); ++row) {
+    REQUIRE(get_row(index, buffer, row) == lines[row]);
+
+    std::vector<short> separators;
+    h_convert::detect_delim_scalar(lines[row], "#//#", separators);
+    REQUIRE(get_field_count(index, row) == separators.size() + 1);
+  }
+}
+
+TEST_CASE("get_all_clients_indexed maps and indexes a file",
+          "[structural_index]") {
+  std::string file_name = "clients_indexed.csv";
+  {
+    std::ofstream out(file_name, std::ios::binary);
+    out << "1#//#pw#//#555#//#Alice#//#10.5\n2#//#pw2#//#556#//#Bob#//#-3\n";
+  }
+  {
+    auto clients = file_ops::get_all_clients_indexed(file_name);
+    std::string_view buffer = clients.mapping.view();
+    REQUIRE(row_count(clients.index) == 2);
+    REQUIRE(get_field(clients.index, buffer, 0, 3) == "Alice");
+    REQUIRE(get_field(clients.index, buffer, 1, 4) == "-3");
+  }
+  std::filesystem::remove(file_name);
+}
@@ -0,0 +1,96 @@
+// tools/generate_clients.cpp : writes a seeded synthetic clients.csv for load
+// testing and benchmarks.
+//
+// Usage: SafecoinGen <output> <rows> [--seed N] [--name-length MIN:MAX]
+//                    [--balance MIN:MAX] [--balance-distribution uniform|skewed]
+//                    [--duplicates RATIO] [--threads N]
+// Balances are given in major units ("-1000:100000"); the same arguments always
+// produce the same bytes.
+
+#include "services/balance/balance.h"
+#include "services/generator/client_generator.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+void print_usage() {
+  std::cerr << "usage: SafecoinGen <output> <rows> [--seed N] "
+               "[--name-length MIN:MAX] [--balance MIN:MAX]\n"
+               "                   [--balance-distribution uniform|skewed] "
+               "[--duplicates RATIO] [--threads N]\n";
+}
+
+std::pair<std::string_view, std::string_view> split_range(std::string_view text) {
+  const std::size_t colon = text.find(':');
+  if (colon == std::string_view::npos)
+    throw std::invalid_argument("expected MIN:MAX, got " + std::string(text));
+  return {text.substr(0, colon), text.substr(colon + 1)};
+}
+
+std::int64_t parse_balance(std::string_view text) {
+  std::int64_t minor_units = 0;
+  if (!balance::parse_minor_units(text, minor_units))
+    throw std::invalid_argument("not a balance: " + std::string(text));
+  return minor_units;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    print_usage();
+    return 2;
+  }
+
+  client_generator::stGeneratorOptions options;
+  try {
+    options.rows = std::stoull(argv[2]);
+    for (int i = 3; i < argc; ++i) {
+      const std::string_view flag = argv[i];
+      if (i + 1 >= argc)
+        throw std::invalid_argument("missing value for " + std::string(flag));
+      const std::string value = argv[++i];
+
+      if (flag == "--seed") {
+        options.seed = std::stoull(value);
+      } else if (flag == "--name-length") {
+        auto [low, high] = split_range(value);
+        options.name_length_min = std::stoull(std::string(low));
+        options.name_length_max = std::stoull(std::string(high));
+      } else if (flag == "--balance") {
+        auto [low, high] = split_range(value);
+        options.balance_min_minor = parse_balance(low);
+        options.balance_max_minor = parse_balance(high);
+      } else if (flag == "--balance-distribution") {
+        if (value == "uniform")
+          options.balance_distribution = client_generator::enBalanceDistribution::uniform;
+        else if (value == "skewed")
+          options.balance_distribution = client_generator::enBalanceDistribution::skewed;
+        else
+          throw std::invalid_argument("unknown distribution: " + value);
+      } else if (flag == "--duplicates") {
+        options.duplicate_ratio = std::stod(value);
+      } else if (flag == "--threads") {
+        options.thread_count = static_cast<unsigned>(std::stoul(value));
+      } else {
+        throw std::invalid_argument("unknown option: " + std::string(flag));
+      }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t bytes =
+        client_generator::generate_clients_file(argv[1], options);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << options.rows << " rows, " << bytes << " bytes written to "
+              << argv[1] << " in " << elapsed.count() << " s\n";
+  } catch (const std::exception &error) {
+    std::cerr << "SafecoinGen: " << error.what() << '\n';
+    print_usage();
+    return 1;
+  }
+  return 0;
+}